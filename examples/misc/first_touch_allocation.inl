@@ -0,0 +1,213 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * first_touch_allocation.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef FIRST_TOUCH_ALLOCATION_INL_
+#define FIRST_TOUCH_ALLOCATION_INL_
+
+/**
+ * \example first_touch_allocation.inl
+ *
+ * Benchmark of the placement of the pages of the containers on NUMA machines (OpenMP backend).
+ * A dataset and a sample of decays are allocated and written by a single thread, as by
+ * a sequential reader, so that all their pages are mapped on the memory of one socket.
+ * The evaluation of a hydra::LogLikelihoodFCN and hydra::PhaseSpace::Generate are timed on
+ * these containers, and again after numa_resize(), which moves the storage to new blocks
+ * mapped by the threads processing each part of them. Run it with the threads pinned,
+ * e.g. OMP_PROC_BIND=spread OMP_PLACES=cores, on a machine with more than one socket.
+ *
+ * With HYDRA_FIRST_TOUCH_ALLOCATION, the pages are mapped by all threads as soon as
+ * the containers are allocated, e.g. by reserve() before a sequential push_back().
+ */
+
+#include <iostream>
+#include <assert.h>
+#include <time.h>
+#include <chrono>
+#include <vector>
+#include <omp.h>
+
+//command line
+#include <tclap/CmdLine.h>
+
+//this lib
+#include <hydra/device/System.h>
+#include <hydra/host/System.h>
+#include <hydra/Function.h>
+#include <hydra/Random.h>
+#include <hydra/LogLikelihoodFCN.h>
+#include <hydra/Parameter.h>
+#include <hydra/UserParameters.h>
+#include <hydra/Pdf.h>
+#include <hydra/functions/Gaussian.h>
+#include <hydra/Vector4R.h>
+#include <hydra/PhaseSpace.h>
+#include <hydra/Decays.h>
+#include <hydra/multivector.h>
+
+
+template<typename FCN>
+double time_fcn(FCN const& fcn, size_t nrepetitions)
+{
+	std::vector<double> parameters{0.0, 1.0};
+
+	double sum = 0;
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for(size_t i=0; i<nrepetitions; i++){
+
+		parameters[0] = 0.001*i;
+		sum += fcn(parameters);
+	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+
+	std::chrono::duration<double, std::milli> elapsed = end - start;
+
+	std::cout << "| -log(L) sum          :" << sum << std::endl;
+
+	return elapsed.count()/nrepetitions;
+}
+
+template<typename PHSP, typename EVENTS>
+double time_generate(PHSP& phsp, hydra::Vector4R const& mother, EVENTS& events, size_t nrepetitions)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for(size_t i=0; i<nrepetitions; i++)
+		phsp.Generate(mother, events.begin(), events.end());
+
+	auto end = std::chrono::high_resolution_clock::now();
+
+	std::chrono::duration<double, std::milli> elapsed = end - start;
+
+	return elapsed.count()/nrepetitions;
+}
+
+int main(int argv, char** argc)
+{
+	size_t nentries     = 0;
+	size_t nrepetitions = 0;
+
+	try {
+
+		TCLAP::CmdLine cmd("Command line arguments for ", '=');
+
+		TCLAP::ValueArg<size_t> EArg("n", "number-of-events","Number of events", true, 10e6, "size_t");
+		cmd.add(EArg);
+
+		TCLAP::ValueArg<size_t> RArg("r", "repetitions","Number of repetitions of each measurement", false, 20, "size_t");
+		cmd.add(RArg);
+
+		// Parse the argv array.
+		cmd.parse(argv, argc);
+
+		// Get the value parsed by each arg.
+		nentries     = EArg.getValue();
+		nrepetitions = RArg.getValue();
+
+	}
+	catch (TCLAP::ArgException &e)  {
+		std::cerr << "error: " << e.error() << " for arg " << e.argId()
+														<< std::endl;
+	}
+
+	//-----------------
+	// model
+	double min   = -5.0;
+	double max   =  5.0;
+
+	hydra::Parameter  mean_p  = hydra::Parameter::Create().Name("Mean").Value(0.0).Error(0.0001).Limits(-1.0, 1.0);
+	hydra::Parameter  sigma_p = hydra::Parameter::Create().Name("Sigma").Value(1.0).Error(0.0001).Limits(0.01, 1.5);
+
+	hydra::Gaussian<> gaussian(mean_p, sigma_p);
+
+	auto model = hydra::make_pdf(gaussian, hydra::GaussianAnalyticalIntegral(min, max) );
+
+	//-----------------
+	// phase-space B0 -> J/psi K pi
+	double B0_mass    = 5.27955;
+	double Jpsi_mass  = 3.0969;
+	double K_mass     = 0.493677;
+	double pi_mass    = 0.13957061;
+
+	hydra::Vector4R B0(B0_mass, 0.0, 0.0, 0.0);
+
+	hydra::PhaseSpace<3> phsp{Jpsi_mass, K_mass, pi_mass};
+
+	//-----------------
+	// containers written for the first time by a single thread,
+	// e.g. by a sequential reader
+	hydra::host::vector<double> source(nentries);
+
+	hydra::Random<> Generator(159753);
+	Generator.Gauss(0.0, 1.0, source.begin(), source.end());
+
+	hydra::Decays<3, hydra::host::sys_t > events_h(nentries);
+	phsp.Generate(B0, events_h.begin(), events_h.end());
+
+	int nthreads = omp_get_max_threads();
+
+	omp_set_num_threads(1);
+
+	hydra::multivector<HYDRA_EXTERNAL_NS::thrust::tuple<double>, hydra::device::sys_t> data_d(nentries);
+	HYDRA_EXTERNAL_NS::thrust::copy(source.begin(), source.end(), data_d.begin(hydra::placeholders::_0));
+
+	hydra::Decays<3, hydra::device::sys_t > events_d(events_h);
+
+	omp_set_num_threads(nthreads);
+
+	//-----------------
+	// timings
+	auto fcn = hydra::make_loglikehood_fcn(model, data_d.begin(), data_d.end());
+
+	double fcn_serial      = time_fcn(fcn, nrepetitions);
+	double generate_serial = time_generate(phsp, B0, events_d, nrepetitions);
+
+	//move the storage to blocks mapped by the threads processing them
+	data_d.numa_resize(nentries);
+	events_d.numa_resize(nentries);
+
+	auto fcn_local = hydra::make_loglikehood_fcn(model, data_d.begin(), data_d.end());
+
+	double fcn_numa      = time_fcn(fcn_local, nrepetitions);
+	double generate_numa = time_generate(phsp, B0, events_d, nrepetitions);
+
+	std::cout << std::endl;
+	std::cout << "-----------------------------------------------------"<< std::endl;
+	std::cout << "| Number of threads    :" << nthreads                   << std::endl;
+	std::cout << "| Number of events     :" << nentries                   << std::endl;
+	std::cout << "| Time per call (ms)   : filled serially | numa_resize" << std::endl;
+	std::cout << "| LogLikelihoodFCN     : " << fcn_serial      << " | " << fcn_numa      << std::endl;
+	std::cout << "| PhaseSpace::Generate : " << generate_serial << " | " << generate_numa << std::endl;
+	std::cout << "-----------------------------------------------------"<< std::endl;
+
+	return 0;
+}
+
+#endif /* FIRST_TOUCH_ALLOCATION_INL_ */
@@ -185,6 +185,31 @@ int main(int argv, char** argc)
 
 	}//device
 
+	//device, stratified sampling
+	{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	auto device_result = phsp.AverageOn(hydra::device::sys, B0 , cosTheta, nentries, hydra::StratifiedSampling) ;
+
+	auto end = std::chrono::high_resolution_clock::now();
+
+	std::chrono::duration<double, std::milli> elapsed = end - start;
+
+	//output
+	std::cout << std::endl;
+	std::cout << std::endl;
+	std::cout << "--------- Device (stratified) -----------"<< std::endl;
+	std::cout << "|< cos(theta_K) >(B0 -> J/psi K pi): "
+			  << device_result.first
+			  << " +- "
+			  << device_result.second
+			  << std::endl;
+	std::cout << "| Number of events :"<< nentries          << std::endl;
+	std::cout << "| Time (ms)        :"<< elapsed.count()   << std::endl;
+	std::cout << "-----------------------------------------"<< std::endl;
+
+	}//device, stratified
+
 
 
 
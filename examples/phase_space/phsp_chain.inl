@@ -274,7 +274,35 @@ int main(int argv, char** argc)
 
 	}
 
+	//device, fused
+	{
+		//allocate memory to hold the final states particles
+		auto Chain_d   = hydra::make_chain<3,2>(hydra::device::sys, nentries);
+
+		auto start = std::chrono::high_resolution_clock::now();
+
+		//generate B0 -> K pi J/psi and J/psi -> mu+ mu- in a single pass.
+		//The mother of the second decay is the daughter 0 of the first one.
+		//Only the final state particles and the chain weights are stored.
+		Chain_d.GenerateFinalState(B0, {{0,0}}, phsp1, phsp2);
+
+		auto end = std::chrono::high_resolution_clock::now();
+
+		std::chrono::duration<double, std::milli> elapsed = end - start;
+
+		//output
+		std::cout << std::endl;
+		std::cout << std::endl;
+		std::cout << "------------- Device (fused) ------------"<< std::endl;
+		std::cout << "| B0 -> J/psi K pi | J/psi -> mu+ mu-"    << std::endl;
+		std::cout << "| Number of events :"<< nentries          << std::endl;
+		std::cout << "| Time (ms)        :"<< elapsed.count()   << std::endl;
+		std::cout << "-----------------------------------------"<< std::endl;
 
+		//print
+		for( size_t i=0; i<10; i++ )
+			std::cout << Chain_d[i] << std::endl;
+	}
 
 
 #ifdef 	_ROOT_AVAILABLE_
@@ -127,6 +127,15 @@ public:
 		HYDRA_EXTERNAL_NS::thrust::copy(other.begin(), other.end(), this->begin());
 	}
 
+	/**
+	 * Move constructor for caches allocated in different backends, handing over the
+	 * storage of \p other without copying when possible (see hydra::multivector).
+	 */
+	template< hydra::detail::Backend BACKEND2>
+	Cache(Cache<hydra::detail::BackendPolicy<BACKEND2>,Functors...>&& other):
+		fData(other.MoveData())
+	{}
+
 	Cache<hydra::detail::BackendPolicy<BACKEND>,Functors...>&
 	operator=(Cache<hydra::detail::BackendPolicy<BACKEND>,Functors...> const& other){
 
@@ -171,6 +180,9 @@ public:
 
 private:
 
+	template< typename BACKEND2, typename ...Functors2>
+	friend class Cache;
+
 	template<size_t I>
 	typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I == sizeof...(Functors)), void>::type
 	SetCacheIndexHelper(HYDRA_EXTERNAL_NS::thrust::tuple<Functors&...>){ }
@@ -202,6 +214,21 @@ private:
 };
 
 
+/**
+ * Move the storage of a Cache to a Cache of the backend BACKEND2 without copying,
+ * e.g. `hydra::rebind<hydra::omp::sys_t>(std::move(cache))`. The allocators of the two backends
+ * must share the memory resource (hydra::detail::is_rebindable). \p other is left empty.
+ */
+template<typename BACKEND2, hydra::detail::Backend BACKEND, typename ...Functors>
+Cache<BACKEND2, Functors...>
+rebind(Cache<hydra::detail::BackendPolicy<BACKEND>, Functors...>&& other)
+{
+	static_assert( detail::is_rebindable<detail::BackendPolicy<BACKEND>, BACKEND2>::value,
+			"[Hydra::rebind] : the containers of the two backends do not share the memory resource.");
+
+	return Cache<BACKEND2, Functors...>(std::move(other));
+}
+
 template< hydra::detail::Backend BACKEND, typename Iterator, typename ...Functors>
 auto make_cache(hydra::detail::BackendPolicy<BACKEND>, Iterator first, Iterator last, Functors&... functors)
 ->Cache<hydra::detail::BackendPolicy<BACKEND>, Functors...>
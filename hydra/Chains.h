@@ -40,14 +40,19 @@
 #include <hydra/Types.h>
 #include <hydra/Containers.h>
 #include <hydra/Decays.h>
+#include <hydra/PhaseSpace.h>
+#include <hydra/Vector4R.h>
 #include <hydra/detail/utility/Utility_Tuple.h>
 #include <hydra/detail/utility/Generic.h>
 #include <hydra/detail/functors/FlagAcceptReject.h>
+#include <hydra/detail/functors/DecayChain.h>
+#include <hydra/detail/launch_decayers.inl>
 #include <hydra/Placeholders.h>
 //thrust
 #include <hydra/detail/external/thrust/tuple.h>
 #include <hydra/detail/external/thrust/iterator/zip_iterator.h>
 #include <hydra/detail/external/thrust/distance.h>
+#include <hydra/detail/external/thrust/iterator/constant_iterator.h>
 
 namespace hydra {
 
@@ -70,6 +75,8 @@ template<size_t ...N, hydra::detail::Backend BACKEND>
 class Chains<Decays<N, hydra::detail::BackendPolicy<BACKEND> >...> {
 
 	constexpr const static size_t NDecays = sizeof...(N);
+	constexpr const static size_t N0 = detail::chain_element<0, N...>::value;
+	constexpr const static size_t NParticles = detail::chain_offset<sizeof...(N), N...>::value;
 	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
 
 	typedef decltype(hydra::detail::make_index_sequence<sizeof...(N)> {}) indexing_type;
@@ -309,8 +316,165 @@ public:
 	const reference_type operator[](size_t i) const
 	{	return this->begin()[i];}
 
+	/**
+	 * @brief Generate the whole chain in a single pass over the events, given a mother particle.
+	 *
+	 * All decays of each event are generated at once and the intermediate states are kept in registers,
+	 * so the chain is written to memory only once. The chain weight is the product of the weights of
+	 * all decays. Each decay is generated with the seed of the corresponding hydra::PhaseSpace object,
+	 * reproducing the events obtained calling PhaseSpace::Generate decay by decay.
+	 * @code{.cpp}
+	 * //B0 -> J/psi K pi, J/psi -> mu+ mu-: the mother of the decay 1 is the daughter 0 of the decay 0.
+	 * chain.Generate(B0, {{0,0}}, phsp_B0, phsp_Jpsi);
+	 * @endcode
+	 * @param mother Mother particle of the first decay.
+	 * @param links List of pairs {J, K}, one for each decay I>0, meaning that the mother of the decay I is the daughter K of the decay J<I.
+	 * @param phsp hydra::PhaseSpace objects describing each decay.
+	 */
+	template<typename GRND>
+	void Generate(Vector4R const& mother, std::initializer_list<std::pair<size_t,size_t>> links,
+			PhaseSpace<N, GRND> const& ...phsp)
+	{
+		__generate(mother, links, true, phsp...);
+	}
+
+	/**
+	 * @brief Generate the whole chain in a single pass over the events, given a range of mother particles.
+	 * @param mbegin Iterator pointing to the begin of range of mother particles.
+	 * @param mend Iterator pointing to the end of range of mother particles.
+	 * @param links List of pairs {J, K}, one for each decay I>0, meaning that the mother of the decay I is the daughter K of the decay J<I.
+	 * @param phsp hydra::PhaseSpace objects describing each decay.
+	 */
+	template<typename Iterator, typename GRND>
+	void Generate(Iterator mbegin, Iterator mend, std::initializer_list<std::pair<size_t,size_t>> links,
+			PhaseSpace<N, GRND> const& ...phsp)
+	{
+		__generate(mbegin, mend, links, true, phsp...);
+	}
+
+	/**
+	 * @brief Same as Generate(mother, links, phsp...), but only the final state particles
+	 * and the chain weight are written. The weights of each decay and the intermediate
+	 * states are not stored, reducing the memory traffic.
+	 */
+	template<typename GRND>
+	void GenerateFinalState(Vector4R const& mother, std::initializer_list<std::pair<size_t,size_t>> links,
+			PhaseSpace<N, GRND> const& ...phsp)
+	{
+		__generate(mother, links, false, phsp...);
+	}
+
+	/**
+	 * @brief Same as Generate(mbegin, mend, links, phsp...), but only the final state particles
+	 * and the chain weight are written.
+	 */
+	template<typename Iterator, typename GRND>
+	void GenerateFinalState(Iterator mbegin, Iterator mend, std::initializer_list<std::pair<size_t,size_t>> links,
+			PhaseSpace<N, GRND> const& ...phsp)
+	{
+		__generate(mbegin, mend, links, false, phsp...);
+	}
+
 private:
 
+	//_______________________________________________
+	//fused generation
+
+	template<typename GRND>
+	bool __setup(std::initializer_list<std::pair<size_t,size_t>> links,
+			GReal_t (&masses)[NParticles], size_t (&seeds)[NDecays],
+			GInt_t (&mothers)[NDecays], PhaseSpace<N, GRND> const& ...phsp) const
+	{
+		assert(links.size()==NDecays-1 && "HYDRA MESSAGE: hydra::Chains::Generate -> links list need to have one entry for each decay after the first one.");
+
+		size_t sizes[NDecays]{N...};
+		size_t offsets[NDecays]{};
+		for(size_t i=1; i<NDecays; i++)
+			offsets[i] = offsets[i-1] + sizes[i-1];
+
+		const GReal_t* decay_masses[NDecays]{ phsp.GetMasses()...};
+		size_t decay_seeds[NDecays]{ size_t(phsp.GetSeed())...};
+
+		for(size_t i=0; i<NDecays; i++){
+			seeds[i] = decay_seeds[i];
+			for(size_t j=0; j<sizes[i]; j++)
+				masses[offsets[i]+j] = decay_masses[i][j];
+		}
+
+		mothers[0] = -1;
+		bool energy = true;
+		size_t i=1;
+		for(auto link: links){
+
+			assert(link.first < i && link.second < sizes[link.first] && "HYDRA MESSAGE: hydra::Chains::Generate -> the mother of the decay I needs to be a daughter of a decay J<I.");
+
+			mothers[i] = offsets[link.first] + link.second;
+
+			GReal_t sum = 0;
+			for(size_t j=0; j<sizes[i]; j++)
+				sum += masses[offsets[i]+j];
+
+			energy &= masses[mothers[i]] > sum;
+			i++;
+		}
+
+		return energy;
+	}
+
+	template<typename GRND>
+	void __generate(Vector4R const& mother, std::initializer_list<std::pair<size_t,size_t>> links,
+			bool store_intermediates, PhaseSpace<N, GRND> const& ...phsp)
+	{
+		typedef detail::DecayChain<GRND, N...> decayer_t;
+
+		GReal_t masses[NParticles];
+		size_t seeds[NDecays];
+		GInt_t mothers[NDecays];
+
+		bool energy = __setup(links, masses, seeds, mothers, phsp...);
+
+		GReal_t teCmTm = mother.mass();
+		for(size_t j=0; j<N0; j++)
+			teCmTm -= masses[j];
+
+		if( energy && teCmTm > 0.0 ){
+
+			decayer_t decayer(mother, masses, seeds, mothers, store_intermediates);
+			detail::launch_decayer(this->begin(), this->end(), decayer);
+		}
+		else {
+			HYDRA_LOG(WARNING, "Not enough energy to generate all decays.Check the masses of the particles in the chain")
+		}
+	}
+
+	template<typename Iterator, typename GRND>
+	void __generate(Iterator mbegin, Iterator mend, std::initializer_list<std::pair<size_t,size_t>> links,
+			bool store_intermediates, PhaseSpace<N, GRND> const& ...phsp)
+	{
+		typedef detail::DecayChain<GRND, N...> decayer_t;
+
+		GReal_t masses[NParticles];
+		size_t seeds[NDecays];
+		GInt_t mothers[NDecays];
+
+		bool energy = __setup(links, masses, seeds, mothers, phsp...);
+
+		GReal_t first_masses[N0];
+		for(size_t j=0; j<N0; j++)
+			first_masses[j] = masses[j];
+
+		energy &= HYDRA_EXTERNAL_NS::thrust::all_of( mbegin,  mend,  detail::CheckEnergy<N0>(first_masses) );
+
+		if( energy ){
+
+			decayer_t decayer(masses, seeds, mothers, store_intermediates);
+			detail::launch_decayer(mbegin, mend, this->begin(), decayer);
+		}
+		else {
+			HYDRA_LOG(WARNING, "Not enough energy to generate all decays.Check the masses of the particles in the chain")
+		}
+	}
+
 	const weights_type& __copy_weights() const {return fWeights;}
 	const decays_type& __copy_decays() const {return fDecays;}
 
@@ -0,0 +1,234 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * ChunkedSource.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+/**
+ * \file
+ * \ingroup generic
+ */
+
+#ifndef CHUNKEDSOURCE_H_
+#define CHUNKEDSOURCE_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/BackendPolicy.h>
+#include <hydra/multivector.h>
+#include <hydra/multivector_view.h>
+#include <hydra/detail/external/thrust/tuple.h>
+#include <hydra/detail/external/thrust/transform_reduce.h>
+
+#include <array>
+#include <future>
+#include <memory>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+
+namespace hydra {
+
+template<typename T, typename BACKEND>
+class ChunkedSource;
+
+/**
+ * \ingroup generic
+ *
+ * \brief Dataset read in chunks of fixed size, for datasets that do not fit in memory.
+ *
+ * A \p ChunkedSource describes \p nrows rows, in the columns T..., delivered as consecutive chunks of at most
+ * \p chunk_size rows by a loader: a callable `view_type(size_t first_row, size_t n, chunk_type& buffer)` returning a
+ * read-only hydra::multivector_view of the rows [first_row, first_row + n), either stored in the \p buffer (e.g. read
+ * from a file) or elsewhere (e.g. mapped to memory by hydra::ColumnarFile). hydra::make_chunked_source builds a source
+ * from a reader filling a hydra::multivector with each chunk.
+ *
+ * hydra::ChunkedSource::ForEachChunk processes the chunks in order, while the next one is loaded on a background
+ * thread, in a second buffer, so that reading overlaps with the computation. Only two chunks are in memory at a time.
+ * The overloads of hydra::make_loglikehood_fcn, hydra::DenseHistogram::Fill and hydra::SPlot::Generate taking a source
+ * process it chunk by chunk, carrying the partial results from one chunk to the next, so that each row contributes as in
+ * the same call on the whole dataset in memory.
+ *
+ * Copies of a source share the buffers: a source must not be processed by two threads at the same time.
+ */
+template<typename ...T, hydra::detail::Backend BACKEND>
+class ChunkedSource< HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>>
+{
+	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
+
+public:
+
+	typedef multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, system_t>      chunk_type;
+	typedef multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T const...>, system_t> view_type;
+	typedef typename chunk_type::const_iterator iterator;
+	typedef typename chunk_type::value_type     value_type;
+	typedef std::function<view_type(size_t, size_t, chunk_type&)> loader_type;
+
+	ChunkedSource() = delete;
+
+	/**
+	 * @param nrows number of rows of the dataset.
+	 * @param chunk_size maximum number of rows of each chunk.
+	 * @param loader callable returning the view of the rows [first_row, first_row + n), given a buffer to store them.
+	 */
+	ChunkedSource(size_t nrows, size_t chunk_size, loader_type const& loader):
+		fNRows(nrows),
+		fChunkSize(chunk_size),
+		fLoader(loader),
+		fBuffers(std::make_shared<std::array<chunk_type, 2>>())
+	{
+		if( fChunkSize == 0 )
+			throw std::invalid_argument("[Hydra::ChunkedSource] : the chunk size must be positive.");
+	}
+
+	ChunkedSource(ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, system_t> const& other):
+		fNRows(other.GetNRows()),
+		fChunkSize(other.GetChunkSize()),
+		fLoader(other.GetLoader()),
+		fBuffers(other.fBuffers)
+	{}
+
+	ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, system_t>&
+	operator=(ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, system_t> const& other)
+	{
+		if(this == &other) return *this;
+
+		fNRows     = other.GetNRows();
+		fChunkSize = other.GetChunkSize();
+		fLoader    = other.GetLoader();
+		fBuffers   = other.fBuffers;
+
+		return *this;
+	}
+
+	inline size_t GetNRows() const
+	{
+		return fNRows;
+	}
+
+	inline size_t GetChunkSize() const
+	{
+		return fChunkSize;
+	}
+
+	inline size_t GetNChunks() const
+	{
+		return (fNRows + fChunkSize - 1)/fChunkSize;
+	}
+
+	inline const loader_type& GetLoader() const
+	{
+		return fLoader;
+	}
+
+	/**
+	 * Call `function(first, last, first_row)` for each chunk, in order, with the iterators of the rows of the chunk
+	 * and the index of its first row in the dataset. The next chunk is loaded on a background thread during the call.
+	 * Exceptions thrown by the loader are rethrown here.
+	 */
+	template<typename Function>
+	void ForEachChunk(Function&& function) const
+	{
+		size_t nchunks = GetNChunks();
+
+		if( nchunks == 0 ) return;
+
+		std::future<view_type> next = Load(0);
+
+		for(size_t chunk = 0; chunk < nchunks; chunk++)
+		{
+			view_type current = next.get();
+
+			if( chunk + 1 < nchunks )
+				next = Load(chunk + 1);
+
+			function(current.begin(), current.end(), chunk*fChunkSize);
+		}
+	}
+
+	/**
+	 * Equivalent to `thrust::transform_reduce` over the whole dataset, computed chunk by chunk. The result of
+	 * each chunk is the initial value of the next one, so that, on sequential backends, the operations are
+	 * performed in the same order as on the dataset in memory.
+	 */
+	template<typename UnaryFunction, typename OutputType, typename BinaryFunction>
+	OutputType TransformReduce(UnaryFunction const& unary_op, OutputType init, BinaryFunction const& binary_op) const
+	{
+		OutputType result = init;
+
+		ForEachChunk([&](iterator first, iterator last, size_t){
+
+			result = HYDRA_EXTERNAL_NS::thrust::transform_reduce(system_t(), first, last, unary_op, result, binary_op);
+		});
+
+		return result;
+	}
+
+private:
+
+	std::future<view_type> Load(size_t chunk) const
+	{
+		size_t first = chunk*fChunkSize;
+		size_t n     = std::min(fChunkSize, fNRows - first);
+
+		chunk_type& buffer = (*fBuffers)[chunk%2];
+		loader_type const& loader = fLoader;
+
+		return std::async(std::launch::async, [first, n, &buffer, &loader](){ return loader(first, n, buffer); });
+	}
+
+	size_t fNRows;
+	size_t fChunkSize;
+	loader_type fLoader;
+	std::shared_ptr<std::array<chunk_type, 2>> fBuffers;
+};
+
+/**
+ * \ingroup generic
+ *
+ * Build a hydra::ChunkedSource of \p nrows rows, with the columns T..., in the memory space of the backend.
+ * The chunks are read by calling `reader(first_row, n, chunk)` with a hydra::multivector \p chunk
+ * resized to n rows, to be filled with the rows [first_row, first_row + n), e.g. from a file or a generator.
+ *
+ * Usage: `hydra::make_chunked_source<double, double>(hydra::device::sys, nrows, chunk_size, reader)`
+ */
+template<typename ...T, hydra::detail::Backend BACKEND, typename Reader>
+ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>>
+make_chunked_source(hydra::detail::BackendPolicy<BACKEND> const&, size_t nrows, size_t chunk_size, Reader reader)
+{
+	typedef ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> source_type;
+
+	return source_type(nrows, chunk_size,
+			[reader](size_t first, size_t n, typename source_type::chunk_type& chunk) mutable {
+
+		chunk.resize(n);
+		reader(first, n, chunk);
+
+		return typename source_type::view_type(chunk.begin(), chunk.end());
+	});
+}
+
+}  // namespace hydra
+
+#endif /* CHUNKEDSOURCE_H_ */
@@ -0,0 +1,162 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * ColumnSpan.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+/**
+ * \file
+ * \ingroup generic
+ */
+
+#ifndef COLUMNSPAN_H_
+#define COLUMNSPAN_H_
+
+#include <hydra/detail/Config.h>
+
+#include <cstddef>
+
+namespace hydra {
+
+/**
+ * \ingroup generic
+ *
+ * \brief Raw access to one column of a container: a pointer and the number of elements.
+ *
+ * The span itself makes no aliasing promise to the compiler. The columns of a container do not overlap,
+ * so user loops can copy the pointers of hydra::multivector::spans() into local `restrict` pointers:
+ * \code{.cpp}
+ * auto spans = data.spans();
+ * double* __restrict__ x = hydra::get<0>(spans).data();
+ * double* __restrict__ y = hydra::get<1>(spans).data();
+ *
+ * for(size_t i=0; i<hydra::get<0>(spans).padded_size(); i++) y[i] = 2.0*x[i];
+ * \endcode
+ * For containers allocated with HYDRA_ALIGNED_ALLOCATION, the data is aligned to HYDRA_ALIGNMENT bytes and
+ * can be read up to padded_size(), a multiple of HYDRA_ALIGNMENT bytes; the elements between size() and
+ * padded_size() are not initialized. Otherwise padded_size() is size().
+ * The pointers refer to the memory of the backend of the container, i.e. device memory for CUDA.
+ */
+template<typename T>
+class ColumnSpan
+{
+
+public:
+
+	typedef T        value_type;
+	typedef T*       pointer;
+	typedef T&       reference;
+	typedef size_t   size_type;
+
+	__hydra_host__ __hydra_device__
+	ColumnSpan():
+		fData(nullptr),
+		fSize(0),
+		fPaddedSize(0)
+	{}
+
+	__hydra_host__ __hydra_device__
+	ColumnSpan(T* data, size_t size, size_t padded_size):
+		fData(data),
+		fSize(size),
+		fPaddedSize(padded_size)
+	{}
+
+	//copy
+	__hydra_host__ __hydra_device__
+	ColumnSpan(ColumnSpan<T> const& other):
+		fData(other.data()),
+		fSize(other.size()),
+		fPaddedSize(other.padded_size())
+	{}
+
+	__hydra_host__ __hydra_device__
+	ColumnSpan<T>& operator=(ColumnSpan<T> const& other)
+	{
+		if(this==&other) return *this;
+
+		fData       = other.data();
+		fSize       = other.size();
+		fPaddedSize = other.padded_size();
+
+		return *this;
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	pointer data() const
+	{
+		return fData;
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	size_t size() const
+	{
+		return fSize;
+	}
+
+	/**
+	 * Number of elements that can be read from data(): size() rounded up to
+	 * a multiple of HYDRA_ALIGNMENT bytes for aligned containers.
+	 */
+	__hydra_host__ __hydra_device__ inline
+	size_t padded_size() const
+	{
+		return fPaddedSize;
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	bool empty() const
+	{
+		return fSize==0;
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	reference operator[](size_t i) const
+	{
+		return fData[i];
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	pointer begin() const
+	{
+		return fData;
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	pointer end() const
+	{
+		return fData + fSize;
+	}
+
+private:
+
+	T* fData;
+	size_t fSize;
+	size_t fPaddedSize;
+};
+
+}  // namespace hydra
+
+#endif /* COLUMNSPAN_H_ */
@@ -0,0 +1,884 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * ColumnarFile.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+/**
+ * \file
+ * \ingroup generic
+ */
+
+#ifndef COLUMNARFILE_H_
+#define COLUMNARFILE_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/BackendPolicy.h>
+#include <hydra/detail/Rebind.h>
+#include <hydra/detail/utility/Generic.h>
+#include <hydra/multivector.h>
+#include <hydra/multiarray.h>
+#include <hydra/multivector_view.h>
+#include <hydra/ChunkedSource.h>
+#include <hydra/Decays.h>
+#include <hydra/DenseHistogram.h>
+#include <hydra/SparseHistogram.h>
+#include <hydra/detail/external/thrust/copy.h>
+#include <hydra/detail/external/thrust/tuple.h>
+#include <hydra/detail/external/thrust/iterator/iterator_traits.h>
+#include <hydra/Placeholders.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <array>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Number of elements of the buffer used to copy each column to the file.
+ */
+#ifndef HYDRA_COLUMNAR_BUFFER_SIZE
+#define HYDRA_COLUMNAR_BUFFER_SIZE 1048576
+#endif
+
+namespace hydra {
+
+/**
+ * \ingroup generic
+ *
+ * Type codes of the columns stored in a columnar file.
+ */
+enum ColumnType: uint32_t
+{
+	kColumnUnknown = 0,
+	kColumnInt8    = 1,
+	kColumnUInt8   = 2,
+	kColumnInt16   = 3,
+	kColumnUInt16  = 4,
+	kColumnInt32   = 5,
+	kColumnUInt32  = 6,
+	kColumnInt64   = 7,
+	kColumnUInt64  = 8,
+	kColumnFloat32 = 9,
+	kColumnFloat64 = 10
+};
+
+/**
+ * \ingroup generic
+ *
+ * Access to the columns of a hydra::ColumnarFile: read-only, or copy-on-write, where the
+ * columns can be modified in memory without changing the file.
+ */
+enum ColumnarAccess: uint32_t
+{
+	kColumnarReadOnly    = 0,
+	kColumnarCopyOnWrite = 1
+};
+
+namespace detail {
+
+/*
+ * Layout of a columnar file (version 1), all fields in the byte order of the machine:
+ *
+ * [header, 64 bytes][descriptor of each column, 64 bytes][data of each column, starting at multiples of 64 bytes]
+ */
+struct ColumnarHeader
+{
+	char     fMagic[8];      // "HYDRACOL"
+	uint32_t fVersion;
+	uint32_t fNColumns;
+	uint64_t fDataOffset;    // end of the descriptors
+	char     fPadding[40];
+};
+
+struct ColumnarDescriptor
+{
+	char     fName[32];      // null terminated
+	uint32_t fType;          // ColumnType
+	uint32_t fTypeSize;
+	uint64_t fNRows;
+	uint64_t fOffset;        // from the beginning of the file
+	uint64_t fPadding;
+};
+
+static_assert(sizeof(ColumnarHeader)==64 && sizeof(ColumnarDescriptor)==64,
+		"[Hydra::ColumnarFile] : unexpected size of the header or of the column descriptors.");
+
+constexpr char     columnar_magic[8]  = {'H','Y','D','R','A','C','O','L'};
+constexpr uint32_t columnar_version   = 1;
+constexpr uint64_t columnar_alignment = 64;
+
+inline uint64_t columnar_align(uint64_t offset)
+{
+	return (offset + columnar_alignment - 1)/columnar_alignment*columnar_alignment;
+}
+
+template<typename T>
+struct columnar_type_code: std::integral_constant<uint32_t,
+	std::is_floating_point<T>::value ?
+		( sizeof(T)==4 ? kColumnFloat32 : sizeof(T)==8 ? kColumnFloat64 : kColumnUnknown ) :
+	std::is_integral<T>::value && !std::is_same<T, bool>::value ?
+		( sizeof(T)==1 ? (std::is_signed<T>::value ? kColumnInt8  : kColumnUInt8 ) :
+		  sizeof(T)==2 ? (std::is_signed<T>::value ? kColumnInt16 : kColumnUInt16) :
+		  sizeof(T)==4 ? (std::is_signed<T>::value ? kColumnInt32 : kColumnUInt32) :
+		  sizeof(T)==8 ? (std::is_signed<T>::value ? kColumnInt64 : kColumnUInt64) : kColumnUnknown ) :
+	kColumnUnknown >{};
+
+/*
+ * Collects the columns to be written, from any backend, and writes them in a single pass.
+ * Each column is copied to the file through a host buffer of HYDRA_COLUMNAR_BUFFER_SIZE elements.
+ */
+class ColumnarFileWriter
+{
+	typedef std::function<void(std::FILE*)> writer_type;
+
+public:
+
+	template<typename Iterator>
+	void AddColumn(std::string const& name, Iterator first, Iterator last)
+	{
+		typedef typename std::remove_cv<typename
+				HYDRA_EXTERNAL_NS::thrust::iterator_value<Iterator>::type>::type value_type;
+
+		static_assert(columnar_type_code<value_type>::value != kColumnUnknown,
+				"[Hydra::ColumnarFile] : only arithmetic columns can be stored.");
+
+		if( name.size() >= sizeof(ColumnarDescriptor::fName) )
+			throw std::invalid_argument("[Hydra::ColumnarFile] : column name '" + name + "' longer than 31 characters.");
+
+		ColumnarDescriptor descriptor;
+		std::memset(&descriptor, 0, sizeof(ColumnarDescriptor));
+		std::strncpy(descriptor.fName, name.c_str(), sizeof(descriptor.fName) - 1);
+		descriptor.fType     = columnar_type_code<value_type>::value;
+		descriptor.fTypeSize = sizeof(value_type);
+		descriptor.fNRows    = HYDRA_EXTERNAL_NS::thrust::distance(first, last);
+
+		fDescriptors.push_back(descriptor);
+
+		fWriters.push_back( [first, last](std::FILE* file){
+
+			size_t nrows  = HYDRA_EXTERNAL_NS::thrust::distance(first, last);
+			std::vector<value_type> buffer( std::min<size_t>(nrows, HYDRA_COLUMNAR_BUFFER_SIZE) );
+
+			for(size_t row = 0; row < nrows; row += buffer.size())
+			{
+				size_t n = std::min<size_t>(buffer.size(), nrows - row);
+
+				HYDRA_EXTERNAL_NS::thrust::copy(first + row, first + row + n, buffer.begin());
+
+				if( std::fwrite(buffer.data(), sizeof(value_type), n, file) != n )
+					throw std::runtime_error("[Hydra::ColumnarFile] : failed to write the column data.");
+			}
+		});
+	}
+
+	void Write(std::string const& filename)
+	{
+		ColumnarHeader header;
+		std::memset(&header, 0, sizeof(ColumnarHeader));
+		std::memcpy(header.fMagic, columnar_magic, sizeof(header.fMagic));
+		header.fVersion    = columnar_version;
+		header.fNColumns   = fDescriptors.size();
+		header.fDataOffset = sizeof(ColumnarHeader) + fDescriptors.size()*sizeof(ColumnarDescriptor);
+
+		uint64_t offset = header.fDataOffset;
+
+		for(auto& descriptor: fDescriptors)
+		{
+			descriptor.fOffset = columnar_align(offset);
+			offset = descriptor.fOffset + descriptor.fNRows*descriptor.fTypeSize;
+		}
+
+		std::FILE* file = std::fopen(filename.c_str(), "wb");
+
+		if( file == nullptr )
+			throw std::runtime_error("[Hydra::ColumnarFile] : can not open '" + filename + "' for writing.");
+
+		try {
+
+			Put(file, &header, sizeof(ColumnarHeader));
+
+			if( !fDescriptors.empty() )
+				Put(file, fDescriptors.data(), fDescriptors.size()*sizeof(ColumnarDescriptor));
+
+			offset = header.fDataOffset;
+
+			for(size_t i=0; i<fDescriptors.size(); i++)
+			{
+				Pad(file, fDescriptors[i].fOffset - offset);
+
+				fWriters[i](file);
+
+				offset = fDescriptors[i].fOffset + fDescriptors[i].fNRows*fDescriptors[i].fTypeSize;
+			}
+
+			Pad(file, columnar_align(offset) - offset);
+		}
+		catch(...){
+
+			std::fclose(file);
+			throw;
+		}
+
+		if( std::fclose(file) != 0 )
+			throw std::runtime_error("[Hydra::ColumnarFile] : failed to write '" + filename + "'.");
+	}
+
+private:
+
+	static void Put(std::FILE* file, void const* data, size_t bytes)
+	{
+		if( std::fwrite(data, 1, bytes, file) != bytes )
+			throw std::runtime_error("[Hydra::ColumnarFile] : failed to write the header.");
+	}
+
+	static void Pad(std::FILE* file, size_t bytes)
+	{
+		static const char zeros[columnar_alignment] = {};
+
+		Put(file, zeros, bytes);
+	}
+
+	std::vector<ColumnarDescriptor> fDescriptors;
+	std::vector<writer_type>        fWriters;
+};
+
+template<typename Container, size_t ...I>
+inline void add_columns(ColumnarFileWriter& writer, Container const& container,
+		std::vector<std::string> const& names, index_sequence<I...>)
+{
+	using swallow = int[];
+
+	(void) swallow{ 0, ( writer.AddColumn(
+			I < names.size() ? names[I] : std::to_string(I),
+			container.begin(placeholders::placeholder<I>{}),
+			container.end(placeholders::placeholder<I>{}) ), 0)... };
+}
+
+/*
+ * Prefetch the pages of [data, data + n), mapped from a file: the kernel is asked to read them ahead
+ * and the pages are then touched, so that the calling thread waits for the reading.
+ */
+template<typename T>
+inline void columnar_prefetch(T const* data, size_t n)
+{
+	if( n == 0 ) return;
+
+	static const uintptr_t page = ::sysconf(_SC_PAGESIZE);
+
+	uintptr_t first = reinterpret_cast<uintptr_t>(data)/page*page;
+	uintptr_t last  = reinterpret_cast<uintptr_t>(data + n);
+
+	::madvise(reinterpret_cast<void*>(first), last - first, MADV_WILLNEED);
+
+	char sum = 0;
+
+	for(uintptr_t address = first; address < last; address += page)
+		sum += *reinterpret_cast<volatile char const*>(address);
+
+	(void) sum;
+}
+
+/*
+ * Chunks of mapped columns: views of the mapped rows on the backends accessing host memory,
+ * otherwise copies in the buffer.
+ */
+template<typename View, typename Chunk, typename ...T, size_t ...I>
+inline View columnar_load(HYDRA_EXTERNAL_NS::thrust::tuple<T*...> const& columns, size_t first, size_t n,
+		Chunk&, index_sequence<I...>, std::true_type)
+{
+	using swallow = int[];
+
+	(void) swallow{ 0, (columnar_prefetch(HYDRA_EXTERNAL_NS::thrust::get<I>(columns) + first, n), 0)... };
+
+	return View(n, (HYDRA_EXTERNAL_NS::thrust::get<I>(columns) + first)...);
+}
+
+template<typename View, typename Chunk, typename ...T, size_t ...I>
+inline View columnar_load(HYDRA_EXTERNAL_NS::thrust::tuple<T*...> const& columns, size_t first, size_t n,
+		Chunk& chunk, index_sequence<I...>, std::false_type)
+{
+	using swallow = int[];
+
+	chunk.resize(n);
+
+	(void) swallow{ 0, (HYDRA_EXTERNAL_NS::thrust::copy(HYDRA_EXTERNAL_NS::thrust::get<I>(columns) + first,
+			HYDRA_EXTERNAL_NS::thrust::get<I>(columns) + first + n,
+			chunk.begin(placeholders::placeholder<I>{})), 0)... };
+
+	return View(chunk.begin(), chunk.end());
+}
+
+}  // namespace detail
+
+/**
+ * \ingroup generic
+ *
+ * Write the columns of a hydra::multivector to a columnar file, from any backend.
+ *
+ * The file starts with a header giving the number of columns, followed by one descriptor per
+ * column (name, type, number of rows and offset) and by the data of each column, contiguous and
+ * aligned to 64 bytes. The file can be mapped to memory and read without copies with hydra::ColumnarFile.
+ *
+ * @param filename name of the file, which is overwritten.
+ * @param container the data.
+ * @param names names of the columns (up to 31 characters), by default "0", "1", ...
+ */
+template<typename ...T, hydra::detail::Backend BACKEND>
+void write_columnar(std::string const& filename,
+		multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> const& container,
+		std::vector<std::string> const& names = std::vector<std::string>{})
+{
+	detail::ColumnarFileWriter writer;
+
+	detail::add_columns(writer, container, names, detail::make_index_sequence<sizeof...(T)>{});
+
+	writer.Write(filename);
+}
+
+/**
+ * \ingroup generic
+ *
+ * Write the columns of a hydra::multiarray to a columnar file, from any backend.
+ *
+ * @param filename name of the file, which is overwritten.
+ * @param container the data.
+ * @param names names of the columns (up to 31 characters), by default "0", "1", ...
+ */
+template<typename T, size_t N, hydra::detail::Backend BACKEND>
+void write_columnar(std::string const& filename,
+		multiarray<T, N, hydra::detail::BackendPolicy<BACKEND>> const& container,
+		std::vector<std::string> const& names = std::vector<std::string>{})
+{
+	detail::ColumnarFileWriter writer;
+
+	for(size_t i=0; i<N; i++)
+		writer.AddColumn( i < names.size() ? names[i] : std::to_string(i),
+				container.begin(i), container.end(i) );
+
+	writer.Write(filename);
+}
+
+/**
+ * \ingroup generic
+ *
+ * Write a sample of decays to a columnar file, from any backend. The weights are
+ * stored in the column "weights", followed by the components of the four-momentum of each particle i, in
+ * the columns "pi_0", ..., "pi_3" (i.e. E, px, py, pz). The file can be read with
+ * hydra::ColumnarFile::GetView<double, ...>(policy) to get the 1 + 4N columns in this order.
+ */
+template<size_t N, hydra::detail::Backend BACKEND>
+void write_columnar(std::string const& filename,
+		Decays<N, hydra::detail::BackendPolicy<BACKEND>> const& events)
+{
+	detail::ColumnarFileWriter writer;
+
+	writer.AddColumn("weights", events.GetWeights().begin(), events.GetWeights().end());
+
+	for(size_t i=0; i<N; i++)
+		detail::add_columns(writer, events.GetListOfParticles(i),
+				{ "p" + std::to_string(i) + "_0", "p" + std::to_string(i) + "_1",
+				  "p" + std::to_string(i) + "_2", "p" + std::to_string(i) + "_3" },
+				detail::make_index_sequence<4>{});
+
+	writer.Write(filename);
+}
+
+/**
+ * \ingroup histogram
+ *
+ * Write a multidimensional dense histogram to a columnar file, from any backend. The bin contents,
+ * including the underflow and overflow bins, are stored in the column "contents" and the binning in
+ * the columns "grid", "lower" and "upper", with one row per dimension.
+ */
+template<typename T, size_t N, hydra::detail::Backend BACKEND>
+void write_columnar(std::string const& filename,
+		DenseHistogram<T, N, hydra::detail::BackendPolicy<BACKEND>, detail::multidimensional> const& histogram)
+{
+	std::vector<uint64_t> grid(N);
+	std::vector<T> lower(N), upper(N);
+
+	for(size_t i=0; i<N; i++){
+		grid[i]  = histogram.GetGrid(i);
+		lower[i] = histogram.GetLowerLimits(i);
+		upper[i] = histogram.GetUpperLimits(i);
+	}
+
+	detail::ColumnarFileWriter writer;
+
+	writer.AddColumn("contents", histogram.GetContents().begin(), histogram.GetContents().end());
+	writer.AddColumn("grid",  grid.begin(),  grid.end());
+	writer.AddColumn("lower", lower.begin(), lower.end());
+	writer.AddColumn("upper", upper.begin(), upper.end());
+
+	writer.Write(filename);
+}
+
+/**
+ * \ingroup histogram
+ *
+ * Write a one-dimensional dense histogram to a columnar file, from any backend, with the
+ * same columns as the multidimensional histograms.
+ */
+template<typename T, hydra::detail::Backend BACKEND>
+void write_columnar(std::string const& filename,
+		DenseHistogram<T, 1, hydra::detail::BackendPolicy<BACKEND>, detail::unidimensional> const& histogram)
+{
+	uint64_t grid = histogram.GetGrid();
+	T lower = histogram.GetLowerLimits();
+	T upper = histogram.GetUpperLimits();
+
+	detail::ColumnarFileWriter writer;
+
+	writer.AddColumn("contents", histogram.GetContents().begin(), histogram.GetContents().end());
+	writer.AddColumn("grid",  &grid,  &grid + 1);
+	writer.AddColumn("lower", &lower, &lower + 1);
+	writer.AddColumn("upper", &upper, &upper + 1);
+
+	writer.Write(filename);
+}
+
+/**
+ * \ingroup histogram
+ *
+ * Write a multidimensional sparse histogram to a columnar file, from any backend. The global
+ * indexes of the filled bins are stored in the column "bins" and their contents in the column
+ * "contents", followed by the binning in the columns "grid", "lower" and "upper".
+ */
+template<typename T, size_t N, hydra::detail::Backend BACKEND>
+void write_columnar(std::string const& filename,
+		SparseHistogram<T, N, hydra::detail::BackendPolicy<BACKEND>, detail::multidimensional> const& histogram)
+{
+	std::vector<uint64_t> grid(N);
+	std::vector<T> lower(N), upper(N);
+
+	for(size_t i=0; i<N; i++){
+		grid[i]  = histogram.GetGrid(i);
+		lower[i] = histogram.GetLowerLimits(i);
+		upper[i] = histogram.GetUpperLimits(i);
+	}
+
+	detail::ColumnarFileWriter writer;
+
+	writer.AddColumn("bins",     histogram.GetBins().begin(),     histogram.GetBins().end());
+	writer.AddColumn("contents", histogram.GetContents().begin(), histogram.GetContents().end());
+	writer.AddColumn("grid",  grid.begin(),  grid.end());
+	writer.AddColumn("lower", lower.begin(), lower.end());
+	writer.AddColumn("upper", upper.begin(), upper.end());
+
+	writer.Write(filename);
+}
+
+/**
+ * \ingroup generic
+ *
+ * \brief Columnar file written by hydra::write_columnar, mapped to memory.
+ *
+ * The file is mapped with `mmap` when opened and its columns are read in place: hydra::ColumnarFile::GetView
+ * returns a hydra::multivector_view over the mapped columns, for the backends accessing host memory
+ * (CPP, OMP, TBB and the device backend unless the device system is CUDA), so that a dataset can be
+ * passed to the algorithms of Hydra without reading it into a container. The pages are loaded on demand
+ * by the kernel and shared with the page cache. The views must not outlive the hydra::ColumnarFile.
+ *
+ * By default the file is mapped read-only and the views and the pointers to the columns are const.
+ * Mutable access is available only for files opened with hydra::kColumnarCopyOnWrite, through
+ * hydra::ColumnarFile::GetMutableColumn and hydra::ColumnarFile::GetMutableView: the mapping is then
+ * private, and writes modify only this mapping, not the file.
+ */
+class ColumnarFile
+{
+
+public:
+
+	ColumnarFile() = delete;
+
+	/**
+	 * Map the file \p filename, read-only unless \p access is hydra::kColumnarCopyOnWrite.
+	 * Throws std::runtime_error if it can not be mapped or is not a valid columnar file.
+	 */
+	explicit ColumnarFile(std::string const& filename, ColumnarAccess access=kColumnarReadOnly):
+		fData(nullptr),
+		fSize(0),
+		fAccess(access),
+		fHeader(nullptr),
+		fDescriptors(nullptr)
+	{
+		int fd = ::open(filename.c_str(), O_RDONLY);
+
+		if( fd < 0 )
+			throw std::runtime_error("[Hydra::ColumnarFile] : can not open '" + filename + "'.");
+
+		struct stat status;
+
+		if( ::fstat(fd, &status) != 0 ){
+			::close(fd);
+			throw std::runtime_error("[Hydra::ColumnarFile] : can not stat '" + filename + "'.");
+		}
+
+		fSize = status.st_size;
+
+		if( fSize < sizeof(detail::ColumnarHeader) ){
+			::close(fd);
+			throw std::runtime_error("[Hydra::ColumnarFile] : '" + filename + "' is not a columnar file.");
+		}
+
+		void* data = fAccess == kColumnarCopyOnWrite ?
+				::mmap(nullptr, fSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0) :
+				::mmap(nullptr, fSize, PROT_READ, MAP_SHARED, fd, 0);
+
+		::close(fd);
+
+		if( data == MAP_FAILED )
+			throw std::runtime_error("[Hydra::ColumnarFile] : can not map '" + filename + "'.");
+
+		fData = static_cast<char*>(data);
+
+		try {
+
+			Validate(filename);
+		}
+		catch(...){
+
+			::munmap(fData, fSize);
+			throw;
+		}
+	}
+
+	ColumnarFile(ColumnarFile const&) = delete;
+
+	ColumnarFile& operator=(ColumnarFile const&) = delete;
+
+	ColumnarFile(ColumnarFile&& other):
+		fData(other.fData),
+		fSize(other.fSize),
+		fAccess(other.fAccess),
+		fHeader(other.fHeader),
+		fDescriptors(other.fDescriptors)
+	{
+		other.fData = nullptr;
+		other.fSize = 0;
+		other.fHeader = nullptr;
+		other.fDescriptors = nullptr;
+	}
+
+	ColumnarFile& operator=(ColumnarFile&& other)
+	{
+		if(this == &other) return *this;
+
+		if( fData != nullptr )
+			::munmap(fData, fSize);
+
+		fData        = other.fData;
+		fSize        = other.fSize;
+		fAccess      = other.fAccess;
+		fHeader      = other.fHeader;
+		fDescriptors = other.fDescriptors;
+
+		other.fData = nullptr;
+		other.fSize = 0;
+		other.fHeader = nullptr;
+		other.fDescriptors = nullptr;
+
+		return *this;
+	}
+
+	~ColumnarFile()
+	{
+		if( fData != nullptr )
+			::munmap(fData, fSize);
+	}
+
+	inline ColumnarAccess GetAccess() const
+	{
+		return fAccess;
+	}
+
+	inline size_t GetNColumns() const
+	{
+		return fHeader->fNColumns;
+	}
+
+	inline size_t GetNRows(size_t i) const
+	{
+		return Descriptor(i).fNRows;
+	}
+
+	inline std::string GetColumnName(size_t i) const
+	{
+		return std::string(Descriptor(i).fName);
+	}
+
+	inline ColumnType GetColumnType(size_t i) const
+	{
+		return static_cast<ColumnType>(Descriptor(i).fType);
+	}
+
+	/**
+	 * Index of the column \p name. Throws std::out_of_range if there is no such column.
+	 */
+	inline size_t GetColumnIndex(std::string const& name) const
+	{
+		for(size_t i=0; i<GetNColumns(); i++)
+			if( name == fDescriptors[i].fName ) return i;
+
+		throw std::out_of_range("[Hydra::ColumnarFile] : no column '" + name + "'.");
+	}
+
+	/**
+	 * Pointer to the first element of the column \p i, mapped to memory.
+	 * Throws std::invalid_argument if the column does not store elements of type T.
+	 */
+	template<typename T>
+	inline T const* GetColumn(size_t i) const
+	{
+		detail::ColumnarDescriptor const& descriptor = Descriptor(i);
+
+		if( descriptor.fType != detail::columnar_type_code<T>::value || descriptor.fTypeSize != sizeof(T) )
+			throw std::invalid_argument("[Hydra::ColumnarFile] : column '" + GetColumnName(i) +
+					"' does not store elements of the requested type.");
+
+		return reinterpret_cast<T const*>(fData + descriptor.fOffset);
+	}
+
+	/**
+	 * Mutable pointer to the first element of the column \p i. Writes modify only the mapping, not the file.
+	 * Throws std::logic_error if the file was not opened with hydra::kColumnarCopyOnWrite.
+	 */
+	template<typename T>
+	inline T* GetMutableColumn(size_t i)
+	{
+		CheckMutable();
+
+		return const_cast<T*>(GetColumn<T>(i));
+	}
+
+	/**
+	 * Read-only view of the sizeof...(T) consecutive columns starting at \p first_column, with elements of types T...
+	 * Throws std::invalid_argument if the types or the number of rows of the columns do not match.
+	 */
+	template<typename ...T, hydra::detail::Backend BACKEND>
+	multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T const...>, hydra::detail::BackendPolicy<BACKEND>>
+	GetView(hydra::detail::BackendPolicy<BACKEND> const&, size_t first_column=0) const
+	{
+		return GetView<T const...>(Consecutive<sizeof...(T)>(first_column),
+				detail::make_index_sequence<sizeof...(T)>{}, hydra::detail::BackendPolicy<BACKEND>{});
+	}
+
+	/**
+	 * Read-only view of the columns \p names, with elements of types T...
+	 * Throws std::invalid_argument if the types or the number of rows of the columns do not match.
+	 */
+	template<typename ...T, hydra::detail::Backend BACKEND>
+	multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T const...>, hydra::detail::BackendPolicy<BACKEND>>
+	GetView(hydra::detail::BackendPolicy<BACKEND> const&, std::array<std::string, sizeof...(T)> const& names) const
+	{
+		return GetView<T const...>(Named<sizeof...(T)>(names),
+				detail::make_index_sequence<sizeof...(T)>{}, hydra::detail::BackendPolicy<BACKEND>{});
+	}
+
+	/**
+	 * Mutable view of the sizeof...(T) consecutive columns starting at \p first_column, with elements of types T...
+	 * Writes modify only the mapping, not the file.
+	 * Throws std::logic_error if the file was not opened with hydra::kColumnarCopyOnWrite.
+	 */
+	template<typename ...T, hydra::detail::Backend BACKEND>
+	multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>>
+	GetMutableView(hydra::detail::BackendPolicy<BACKEND> const&, size_t first_column=0)
+	{
+		CheckMutable();
+
+		return GetView<T...>(Consecutive<sizeof...(T)>(first_column),
+				detail::make_index_sequence<sizeof...(T)>{}, hydra::detail::BackendPolicy<BACKEND>{});
+	}
+
+	/**
+	 * Mutable view of the columns \p names, with elements of types T...
+	 * Throws std::logic_error if the file was not opened with hydra::kColumnarCopyOnWrite.
+	 */
+	template<typename ...T, hydra::detail::Backend BACKEND>
+	multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>>
+	GetMutableView(hydra::detail::BackendPolicy<BACKEND> const&, std::array<std::string, sizeof...(T)> const& names)
+	{
+		CheckMutable();
+
+		return GetView<T...>(Named<sizeof...(T)>(names),
+				detail::make_index_sequence<sizeof...(T)>{}, hydra::detail::BackendPolicy<BACKEND>{});
+	}
+
+	/**
+	 * hydra::ChunkedSource reading the sizeof...(T) consecutive columns starting at \p first_column, with elements
+	 * of types T..., in chunks of \p chunk_size rows. On the backends accessing host memory, the chunks are views of the
+	 * mapped rows, whose pages are read on the background thread of the source, while the previous chunk is processed.
+	 * Otherwise the rows are copied to the memory of the backend. The source must not outlive the hydra::ColumnarFile.
+	 */
+	template<typename ...T, hydra::detail::Backend BACKEND>
+	ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>>
+	GetChunkedSource(hydra::detail::BackendPolicy<BACKEND> const&, size_t chunk_size, size_t first_column=0) const
+	{
+		return GetChunkedSource<T...>(Consecutive<sizeof...(T)>(first_column), chunk_size,
+				detail::make_index_sequence<sizeof...(T)>{}, hydra::detail::BackendPolicy<BACKEND>{});
+	}
+
+	/**
+	 * hydra::ChunkedSource reading the columns \p names, with elements of types T..., in chunks of \p chunk_size rows.
+	 */
+	template<typename ...T, hydra::detail::Backend BACKEND>
+	ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>>
+	GetChunkedSource(hydra::detail::BackendPolicy<BACKEND> const&, size_t chunk_size,
+			std::array<std::string, sizeof...(T)> const& names) const
+	{
+		return GetChunkedSource<T...>(Named<sizeof...(T)>(names), chunk_size,
+				detail::make_index_sequence<sizeof...(T)>{}, hydra::detail::BackendPolicy<BACKEND>{});
+	}
+
+private:
+
+	template<typename ...T, size_t ...I, hydra::detail::Backend BACKEND>
+	multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>>
+	GetView(std::array<size_t, sizeof...(T)> const& columns, detail::index_sequence<I...>,
+			hydra::detail::BackendPolicy<BACKEND> const&) const
+	{
+		static_assert(detail::is_host_backend<hydra::detail::BackendPolicy<BACKEND>>::value,
+				"[Hydra::ColumnarFile] : the columns are mapped to host memory, views are not available for this backend.");
+
+		//the mutable views are reached only through CheckMutable()
+		return multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>>(
+				GetNRows(columns), const_cast<T*>(GetColumn<typename std::remove_const<T>::type>(columns[I]))...);
+	}
+
+	template<typename ...T, size_t ...I, hydra::detail::Backend BACKEND>
+	ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>>
+	GetChunkedSource(std::array<size_t, sizeof...(T)> const& columns, size_t chunk_size, detail::index_sequence<I...>,
+			hydra::detail::BackendPolicy<BACKEND> const&) const
+	{
+		typedef ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> source_type;
+		typedef typename source_type::view_type  view_type;
+		typedef typename source_type::chunk_type chunk_type;
+		typedef typename detail::is_host_backend<hydra::detail::BackendPolicy<BACKEND>>::type is_host;
+
+		HYDRA_EXTERNAL_NS::thrust::tuple<T const*...> pointers(GetColumn<T>(columns[I])...);
+
+		return source_type(GetNRows(columns), chunk_size, [pointers](size_t first, size_t n, chunk_type& chunk){
+
+			return detail::columnar_load<view_type>(pointers, first, n, chunk,
+					detail::make_index_sequence<sizeof...(T)>{}, is_host{});
+		});
+	}
+
+	template<size_t N>
+	inline size_t GetNRows(std::array<size_t, N> const& columns) const
+	{
+		size_t nrows = N ? GetNRows(columns[0]) : 0;
+
+		for(size_t i=0; i<N; i++)
+			if( GetNRows(columns[i]) != nrows )
+				throw std::invalid_argument("[Hydra::ColumnarFile] : the columns of a view must have the same number of rows.");
+
+		return nrows;
+	}
+
+	template<size_t N>
+	inline std::array<size_t, N> Consecutive(size_t first_column) const
+	{
+		std::array<size_t, N> columns;
+
+		for(size_t i=0; i<N; i++)
+			columns[i] = first_column + i;
+
+		return columns;
+	}
+
+	template<size_t N>
+	inline std::array<size_t, N> Named(std::array<std::string, N> const& names) const
+	{
+		std::array<size_t, N> columns;
+
+		for(size_t i=0; i<N; i++)
+			columns[i] = GetColumnIndex(names[i]);
+
+		return columns;
+	}
+
+	inline void CheckMutable() const
+	{
+		if( fAccess != kColumnarCopyOnWrite )
+			throw std::logic_error("[Hydra::ColumnarFile] : the file is mapped read-only, "
+					"open it with hydra::kColumnarCopyOnWrite to modify the columns.");
+	}
+
+	inline detail::ColumnarDescriptor const& Descriptor(size_t i) const
+	{
+		if( i >= GetNColumns() )
+			throw std::out_of_range("[Hydra::ColumnarFile] : column index out of range.");
+
+		return fDescriptors[i];
+	}
+
+	void Validate(std::string const& filename)
+	{
+		fHeader = reinterpret_cast<detail::ColumnarHeader const*>(fData);
+
+		if( std::memcmp(fHeader->fMagic, detail::columnar_magic, sizeof(fHeader->fMagic)) != 0 )
+			throw std::runtime_error("[Hydra::ColumnarFile] : '" + filename + "' is not a columnar file.");
+
+		if( fHeader->fVersion != detail::columnar_version )
+			throw std::runtime_error("[Hydra::ColumnarFile] : unsupported version of '" + filename + "'.");
+
+		if( fHeader->fDataOffset != sizeof(detail::ColumnarHeader) + uint64_t(fHeader->fNColumns)*sizeof(detail::ColumnarDescriptor)
+				|| fHeader->fDataOffset > fSize )
+			throw std::runtime_error("[Hydra::ColumnarFile] : corrupted header in '" + filename + "'.");
+
+		fDescriptors = reinterpret_cast<detail::ColumnarDescriptor const*>(fData + sizeof(detail::ColumnarHeader));
+
+		for(size_t i=0; i<fHeader->fNColumns; i++)
+		{
+			detail::ColumnarDescriptor const& descriptor = fDescriptors[i];
+
+			if( descriptor.fOffset % detail::columnar_alignment != 0 || descriptor.fOffset > fSize ||
+				descriptor.fTypeSize == 0 || descriptor.fNRows > (fSize - descriptor.fOffset)/descriptor.fTypeSize )
+				throw std::runtime_error("[Hydra::ColumnarFile] : corrupted column descriptor in '" + filename + "'.");
+		}
+	}
+
+	char*  fData;
+	size_t fSize;
+	ColumnarAccess fAccess;
+	detail::ColumnarHeader     const* fHeader;
+	detail::ColumnarDescriptor const* fDescriptors;
+};
+
+}  // namespace hydra
+
+#endif /* COLUMNARFILE_H_ */
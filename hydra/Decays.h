@@ -40,6 +40,7 @@
 #include <hydra/Vector3R.h>
 #include <hydra/Vector4R.h>
 #include <hydra/multiarray.h>
+#include <hydra/detail/Rebind.h>
 #include <hydra/detail/utility/Utility_Tuple.h>
 #include <hydra/Tuple.h>
 #include <hydra/GenericRange.h>
@@ -308,6 +309,19 @@ public:
 		HYDRA_EXTERNAL_NS::thrust::copy(other.begin(),  other.end(), this->begin() );
 	}
 
+	/**
+	 * Move constructor for containers allocated in different backends. If the allocators
+	 * of the two backends share the memory resource (hydra::detail::is_rebindable), as for the CPP,
+	 * OMP and TBB backends, the storage of \p other is handed over without copying.
+	 * Otherwise the decays are copied.
+	 * @param other
+	 */
+	template< hydra::detail::Backend BACKEND2>
+	Decays(Decays<N,detail::BackendPolicy<BACKEND2>>&& other )
+	{
+		__move_from(other, detail::is_rebindable<detail::BackendPolicy<BACKEND2>, system_t>{});
+	}
+
 	/**
 	 * Assignment operator.
 	 * @param other
@@ -366,6 +380,21 @@ public:
 		return *this;
 	}
 
+	/**
+	 * Move assignment operator for containers allocated in different backends,
+	 * handing over the storage of \p other without copying when possible.
+	 * @param other
+	 * @return
+	 */
+	template< hydra::detail::Backend BACKEND2>
+	Decays<N,detail::BackendPolicy<BACKEND> >&
+	operator=(Decays<N,detail::BackendPolicy<BACKEND2> >&& other )
+	{
+		__move_from(other, detail::is_rebindable<detail::BackendPolicy<BACKEND2>, system_t>{});
+
+		return *this;
+	}
+
 	/**
 	 * Add a decay to the container, increasing its size by one element.
 	 * @param w is the weight of the decay being added.
@@ -678,6 +707,12 @@ public:
 
 	void reserve(size_t size) { __reserve(size); }
 
+	/**
+	 * Resize to exactly size decays, moving the storage of the particles and weights to new blocks,
+	 * so that their pages are mapped by the threads processing them on NUMA machines (see multivector::numa_resize).
+	 */
+	void numa_resize(size_t size) { __numa_resize(size); }
+
 	size_t size() const{return this->fWeights.size(); }
 
 	size_t capacity() const{return this->fWeights.capacity();}
@@ -788,12 +823,34 @@ public:
 
 private:
 
+	template<size_t N2, typename BACKEND2>
+	friend class Decays;
+
 	const weights_type& __copy_weights() const { return fWeights; }
 	const  decays_type& __copy_decays() const { return fDecays; }
 
 	weights_type __move_weights() { return std::move(fWeights); }
 	decays_type  __move_decays() { return std::move(fDecays); }
 
+	//_______________________________________________
+	//move from other backends
+
+	template<typename Other>
+	void __move_from(Other& other, std::true_type)
+	{
+		for( size_t i=0; i<N; i++)
+			fDecays[i] = std::move(other.fDecays[i]);
+
+		detail::adopt_storage(fWeights, other.fWeights);
+	}
+
+	template<typename Other>
+	void __move_from(Other& other, std::false_type)
+	{
+		this->resize(HYDRA_EXTERNAL_NS::thrust::distance(other.begin(),  other.end()));
+		HYDRA_EXTERNAL_NS::thrust::copy(other.begin(),  other.end(), this->begin() );
+	}
+
 	//_______________________________________________
 	//pop_back
 
@@ -879,6 +936,23 @@ private:
 
 	void __reserve( size_t n) { fWeights.reserve(n); __reserve_helper(n); }
 
+	//_______________________________________________
+	//numa_resize
+
+	template<size_t I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I == N), void >::type
+	__numa_resize_helper( size_t ){ }
+
+	template<size_t I = 0>
+	inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I < N), void >::type
+	__numa_resize_helper( size_t n)
+	{
+		std::get<I>(fDecays).numa_resize(n);
+		__numa_resize_helper<I+1>(n);
+	}
+
+	void __numa_resize( size_t n) { detail::first_touch_resize(fWeights, n); __numa_resize_helper(n); }
+
 	//_______________________________________________
 	//insert
 	template<size_t I>
@@ -889,7 +963,7 @@ private:
 	inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I < N), void >::type
 	__insert_helper(size_type i, size_type n, value_type const& x )
 	{
-		std::get<I>(fDecays).insert( HYDRA_EXTERNAL_NS::thrust::get<I>(fDecays).begin() + i, n,
+		std::get<I>(fDecays).insert( std::get<I>(fDecays).begin() + i, n,
 				HYDRA_EXTERNAL_NS::thrust::get<I+1>(x)  ); ;
 
 		__insert_helper<I+1>(i, n, x);
@@ -939,7 +1013,7 @@ private:
 	inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I < N), void >::type
 	__insert_helper(size_type pos, value_type const& x )
 	{
-		std::get<I>(fDecays).insert( HYDRA_EXTERNAL_NS::thrust::get<I>(fDecays).begin() + pos,
+		std::get<I>(fDecays).insert( std::get<I>(fDecays).begin() + pos,
 				HYDRA_EXTERNAL_NS::thrust::get<I+1>(x)  ); ;
 
 		__insert_helper<I+1>(pos, x);
@@ -961,7 +1035,7 @@ private:
 	inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I < N), void >::type
 	__erase_helper(size_type pos )
 	{
-		std::get<I>(fDecays).erase( HYDRA_EXTERNAL_NS::thrust::get<I>(fDecays).begin() + pos);
+		std::get<I>(fDecays).erase( std::get<I>(fDecays).begin() + pos);
 
 		__erase_helper<I+1>(pos);
 	}
@@ -1044,7 +1118,7 @@ private:
 	inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I < N), void >::type
 	__push_back_helper(value_type const& p)
 	{
-		fDecays[I].push_back( HYDRA_EXTERNAL_NS::thrust::get<I>(p)  );
+		fDecays[I].push_back( HYDRA_EXTERNAL_NS::thrust::get<I+1>(p)  );
 		__push_back_helper<I+1>(p);
 	}
 
@@ -1227,6 +1301,54 @@ make_decays( hydra::detail::BackendPolicy<BACKEND>, size_t entries ){
 	return Decays<N, hydra::detail::BackendPolicy<BACKEND> >(entries);
 }
 
+/**
+ * Move the storage of a Decays container to a Decays container of the backend BACKEND2 without
+ * copying, e.g. `hydra::rebind<hydra::omp::sys_t>(std::move(events))`. The allocators of the two
+ * backends must share the memory resource (hydra::detail::is_rebindable). \p other is left empty.
+ */
+template<typename BACKEND2, size_t N, hydra::detail::Backend BACKEND>
+inline Decays<N, BACKEND2>
+rebind( Decays<N, hydra::detail::BackendPolicy<BACKEND> >&& other ){
+
+	static_assert( detail::is_rebindable<detail::BackendPolicy<BACKEND>, BACKEND2>::value,
+			"[Hydra::rebind] : the containers of the two backends do not share the memory resource.");
+
+	return Decays<N, BACKEND2>(std::move(other));
+}
+
+/**
+ * Non-owning range over a Decays container, with the iterators of a Decays container
+ * of the backend BACKEND2. Both backends must allocate in host memory (hydra::detail::is_host_backend).
+ * The range is invalidated by the operations invalidating the iterators of \p other.
+ */
+template<typename BACKEND2, size_t N, hydra::detail::Backend BACKEND>
+inline GenericRange<typename Decays<N, BACKEND2>::iterator>
+rebind_view( Decays<N, hydra::detail::BackendPolicy<BACKEND> >& other ){
+
+	typedef typename Decays<N, BACKEND2>::iterator iterator;
+
+	static_assert( detail::is_host_backend<detail::BackendPolicy<BACKEND>>::value &&
+			detail::is_host_backend<BACKEND2>::value,
+			"[Hydra::rebind_view] : the containers of both backends must be allocated in host memory.");
+
+	return make_range( detail::rebind_iterator<iterator>(other.begin()),
+			detail::rebind_iterator<iterator>(other.end()) );
+}
+
+template<typename BACKEND2, size_t N, hydra::detail::Backend BACKEND>
+inline GenericRange<typename Decays<N, BACKEND2>::const_iterator>
+rebind_view( Decays<N, hydra::detail::BackendPolicy<BACKEND> > const& other ){
+
+	typedef typename Decays<N, BACKEND2>::const_iterator iterator;
+
+	static_assert( detail::is_host_backend<detail::BackendPolicy<BACKEND>>::value &&
+			detail::is_host_backend<BACKEND2>::value,
+			"[Hydra::rebind_view] : the containers of both backends must be allocated in host memory.");
+
+	return make_range( detail::rebind_iterator<iterator>(other.begin()),
+			detail::rebind_iterator<iterator>(other.end()) );
+}
+
 template<size_t N1, hydra::detail::Backend BACKEND1,
          size_t N2, hydra::detail::Backend BACKEND2>
 bool operator==(const Decays<N1, hydra::detail::BackendPolicy<BACKEND1> >& lhs,
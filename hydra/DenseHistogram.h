@@ -47,6 +47,9 @@
 
 namespace hydra {
 
+template<typename T, typename BACKEND>
+class ChunkedSource;
+
 /**
  * \ingroup histogram
  */
@@ -436,6 +439,12 @@ public:
 	template<hydra::detail::Backend BACKEND2, typename Iterator1, typename Iterator2>
 	 inline 	void Fill(detail::BackendPolicy<BACKEND2> const& exec_policy, Iterator1 begin, Iterator1 end, Iterator2 wbegin);
 
+	/**
+	 * Fill the histogram with a dataset read in chunks from a hydra::ChunkedSource.
+	 */
+	template<typename ...T2, hydra::detail::Backend BACKEND2>
+	 inline void Fill(ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T2...>, detail::BackendPolicy<BACKEND2>> const& source);
+
 
 
 private:
@@ -771,6 +780,12 @@ public:
 	template<hydra::detail::Backend BACKEND2, typename Iterator1, typename Iterator2>
 	void Fill(detail::BackendPolicy<BACKEND2> const& exec_policy,Iterator1 begin, Iterator1 end, Iterator2 wbegin);
 
+	/**
+	 * Fill the histogram with a dataset read in chunks from a hydra::ChunkedSource.
+	 */
+	template<typename ...T2, hydra::detail::Backend BACKEND2>
+	void Fill(ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T2...>, detail::BackendPolicy<BACKEND2>> const& source);
+
 
 
 private:
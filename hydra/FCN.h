@@ -54,6 +54,9 @@
 
 namespace hydra {
 
+template<typename T, typename BACKEND>
+class ChunkedSource;
+
 namespace detail {
 
 template<typename ArgType>
@@ -366,6 +369,7 @@ public:
 
 	FCN(FCN<Estimator<PDF,Iterator>> const& other):
 	ROOT::Minuit2::FCNBase(other),
+	fDataSize(other.GetDataSize()),
 	fPDF(other.GetPDF()),
 	fBegin(other.GetBegin()),
 	fEnd(other.GetEnd()),
@@ -385,6 +389,7 @@ public:
 		fPDF   = other.GetPDF();
 		fBegin = other.GetBegin();
 		fEnd   = other.GetEnd();
+		fDataSize = other.GetDataSize();
 		fErrorDef = other.GetErrorDef();
 		fUserParameters = other.GetParameters();
 		fFCNCache = other.GetFcnCache();
@@ -550,6 +555,185 @@ private:
 
 };
 
+/**
+ * \ingroup fit
+ * FCN base class of the estimators on datasets read in chunks from a hydra::ChunkedSource,
+ * which is held by the FCN instead of a pair of iterators.
+ * \tparam Estimator estimator base class
+ * \tparam T columns of the dataset
+ * \tparam BACKEND backend of the chunks
+ */
+template< template<typename ...> class Estimator, typename PDF, typename T, typename BACKEND>
+class FCN<Estimator<PDF, ChunkedSource<T, BACKEND>>>: public ROOT::Minuit2::FCNBase
+{
+
+	typedef Estimator<PDF, ChunkedSource<T, BACKEND>> estimator_type;
+
+public:
+
+	typedef ChunkedSource<T, BACKEND> source_type;
+	typedef typename source_type::iterator iterator;
+
+	FCN(PDF const& pdf, source_type const& source):
+	fDataSize(source.GetNRows()),
+	fPDF(pdf),
+	fSource(source),
+	fErrorDef(0.5),
+	fFCNCache(std::unordered_map<size_t, GReal_t>())
+	{
+		LoadFCNParameters();
+	}
+
+	FCN(FCN<estimator_type> const& other):
+	ROOT::Minuit2::FCNBase(other),
+	fDataSize(other.GetDataSize()),
+	fPDF(other.GetPDF()),
+	fSource(other.GetSource()),
+	fErrorDef(other.GetErrorDef()),
+	fUserParameters(other.GetParameters()),
+	fFCNCache(other.GetFcnCache())
+	{
+		LoadFCNParameters();
+	}
+
+	FCN<estimator_type>&
+	operator=(FCN<estimator_type> const& other){
+
+		if( this==&other ) return *this;
+
+		ROOT::Minuit2::FCNBase::operator=(other);
+		fPDF      = other.GetPDF();
+		fSource   = other.GetSource();
+		fDataSize = other.GetDataSize();
+		fErrorDef = other.GetErrorDef();
+		fUserParameters = other.GetParameters();
+		fFCNCache = other.GetFcnCache();
+
+		return *this;
+	}
+
+    // from Minuit2
+	double ErrorDef() const{
+		return fErrorDef;
+	}
+
+    void   SetErrorDef(double error){
+    	fErrorDef=error;
+    }
+
+	double Up() const{
+		return fErrorDef;
+	}
+
+	/**
+	 * @brief Function call operator
+	 *
+	 * @param parameters passed by Minuit
+	 * @return
+	 */
+	virtual GReal_t operator()(const std::vector<double>& parameters) const {
+
+		return GetFCNValue(parameters);
+	}
+
+	//this class
+	GReal_t GetErrorDef() const {
+		return fErrorDef;
+	}
+
+	const source_type& GetSource() const {
+		return fSource;
+	}
+
+	PDF& GetPDF() {
+		return fPDF;
+	}
+
+	const PDF& GetPDF() const {
+			return fPDF;
+	}
+
+	hydra::UserParameters& GetParameters() {
+		return fUserParameters;
+	}
+
+	const hydra::UserParameters& GetParameters() const {
+		return fUserParameters;
+	}
+
+	void SetParameters(const hydra::UserParameters& userParameters) {
+		fUserParameters = userParameters;
+	}
+
+	size_t GetDataSize() const
+	{
+		return fDataSize;
+	}
+
+private:
+
+	std::unordered_map<size_t, GReal_t>& GetFcnCache() const {
+		return fFCNCache;
+	}
+
+	GReal_t GetFCNValue(const std::vector<double>& parameters) const {
+
+		size_t key = hydra::detail::hash_range(parameters.begin(),parameters.end());
+
+		auto search = fFCNCache.find(key);
+
+		GReal_t value = 0.0;
+
+		if (search != fFCNCache.end() && fFCNCache.size()>0) {
+
+			if (INFO >= Print::Level()  )
+			{
+				std::ostringstream stringStream;
+				stringStream <<" Found in cache: key "
+						     <<  search->first
+						     << " value "
+						     << search->second << std::endl;
+				HYDRA_LOG(INFO, stringStream.str().c_str() )
+			}
+
+			value = search->second;
+		}
+		else {
+			value = EvalFCN(parameters);
+			fFCNCache[key] = value;
+
+			if (INFO >= Print::Level()  )
+			{
+				std::ostringstream stringStream;
+				stringStream <<" Not found in cache. Calculated and cached: key "
+						<<  key
+						<< " value "
+						<< value << std::endl;
+				HYDRA_LOG(INFO, stringStream.str().c_str() )
+			}
+		}
+
+		return value;
+	}
+
+	GReal_t EvalFCN(const std::vector<double>& parameters) const {
+		return static_cast<const estimator_type*>(this)->Eval(parameters);
+	}
+
+	void LoadFCNParameters(){
+		std::vector<hydra::Parameter*> temp;
+		fPDF.AddUserParameters(temp );
+		fUserParameters.SetVariables( temp);
+	}
+
+	GReal_t fDataSize;
+	PDF fPDF;
+	source_type fSource;
+	GReal_t  fErrorDef;
+	hydra::UserParameters fUserParameters ;
+	mutable std::unordered_map<size_t, GReal_t> fFCNCache;
+
+};
 
 } //namespace hydra
 
@@ -40,6 +40,7 @@
 #include <hydra/multivector.h>
 #include <hydra/detail/Integrator.h>
 #include <hydra/Placeholders.h>
+#include <hydra/detail/external/thrust/copy.h>
 
 #include <hydra/detail/Print.h>
 #include <tuple>
@@ -98,6 +99,15 @@ the corresponding Gauss rule is of order \f$2n-1\f$. These extra points are the
 This allows for computing higher-order estimates while reusing the function values of a lower-order estimate.
 The difference between a Gauss quadrature rule and its Kronrod extension are often used as an estimate of the approximation error.
 
+###Adaptive strategy###
+
+The integration region is divided in NBIN nodes, which are evaluated in parallel. While the total error is larger
+than the requested, all nodes whose error exceeds their share of the tolerance, \f$ \epsilon |I|/\sqrt{n_{nodes}} \f$,
+are halved in the same round. Only the new nodes are evaluated, all together in one call to the back end.
+The rounds stop when the total error is below the tolerance, when no node can be split further, or when
+splitting would exceed GetMaxNodes() nodes.
+The table of nodes stays on the back end and the integral and its error are calculated by a reduction.
+
  */
 template<size_t NRULE, size_t NBIN, hydra::detail::Backend BACKEND>
 class GaussKronrodAdaptiveQuadrature<NRULE,NBIN, hydra::detail::BackendPolicy<BACKEND>>:
@@ -106,55 +116,29 @@ public Integrator< GaussKronrodAdaptiveQuadrature<NRULE, NBIN, hydra::detail::Ba
 
 	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
 
-	/**
+	/*
 	 * nodes
 	 */
 	typedef HYDRA_EXTERNAL_NS::thrust::tuple<
-			GBool_t, // process
-			GUInt_t,  // bin
 			double,  // lower
 			double,  // upper
 			double,  // integral
 			double   // error
 			> node_t;
 
-	typedef HYDRA_EXTERNAL_NS::thrust::host_vector<node_t>   node_list_h;
-	//typedef multivector<node_list_h> node_table_h;
+	typedef multivector<node_t, system_t> node_table_d;
 	typedef multivector<node_t, hydra::host::sys_t> node_table_h;
-	/*
-	 * parameters
-	 */
-	typedef HYDRA_EXTERNAL_NS::thrust::tuple<
-			GUInt_t,// bin ,
-			double, // abscissa_X_P
-			double, // abscissa_X_M
-			double, // Jacobian
-			double, // rule_GaussKronrod_Weight
-			double  // rule_Gauss_Weight
-			> parameters_t;
-
-	typedef std::vector<parameters_t>   parameters_list_h;
-	typedef typename system_t::template container<parameters_t> parameters_list_d;
-
-	typedef multivector<parameters_t, hydra::host::sys_t> parameters_table_h;
-	typedef multivector<parameters_t, hydra::detail::BackendPolicy<BACKEND>> parameters_table_d;
-
 
 	/*
-	 * call results
+	 * call results summed per node
 	 */
 	typedef HYDRA_EXTERNAL_NS::thrust::tuple<
-			GUInt_t, // bin
 			double,  // gauss
 			double   // kronrod
 			> call_t;
 
-	typedef std::vector<call_t>   call_list_h;
-	typedef typename system_t::template container<call_t> call_list_d;
-
-	typedef multivector<call_t,hydra::host::sys_t > call_table_h;
-	typedef multivector<call_t,hydra::detail::BackendPolicy<BACKEND>> call_table_d;
-
+	typedef multivector<call_t, system_t> call_table_d;
+	typedef typename system_t::template container<size_t> key_list_d;
 
 public:
 
@@ -177,6 +161,7 @@ public:
 		fXLower(xlower),
 		fXUpper(xupper),
 		fMaxRelativeError( tolerance ),
+		fMaxNodes(100000),
 		fRule(GaussKronrodRuleSelector<NRULE>().fRule)
 	{ InitNodes(); }
 
@@ -191,6 +176,7 @@ public:
 			fXLower(other.GetXLower() ),
 			fXUpper(other.GetXUpper()),
 			fMaxRelativeError(other.GetMaxRelativeError() ),
+			fMaxNodes(other.GetMaxNodes() ),
 			fRule(other.GetRule())
 		{
 			InitNodes();
@@ -207,6 +193,7 @@ public:
 				fXLower(other.GetXLower() ),
 				fXUpper(other.GetXUpper()),
 				fMaxRelativeError(other.GetMaxRelativeError() ),
+				fMaxNodes(other.GetMaxNodes() ),
 				fRule(other.GetRule())
 			{
 				InitNodes();
@@ -227,6 +214,7 @@ public:
 		this->fXLower = other.GetXLower() ;
 		this->fXUpper = other.GetXUpper();
 		this->fMaxRelativeError = other.GetMaxRelativeError() ;
+		this->fMaxNodes = other.GetMaxNodes() ;
 		this->fRule=other.GetRule();
 		this->InitNodes();
 
@@ -249,6 +237,7 @@ public:
 			this->fXLower = other.GetXLower() ;
 			this->fXUpper = other.GetXUpper();
 			this->fMaxRelativeError = other.GetMaxRelativeError() ;
+			this->fMaxNodes = other.GetMaxNodes() ;
 			this->fRule=other.GetRule();
 			this->InitNodes();
 
@@ -270,31 +259,38 @@ public:
 	 */
 	void Print()
 	{
-		size_t nNodes   =  fNodesTable.size();
+		node_table_h nodes(fNodesTable);
+
 		HYDRA_CALLER ;
 		HYDRA_MSG << "GaussKronrodAdaptiveQuadrature begin: " << HYDRA_ENDL;
 		HYDRA_MSG << "XLower: " << fXLower << HYDRA_ENDL;
 		HYDRA_MSG << "XUpper: " << fXUpper << HYDRA_ENDL;
-		HYDRA_MSG << "#Nodes: " << nNodes << HYDRA_ENDL;
-		for(size_t i=0; i< nNodes; i++ ){
-			auto node = this->fNodesTable[i];
-			HYDRA_MSG <<std::setprecision(50)<< "Node ID #" << HYDRA_EXTERNAL_NS::thrust::get<1>(node) <<" Interval ["
-					  << HYDRA_EXTERNAL_NS::thrust::get<2>(node)
+		HYDRA_MSG << "#Nodes: " << nodes.size() << HYDRA_ENDL;
+		for(size_t i=0; i< nodes.size(); i++ ){
+			node_t node = nodes[i];
+			HYDRA_MSG <<std::setprecision(50)<< "Node ID #" << i <<" Interval ["
+					  << HYDRA_EXTERNAL_NS::thrust::get<0>(node)
 					  <<", "
-					  << HYDRA_EXTERNAL_NS::thrust::get<3>(node)
+					  << HYDRA_EXTERNAL_NS::thrust::get<1>(node)
 					  << "] Result ["
-					  << HYDRA_EXTERNAL_NS::thrust::get<4>(node)
+					  << HYDRA_EXTERNAL_NS::thrust::get<2>(node)
 					  << ", "
-					  << HYDRA_EXTERNAL_NS::thrust::get<5>(node)
+					  << HYDRA_EXTERNAL_NS::thrust::get<3>(node)
 					  << "]"
-					  << " Process  "
-					  << HYDRA_EXTERNAL_NS::thrust::get<0>(node)
 					  << HYDRA_ENDL;
 		}
 		fRule.Print();
 		HYDRA_MSG << "GaussKronrodAdaptiveQuadrature end. " << HYDRA_ENDL;
 	}
 
+	/**
+	 * @brief Number of nodes (subintervals) used by the last integration.
+	 */
+	size_t GetNumberOfNodes() const
+	{
+		return fNodesTable.size();
+	}
+
 
 	GReal_t GetMaxRelativeError() const
 	{
@@ -306,6 +302,19 @@ public:
 		fMaxRelativeError = maxRelativeError;
 	}
 
+	/**
+	 * Maximum number of nodes of the adaptive integration (default 100000).
+	 */
+	size_t GetMaxNodes() const
+	{
+		return fMaxNodes;
+	}
+
+	void SetMaxNodes(size_t maxNodes)
+	{
+		fMaxNodes = maxNodes;
+	}
+
 	GReal_t GetXLower() const
 	{
 		return fXLower;
@@ -342,97 +351,32 @@ private:
 
 	std::pair<GReal_t, GReal_t> Accumulate();
 
-	GReal_t GetError( GReal_t delta)
-	{
-		return  std::max(std::numeric_limits<GReal_t>::epsilon(),
-				std::pow(200.0*std::fabs(delta ), 1.5));
-	}
+	template<typename FUNCTOR>
+	void EvaluateNodes(FUNCTOR const& functor, size_t first_node);
 
+	size_t UpdateNodes(GReal_t threshold);
 
 	void InitNodes()
 	{
 		GReal_t delta = (fXUpper - fXLower)/NBIN;
-		fNodesTable.resize(NBIN);
+		node_table_h nodes(NBIN);
 
 		for(size_t i=0; i<NBIN; i++ )
-		{
-			auto node = this->fNodesTable[i];
-			HYDRA_EXTERNAL_NS::thrust::get<0>(node) = 	1;
-			HYDRA_EXTERNAL_NS::thrust::get<1>(node) = 	i;
-			HYDRA_EXTERNAL_NS::thrust::get<2>(node) = 	this->fXLower + i*delta;
-			HYDRA_EXTERNAL_NS::thrust::get<3>(node) = 	this->fXLower + (i+1)*delta;
-			HYDRA_EXTERNAL_NS::thrust::get<4>(node) = 	0.0;
-			HYDRA_EXTERNAL_NS::thrust::get<5>(node) = 	0.0;
-		}
-
-	}
-
-	size_t CountNodesToProcess()
-	{
-		auto begin = fNodesTable.begin( placeholders::_0);
-		auto end   = fNodesTable.end( placeholders::_0);
-
-	    size_t n=0;
-		for(auto i = begin; i!=end; i++)
-		if(*i)n++;
-		return n;
-	}
-
-	void SetParametersTable( )
-	{
-
-		size_t nNodes =  CountNodesToProcess();
-
-		fParametersTable.clear();
-		fParametersTable.resize(nNodes*(NRULE+1)/2);
-		parameters_table_h temp_table(nNodes*(NRULE+1)/2);
-
-		//for(size_t i=0; i<nNodes; i++)
-		size_t i=0;
-		for(auto node : fNodesTable)
-		{
-
-			if(!HYDRA_EXTERNAL_NS::thrust::get<0>(node)) 	continue;
-
-			for(size_t call=0; call<(NRULE+1)/2; call++)
-			{
-				GReal_t abscissa_X_P = 0;
-				GReal_t abscissa_X_M = 0;
-				GReal_t jacobian = 0;
-				GReal_t fLowerLimits= HYDRA_EXTERNAL_NS::thrust::get<2>(node);
-				GReal_t fUpperLimits= HYDRA_EXTERNAL_NS::thrust::get<3>(node);
-
-				HYDRA_EXTERNAL_NS::thrust::tie(abscissa_X_P, abscissa_X_M, jacobian)
-				= fRule.GetAbscissa(call , fLowerLimits, fUpperLimits);
-
-				GReal_t rule_GaussKronrod_Weight   = fRule.KronrodWeight[call];
-				GReal_t rule_Gauss_Weight                = fRule.GaussWeight[call];
-
-				size_t index = call*nNodes + i;
-
-				temp_table[index]= parameters_t(HYDRA_EXTERNAL_NS::thrust::get<1>(node), abscissa_X_P, abscissa_X_M,
-						jacobian, rule_GaussKronrod_Weight, rule_Gauss_Weight);
-			}
-
-			i++;
-		}
-
-	//	for(auto row: temp_table) std::cout << row << std::endl;
-		HYDRA_EXTERNAL_NS::thrust::copy( temp_table.begin(), temp_table.end(),
-				fParametersTable.begin() );
+			nodes[i] = node_t(this->fXLower + i*delta, this->fXLower + (i+1)*delta, 0.0, 0.0);
 
+		fNodesTable.resize(NBIN);
+		HYDRA_EXTERNAL_NS::thrust::copy(nodes.begin(), nodes.end(), fNodesTable.begin());
 	}
 
-	void UpdateNodes();
-
 	GUInt_t fIterationNumber;
 	GReal_t fXLower;
 	GReal_t fXUpper;
 	GReal_t fMaxRelativeError;
-	node_table_h  fNodesTable;
-	parameters_table_d fParametersTable;
-	call_table_h fCallTableHost;
-	call_table_d fCallTableDevice;
+	size_t  fMaxNodes;
+	node_table_d  fNodesTable;
+	node_table_d  fSplitNodes;
+	call_table_d  fCallTable;
+	key_list_d    fKeys;
 
 	GaussKronrodRule<NRULE> fRule;
 
@@ -41,6 +41,7 @@
 
 #include <hydra/detail/Print.h>
 #include <tuple>
+#include <vector>
 
 namespace hydra {
 
@@ -165,6 +166,14 @@ public:
 	template<typename FUNCTOR>
 	std::pair<GReal_t, GReal_t> Integrate(FUNCTOR const& functor);
 
+	/**
+	 * Integrate several functors in a single pass over the abscissas.
+	 * @param functors : hydra::tuple of functors (integrands)
+	 * @return std::vector with the integration result and error of each functor
+	 */
+	template<typename ...FUNCTORS>
+	std::vector<std::pair<GReal_t, GReal_t>> Integrate(HYDRA_EXTERNAL_NS::thrust::tuple<FUNCTORS...> const& functors);
+
 	void Print()
 	{
 		HYDRA_CALLER ;
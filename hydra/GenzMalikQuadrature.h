@@ -44,6 +44,8 @@
 #include <hydra/detail/utility/Generic.h>
 
 #include <algorithm>
+#include <utility>
+#include <vector>
 #include <cmath>
 
 namespace hydra {
@@ -53,10 +55,22 @@ class  GenzMalikQuadrature;
 
 /**
  * \ingroup numerical_integration
- * \brief Non-adaptive Genz-Malik multidimensional quadrature
+ * \brief Genz-Malik multidimensional quadrature
+ *
+ * Genz-Malik multidimensional quadrature. The integration region is divided in boxes and each box is
+ * integrated with the degree seven rule, the difference with the embedded degree five rule giving its error.
+ * The error of the integral is the sum of the errors of the boxes.
+ * All rule abscissas of all boxes are evaluated by a single launch on the backend.
+ *
+ * ###Adaptive strategy###
+ * The integration is adaptive if SetMaxRelativeError(...) is called with a positive tolerance \f$\epsilon\f$.
+ * After the evaluation of the initial boxes, each round bisects the boxes with the largest errors,
+ * until the boxes left untouched account for at most \f$ |I|\epsilon/2 \f$, along the dimension
+ * with the largest fourth difference, as in the original paper.
+ * Only the new boxes are evaluated, again in a single launch per round.
+ * The rounds stop when the total error is below the tolerance or the number of boxes reaches GetMaxBoxes().
+ * The boxes are refined in place, so the next integration starts from the subdivision found by the previous one.
  *
- * Non-adaptive Genz-Malik multidimensional quadrature. This algorithm follows the original paper prescription
- * but does not implement the subdivision strategy yet.
  * A. C. Genz and A. A. Malik, "An adaptive algorithm for numeric integration over an N-dimensional rectangular region," J. Comput. Appl. Math. 6 (4), 295–302 (1980).
  * J. Berntsen, T. O. Espelid, and A. Genz, "An adaptive algorithm for the approximate calculation of multiple integrals," ACM Trans. Math. Soft. 17 (4), 437–451 (1991)
  */
@@ -73,6 +87,12 @@ public Integrator<typename std::enable_if< (N>1),GenzMalikQuadrature<N, hydra::d
 	typedef typename GenzMalikRule<N, hydra::detail::BackendPolicy<BACKEND>>::abscissa_iterator rule_iterator;
 	typedef typename GenzMalikRule<N, hydra::detail::BackendPolicy<BACKEND>>::const_abscissa_iterator const_rule_iterator;
 
+	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
+	typedef typename detail::GenzMalikBox<N>::data_type box_data_t;
+	typedef typename system_t::template container<GReal_t> vector_t;
+	typedef typename system_t::template container<size_t> uvector_t;
+	typedef typename system_t::template container<box_data_t> box_data_vector_t;
+
 public:
 
 	GenzMalikQuadrature()=delete;
@@ -136,6 +156,16 @@ public:
 	template<typename FUNCTOR>
 	std::pair<GReal_t, GReal_t> Integrate(FUNCTOR const& functor);
 
+	/**
+	 * Integrate several functors in a single pass over the rule abscissas of all boxes.
+	 * The current subdivision is used as it is, without adaptation. It can be refined
+	 * beforehand with an adaptive integration of a representative functor.
+	 * @param functors : hydra::tuple of functors (integrands)
+	 * @return std::vector with the integration result and error of each functor
+	 */
+	template<typename ...FUNCTORS>
+	std::vector<std::pair<GReal_t, GReal_t>> Integrate(HYDRA_EXTERNAL_NS::thrust::tuple<FUNCTORS...> const& functors);
+
 
 	/**
 	 * Print
@@ -163,9 +193,50 @@ public:
 		fGenzMalikRule = genzMalikRule;
 	}
 
+	/**
+	 * Relative tolerance of the adaptive integration. Zero (default) disables the subdivision.
+	 */
+	GReal_t GetMaxRelativeError() const {
+		return fMaxRelativeError;
+	}
+
+	void SetMaxRelativeError(GReal_t maxRelativeError) {
+		fMaxRelativeError = maxRelativeError;
+	}
+
+	/**
+	 * Maximum number of boxes of the adaptive integration (default 100000).
+	 */
+	size_t GetMaxBoxes() const {
+		return fMaxBoxes;
+	}
+
+	void SetMaxBoxes(size_t maxBoxes) {
+		fMaxBoxes = maxBoxes;
+	}
+
 
 private:
 
+	/*
+	 * Copy the limits of the boxes [first_box, fBoxList.size()) to the backend.
+	 */
+	void SetLimits(size_t first_box);
+
+	/*
+	 * Evaluate the boxes [first_box, fBoxList.size()) in one launch.
+	 */
+	template<typename FUNCTOR>
+	void EvaluateBoxes(FUNCTOR const& functor, size_t first_box);
+
+	/*
+	 * Bisect the boxes with error above threshold and append the halves to the list.
+	 * Returns the index of the first new box.
+	 */
+	size_t SplitBoxes(GReal_t threshold);
+
+	std::pair<GReal_t, GReal_t> Accumulate() const;
+
 	void GetGrid( size_t nboxes , std::array<size_t, N>& grid )
 	{
 		size_t ndivsion = std::llround( std::pow( 2.0, std::log2(double(nboxes))/double(N) ) );
@@ -177,6 +248,11 @@ private:
 
 	GenzMalikRule<  N,  hydra::detail::BackendPolicy<BACKEND>> fGenzMalikRule;
 	box_list_type fBoxList;
+	GReal_t fMaxRelativeError;
+	size_t  fMaxBoxes;
+	vector_t fLimits;
+	uvector_t fKeys;
+	box_data_vector_t fBoxData;
 
 };
 
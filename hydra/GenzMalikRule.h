@@ -394,27 +394,27 @@ public:
 
 				case Central:
 					index = N;
-					four_difference_weight = 6;
+					four_difference_weight = -12;
 					break;
 
 				case FirstRight:
 					index = std::distance( abscissa_temp.begin(), std::max_element ( abscissa_temp.begin(), abscissa_temp.end())   );
-					four_difference_weight = -4;
+					four_difference_weight = -1;
 					break;
 
 				case SecondRight:
 					index = std::distance( abscissa_temp.begin(),  std::max_element ( abscissa_temp.begin(), abscissa_temp.end()) );
-					four_difference_weight = 1;
+					four_difference_weight = 7;
 					break;
 
 				case FirstLeft:
 					index = std::distance(  abscissa_temp.begin(), std::min_element( abscissa_temp.begin(), abscissa_temp.end()) );
-					four_difference_weight = -4;
+					four_difference_weight = -1;
 					break;
 
 				case SecondLeft:
 					index = std::distance(  abscissa_temp.begin(), std::min_element( abscissa_temp.begin(), abscissa_temp.end()) );
-					four_difference_weight = 1;
+					four_difference_weight = 7;
 					break;
 
 				case Multidimensional:
@@ -454,7 +454,7 @@ public:
 			  HYDRA_EXTERNAL_NS::thrust::get<1>(x)= fRule7Weight1;
 			  HYDRA_EXTERNAL_NS::thrust::get<2>(x)= 1.0;
 			  HYDRA_EXTERNAL_NS::thrust::get<4>(x)= N;
-			  HYDRA_EXTERNAL_NS::thrust::get<3>(x)= 6;
+			  HYDRA_EXTERNAL_NS::thrust::get<3>(x)= -12;
 			  fAbscissas.push_back(x);
 			  break;
 		  }
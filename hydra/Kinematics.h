@@ -0,0 +1,198 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * Kinematics.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef KINEMATICS_H_
+#define KINEMATICS_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/BackendPolicy.h>
+#include <hydra/Types.h>
+#include <hydra/Decays.h>
+#include <hydra/multivector.h>
+#include <hydra/detail/functors/KinematicsKernel.h>
+
+#include <array>
+#include <initializer_list>
+#include <assert.h>
+
+#include <hydra/detail/external/thrust/for_each.h>
+#include <hydra/detail/external/thrust/iterator/counting_iterator.h>
+#include <hydra/detail/external/thrust/memory.h>
+
+namespace hydra {
+
+/**
+ * \ingroup phsp
+ * \brief Description of a kinematic quantity to be calculated by hydra::compute_kinematics.
+ *
+ * Four-vectors are specified as lists of daughter indices, whose momenta are summed.
+ * An empty list stands for the whole final state, i.e. the mother particle.
+ */
+class KinematicVariable
+{
+	typedef std::initializer_list<GUInt_t> list_type;
+
+public:
+
+	/**
+	 * @brief Invariant mass squared of the combination of particles, for example {0,1} or {0,1,2}.
+	 */
+	static KinematicVariable MassSquared(list_type particles)
+	{
+		return KinematicVariable(detail::KinematicEntry::ENTRY_MASS2,
+				mask(particles), 0, 0, 0);
+	}
+
+	/**
+	 * @brief Cosine of the helicity angle of D, daughter of Q, grand daughter of P.
+	 * See hydra::CosHelicityAngle.
+	 */
+	static KinematicVariable CosHelicity(list_type P, list_type Q, list_type D)
+	{
+		return KinematicVariable(detail::KinematicEntry::ENTRY_COSHELICITY,
+				mask(P), mask(Q), mask(D), 0);
+	}
+
+	/**
+	 * @brief Angle between the decay planes (d2, d3) and (d2+d3, h1).
+	 * See hydra::PlanesDeltaAngle.
+	 */
+	static KinematicVariable PlanesAngle(list_type d2, list_type d3, list_type h1)
+	{
+		return KinematicVariable(detail::KinematicEntry::ENTRY_PLANESANGLE,
+				mask(d2), mask(d3), mask(h1), 0);
+	}
+
+	/**
+	 * @brief Component (0=E, 1=px, 2=py, 3=pz) of the combination of particles
+	 * in the rest frame of the combination 'frame'.
+	 */
+	static KinematicVariable Boosted(list_type particles, GUInt_t component, list_type frame)
+	{
+		assert(component < 4 && "HYDRA MESSAGE: KinematicVariable::Boosted component out of range [0,4)");
+
+		return KinematicVariable(detail::KinematicEntry::ENTRY_BOOSTED,
+				mask(particles), mask(frame), 0, component);
+	}
+
+	inline detail::KinematicEntry const& GetEntry() const { return fEntry; }
+
+	inline GUInt_t GetUsedParticles() const {
+		return fEntry.fMasks[0] | fEntry.fMasks[1] | fEntry.fMasks[2];
+	}
+
+private:
+
+	KinematicVariable(GInt_t type, GUInt_t m0, GUInt_t m1, GUInt_t m2, GUInt_t component)
+	{
+		fEntry.fType      = type;
+		fEntry.fMasks[0]  = m0;
+		fEntry.fMasks[1]  = m1;
+		fEntry.fMasks[2]  = m2;
+		fEntry.fComponent = component;
+		fEntry.fFrame     = 0;
+	}
+
+	static GUInt_t mask(list_type particles)
+	{
+		GUInt_t m = 0;
+
+		for(auto i: particles){
+			assert(i < 32 && "HYDRA MESSAGE: KinematicVariable supports at most 32 particles");
+			m |= (1u<<i);
+		}
+
+		return m;
+	}
+
+	detail::KinematicEntry fEntry;
+};
+
+/**
+ * \ingroup phsp
+ * \brief Calculate a list of kinematic quantities for all events stored in a hydra::Decays container.
+ *
+ * The daughters are read directly from the SoA columns of the container and all quantities
+ * are evaluated in a single pass, writing to the raw columns of the output multivector (see hydra::multivector::spans).
+ * Boost matrices are calculated once per event for each distinct frame.
+ * @param decays container with the events.
+ * @param variables list of quantities, one per output column.
+ * @param output multivector resized to the number of events.
+ */
+template<size_t N, hydra::detail::Backend BACKEND, typename ...T>
+void compute_kinematics(Decays<N, hydra::detail::BackendPolicy<BACKEND> > const& decays,
+		std::array<KinematicVariable, sizeof...(T)> const& variables,
+		multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND> >& output)
+{
+	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
+	constexpr size_t M = sizeof...(T);
+
+	static_assert(N <= 32, "HYDRA MESSAGE: hydra::compute_kinematics supports at most 32 particles");
+
+	detail::KinematicEntry entries[M];
+	GUInt_t frames[M] = {};
+	size_t  nframes = 0;
+
+	for(size_t i=0; i<M; i++)
+	{
+		entries[i] = variables[i].GetEntry();
+
+		assert( (variables[i].GetUsedParticles() >> N) == 0 &&
+				"HYDRA MESSAGE: KinematicVariable refers to particle out of final state");
+
+		if(entries[i].fType != detail::KinematicEntry::ENTRY_BOOSTED) continue;
+
+		//reuse the boost if the frame was already requested
+		size_t f = 0;
+		while(f < nframes && frames[f] != entries[i].fMasks[1]) f++;
+
+		if(f == nframes) frames[nframes++] = entries[i].fMasks[1];
+
+		entries[i].fFrame = f;
+	}
+
+	const GReal_t* columns[N][4];
+
+	for(size_t i=0; i<N; i++)
+		for(size_t j=0; j<4; j++)
+			columns[i][j] = decays.size() ?
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(&(*decays.GetListOfParticles(i).begin(j))) : nullptr;
+
+	output.resize(decays.size());
+
+	//the results are written through the raw columns of the output
+	HYDRA_EXTERNAL_NS::thrust::for_each(system_t(),
+			HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t>(0),
+			HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t>(decays.size()),
+			detail::KinematicsWriter<N, M, T...>(
+					detail::KinematicsKernel<N, M>(columns, entries, frames, nframes), output.spans()));
+}
+
+}  // namespace hydra
+
+#endif /* KINEMATICS_H_ */
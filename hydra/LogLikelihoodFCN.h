@@ -110,5 +110,6 @@ auto make_loglikehood_fcn(PDFSumNonExtendable<Pdfs...>const& pdf, Iterator first
 #include<hydra/detail/LogLikelihoodFCN1.inl>
 #include<hydra/detail/LogLikelihoodFCN2.inl>
 #include<hydra/detail/LogLikelihoodFCN3.inl>
+#include<hydra/detail/LogLikelihoodFCN4.inl>
 
 #endif /* LOGLIKELIHOODFCN2_H_ */
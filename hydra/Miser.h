@@ -0,0 +1,336 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * Miser.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef MISER_H_
+#define MISER_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/BackendPolicy.h>
+#include <hydra/Types.h>
+#include <hydra/PlainState.h>
+#include <hydra/detail/Integrator.h>
+#include <hydra/detail/functors/ProcessCallsPlain.h>
+#include <hydra/detail/functors/ProcessCallsMiser.h>
+#include <hydra/detail/external/thrust/reduce.h>
+#include <hydra/detail/external/thrust/functional.h>
+#include <hydra/detail/external/thrust/iterator/counting_iterator.h>
+#include <hydra/detail/external/thrust/iterator/transform_iterator.h>
+#include <hydra/detail/external/thrust/random.h>
+
+#include <array>
+#include <vector>
+#include <utility>
+#include <assert.h>
+
+namespace hydra {
+
+template<size_t N, typename BACKEND, typename GRND=HYDRA_EXTERNAL_NS::thrust::random::default_random_engine>
+class Miser;
+
+/**
+ * \ingroup numerical_integration
+ *
+ * \brief This class implements the MISER recursive stratified sampling algorithm
+ * (W. H. Press and G. R. Farrar, Computers in Physics 4, 190 (1990)).
+ *
+ * A region receiving at least GetMinCallsPerBisection() calls spends a fraction GetEstimateFraction()
+ * of them exploring the function. The region is then bisected along the dimension which minimizes
+ * \f$\sigma_l^{\beta} + \sigma_r^{\beta}\f$, \f$\beta = 2/(1+\alpha)\f$, and the remaining calls are
+ * shared between the two halves in proportion to \f$\sigma^{\beta}\f$. Regions with fewer calls
+ * are integrated with plain Monte Carlo and the results of all regions are summed.
+ * Concentrating the calls where the variance is largest makes MISER efficient for integrands with
+ * localized sharp features, which are not separable in the sense of hydra::Vegas.
+ *
+ * The recursion is unrolled level by level: all sub-volumes of one level are explored by a single
+ * launch on the backend, and the terminal sub-volumes are integrated together by a final launch.
+ * Each call draws its random numbers from a stream seeded with the global index of the call.
+ */
+template<size_t N, hydra::detail::Backend BACKEND, typename GRND>
+class Miser<N, hydra::detail::BackendPolicy<BACKEND>, GRND>:
+public Integrator<Miser<N,hydra::detail::BackendPolicy<BACKEND>,GRND>>
+{
+	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
+	typedef typename system_t::template container<size_t> uvector_t;
+	typedef typename system_t::template container<hydra::detail::MiserRegion<N>> region_vector_t;
+	typedef typename system_t::template container<hydra::detail::MiserExploreState<N>> explore_vector_t;
+	typedef typename system_t::template container<PlainState> state_vector_t;
+
+public:
+
+	Miser()=delete;
+
+	/**
+	 * @brief Constructor for the MISER numerical integration algorithm.
+	 * @param LowLim  is std::array<GReal_t,N> with the lower limits of the integration region.
+	 * @param UpLim std::array<GReal_t,N>  with the upper limits of the integration region.
+	 * @param calls Number of calls.
+	 * @param seed Seed of the random number streams.
+	 */
+	Miser( std::array<GReal_t,N> const& LowLim, std::array<GReal_t,N> const& UpLim,
+			size_t calls, size_t seed=159753456852):
+				fSeed(seed),
+				fNCalls(calls),
+				fNRegions(0),
+				fMinCalls(16*N),
+				fMinCallsPerBisection(32*16*N),
+				fEstimateFraction(0.1),
+				fAlpha(2.0),
+				fResult(0),
+				fAbsError(0),
+				fXLow(LowLim),
+				fXUp(UpLim)
+	{ }
+
+	/**
+	 * @brief Constructor for the MISER numerical integration algorithm.
+	 * @param LowLim  array with the lower limits of the integration region.
+	 * @param UpLim array with the upper limits of the integration region.
+	 * @param calls Number of calls.
+	 * @param seed Seed of the random number streams.
+	 */
+	Miser( const double LowLim[N] , const double  UpLim[N], size_t calls, size_t seed=159753456852):
+				fSeed(seed),
+				fNCalls(calls),
+				fNRegions(0),
+				fMinCalls(16*N),
+				fMinCallsPerBisection(32*16*N),
+				fEstimateFraction(0.1),
+				fAlpha(2.0),
+				fResult(0),
+				fAbsError(0)
+	{
+		for(size_t i=0; i<N; i++)
+		{
+			fXLow[i] = LowLim[i];
+			fXUp[i]  = UpLim[i];
+		}
+	}
+
+	Miser( Miser<N, hydra::detail::BackendPolicy<BACKEND>, GRND> const& other):
+		fSeed(other.GetSeed() ),
+		fNCalls(other.GetNCalls()),
+		fNRegions(other.GetNRegions()),
+		fMinCalls(other.GetMinCalls()),
+		fMinCallsPerBisection(other.GetMinCallsPerBisection()),
+		fEstimateFraction(other.GetEstimateFraction()),
+		fAlpha(other.GetAlpha()),
+		fResult(other.GetResult()),
+		fAbsError(other.GetAbsError() ),
+		fXLow(other.GetXLow()),
+		fXUp(other.GetXUp())
+	{ }
+
+	template<hydra::detail::Backend BACKEND2>
+	Miser( Miser<N, hydra::detail::BackendPolicy<BACKEND2>, GRND> const& other):
+		fSeed(other.GetSeed() ),
+		fNCalls(other.GetNCalls()),
+		fNRegions(other.GetNRegions()),
+		fMinCalls(other.GetMinCalls()),
+		fMinCallsPerBisection(other.GetMinCallsPerBisection()),
+		fEstimateFraction(other.GetEstimateFraction()),
+		fAlpha(other.GetAlpha()),
+		fResult(other.GetResult()),
+		fAbsError(other.GetAbsError() ),
+		fXLow(other.GetXLow()),
+		fXUp(other.GetXUp())
+	{ }
+
+	Miser<N, hydra::detail::BackendPolicy<BACKEND>, GRND>&
+	operator=( Miser<N, hydra::detail::BackendPolicy<BACKEND>, GRND> const& other)
+	{
+		if( this==&other) return *this;
+
+		this->fSeed      = other.GetSeed() ;
+		this->fNCalls    = other.GetNCalls();
+		this->fNRegions  = other.GetNRegions();
+		this->fMinCalls  = other.GetMinCalls();
+		this->fMinCallsPerBisection = other.GetMinCallsPerBisection();
+		this->fEstimateFraction     = other.GetEstimateFraction();
+		this->fAlpha     = other.GetAlpha();
+		this->fResult    = other.GetResult();
+		this->fAbsError  = other.GetAbsError() ;
+		this->fXLow      = other.GetXLow();
+		this->fXUp       = other.GetXUp();
+
+		return *this;
+	}
+
+	template<hydra::detail::Backend BACKEND2>
+	Miser<N, hydra::detail::BackendPolicy<BACKEND>, GRND>&
+	operator=( Miser<N, hydra::detail::BackendPolicy<BACKEND2>, GRND> const& other)
+	{
+		this->fSeed      = other.GetSeed() ;
+		this->fNCalls    = other.GetNCalls();
+		this->fNRegions  = other.GetNRegions();
+		this->fMinCalls  = other.GetMinCalls();
+		this->fMinCallsPerBisection = other.GetMinCallsPerBisection();
+		this->fEstimateFraction     = other.GetEstimateFraction();
+		this->fAlpha     = other.GetAlpha();
+		this->fResult    = other.GetResult();
+		this->fAbsError  = other.GetAbsError() ;
+		this->fXLow      = other.GetXLow();
+		this->fXUp       = other.GetXUp();
+
+		return *this;
+	}
+
+	/**
+	 * @brief This method performs the actual integration.
+	 * @param fFunctor functor (integrand).
+	 * @return std::pair<GReal_t, GReal_t> with the integration result and error.
+	 */
+	template<typename FUNCTOR>
+	inline std::pair<GReal_t, GReal_t>  Integrate(FUNCTOR const& fFunctor );
+
+	inline GReal_t GetAbsError() const {
+		return fAbsError;
+	}
+
+	inline GReal_t GetResult() const {
+		return fResult;
+	}
+
+	inline std::array<GReal_t,N> const& GetXLow() const {
+		return fXLow;
+	}
+
+	inline std::array<GReal_t,N> const& GetXUp() const {
+		return fXUp;
+	}
+
+	inline size_t GetNCalls() const {
+		return fNCalls;
+	}
+
+	inline void SetNCalls(size_t nCalls) {
+		fNCalls = nCalls;
+	}
+
+	/**
+	 * @brief Number of terminal sub-volumes used by the last integration.
+	 */
+	inline size_t GetNRegions() const {
+		return fNRegions;
+	}
+
+	/**
+	 * @brief Minimum number of calls to explore a region and to integrate a terminal region (default 16*N).
+	 */
+	inline size_t GetMinCalls() const {
+		return fMinCalls;
+	}
+
+	inline void SetMinCalls(size_t minCalls) {
+
+		assert(minCalls > 1 && "HYDRA MESSAGE: Miser needs at least two calls per region");
+		fMinCalls = minCalls;
+	}
+
+	/**
+	 * @brief Minimum number of calls for a region to be bisected (default 32*GetMinCalls()).
+	 */
+	inline size_t GetMinCallsPerBisection() const {
+		return fMinCallsPerBisection;
+	}
+
+	inline void SetMinCallsPerBisection(size_t minCallsPerBisection) {
+		fMinCallsPerBisection = minCallsPerBisection;
+	}
+
+	/**
+	 * @brief Fraction of the calls of a region spent exploring it (default 0.1).
+	 */
+	inline GReal_t GetEstimateFraction() const {
+		return fEstimateFraction;
+	}
+
+	inline void SetEstimateFraction(GReal_t estimateFraction) {
+
+		assert(estimateFraction > 0.0 && estimateFraction < 1.0
+				&& "HYDRA MESSAGE: Miser estimate fraction out of range (0,1)");
+		fEstimateFraction = estimateFraction;
+	}
+
+	/**
+	 * @brief Exponent controlling the sharing of the calls between the halves of a region (default 2).
+	 */
+	inline GReal_t GetAlpha() const {
+		return fAlpha;
+	}
+
+	inline void SetAlpha(GReal_t alpha) {
+		fAlpha = alpha;
+	}
+
+	inline size_t GetSeed() const {
+		return fSeed;
+	}
+
+	inline void SetSeed(const size_t& seed) {
+		fSeed = seed;
+	}
+
+private:
+
+	/*
+	 * Choose the bisection of an explored region and share its remaining calls.
+	 */
+	void Bisect(hydra::detail::MiserRegion<N> const& region,
+			hydra::detail::MiserExploreState<N> const& state, size_t calls,
+			std::vector<hydra::detail::MiserRegion<N>>& children) const;
+
+	/*
+	 * Copy the regions to the backend and calculate the offsets of their calls.
+	 */
+	size_t SetRegions(std::vector<hydra::detail::MiserRegion<N>> const& regions,
+			std::vector<size_t> const& calls);
+
+	size_t  fSeed;
+	size_t  fNCalls;
+	size_t  fNRegions;
+	size_t  fMinCalls;
+	size_t  fMinCallsPerBisection;
+	GReal_t fEstimateFraction;
+	GReal_t fAlpha;
+	GReal_t fResult;
+	GReal_t fAbsError;
+	std::array<GReal_t,N> fXLow;
+	std::array<GReal_t,N> fXUp;
+
+	region_vector_t  fRegions;
+	uvector_t        fOffsets;
+	uvector_t        fKeys;
+	explore_vector_t fExploreStates;
+	state_vector_t   fLeafStates;
+};
+
+}  // namespace hydra
+
+#include <hydra/detail/Miser.inl>
+
+#endif /* MISER_H_ */
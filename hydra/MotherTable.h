@@ -0,0 +1,167 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * MotherTable.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef MOTHERTABLE_H_
+#define MOTHERTABLE_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/BackendPolicy.h>
+#include <hydra/Types.h>
+#include <hydra/multiarray.h>
+#include <hydra/detail/functors/MotherConstants.h>
+
+#include <hydra/detail/external/thrust/transform.h>
+#include <hydra/detail/external/thrust/extrema.h>
+#include <hydra/detail/external/thrust/distance.h>
+#include <hydra/detail/external/thrust/memory.h>
+
+namespace hydra {
+
+template<size_t N, typename BACKEND>
+class MotherTable;
+
+/**
+ * \ingroup phsp
+ * \brief This class stores a list of mother particles together with the constants
+ * the phase-space generation depends on: the kinetic energy available in the decay,
+ * the normalization of the event weight and the boost to the mother's frame.
+ * Data is stored using SoA layout.
+ *
+ * The constants depend only on the mothers and on the daughter masses, so the same table
+ * can be passed to hydra::PhaseSpace::Generate, hydra::PhaseSpace::Evaluate and
+ * hydra::PhaseSpace::AverageOn any number of times, also after reseeding the generator.
+ *
+ *\tparam N is the number of particles in final state.
+ *\tparam BACKEND memory space where the table is stored.
+ */
+template<size_t N, hydra::detail::Backend BACKEND>
+class MotherTable<N, hydra::detail::BackendPolicy<BACKEND> >
+{
+	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
+	typedef multiarray<GReal_t, detail::MOTHER_NCOLUMNS, system_t> storage_type;
+
+public:
+
+	typedef typename storage_type::const_iterator const_iterator;
+	typedef typename storage_type::value_type     value_type;
+
+	/**
+	 * @brief Build the table for the mothers in the range [mbegin, mend).
+	 * @param masses array with the masses of the daughter particles in Gev/c*c;
+	 * @param mbegin Iterator pointing to the begin of range of mother particles.
+	 * @param mend Iterator pointing to the end  of range of mother particles.
+	 */
+	template<typename Iterator>
+	MotherTable(const GReal_t* masses, Iterator mbegin, Iterator mend):
+		fPhysical(false)
+	{
+		for(size_t i=0; i<N; i++)
+			fMasses[i]= masses[i];
+
+		Update(mbegin, mend);
+	}
+
+	MotherTable(MotherTable<N, system_t> const& other):
+		fPhysical(other.IsPhysical()),
+		fData(other.GetData())
+	{
+		for(size_t i=0; i<N; i++)
+			fMasses[i]= other.GetMasses()[i];
+	}
+
+	MotherTable<N, system_t>&
+	operator=(MotherTable<N, system_t> const& other)
+	{
+		if(this==&other) return *this;
+
+		fPhysical = other.IsPhysical();
+		fData     = other.GetData();
+
+		for(size_t i=0; i<N; i++)
+			fMasses[i]= other.GetMasses()[i];
+
+		return *this;
+	}
+
+	/**
+	 * @brief Replace the mothers stored in the table and recalculate the constants.
+	 * @param mbegin Iterator pointing to the begin of range of mother particles.
+	 * @param mend Iterator pointing to the end  of range of mother particles.
+	 */
+	template<typename Iterator>
+	void Update(Iterator mbegin, Iterator mend)
+	{
+		size_t nmothers = HYDRA_EXTERNAL_NS::thrust::distance(mbegin, mend);
+
+		fData.resize(nmothers);
+
+		HYDRA_EXTERNAL_NS::thrust::transform(system_t(), mbegin, mend, fData.begin(),
+				detail::MotherConstants<N>(fMasses) );
+
+		fPhysical = nmothers > 0 ?
+				*HYDRA_EXTERNAL_NS::thrust::min_element(system_t(),
+						fData.begin(detail::MOTHER_TECMTM), fData.end(detail::MOTHER_TECMTM)) > 0.0 : true;
+	}
+
+	/**
+	 * @brief Raw pointers to the columns of the table, in the order
+	 * E, px, py, pz, available kinetic energy, inverse of the maximum weight, beta_x, beta_y, beta_z.
+	 */
+	void GetColumns(const GReal_t* (&columns)[detail::MOTHER_NCOLUMNS]) const
+	{
+		for(size_t i=0; i<detail::MOTHER_NCOLUMNS; i++)
+			columns[i] = fData.size() ?
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(&(*fData.begin(i))) : nullptr;
+	}
+
+	/**
+	 * @brief True if all mothers are heavy enough to decay into the daughters.
+	 */
+	inline bool IsPhysical() const { return fPhysical; }
+
+	inline size_t size() const { return fData.size(); }
+
+	inline const GReal_t* GetMasses() const { return fMasses; }
+
+	inline storage_type const& GetData() const { return fData; }
+
+	inline const_iterator begin() const { return fData.begin(); }
+
+	inline const_iterator end() const { return fData.end(); }
+
+private:
+
+	GReal_t fMasses[N];
+	bool    fPhysical;
+	storage_type fData;
+
+};
+
+}  // namespace hydra
+
+#endif /* MOTHERTABLE_H_ */
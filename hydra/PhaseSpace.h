@@ -51,12 +51,14 @@
 #include <hydra/detail/functors/EvalMother.h>
 #include <hydra/detail/functors/EvalMothers.h>
 #include <hydra/detail/functors/StatsPHSP.h>
+#include <hydra/detail/functors/AverageMotherVR.h>
 #include <hydra/detail/Print.h>
 #include <hydra/detail/functors/CheckEnergy.h>
 #include <hydra/Tuple.h>
 #include <hydra/detail/Hash.h>
 
 #include <hydra/Decays.h>
+#include <hydra/MotherTable.h>
 
 #include <hydra/detail/launch_decayers.inl>
 
@@ -142,24 +144,40 @@ public:
 
 
 	/**
-	 * @brief Calculate the mean and the \f$ \sqrt(variance)\f$  of a functor over the phase-space with n-samples.
+	 * @brief Calculate the mean and its standard error of a functor over the phase-space with n-samples.
+	 * The mean is weighted by the phase-space weights of the events and the error is the one of the
+	 * ratio \f$ \sum w f / \sum w \f$, as returned by all overloads of AverageOn.
 	 * @param policy  Back-end;
 	 * @param mother  Mother particle four-vector;
 	 * @param functor Functor;
 	 * @param n Number of samples;
-	 * @return std::pair with the mean and the \f$ \sqrt(variance)\f$
+	 * @return std::pair with the mean and its standard error
 	 */
 	template<typename FUNCTOR, hydra::detail::Backend BACKEND>
 	std::pair<GReal_t, GReal_t> AverageOn(hydra::detail::BackendPolicy<BACKEND>const& policy,
 			Vector4R const& mother, FUNCTOR const& functor, size_t n) ;
 
 	/**
-	 * @brief Calculate the mean and the \f$ \sqrt(\sigma)\f$  of a functor over the phase-space given a list of mother particles.
+	 * @brief Calculate the mean and its standard error of a functor over the phase-space with n-samples,
+	 * using a variance reduction technique.
+	 * @param policy  Back-end;
+	 * @param mother  Mother particle four-vector;
+	 * @param functor Functor;
+	 * @param n Number of samples;
+	 * @param sampling Sampling strategy, see hydra::PhaseSpaceSampling;
+	 * @return std::pair with the mean and its standard error
+	 */
+	template<typename FUNCTOR, hydra::detail::Backend BACKEND>
+	std::pair<GReal_t, GReal_t> AverageOn(hydra::detail::BackendPolicy<BACKEND>const& policy,
+			Vector4R const& mother, FUNCTOR const& functor, size_t n, PhaseSpaceSampling sampling) ;
+
+	/**
+	 * @brief Calculate the mean and its standard error of a functor over the phase-space given a list of mother particles.
 	 * @param policy Back-end;
 	 * @param begin Iterator pointing to the begin of list of mother particles;
 	 * @param end   Iterator pointing to the end of list of mother particles;
 	 * @param functor Functor;
-	 * @return std::pair with the mean and the \f$ \sqrt(\sigma)\f$
+	 * @return std::pair with the mean and its standard error
 	 */
 	template<typename FUNCTOR,  typename Iterator>
 	std::pair<GReal_t, GReal_t> AverageOn(Iterator begin, Iterator end, FUNCTOR const& functor);
@@ -226,6 +244,36 @@ public:
 
 
 
+	/**
+	 * @brief Calculate the mean and its standard error of a functor over the phase-space given a table of mother particles.
+	 * @param table hydra::MotherTable with the mother particles and the precomputed constants;
+	 * @param functor Functor;
+	 * @return std::pair with the mean and its standard error
+	 */
+	template<typename FUNCTOR, hydra::detail::Backend BACKEND>
+	std::pair<GReal_t, GReal_t> AverageOn(MotherTable<N, hydra::detail::BackendPolicy<BACKEND>> const& table,
+			FUNCTOR const& functor);
+
+	/**
+	 * @brief Evaluate a list of functors  over the phase-space given a table of mother particles.
+	 * @param table hydra::MotherTable with the mother particles and the precomputed constants;
+	 * @param begin Iterator pointing to the begin of list of output range;
+	 * @param functors Functors;
+	 */
+	template<typename ...FUNCTOR, typename Iterator, hydra::detail::Backend BACKEND>
+	void Evaluate(MotherTable<N, hydra::detail::BackendPolicy<BACKEND>> const& table,
+			Iterator begin, FUNCTOR const& ...functors);
+
+	/**
+	 * @brief Generate a phase-space  given a table of mother particles and a output range.
+	 * The daughters are the same produced by Generate(begin, end, daughters_begin) with the
+	 * mothers stored in the table.
+	 * @param table hydra::MotherTable with the mother particles and the precomputed constants;
+	 * @param daughters_begin Iterator pointing to the begin of range of daughter particles.
+	 */
+	template<typename Iterator, hydra::detail::Backend BACKEND>
+	void Generate(MotherTable<N, hydra::detail::BackendPolicy<BACKEND>> const& table, Iterator daughters_begin);
+
 	/**
 	 * @brief Get seed of the underlying generator;
 	 * @return
@@ -257,6 +305,9 @@ private:
 
 	inline bool EnergyChecker( Vector4R const& mother) const;
 
+	template<hydra::detail::Backend BACKEND>
+	inline bool TableChecker( MotherTable<N, hydra::detail::BackendPolicy<BACKEND>> const& table) const;
+
 
 
 	size_t  fSeed;///< seed.
@@ -33,9 +33,11 @@
 #include <hydra/detail/BackendPolicy.h>
 #include <hydra/Types.h>
 #include <hydra/detail/Integrator.h>
+#include <hydra/PhaseSpace.h>
 
 #include <hydra/detail/Print.h>
 #include <tuple>
+#include <chrono>
 
 namespace hydra {
 
@@ -60,18 +62,33 @@ public:
 	//tag
 	typedef void hydra_integrator_tag;
 
+	//maximum number of batches of the adaptive mode, if no other limit is set
+	enum { DefaultMaxBatches = 1000 };
+
 
 	PhaseSpaceIntegrator(const GReal_t motherMass, const GReal_t (&daughtersMasses)[N], size_t n):
 		fGenerator( daughtersMasses),
 		fMother(motherMass,0,0,0),
-		fNSamples(n)
+		fNSamples(n),
+		fSampling(PlainSampling),
+		fTolerance(0.0),
+		fMaxTime(0.0),
+		fMaxSamples(0),
+		fMaxBatches(DefaultMaxBatches),
+		fNSamplesUsed(0)
 	{}
 
 
 	PhaseSpaceIntegrator(const GReal_t motherMass, std::array<GReal_t,N> const& daughtersMasses, size_t n):
 		fGenerator(daughtersMasses),
 		fMother(motherMass,0,0,0),
-		fNSamples(n)
+		fNSamples(n),
+		fSampling(PlainSampling),
+		fTolerance(0.0),
+		fMaxTime(0.0),
+		fMaxSamples(0),
+		fMaxBatches(DefaultMaxBatches),
+		fNSamplesUsed(0)
 	{}
 
 
@@ -79,20 +96,38 @@ public:
 	PhaseSpaceIntegrator(const GReal_t motherMass, std::initializer_list<GReal_t> const& daughtersMasses, size_t n):
 		fGenerator(daughtersMasses),
 		fMother(motherMass,0,0,0),
-		fNSamples(n)
+		fNSamples(n),
+		fSampling(PlainSampling),
+		fTolerance(0.0),
+		fMaxTime(0.0),
+		fMaxSamples(0),
+		fMaxBatches(DefaultMaxBatches),
+		fNSamplesUsed(0)
 	{}
 
 	PhaseSpaceIntegrator( PhaseSpaceIntegrator<N,hydra::detail::BackendPolicy<BACKEND>, GRND>const& other):
 		fGenerator( other.GetGenerator()),
 		fMother( other. GetMother()  ),
-		fNSamples(other.GetNSamples())
+		fNSamples(other.GetNSamples()),
+		fSampling(other.GetSampling()),
+		fTolerance(other.GetTolerance()),
+		fMaxTime(other.GetMaxTime()),
+		fMaxSamples(other.GetMaxSamples()),
+		fMaxBatches(other.GetMaxBatches()),
+		fNSamplesUsed(other.GetNSamplesUsed())
 	{}
 
 	template < hydra::detail::Backend BACKEND2,  typename GRND2>
 	PhaseSpaceIntegrator( PhaseSpaceIntegrator<N,hydra::detail::BackendPolicy<BACKEND2>, GRND2>const& other):
 	fGenerator( other.GetGenerator()),
 	fMother( other. GetMother()  ),
-	fNSamples(other.GetNSamples())
+	fNSamples(other.GetNSamples()),
+	fSampling(other.GetSampling()),
+	fTolerance(other.GetTolerance()),
+	fMaxTime(other.GetMaxTime()),
+	fMaxSamples(other.GetMaxSamples()),
+	fMaxBatches(other.GetMaxBatches()),
+	fNSamplesUsed(other.GetNSamplesUsed())
 	{}
 
 	PhaseSpaceIntegrator<N,hydra::detail::BackendPolicy<BACKEND>, GRND>&
@@ -103,6 +138,12 @@ public:
 		fGenerator = other.GetGenerator() ;
 		fMother      =  other. GetMother()  ;
 		fNSamples  = other.GetNSamples() ;
+		fSampling  = other.GetSampling() ;
+		fTolerance = other.GetTolerance() ;
+		fMaxTime   = other.GetMaxTime() ;
+		fMaxSamples   = other.GetMaxSamples() ;
+		fMaxBatches   = other.GetMaxBatches() ;
+		fNSamplesUsed = other.GetNSamplesUsed() ;
 
 		return *this;
 	}
@@ -116,6 +157,12 @@ public:
 		fGenerator = other.GetGenerator() ;
 		fMother =  other. GetMother()  ;
 		fNSamples  = other.GetNSamples() ;
+		fSampling  = other.GetSampling() ;
+		fTolerance = other.GetTolerance() ;
+		fMaxTime   = other.GetMaxTime() ;
+		fMaxSamples   = other.GetMaxSamples() ;
+		fMaxBatches   = other.GetMaxBatches() ;
+		fNSamplesUsed = other.GetNSamplesUsed() ;
 
 		return *this;
 	}
@@ -149,14 +196,91 @@ public:
 		fNSamples = nSamples;
 	}
 
+	PhaseSpaceSampling GetSampling() const {
+		return fSampling;
+	}
+
+	/**
+	 * @brief Set the sampling strategy, see hydra::PhaseSpaceSampling. For all choices
+	 * the integration returns the mean and its standard error.
+	 */
+	void SetSampling(PhaseSpaceSampling sampling) {
+		fSampling = sampling;
+	}
+
+	GReal_t GetTolerance() const {
+		return fTolerance;
+	}
+
+	/**
+	 * @brief Enable the adaptive mode. The integration proceeds in batches of GetNSamples() events,
+	 * until the relative error of the result goes below the tolerance, the time budget
+	 * runs out or GetMaxSamples() events are generated. A tolerance <= 0 disables the adaptive mode.
+	 * @param tolerance requested relative error.
+	 */
+	void SetTolerance(GReal_t tolerance) {
+		fTolerance = tolerance;
+	}
+
+	GReal_t GetMaxTime() const {
+		return fMaxTime;
+	}
+
+	/**
+	 * @brief Time budget of the adaptive mode in milliseconds. Zero means no limit.
+	 */
+	void SetMaxTime(GReal_t maxTime) {
+		fMaxTime = maxTime;
+	}
+
+	size_t GetMaxSamples() const {
+		return fMaxSamples;
+	}
+
+	/**
+	 * @brief Maximum number of events generated in adaptive mode. Zero means no limit.
+	 */
+	void SetMaxSamples(size_t maxSamples) {
+		fMaxSamples = maxSamples;
+	}
+
+	size_t GetMaxBatches() const {
+		return fMaxBatches;
+	}
+
+	/**
+	 * @brief Maximum number of batches of GetNSamples() events generated in adaptive mode
+	 * when neither GetMaxSamples() nor GetMaxTime() sets a limit, DefaultMaxBatches by default.
+	 */
+	void SetMaxBatches(size_t maxBatches) {
+		fMaxBatches = maxBatches;
+	}
+
+	/**
+	 * @brief Number of events used in the last integration.
+	 */
+	size_t GetNSamplesUsed() const {
+		return fNSamplesUsed;
+	}
+
 	template<typename FUNCTOR>
 	std::pair<GReal_t, GReal_t> Integrate(FUNCTOR const& functor);
 
 private:
 
+	template<typename FUNCTOR>
+	std::pair<GReal_t, GReal_t> IntegrateAdaptive(FUNCTOR const& functor);
+
+
 	PhaseSpace<N,GRND> fGenerator;
 	Vector4R  fMother;
 	size_t fNSamples;
+	PhaseSpaceSampling fSampling;
+	GReal_t fTolerance;
+	GReal_t fMaxTime;
+	size_t  fMaxSamples;
+	size_t  fMaxBatches;
+	size_t  fNSamplesUsed;
 
 };
 
@@ -38,6 +38,7 @@
 #include <hydra/Types.h>
 #include <hydra/detail/external/thrust/device_vector.h>
 #include <hydra/detail/external/thrust/transform_reduce.h>
+#include <hydra/detail/Integrator.h>
 #include <hydra/PlainState.h>
 #include <hydra/detail/functors/ProcessCallsPlain.h>
 #include <utility>
@@ -195,6 +196,29 @@ public:
 	template<typename FUNCTOR>
 	inline std::pair<GReal_t, GReal_t>  Integrate(FUNCTOR const& fFunctor );
 
+	/**
+	 * @brief Integrate several functors in a single pass over the same sample points.
+	 * GetResult() and GetAbsError() refer to the first functor afterwards.
+	 * @param fFunctors hydra::tuple of functors (integrands).
+	 * @return std::vector with the integration result and error of each functor.
+	 */
+	template<typename ...FUNCTORS>
+	inline std::vector<std::pair<GReal_t, GReal_t>>
+	Integrate(HYDRA_EXTERNAL_NS::thrust::tuple<FUNCTORS...> const& fFunctors );
+
+	/**
+	 * @brief Integrate a functor and its derivatives with respect to its parameters in the same pass.
+	 * The functor must implement
+	 * `template<typename T> GReal_t ParameterGradient(unsigned int n, T* x, GReal_t* gradient) const`,
+	 * returning its value at x and filling gradient[0..parameter_count).
+	 * @param fFunctor functor (integrand).
+	 * @param gradient resized to FUNCTOR::parameter_count, receives the integrals of the derivatives and their errors.
+	 * @return std::pair<GReal_t, GReal_t> with the integration result and error.
+	 */
+	template<typename FUNCTOR>
+	inline std::pair<GReal_t, GReal_t>
+	Integrate(FUNCTOR const& fFunctor, std::vector<std::pair<GReal_t, GReal_t>>& gradient );
+
 	/**
 	 * @brief Get the absolute error of integration.
 	 * @return error of integration.
@@ -281,6 +305,12 @@ public:
 
 private:
 
+	/*
+	 * Integrate the K values of a detail::MultiEvaluator.
+	 */
+	template<typename EVALUATOR>
+	inline std::vector<std::pair<GReal_t, GReal_t>> IntegrateMulti(EVALUATOR const& evaluator );
+
 	size_t  fSeed;
 	size_t  fNCalls;
 	GReal_t fResult;
@@ -0,0 +1,272 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * QuasiMC.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef QUASIMC_H_
+#define QUASIMC_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/BackendPolicy.h>
+#include <hydra/Types.h>
+#include <hydra/detail/Integrator.h>
+#include <hydra/detail/SobolDirections.h>
+#include <hydra/detail/functors/ProcessCallsQuasiMC.h>
+#include <hydra/detail/external/thrust/transform_reduce.h>
+#include <hydra/detail/external/thrust/functional.h>
+#include <hydra/detail/external/thrust/iterator/counting_iterator.h>
+#include <hydra/detail/external/thrust/random.h>
+
+#include <array>
+#include <vector>
+#include <utility>
+#include <assert.h>
+
+namespace hydra {
+
+template<size_t N, typename BACKEND, typename GRND=HYDRA_EXTERNAL_NS::thrust::random::default_random_engine>
+class QuasiMC;
+
+/**
+ * \ingroup numerical_integration
+ *
+ * \brief This class implements randomized quasi-Monte Carlo integration with scrambled Sobol points.
+ *
+ * The calls are split in R replicas of \f$n = calls/R\f$ points. Each replica uses the first
+ * \f$n\f$ points of the Sobol sequence (Joe-Kuo direction numbers), randomized with an
+ * independent linear matrix scrambling and digital shift. Each replica provides an unbiased
+ * estimate \f$E_r\f$ of the integral and the result is their average,
+ * \f[ E = \frac{1}{R}\sum_r E_r, \qquad \sigma^2(E) = \frac{1}{R(R-1)}\sum_r (E_r - E)^2. \f]
+ * For smooth integrands the error decreases close to \f$1/n\f$, instead of the \f$1/\sqrt{n}\f$
+ * of hydra::Plain. The best convergence is obtained when \f$n\f$ is a power of two.
+ *
+ * The points are calculated directly from the bits of their index, without Gray code recursion,
+ * so each call is independent and evaluated in parallel on the backend.
+ * At most hydra::detail::SOBOL_MAX_DIMENSIONS dimensions and \f$2^{32}\f$ points per replica are supported.
+ */
+template<size_t N, hydra::detail::Backend BACKEND, typename GRND>
+class QuasiMC<N, hydra::detail::BackendPolicy<BACKEND>, GRND>:
+public Integrator<QuasiMC<N,hydra::detail::BackendPolicy<BACKEND>,GRND>>
+{
+	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
+	typedef typename system_t::template container<GReal_t> vector_t;
+	typedef typename system_t::template container<GUInt_t> uvector_t;
+
+	static_assert(N>0 && N <= hydra::detail::SOBOL_MAX_DIMENSIONS,
+			"[Hydra::QuasiMC] : number of dimensions not supported by the Sobol sequence.");
+
+public:
+
+	QuasiMC()=delete;
+
+	/**
+	 * @brief Constructor for randomized quasi-Monte Carlo numerical integration.
+	 * @param LowLim  is std::array<GReal_t,N> with the lower limits of the integration region.
+	 * @param UpLim std::array<GReal_t,N>  with the upper limits of the integration region.
+	 * @param calls Total number of calls, shared between the replicas.
+	 * @param seed Seed of the scrambling.
+	 * @param replicas Number of independent scramblings (at least 2).
+	 */
+	QuasiMC( std::array<GReal_t,N> const& LowLim, std::array<GReal_t,N> const& UpLim,
+			size_t calls, size_t seed=159753456852, size_t replicas=16):
+				fSeed(seed),
+				fNCalls(calls),
+				fNReplicas(replicas),
+				fResult(0),
+				fAbsError(0),
+				fVolume(1.0)
+	{
+		assert(replicas > 1 && "HYDRA MESSAGE: QuasiMC needs at least two replicas");
+
+		for(size_t i=0; i<N; i++)
+		{
+			fDeltaX.push_back( -LowLim[i] + UpLim[i]);
+			fXLow.push_back( LowLim[i]);
+			fVolume *= (-LowLim[i] + UpLim[i]);
+		}
+	}
+
+	/**
+	 * @brief Constructor for randomized quasi-Monte Carlo numerical integration.
+	 * @param LowLim  array with the lower limits of the integration region.
+	 * @param UpLim array with the upper limits of the integration region.
+	 * @param calls Total number of calls, shared between the replicas.
+	 * @param seed Seed of the scrambling.
+	 * @param replicas Number of independent scramblings (at least 2).
+	 */
+	QuasiMC( const double LowLim[N] , const double  UpLim[N], size_t calls,
+			size_t seed=159753456852, size_t replicas=16):
+				fSeed(seed),
+				fNCalls(calls),
+				fNReplicas(replicas),
+				fResult(0),
+				fAbsError(0),
+				fVolume(1.0)
+	{
+		assert(replicas > 1 && "HYDRA MESSAGE: QuasiMC needs at least two replicas");
+
+		for(size_t i=0; i<N; i++)
+		{
+			fDeltaX.push_back( -LowLim[i] + UpLim[i]);
+			fXLow.push_back( LowLim[i]);
+			fVolume *= (-LowLim[i] + UpLim[i]);
+		}
+	}
+
+	QuasiMC( QuasiMC<N, hydra::detail::BackendPolicy<BACKEND>, GRND> const& other):
+		fSeed(other.GetSeed() ),
+		fNCalls(other.GetNCalls()),
+		fNReplicas(other.GetNReplicas()),
+		fResult(other.GetResult()),
+		fAbsError(other.GetAbsError() ),
+		fVolume(other.GetVolume()),
+		fDeltaX(other.GetDeltaX()),
+		fXLow(other.GetXLow())
+	{ }
+
+	template<hydra::detail::Backend BACKEND2>
+	QuasiMC( QuasiMC<N, hydra::detail::BackendPolicy<BACKEND2>, GRND> const& other):
+		fSeed(other.GetSeed() ),
+		fNCalls(other.GetNCalls()),
+		fNReplicas(other.GetNReplicas()),
+		fResult(other.GetResult()),
+		fAbsError(other.GetAbsError() ),
+		fVolume(other.GetVolume()),
+		fDeltaX(other.GetDeltaX()),
+		fXLow(other.GetXLow())
+	{ }
+
+	QuasiMC<N, hydra::detail::BackendPolicy<BACKEND>, GRND>&
+	operator=( QuasiMC<N, hydra::detail::BackendPolicy<BACKEND>, GRND> const& other)
+	{
+		if( this==&other) return *this;
+
+		this->fSeed      = other.GetSeed() ;
+		this->fNCalls    = other.GetNCalls();
+		this->fNReplicas = other.GetNReplicas();
+		this->fResult    = other.GetResult();
+		this->fAbsError  = other.GetAbsError() ;
+		this->fVolume    = other.GetVolume();
+		this->fDeltaX    = other.GetDeltaX();
+		this->fXLow      = other.GetXLow();
+
+		return *this;
+	}
+
+	template<hydra::detail::Backend BACKEND2>
+	QuasiMC<N, hydra::detail::BackendPolicy<BACKEND>, GRND>&
+	operator=( QuasiMC<N, hydra::detail::BackendPolicy<BACKEND2>, GRND> const& other)
+	{
+		this->fSeed      = other.GetSeed() ;
+		this->fNCalls    = other.GetNCalls();
+		this->fNReplicas = other.GetNReplicas();
+		this->fResult    = other.GetResult();
+		this->fAbsError  = other.GetAbsError() ;
+		this->fVolume    = other.GetVolume();
+		this->fDeltaX    = other.GetDeltaX();
+		this->fXLow      = other.GetXLow();
+
+		return *this;
+	}
+
+	/**
+	 * @brief This method performs the actual integration.
+	 * @param fFunctor functor (integrand).
+	 * @return std::pair<GReal_t, GReal_t> with the integration result and error.
+	 */
+	template<typename FUNCTOR>
+	inline std::pair<GReal_t, GReal_t>  Integrate(FUNCTOR const& fFunctor );
+
+	inline GReal_t GetAbsError() const {
+		return fAbsError;
+	}
+
+	inline GReal_t GetResult() const {
+		return fResult;
+	}
+
+	inline const vector_t& GetDeltaX() const {
+		return fDeltaX;
+	}
+
+	inline const vector_t& GetXLow() const {
+		return fXLow;
+	}
+
+	inline GReal_t GetVolume() const {
+		return fVolume;
+	}
+
+	inline size_t GetNCalls() const {
+		return fNCalls;
+	}
+
+	inline void SetNCalls(size_t nCalls) {
+		fNCalls = nCalls;
+	}
+
+	inline size_t GetNReplicas() const {
+		return fNReplicas;
+	}
+
+	inline void SetNReplicas(size_t nReplicas) {
+
+		assert(nReplicas > 1 && "HYDRA MESSAGE: QuasiMC needs at least two replicas");
+		fNReplicas = nReplicas;
+	}
+
+	inline size_t GetSeed() const {
+		return fSeed;
+	}
+
+	inline void SetSeed(const size_t& seed) {
+		fSeed = seed;
+	}
+
+private:
+
+	/*
+	 * Draw the scrambled direction numbers and the digital shifts of all replicas.
+	 */
+	void GenerateScrambling(std::vector<GUInt_t>& generators) const;
+
+	size_t  fSeed;
+	size_t  fNCalls;
+	size_t  fNReplicas;
+	GReal_t fResult;
+	GReal_t fAbsError;
+	GReal_t fVolume;
+	vector_t fDeltaX;
+	vector_t fXLow;
+	uvector_t fGenerators;
+
+};
+
+}  // namespace hydra
+
+#include <hydra/detail/QuasiMC.inl>
+
+#endif /* QUASIMC_H_ */
@@ -0,0 +1,380 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * ReducedPrecision.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+/**
+ * \file
+ * \ingroup generic
+ */
+
+#ifndef REDUCEDPRECISION_H_
+#define REDUCEDPRECISION_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/utility/Generic.h>
+#include <hydra/detail/external/thrust/tuple.h>
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <stdexcept>
+
+namespace hydra {
+
+/**
+ * \ingroup generic
+ *
+ * \brief Storage of a column in a narrower floating point type (e.g. `float`), read as `double`.
+ *
+ * The codecs of this file describe how the values of a column are stored. Used with hydra::Decoder, as the
+ * caster of the iterators of a hydra::multivector (e.g. `data.begin(decoder)`), they give the values of the
+ * columns as `double` to the functors, while the containers keep the narrower types. The computations and
+ * the accumulations (e.g. in hydra::LogLikelihoodFCN or hydra::DenseHistogram) are performed in `double`,
+ * and the memory traffic is reduced to the size of the stored types.
+ */
+template<typename Storage=float>
+struct ReducedPrecision
+{
+	static_assert(std::is_floating_point<Storage>::value,
+			"[Hydra::ReducedPrecision] : the storage type must be a floating point type.");
+
+	typedef Storage storage_type;
+	typedef double  value_type;
+
+	//constructor
+	ReducedPrecision() = default;
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	ReducedPrecision(ReducedPrecision<Storage> const&){}
+
+	__hydra_host__ __hydra_device__ inline
+	ReducedPrecision<Storage>& operator=(ReducedPrecision<Storage> const&){ return *this; }
+
+	/**
+	 * Stored value of x.
+	 */
+	__hydra_host__ __hydra_device__ inline
+	storage_type Encode(value_type x) const
+	{
+		return static_cast<storage_type>(x);
+	}
+
+	/**
+	 * Value represented by the stored value q.
+	 */
+	__hydra_host__ __hydra_device__ inline
+	value_type Decode(storage_type q) const
+	{
+		return static_cast<value_type>(q);
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	value_type operator()(storage_type q) const
+	{
+		return Decode(q);
+	}
+};
+
+/**
+ * \ingroup generic
+ *
+ * \brief Storage of a column in fixed point, in an integer type (by default 16 bits),
+ * with a scale and an offset: x = offset + scale*q.
+ *
+ * Values outside of the representable range, [offset + scale*min(Integer), offset + scale*max(Integer)],
+ * are stored as the closest limit, and NaN as the lower one. The resolution of the column is the scale. hydra::make_fixed_point
+ * returns the codec spreading the integers over a given range.
+ */
+template<typename Integer=uint16_t>
+class FixedPoint
+{
+	static_assert(std::is_integral<Integer>::value,
+			"[Hydra::FixedPoint] : the storage type must be an integral type.");
+
+public:
+
+	typedef Integer storage_type;
+	typedef double  value_type;
+
+	//constructor
+	FixedPoint() = delete;
+
+	FixedPoint(double scale, double offset):
+		fScale(scale),
+		fOffset(offset)
+	{
+		if( !(scale > 0.0) )
+			throw std::invalid_argument("[Hydra::FixedPoint] : the scale must be positive.");
+	}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	FixedPoint(FixedPoint<Integer> const& other):
+		fScale(other.GetScale()),
+		fOffset(other.GetOffset())
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	FixedPoint<Integer>& operator=(FixedPoint<Integer> const& other)
+	{
+		if(this==&other) return *this;
+
+		fScale  = other.GetScale();
+		fOffset = other.GetOffset();
+
+		return *this;
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	double GetScale() const
+	{
+		return fScale;
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	double GetOffset() const
+	{
+		return fOffset;
+	}
+
+	/**
+	 * Stored value of x, rounded to the closest representable value.
+	 */
+	__hydra_host__ __hydra_device__ inline
+	storage_type Encode(value_type x) const
+	{
+		const double qmin = static_cast<double>(std::numeric_limits<Integer>::min());
+		const double qmax = static_cast<double>(std::numeric_limits<Integer>::max());
+
+		double q = (x - fOffset)/fScale;
+
+		//NaN fails both comparisons and is stored as the lower limit
+		q = q > qmax ? qmax : q;
+		q = q >= qmin ? q : qmin;
+
+		return static_cast<storage_type>( q < 0.0 ? q - 0.5 : q + 0.5 );
+	}
+
+	/**
+	 * Value represented by the stored value q.
+	 */
+	__hydra_host__ __hydra_device__ inline
+	value_type Decode(storage_type q) const
+	{
+		return fOffset + fScale*static_cast<double>(q);
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	value_type operator()(storage_type q) const
+	{
+		return Decode(q);
+	}
+
+private:
+
+	double fScale;
+	double fOffset;
+};
+
+/**
+ * \ingroup generic
+ *
+ * Fixed point codec spreading the values of Integer over the range [min, max].
+ */
+template<typename Integer=uint16_t>
+inline FixedPoint<Integer> make_fixed_point(double min, double max)
+{
+	if( !(max > min) )
+		throw std::invalid_argument("[Hydra::make_fixed_point] : the upper limit must be greater than the lower limit.");
+
+	const double qmin = static_cast<double>(std::numeric_limits<Integer>::min());
+	const double qmax = static_cast<double>(std::numeric_limits<Integer>::max());
+
+	double scale = (max - min)/(qmax - qmin);
+
+	return FixedPoint<Integer>(scale, min - scale*qmin);
+}
+
+/**
+ * \ingroup generic
+ *
+ * \brief Caster decoding the rows of a table, stored with the codecs Codecs..., to tuples of `double`.
+ *
+ * Usage, with a hydra::multivector `data` of columns `hydra::tuple<uint16_t, float>`:
+ * \code{.cpp}
+ * auto decoder = hydra::make_decoder( hydra::make_fixed_point(-5.0, 5.0), hydra::ReducedPrecision<float>() );
+ * auto fcn = hydra::make_loglikehood_fcn(model, data.begin(decoder), data.end(decoder));
+ * \endcode
+ */
+template<typename ...Codecs>
+class Decoder
+{
+
+public:
+
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<typename Codecs::storage_type...> storage_type;
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<typename Codecs::value_type...>   value_type;
+
+	//constructor
+	Decoder() = delete;
+
+	Decoder(Codecs const& ...codecs):
+		fCodecs(codecs...)
+	{}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	Decoder(Decoder<Codecs...> const& other):
+		fCodecs(other.GetCodecs())
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	Decoder<Codecs...>& operator=(Decoder<Codecs...> const& other)
+	{
+		if(this==&other) return *this;
+
+		fCodecs = other.GetCodecs();
+
+		return *this;
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	HYDRA_EXTERNAL_NS::thrust::tuple<Codecs...> const& GetCodecs() const
+	{
+		return fCodecs;
+	}
+
+	template<typename Tuple>
+	__hydra_host__ __hydra_device__ inline
+	value_type operator()(Tuple const& row) const
+	{
+		return decode(row, detail::make_index_sequence<sizeof...(Codecs)>{});
+	}
+
+private:
+
+	template<typename Tuple, size_t ...I>
+	__hydra_host__ __hydra_device__ inline
+	value_type decode(Tuple const& row, detail::index_sequence<I...>) const
+	{
+		return value_type( HYDRA_EXTERNAL_NS::thrust::get<I>(fCodecs).Decode(
+				static_cast<typename Codecs::storage_type>(HYDRA_EXTERNAL_NS::thrust::get<I>(row)))... );
+	}
+
+	HYDRA_EXTERNAL_NS::thrust::tuple<Codecs...> fCodecs;
+};
+
+/**
+ * \ingroup generic
+ *
+ * \brief Functor encoding rows of values to the storage types of the codecs Codecs..., e.g. to fill
+ * a hydra::multivector: `hydra::copy` or `thrust::transform(input.begin(), input.end(), data.begin(), encoder)`.
+ */
+template<typename ...Codecs>
+class Encoder
+{
+
+public:
+
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<typename Codecs::storage_type...> storage_type;
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<typename Codecs::value_type...>   value_type;
+
+	//constructor
+	Encoder() = delete;
+
+	Encoder(Codecs const& ...codecs):
+		fCodecs(codecs...)
+	{}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	Encoder(Encoder<Codecs...> const& other):
+		fCodecs(other.GetCodecs())
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	Encoder<Codecs...>& operator=(Encoder<Codecs...> const& other)
+	{
+		if(this==&other) return *this;
+
+		fCodecs = other.GetCodecs();
+
+		return *this;
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	HYDRA_EXTERNAL_NS::thrust::tuple<Codecs...> const& GetCodecs() const
+	{
+		return fCodecs;
+	}
+
+	template<typename Tuple>
+	__hydra_host__ __hydra_device__ inline
+	storage_type operator()(Tuple const& row) const
+	{
+		return encode(row, detail::make_index_sequence<sizeof...(Codecs)>{});
+	}
+
+private:
+
+	template<typename Tuple, size_t ...I>
+	__hydra_host__ __hydra_device__ inline
+	storage_type encode(Tuple const& row, detail::index_sequence<I...>) const
+	{
+		return storage_type( HYDRA_EXTERNAL_NS::thrust::get<I>(fCodecs).Encode(
+				static_cast<typename Codecs::value_type>(HYDRA_EXTERNAL_NS::thrust::get<I>(row)))... );
+	}
+
+	HYDRA_EXTERNAL_NS::thrust::tuple<Codecs...> fCodecs;
+};
+
+/**
+ * \ingroup generic
+ *
+ * Build a hydra::Decoder, with one codec per column.
+ */
+template<typename ...Codecs>
+inline Decoder<Codecs...> make_decoder(Codecs const& ...codecs)
+{
+	return Decoder<Codecs...>(codecs...);
+}
+
+/**
+ * \ingroup generic
+ *
+ * Build a hydra::Encoder, with one codec per column.
+ */
+template<typename ...Codecs>
+inline Encoder<Codecs...> make_encoder(Codecs const& ...codecs)
+{
+	return Encoder<Codecs...>(codecs...);
+}
+
+}  // namespace hydra
+
+#endif /* REDUCEDPRECISION_H_ */
@@ -49,6 +49,9 @@
 
 namespace hydra {
 
+template<typename T, typename BACKEND>
+class ChunkedSource;
+
 template < typename PDF1,  typename PDF2, typename ...PDFs>
 class SPlot: public detail::AddPdfBase<PDF1,PDF2,PDFs...>
 {
@@ -112,6 +115,16 @@ public:
 	Generate(InputIterator in_begin, InputIterator in_end,
 			OutputIterator out_begin);
 
+	/**
+	 * Calculate the sweights of a dataset read in chunks from a hydra::ChunkedSource, in two passes over the source:
+	 * the first one accumulates the covariance matrix and the second one writes the sweights of the rows of each
+	 * chunk, starting at \p out_begin + first row of the chunk.
+	 */
+	template<typename ...T, hydra::detail::Backend BACKEND, typename OutputIterator>
+	inline HYDRA_EXTERNAL_NS::Eigen::Matrix<double, sizeof...(PDFs)+2, sizeof...(PDFs)+2>
+	Generate(ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> const& source,
+			OutputIterator out_begin);
+
 
 private:
 
@@ -39,6 +39,8 @@
 #include <hydra/detail/functors/ProcessCallsVegas.h>
 #include <hydra/detail/Integrator.h>
 #include <utility>
+#include <vector>
+#include <array>
 
 #include <hydra/detail/external/thrust/random.h>
 
@@ -57,6 +59,11 @@ class Vegas ;
  *  function |f|, so that the points are concentrated in the regions that
  *  make the largest contribution to the integral.
  *
+ *  If the mode of the hydra::VegasState is set to MODE_ADAPTIVE_STRATIFIED, the importance
+ *  sampling is combined with adaptive stratified sampling (VEGAS+, G. P. Lepage, J.Comput.Phys. 439 (2021) 110386):
+ *  after each iteration the calls are redistributed between the hypercubes
+ *  in proportion to the standard deviation of the integrand measured in each of them.
+ *
  *  *Find a more complete documentation* [here](https://www.gnu.org/software/gsl/doc/html/montecarlo.html#vegas) .
  *
  */
@@ -66,7 +73,7 @@ class Vegas<N, hydra::detail::BackendPolicy<BACKEND>, GRND >
 {
 	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
 	typedef typename system_t::template container<GReal_t>  rvector_backend;
-	typedef typename system_t::template container<GUInt_t>  uvector_backend;
+	typedef typename system_t::template container<size_t>  uvector_backend;
 
 	typedef typename rvector_backend::iterator rvector_iterator;
 	typedef typename uvector_backend::iterator uvector_iterator;
@@ -150,8 +157,49 @@ public:
 	template<typename FUNCTOR>
 	inline std::pair<GReal_t, GReal_t> Integrate(FUNCTOR const& fFunctor);
 
+	/**
+	 * @brief Integrate reusing the grid already held by the state, e.g. loaded with
+	 * VegasState::LoadState(...) or trained by a previous call, skipping the training iterations.
+	 * If the state does not hold a grid, it is equivalent to Integrate(...).
+	 */
+	template<typename FUNCTOR>
+	inline std::pair<GReal_t, GReal_t> WarmIntegrate(FUNCTOR const& fFunctor);
+
+	/**
+	 * @brief Integrate several functors in a single pass per iteration over the same calls.
+	 * The grid is trained and refined on the first functor, which also controls the convergence
+	 * of the iterations, so it should cover the support of the others (e.g. the sum of the components).
+	 * The results of each functor are averaged over the iterations with inverse variance weights.
+	 * The adaptive stratified mode is not supported, importance sampling is used instead.
+	 * @param fFunctors hydra::tuple of functors (integrands).
+	 * @return std::vector with the integration result and error of each functor.
+	 */
+	template<typename ...FUNCTORS>
+	inline std::vector<std::pair<GReal_t, GReal_t>>
+	Integrate(HYDRA_EXTERNAL_NS::thrust::tuple<FUNCTORS...> const& fFunctors);
+
+	/**
+	 * @brief Integrate a functor and its derivatives with respect to its parameters in the same pass.
+	 * The functor must implement
+	 * `template<typename T> GReal_t ParameterGradient(unsigned int n, T* x, GReal_t* gradient) const`,
+	 * returning its value at x and filling gradient[0..parameter_count).
+	 * The grid is trained and refined on the value of the functor, as by Integrate(functor).
+	 * @param fFunctor functor (integrand).
+	 * @param gradient resized to FUNCTOR::parameter_count, receives the integrals of the derivatives and their errors.
+	 * @return std::pair<GReal_t, GReal_t> with the integration result and error.
+	 */
+	template<typename FUNCTOR>
+	inline std::pair<GReal_t, GReal_t>
+	Integrate(FUNCTOR const& fFunctor, std::vector<std::pair<GReal_t, GReal_t>>& gradient);
+
 private:
 
+	/*
+	 * Integrate the K values of a detail::MultiEvaluator.
+	 */
+	template<typename EVALUATOR>
+	std::vector<std::pair<GReal_t, GReal_t>> IntegrateMulti(EVALUATOR const& evaluator);
+
 
 
 	template<typename FUNCTOR>
@@ -165,7 +213,28 @@ private:
 	void RefineGrid();
 
 	template<typename FUNCTOR>
-	void ProcessFuncionCalls(FUNCTOR const& functor, GBool_t training,GReal_t& integral, GReal_t& tss);
+	void ProcessFuncionCalls(FUNCTOR const& functor, GBool_t training,GReal_t& integral, GReal_t& variance);
+
+	template<typename FUNCTOR>
+	void ProcessFuncionCallsAdaptive(FUNCTOR const& functor, GBool_t training,GReal_t& integral, GReal_t& variance);
+
+	/*
+	 * Evaluate all values of the evaluator at the same calls and accumulate their results in fMultiSums.
+	 */
+	template<typename FUNCTORS, bool GRADIENT>
+	void ProcessFuncionCalls(detail::MultiEvaluator<FUNCTORS,GRADIENT> const& evaluator,
+			GBool_t training,GReal_t& integral, GReal_t& variance);
+
+	template<typename FUNCTORS, bool GRADIENT>
+	void ProcessFuncionCallsAdaptive(detail::MultiEvaluator<FUNCTORS,GRADIENT> const& evaluator,
+			GBool_t training,GReal_t& integral, GReal_t& variance);
+
+	/*
+	 * Sum the private copies of the grid distribution filled by the calls and store the result in the state.
+	 */
+	void MergePartialDistributions(size_t npartials, size_t nkeys);
+
+	void AllocateCalls(GBool_t training);
 
 
 	inline GReal_t GetCoordinate(const GUInt_t i, const GUInt_t j) const {
@@ -194,10 +263,18 @@ private:
 	}
 
 	VegasState<N,hydra::detail::BackendPolicy<BACKEND>> fState;
-	rvector_backend fFValInput;
-	uvector_backend fGlobalBinInput;
-	rvector_backend fFValOutput;
-	uvector_backend fGlobalBinOutput;
+	rvector_backend fPartialDistribution;
+	//adaptive stratification
+	rvector_backend fCubeSum;
+	rvector_backend fCubeSum2;
+	uvector_backend fEdgeKey;
+	rvector_backend fEdgeSum;
+	rvector_backend fEdgeSum2;
+	uvector_backend fEdgeKeyOutput;
+	rvector_backend fEdgeSumOutput;
+	//multiple integrands: {sum of I/var, sum of 1/var, sum of I} per functor and number of iterations
+	std::vector<std::array<GReal_t,3>> fMultiSums;
+	size_t fMultiIterations;
 };
 
 }
@@ -37,8 +37,11 @@
 #include <hydra/detail/BackendPolicy.h>
 #include <hydra/Containers.h>
 #include <hydra/Types.h>
+#include <hydra/detail/Print.h>
 
 #include <vector>
+#include <string>
+#include <fstream>
 #include <hydra/detail/external/thrust/copy.h>
 #include <chrono>
 
@@ -47,6 +50,7 @@ namespace hydra {
 
 enum {
 
+	MODE_ADAPTIVE_STRATIFIED = 2,
 	MODE_IMPORTANCE = 1,
 	MODE_IMPORTANCE_ONLY = 0,
 	MODE_STRATIFIED = -1,
@@ -76,7 +80,7 @@ class VegasState<N, hydra::detail::BackendPolicy<BACKEND>>
 {
 	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
 	typedef typename system_t::template container<GReal_t>  rvector_backend;
-	typedef typename system_t::template container<GUInt_t>  uvector_backend;
+	typedef typename system_t::template container<size_t>  uvector_backend;
 	typedef typename std::vector<GReal_t>        rvector_std;
 
 	typedef typename rvector_backend::iterator rvector_iterator;
@@ -136,10 +140,45 @@ public:
      */
 	void ClearStoredIterations();
 
+	/**
+	 * @brief Write the state, including the trained grid, to a binary file.
+	 *
+	 * The file starts with a version tag, the number of dimensions and the number of bins
+	 * of the grid, followed by the limits, the control parameters, the grid, the weights of
+	 * the adaptive stratification and the results of the stored iterations.
+	 * @param filename name of the output file.
+	 * @return false if the file could not be written.
+	 */
+	bool SaveState(std::string const& filename) const;
+
+	/**
+	 * @brief Read a state written by SaveState(...).
+	 *
+	 * The file must have been produced with the same number of dimensions and at most
+	 * BINS_MAX bins, otherwise the state is left untouched. The loaded grid is ready to
+	 * be used by Vegas::WarmIntegrate(...), that skips the training iterations.
+	 * @param filename name of the input file.
+	 * @return false if the file could not be read or is not compatible.
+	 */
+	bool LoadState(std::string const& filename);
+
 
 	inline GReal_t GetAlpha() const { return fAlpha; }
 
 	inline void SetAlpha(GReal_t alpha)	{ fAlpha = alpha;	}
+
+	//-----------------------------
+	//Beta
+
+	/**
+	 * @brief Damping of the redistribution of calls between hypercubes in
+	 * MODE_ADAPTIVE_STRATIFIED. The calls in each hypercube are proportional to
+	 * sigma^beta, where sigma is the standard deviation measured in the hypercube
+	 * in the previous iteration. beta=0 disables the redistribution.
+	 */
+	inline GReal_t GetBeta() const { return fBeta; }
+
+	inline void SetBeta(GReal_t beta)	{ fBeta = beta;	}
 	//-----------------------------
 	//Calls
 
@@ -355,6 +394,20 @@ public:
 
 	inline void SetUseRelativeError(GBool_t useRelativeError) {fUseRelativeError = useRelativeError;	}
 
+	//----------------
+	//ScrambledSeeds
+
+	/**
+	 * The random engine of each call is seeded with the pairing of the iteration and call indices.
+	 * Consecutive calls then get nearby seeds, whose first draws from linear congruential engines
+	 * are correlated. With scrambled seeds, the pairing passes through the splitmix64 finalizer.
+	 * Disabled by default, so that the existing modes reproduce their previous results,
+	 * except in MODE_ADAPTIVE_STRATIFIED, which always uses scrambled seeds.
+	 */
+	inline GBool_t IsScrambledSeeds() const {return fScrambledSeeds;}
+
+	inline void SetScrambledSeeds(GBool_t scrambledSeeds) {fScrambledSeeds = scrambledSeeds;	}
+
 	//----------------
 	//Verbose
 
@@ -483,6 +536,20 @@ public:
 
 	void SetBackendXLow(const rvector_backend& deviceXLow) {fBackendXLow = deviceXLow;}
 
+//
+	rvector_backend& GetBackendCubeWeights() { return fBackendCubeWeights;}
+
+	const rvector_backend& GetBackendCubeWeights() const { return fBackendCubeWeights;}
+
+	void SetBackendCubeWeights(const rvector_backend& cubeWeights) {fBackendCubeWeights = cubeWeights;}
+
+//
+	uvector_backend& GetBackendCubeOffsets() { return fBackendCubeOffsets;}
+
+	const uvector_backend& GetBackendCubeOffsets() const { return fBackendCubeOffsets;}
+
+	void SetBackendCubeOffsets(const uvector_backend& cubeOffsets) {fBackendCubeOffsets = cubeOffsets;}
+
 
 
 	size_t GetTrainingCalls() const {
@@ -522,6 +589,25 @@ public:
 
 private:
 
+	/*
+	 * Binary layout written by SaveState.
+	 * Integers are stored as 64 bit and floating point numbers as double.
+	 */
+	static constexpr char   kStateTag[] = "HYDRA_VEGAS_STATE";
+	static constexpr GInt_t kStateVersion = 2;
+
+	template<typename T>
+	static void WriteValue(std::ostream& stream, T const value);
+
+	template<typename T>
+	static bool ReadValue(std::istream& stream, T& value);
+
+	template<typename T>
+	static void WriteVector(std::ostream& stream, std::vector<T> const& values);
+
+	template<typename T>
+	static bool ReadVector(std::istream& stream, std::vector<T>& values, size_t max_size);
+
 	GInt_t fVerbose;
 	std::ostream &fOStream;
 
@@ -539,6 +625,8 @@ private:
 	rvector_backend fBackendXLow;//initgrid
 	rvector_backend fBackendXi;//CopyStateToDevice
 	rvector_backend fBackendDeltaX;//initgrid
+	rvector_backend fBackendCubeWeights;//adaptive stratification: sigma^beta per hypercube
+	uvector_backend fBackendCubeOffsets;//adaptive stratification: first call of each hypercube
 
 
 	//std
@@ -563,6 +651,7 @@ private:
 	GReal_t fVolume;
 	/* control variables */
 	GReal_t fAlpha;
+	GReal_t fBeta;
 	GInt_t fMode;
 	GUInt_t fIterations;
 	GInt_t fStage;
@@ -586,6 +675,7 @@ private:
 	size_t  fTrainingCalls;
 	GReal_t fMaxError; ///< max error
 	GBool_t fUseRelativeError; ///< use relative error as convergence criteria
+	GBool_t fScrambledSeeds; ///< seeds of the calls passed through the splitmix64 finalizer
 
 };
 
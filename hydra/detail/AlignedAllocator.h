@@ -0,0 +1,182 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * AlignedAllocator.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+/**
+ * \file
+ * \ingroup generic
+ */
+
+#ifndef ALIGNEDALLOCATOR_H_
+#define ALIGNEDALLOCATOR_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/Rebind.h>
+#include <hydra/detail/external/thrust/detail/raw_pointer_cast.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <stdlib.h>
+
+/**
+ * Alignment, in bytes, of the blocks of the containers allocated with HYDRA_ALIGNED_ALLOCATION.
+ * The blocks are also padded to a multiple of it. The default covers one cache line and
+ * one AVX-512 register.
+ */
+#ifndef HYDRA_ALIGNMENT
+#define HYDRA_ALIGNMENT 64
+#endif
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * Bytes of a block of n elements of T, padded to a multiple of HYDRA_ALIGNMENT.
+ */
+template<typename T>
+inline size_t aligned_block_bytes(size_t n)
+{
+	size_t bytes = n*sizeof(T);
+
+	return bytes == 0 ? HYDRA_ALIGNMENT : ((bytes + HYDRA_ALIGNMENT - 1)/HYDRA_ALIGNMENT)*HYDRA_ALIGNMENT;
+}
+
+/**
+ * \ingroup generic
+ *
+ * \brief Allocator of blocks aligned to HYDRA_ALIGNMENT bytes and padded to a multiple of it.
+ *
+ * ALLOCATOR is the allocator of a system with plain host memory (e.g. `thrust::omp::allocator<T>`), whose
+ * pointer type is kept. The blocks are allocated with `posix_memalign` and released with `std::free`.
+ * A block of n elements can be read up to the next multiple of HYDRA_ALIGNMENT bytes, so that loops over
+ * the raw columns of a container (see hydra::ColumnSpan::padded_size) can run in full SIMD registers.
+ * The padding is not initialized.
+ *
+ * The containers of the CPP, OMP and TBB backends, and the device containers when the device system is
+ * not CUDA, use this allocator if HYDRA_ALIGNED_ALLOCATION is defined.
+ */
+template<typename ALLOCATOR>
+class AlignedAllocator: public ALLOCATOR
+{
+
+public:
+
+	typedef typename ALLOCATOR::value_type value_type;
+	typedef typename ALLOCATOR::pointer    pointer;
+	typedef typename ALLOCATOR::size_type  size_type;
+
+	template<typename U>
+	struct rebind
+	{
+		typedef AlignedAllocator<typename ALLOCATOR::template rebind<U>::other> other;
+	};
+
+	__hydra_host__ __hydra_device__
+	AlignedAllocator():
+		ALLOCATOR()
+	{}
+
+	__hydra_host__ __hydra_device__
+	AlignedAllocator(AlignedAllocator<ALLOCATOR> const& other):
+		ALLOCATOR(other)
+	{}
+
+	template<typename ALLOCATOR2>
+	__hydra_host__ __hydra_device__
+	AlignedAllocator(AlignedAllocator<ALLOCATOR2> const& other):
+		ALLOCATOR(other)
+	{}
+
+	pointer allocate(size_type n)
+	{
+		void* block = nullptr;
+
+		if( posix_memalign(&block, HYDRA_ALIGNMENT, aligned_block_bytes<value_type>(n)) != 0 )
+			throw std::bad_alloc();
+
+		return pointer(static_cast<value_type*>(block));
+	}
+
+	void deallocate(pointer block, size_type)
+	{
+		std::free(HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(block));
+	}
+};
+
+/*
+ * Memory resource of the aligned allocators (see hydra::detail::is_rebindable). The blocks
+ * are released with std::free as the ones of std::malloc, but these are not padded.
+ */
+struct host_aligned_resource{};
+
+template<typename ALLOCATOR>
+host_aligned_resource memory_resource_of(AlignedAllocator<ALLOCATOR> const*);
+
+/*
+ * The allocator ALLOCATOR, wrapped in AlignedAllocator if HYDRA_ALIGNED_ALLOCATION is defined.
+ */
+#ifdef HYDRA_ALIGNED_ALLOCATION
+template<typename ALLOCATOR>
+using aligned_allocator_t = AlignedAllocator<ALLOCATOR>;
+#else
+template<typename ALLOCATOR>
+using aligned_allocator_t = ALLOCATOR;
+#endif
+
+/*
+ * True if the blocks of Allocator, including the allocators deriving from
+ * AlignedAllocator (e.g. FirstTouchAllocator<AlignedAllocator<A>>), are padded.
+ */
+template<typename Allocator>
+struct is_padded_allocator: std::is_same<
+	typename memory_resource<Allocator>::type, host_aligned_resource>{};
+
+/*
+ * Number of elements of T that can be read in a block of n elements of Allocator.
+ */
+template<typename T, typename Allocator>
+inline typename std::enable_if<is_padded_allocator<Allocator>::value, size_t>::type
+padded_size(size_t n)
+{
+	return n == 0 ? 0 : aligned_block_bytes<T>(n)/sizeof(T);
+}
+
+template<typename T, typename Allocator>
+inline typename std::enable_if<!is_padded_allocator<Allocator>::value, size_t>::type
+padded_size(size_t n)
+{
+	return n;
+}
+
+}  // namespace detail
+
+}  // namespace hydra
+
+#endif /* ALIGNEDALLOCATOR_H_ */
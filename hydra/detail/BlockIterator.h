@@ -0,0 +1,163 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * BlockIterator.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef BLOCKITERATOR_H_
+#define BLOCKITERATOR_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/Rebind.h>
+#include <hydra/detail/external/thrust/iterator/iterator_facade.h>
+#include <hydra/detail/external/thrust/iterator/iterator_categories.h>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * Random access iterator over one column of a sequence of blocks of Stride bytes,
+ * each holding W consecutive values of the column, starting at the address fBase
+ * in the first block. The element i is the value i%W of the block i/W.
+ */
+template<typename T, size_t W, size_t Stride, typename System>
+class BlockIterator: public HYDRA_EXTERNAL_NS::thrust::iterator_facade<
+		BlockIterator<T, W, Stride, System>,
+		typename std::remove_const<T>::type,
+		System,
+		HYDRA_EXTERNAL_NS::thrust::random_access_traversal_tag,
+		T&,
+		std::ptrdiff_t>
+{
+	typedef typename std::conditional<std::is_const<T>::value,
+			const unsigned char, unsigned char>::type byte_type;
+
+public:
+
+	__hydra_host__ __hydra_device__
+	BlockIterator():
+		fBase(nullptr),
+		fIndex(0)
+	{}
+
+	__hydra_host__ __hydra_device__
+	BlockIterator(byte_type* base, std::ptrdiff_t index):
+		fBase(base),
+		fIndex(index)
+	{}
+
+	//copy, including the conversion to the iterator over constant values
+	template<typename T2, typename = typename std::enable_if<
+		std::is_convertible<T2*, T*>::value>::type>
+	__hydra_host__ __hydra_device__
+	BlockIterator(BlockIterator<T2, W, Stride, System> const& other):
+		fBase(other.GetBase()),
+		fIndex(other.GetIndex())
+	{}
+
+	__hydra_host__ __hydra_device__
+	byte_type* GetBase() const
+	{
+		return fBase;
+	}
+
+	__hydra_host__ __hydra_device__
+	std::ptrdiff_t GetIndex() const
+	{
+		return fIndex;
+	}
+
+private:
+
+	friend class HYDRA_EXTERNAL_NS::thrust::iterator_core_access;
+
+	__hydra_host__ __hydra_device__ inline
+	T& dereference() const
+	{
+		const size_t i = static_cast<size_t>(fIndex);
+
+		return *reinterpret_cast<T*>(fBase + (i/W)*Stride + (i%W)*sizeof(T));
+	}
+
+	template<typename T2>
+	__hydra_host__ __hydra_device__ inline
+	bool equal(BlockIterator<T2, W, Stride, System> const& other) const
+	{
+		return fBase == other.GetBase() && fIndex == other.GetIndex();
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	void increment()
+	{
+		++fIndex;
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	void decrement()
+	{
+		--fIndex;
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	void advance(std::ptrdiff_t n)
+	{
+		fIndex += n;
+	}
+
+	template<typename T2>
+	__hydra_host__ __hydra_device__ inline
+	std::ptrdiff_t distance_to(BlockIterator<T2, W, Stride, System> const& other) const
+	{
+		return other.GetIndex() - fIndex;
+	}
+
+	byte_type*     fBase;
+	std::ptrdiff_t fIndex;
+};
+
+/*
+ * Rebinding of block iterators over host memory to the iterators of another backend.
+ */
+template<typename T, size_t W, size_t Stride, typename System>
+struct RebindIterator< BlockIterator<T, W, Stride, System> >
+{
+	typedef BlockIterator<T, W, Stride, System> iterator_type;
+
+	template<typename T2, typename System2>
+	static iterator_type convert(BlockIterator<T2, W, Stride, System2> const& source)
+	{
+		return iterator_type(source.GetBase(), source.GetIndex());
+	}
+};
+
+}  // namespace detail
+
+}  // namespace hydra
+
+#endif /* BLOCKITERATOR_H_ */
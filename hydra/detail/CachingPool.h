@@ -0,0 +1,344 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * CachingPool.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+/**
+ * \file
+ * \ingroup policy
+ */
+
+#ifndef CACHINGPOOL_H_
+#define CACHINGPOOL_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/external/thrust/memory.h>
+#include <hydra/detail/external/thrust/pair.h>
+
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+#include <mutex>
+#include <new>
+#include <exception>
+
+/**
+ * Default maximum number of bytes kept by the caching pool of each backend (1 GiB).
+ */
+#ifndef HYDRA_CACHING_POOL_MAX_BYTES
+#define HYDRA_CACHING_POOL_MAX_BYTES (size_t(1) << 30)
+#endif
+
+namespace hydra {
+
+namespace detail {
+
+/**
+ * \ingroup policy
+ *
+ * \brief Caching allocator for the temporary buffers of one thrust system (e.g. thrust::system::omp::tag).
+ *
+ * Blocks are rounded up to size classes, four per power of two (at most 25% of padding),
+ * and returned blocks are kept in free lists of their size class for the next request,
+ * avoiding the allocation, page faults and, on CUDA, the synchronization of each call.
+ * The bytes kept in the free lists never exceed the high-water mark GetMaxCachedBytes(),
+ * blocks returned above it are freed immediately. If an allocation fails, all cached
+ * blocks are released and the allocation is tried again.
+ *
+ * There is one pool per system, shared by all threads. It is reached through the backend policies,
+ * e.g. `hydra::omp::sys.GetCachingPool()`, and is used by the thrust algorithms and by
+ * Hydra for all temporary buffers requested with these policies.
+ */
+template<typename System>
+class CachingPool
+{
+	typedef std::multimap<size_t, char*>        free_blocks_t;
+	typedef std::unordered_map<char*, size_t>   allocated_blocks_t;
+
+public:
+
+	static CachingPool<System>& Instance()
+	{
+		static CachingPool<System> pool;
+		return pool;
+	}
+
+	CachingPool(CachingPool<System> const&)=delete;
+
+	CachingPool<System>& operator=(CachingPool<System> const&)=delete;
+
+	~CachingPool()
+	{
+		//the backend runtime can be unloaded at exit
+		try { Release(); } catch(...) {}
+	}
+
+	/**
+	 * Allocate a block of at least 'bytes' bytes.
+	 */
+	char* Allocate(size_t bytes)
+	{
+		size_t size = SizeClass(bytes);
+
+		std::lock_guard<std::mutex> lock(fMutex);
+
+		char* block = 0;
+
+		auto it = fFreeBlocks.find(size);
+
+		if( it != fFreeBlocks.end() ){
+
+			block = it->second;
+			fFreeBlocks.erase(it);
+			fCachedBytes -= size;
+		}
+		else {
+
+			try {
+				block = Malloc(size);
+			}
+			catch(std::exception const&){
+
+				//release the cache and try again
+				FreeCached(0);
+				block = Malloc(size);
+			}
+		}
+
+		fAllocatedBlocks[block] = size;
+		fAllocatedBytes += size;
+
+		return block;
+	}
+
+	/**
+	 * Return a block to the pool.
+	 */
+	void Deallocate(char* block)
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+
+		auto it = fAllocatedBlocks.find(block);
+
+		if( it == fAllocatedBlocks.end() ) return;
+
+		size_t size = it->second;
+
+		fAllocatedBlocks.erase(it);
+		fAllocatedBytes -= size;
+
+		if( fCachedBytes + size > fMaxCachedBytes ){
+
+			Free(block);
+			return;
+		}
+
+		fFreeBlocks.insert(std::make_pair(size, block));
+		fCachedBytes += size;
+	}
+
+	/**
+	 * Free cached blocks, largest first, until at most 'bytes' bytes are kept.
+	 */
+	void Trim(size_t bytes)
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+
+		FreeCached(bytes);
+	}
+
+	/**
+	 * Free all cached blocks. Blocks in use are not affected.
+	 */
+	void Release()
+	{
+		Trim(0);
+	}
+
+	/**
+	 * Maximum number of bytes kept in the free lists (default HYDRA_CACHING_POOL_MAX_BYTES).
+	 * Setting it to zero disables the caching.
+	 */
+	size_t GetMaxCachedBytes() const
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+
+		return fMaxCachedBytes;
+	}
+
+	void SetMaxCachedBytes(size_t bytes)
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+
+		fMaxCachedBytes = bytes;
+
+		FreeCached(bytes);
+	}
+
+	/**
+	 * Bytes kept in the free lists.
+	 */
+	size_t GetCachedBytes() const
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+
+		return fCachedBytes;
+	}
+
+	/**
+	 * Bytes of the blocks in use.
+	 */
+	size_t GetAllocatedBytes() const
+	{
+		std::lock_guard<std::mutex> lock(fMutex);
+
+		return fAllocatedBytes;
+	}
+
+	/**
+	 * Size class of a request: multiple of a quarter of the largest power of two below it, at least 256 bytes.
+	 */
+	static size_t SizeClass(size_t bytes)
+	{
+		if(bytes <= 256) return 256;
+
+		size_t power = 256;
+
+		while( power < (bytes - 1)/2 + 1 ) power <<= 1;
+
+		size_t step = power/4;
+
+		return ((bytes + step - 1)/step)*step;
+	}
+
+private:
+
+	CachingPool():
+		fMaxCachedBytes(HYDRA_CACHING_POOL_MAX_BYTES),
+		fCachedBytes(0),
+		fAllocatedBytes(0)
+	{}
+
+	char* Malloc(size_t bytes)
+	{
+		char* block = static_cast<char*>( HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(
+				HYDRA_EXTERNAL_NS::thrust::malloc(System(), bytes)) );
+
+		if(block == 0) throw std::bad_alloc();
+
+		return block;
+	}
+
+	void Free(char* block)
+	{
+		HYDRA_EXTERNAL_NS::thrust::free(System(), HYDRA_EXTERNAL_NS::thrust::pointer<void,System>(block));
+	}
+
+	void FreeCached(size_t bytes)
+	{
+		while( fCachedBytes > bytes && !fFreeBlocks.empty() ){
+
+			auto it = --fFreeBlocks.end();
+
+			Free(it->second);
+
+			fCachedBytes -= it->first;
+			fFreeBlocks.erase(it);
+		}
+	}
+
+	mutable std::mutex fMutex;
+	size_t fMaxCachedBytes;
+	size_t fCachedBytes;
+	size_t fAllocatedBytes;
+	free_blocks_t      fFreeBlocks;
+	allocated_blocks_t fAllocatedBlocks;
+};
+
+/**
+ * \ingroup policy
+ *
+ * \brief Base of the backend policies routing their temporary buffers to CachingPool<System>.
+ *
+ * The functions below are found by argument dependent lookup when thrust or Hydra request
+ * a temporary buffer with a policy derived from this class, and take precedence over the
+ * generic thrust implementation.
+ */
+template<typename Derived, typename System>
+struct CachingPolicy
+{
+	typedef CachingPool<System> caching_pool_type;
+
+	/**
+	 * The caching pool of the temporary buffers of this backend.
+	 */
+	static caching_pool_type& GetCachingPool()
+	{
+		return caching_pool_type::Instance();
+	}
+
+	template<typename T>
+	friend HYDRA_EXTERNAL_NS::thrust::pair<T*, std::ptrdiff_t>
+	get_temporary_buffer(Derived&, std::ptrdiff_t n)
+	{
+		T* buffer = reinterpret_cast<T*>( caching_pool_type::Instance().Allocate(n*sizeof(T)) );
+
+		return HYDRA_EXTERNAL_NS::thrust::make_pair(buffer, n);
+	}
+
+	template<typename Pointer>
+	friend void return_temporary_buffer(Derived&, Pointer p)
+	{
+		caching_pool_type::Instance().Deallocate(
+				reinterpret_cast<char*>( HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(p) ) );
+	}
+};
+
+/**
+ * Temporary buffer for a thrust system tag, from the caching pool of the system. Used where the
+ * system is deduced from the iterators, e.g. `thrust::iterator_system<Iterator>::type`.
+ */
+template<typename T, typename System>
+inline HYDRA_EXTERNAL_NS::thrust::pair<HYDRA_EXTERNAL_NS::thrust::pointer<T,System>, std::ptrdiff_t>
+get_temporary_buffer(System const&, std::ptrdiff_t n)
+{
+	T* buffer = reinterpret_cast<T*>( CachingPool<System>::Instance().Allocate(n*sizeof(T)) );
+
+	return HYDRA_EXTERNAL_NS::thrust::make_pair(HYDRA_EXTERNAL_NS::thrust::pointer<T,System>(buffer), n);
+}
+
+template<typename System, typename Pointer>
+inline void return_temporary_buffer(System const&, Pointer p)
+{
+	CachingPool<System>::Instance().Deallocate(
+			reinterpret_cast<char*>( HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(p) ) );
+}
+
+}  // namespace detail
+
+}  // namespace hydra
+
+#endif /* CACHINGPOOL_H_ */
@@ -35,6 +35,9 @@
 #include <hydra/detail/external/thrust/complex.h>
 #if HYDRA_THRUST_DEVICE_SYSTEM==HYDRA_THRUST_DEVICE_SYSTEM_CUDA
 #include <hydra/detail/external/thrust/system/cuda/experimental/pinned_allocator.h>
+#else
+#include <hydra/detail/FirstTouchAllocator.h>
+#include <hydra/detail/AlignedAllocator.h>
 #endif
 
 namespace hydra
@@ -57,13 +60,27 @@ namespace hydra
 	template <typename T>
 		using  mc_host_vector = HYDRA_EXTERNAL_NS::thrust::host_vector<T, HYDRA_EXTERNAL_NS::thrust::system::cuda::experimental::pinned_allocator<T>>;
 
+#elif defined(HYDRA_FIRST_TOUCH_ALLOCATION) && (HYDRA_THRUST_DEVICE_SYSTEM==HYDRA_THRUST_DEVICE_SYSTEM_OMP || HYDRA_THRUST_DEVICE_SYSTEM==HYDRA_THRUST_DEVICE_SYSTEM_TBB)
+/*!
+ * Generic template typedef for HYDRA_EXTERNAL_NS::thrust::device_vector. The pages of the
+ * OpenMP and TBB device containers are mapped in parallel as they are allocated (see hydra::detail::FirstTouchAllocator).
+ */
+	template <typename T>
+		using  mc_device_vector = HYDRA_EXTERNAL_NS::thrust::device_vector<T,
+				detail::FirstTouchAllocator<
+					detail::aligned_allocator_t<HYDRA_EXTERNAL_NS::thrust::device_malloc_allocator<T>>>>;
+
+	template <typename T>
+		using  mc_host_vector   = HYDRA_EXTERNAL_NS::thrust::host_vector<T>;
 #else
 /*!
  * Generic template typedef for HYDRA_EXTERNAL_NS::thrust::host_vector. Use it instead of Thrust implementation
  * in order to avoid problems to compile OpenMP based applications using gcc and without a cuda runtime installation.
+ * The blocks are aligned and padded if HYDRA_ALIGNED_ALLOCATION is defined (see hydra::detail::AlignedAllocator).
  */
 	template <typename T>
-		using  mc_device_vector = HYDRA_EXTERNAL_NS::thrust::device_vector<T>;
+		using  mc_device_vector = HYDRA_EXTERNAL_NS::thrust::device_vector<T,
+				detail::aligned_allocator_t<HYDRA_EXTERNAL_NS::thrust::device_malloc_allocator<T>>>;
 /*!
  * Generic template typedef for HYDRA_EXTERNAL_NS::thrust::host_vector. Use it instead of Thrust implementation
  * in order to avoid problems to compile OpenMP based applications using gcc and without a cuda runtime installation.
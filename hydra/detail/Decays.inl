@@ -97,8 +97,6 @@ struct FlagDaugthers: public HYDRA_EXTERNAL_NS::thrust::unary_function<size_t,
 template<size_t N, detail::Backend BACKEND>
 size_t Decays<N, detail::BackendPolicy<BACKEND> >::Unweight(GUInt_t scale) {
 	using HYDRA_EXTERNAL_NS::thrust::system::detail::generic::select_system;
-	typedef typename HYDRA_EXTERNAL_NS::thrust::iterator_system<
-			typename Decays<N, detail::BackendPolicy<BACKEND> >::const_iterator>::type system_t;
 
 	//number of events to trial
 	size_t ntrials = this->size();
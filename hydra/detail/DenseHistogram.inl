@@ -31,6 +31,8 @@
 
 #include <hydra/detail/external/thrust/memory.h>
 #include <hydra/detail/external/thrust/reduce.h>
+#include <hydra/detail/external/thrust/transform.h>
+#include <hydra/detail/external/thrust/functional.h>
 #include <hydra/detail/external/thrust/gather.h>
 #include <hydra/detail/external/thrust/scatter.h>
 #include <hydra/detail/functors/GetGlobalBin.h>
@@ -39,6 +41,7 @@
 #include <hydra/detail/external/thrust/iterator/constant_iterator.h>
 #include <hydra/detail/external/thrust/iterator/iterator_traits.h>
 #include <hydra/detail/external/thrust/system/detail/generic/select_system.h>
+#include <hydra/detail/CachingPool.h>
 #include <hydra/detail/external/thrust/iterator/iterator_traits.h>
 
 namespace hydra {
@@ -65,12 +68,12 @@ void DenseHistogram<T, N, detail::BackendPolicy<BACKEND>, detail::multidimension
 
 	//work on local copy of weights
 
-	auto weights  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto weights  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
 	hydra::copy(wbegin, wbegin+data_size, weights.first);
 
 	auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 	auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-	auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::copy( keys_begin, keys_end, key_buffer.first);
 
@@ -78,9 +81,9 @@ void DenseHistogram<T, N, detail::BackendPolicy<BACKEND>, detail::multidimension
 
 
 	//bins content
-	auto bin_contents    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), fContents.size());
-	auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-	auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto bin_contents    = hydra::detail::get_temporary_buffer<double>(common_system_t(), fContents.size());
+	auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::fill(bin_contents.first, bin_contents.first+bin_contents.second, 0.0);
 
@@ -93,12 +96,12 @@ void DenseHistogram<T, N, detail::BackendPolicy<BACKEND>, detail::multidimension
 	HYDRA_EXTERNAL_NS::thrust::copy(bin_contents.first ,
 			bin_contents.first+ bin_contents.second,  fContents.begin());
 
-    // deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), bin_contents.first );
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), weights.first  );
+    // return the buffers to the caching pool
+	hydra::detail::return_temporary_buffer(common_system_t(), bin_contents.first );
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), weights.first  );
 }
 
 
@@ -125,12 +128,12 @@ void DenseHistogram<T, N, detail::BackendPolicy<BACKEND>, detail::multidimension
 
 	//work on local copy of weights
 
-	auto weights  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto weights  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
 	hydra::copy(wbegin, wbegin+data_size, weights.first);
 
 	auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 	auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-	auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::copy( keys_begin, keys_end, key_buffer.first);
 
@@ -138,9 +141,9 @@ void DenseHistogram<T, N, detail::BackendPolicy<BACKEND>, detail::multidimension
 
 
 	//bins content
-	auto bin_contents    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), fContents.size());
-	auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-	auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto bin_contents    = hydra::detail::get_temporary_buffer<double>(common_system_t(), fContents.size());
+	auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::fill(bin_contents.first, bin_contents.first+bin_contents.second, 0.0);
 
@@ -153,12 +156,12 @@ void DenseHistogram<T, N, detail::BackendPolicy<BACKEND>, detail::multidimension
 	HYDRA_EXTERNAL_NS::thrust::copy(bin_contents.first ,
 			bin_contents.first+ bin_contents.second,  fContents.begin());
 
-    // deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), bin_contents.first );
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), weights.first  );
+    // return the buffers to the caching pool
+	hydra::detail::return_temporary_buffer(common_system_t(), bin_contents.first );
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), weights.first  );
 }
 
 
@@ -182,7 +185,7 @@ void DenseHistogram<T, N,  hydra::detail::BackendPolicy<BACKEND>, detail::multid
 
 		auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 		auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-		auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+		auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 
 		HYDRA_EXTERNAL_NS::thrust::copy( keys_begin, keys_end, key_buffer.first);
@@ -190,9 +193,9 @@ void DenseHistogram<T, N,  hydra::detail::BackendPolicy<BACKEND>, detail::multid
 
 
 		//bins content
-		auto bin_contents    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), fContents.size());
-		auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-		auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+		auto bin_contents    = hydra::detail::get_temporary_buffer<double>(common_system_t(), fContents.size());
+		auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+		auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 		auto weights         = HYDRA_EXTERNAL_NS::thrust::constant_iterator<double>(1.0);
 
 		auto reduced_end = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(common_system_t(),
@@ -210,11 +213,11 @@ void DenseHistogram<T, N,  hydra::detail::BackendPolicy<BACKEND>, detail::multid
 		HYDRA_EXTERNAL_NS::thrust::copy(bin_contents.first ,
 				bin_contents.first+ bin_contents.second,  fContents.begin());
 
-	    // deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-		HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
-		HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), bin_contents.first );
-	    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-	    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
+	    // return the buffers to the caching pool
+		hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
+		hydra::detail::return_temporary_buffer(common_system_t(), bin_contents.first );
+	    hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+	    hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
 
 }
 
@@ -236,7 +239,7 @@ void DenseHistogram<T, N,  hydra::detail::BackendPolicy<BACKEND>, detail::multid
 
 		auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 		auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-		auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+		auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 
 		HYDRA_EXTERNAL_NS::thrust::copy( keys_begin, keys_end, key_buffer.first);
@@ -244,9 +247,9 @@ void DenseHistogram<T, N,  hydra::detail::BackendPolicy<BACKEND>, detail::multid
 
 
 		//bins content
-		auto bin_contents    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), fContents.size());
-		auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-		auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+		auto bin_contents    = hydra::detail::get_temporary_buffer<double>(common_system_t(), fContents.size());
+		auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+		auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 		auto weights         = HYDRA_EXTERNAL_NS::thrust::constant_iterator<double>(1.0);
 
 		auto reduced_end = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(common_system_t(),
@@ -264,11 +267,11 @@ void DenseHistogram<T, N,  hydra::detail::BackendPolicy<BACKEND>, detail::multid
 		HYDRA_EXTERNAL_NS::thrust::copy(bin_contents.first ,
 				bin_contents.first+ bin_contents.second,  fContents.begin());
 
-	    // deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-		HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
-		HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), bin_contents.first );
-	    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-	    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
+	    // return the buffers to the caching pool
+		hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
+		hydra::detail::return_temporary_buffer(common_system_t(), bin_contents.first );
+	    hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+	    hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
 
 }
 
@@ -292,16 +295,16 @@ void DenseHistogram< T,1, detail::BackendPolicy<BACKEND>, detail::unidimensional
 
 	auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 	auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-	auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::copy( keys_begin, keys_end, key_buffer.first);
 	HYDRA_EXTERNAL_NS::thrust::sort(key_buffer.first, key_buffer.first+data_size );
 
 
 	//bins content
-	auto bin_contents    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), fContents.size());
-	auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-	auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto bin_contents    = hydra::detail::get_temporary_buffer<double>(common_system_t(), fContents.size());
+	auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 	auto  weights    = HYDRA_EXTERNAL_NS::thrust::constant_iterator<size_t>(1.0);
 
 	auto reduced_end = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(common_system_t(),
@@ -317,11 +320,11 @@ void DenseHistogram< T,1, detail::BackendPolicy<BACKEND>, detail::unidimensional
 			bin_contents.first+ bin_contents.second,  fContents.begin());
 
 
-    // deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), bin_contents.first );
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
+    // return the buffers to the caching pool
+	hydra::detail::return_temporary_buffer(common_system_t(), bin_contents.first );
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
 
 }
 
@@ -347,16 +350,16 @@ void DenseHistogram< T,1, detail::BackendPolicy<BACKEND>, detail::unidimensional
 
 	auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 	auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-	auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::copy( keys_begin, keys_end, key_buffer.first);
 	HYDRA_EXTERNAL_NS::thrust::sort(key_buffer.first, key_buffer.first+data_size );
 
 
 	//bins content
-	auto bin_contents    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), fContents.size());
-	auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-	auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto bin_contents    = hydra::detail::get_temporary_buffer<double>(common_system_t(), fContents.size());
+	auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 	auto  weights    = HYDRA_EXTERNAL_NS::thrust::constant_iterator<size_t>(1.0);
 
 	auto reduced_end = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(common_system_t(),
@@ -372,11 +375,11 @@ void DenseHistogram< T,1, detail::BackendPolicy<BACKEND>, detail::unidimensional
 			bin_contents.first+ bin_contents.second,  fContents.begin());
 
 
-    // deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), bin_contents.first );
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
+    // return the buffers to the caching pool
+	hydra::detail::return_temporary_buffer(common_system_t(), bin_contents.first );
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
 
 }
 
@@ -400,20 +403,20 @@ void DenseHistogram<T,1, detail::BackendPolicy<BACKEND>, detail::unidimensional>
 	auto key_functor = detail::GetGlobalBin<1,T>(fGrid, fLowerLimits, fUpperLimits);
 
 	//work on local copy of data
-	auto weights  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto weights  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
 	hydra::copy(wbegin, wbegin+data_size, weights.first);
 
 	auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 	auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-	auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(),  keys_begin, keys_end, key_buffer.first);
 	HYDRA_EXTERNAL_NS::thrust::sort_by_key(common_system_t(), key_buffer.first, key_buffer.first+data_size, weights.first);
 
 	//bins content
-	auto bin_contents    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), fContents.size());
-	auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-	auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto bin_contents    = hydra::detail::get_temporary_buffer<double>(common_system_t(), fContents.size());
+	auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 
 	auto reduced_end = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(common_system_t(),
@@ -429,12 +432,12 @@ void DenseHistogram<T,1, detail::BackendPolicy<BACKEND>, detail::unidimensional>
 			bin_contents.first+ bin_contents.second,  fContents.begin());
 
 
-    // deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), bin_contents.first );
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), weights.first  );
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
+    // return the buffers to the caching pool
+	hydra::detail::return_temporary_buffer(common_system_t(), bin_contents.first );
+	hydra::detail::return_temporary_buffer(common_system_t(), weights.first  );
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
 
 }
 
@@ -460,20 +463,20 @@ void DenseHistogram<T,1, detail::BackendPolicy<BACKEND>, detail::unidimensional
 	auto key_functor = detail::GetGlobalBin<1,T>(fGrid, fLowerLimits, fUpperLimits);
 
 	//work on local copy of data
-	auto weights  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto weights  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
 	hydra::copy(wbegin, wbegin+data_size, weights.first);
 
 	auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 	auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-	auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(),  keys_begin, keys_end, key_buffer.first);
 	HYDRA_EXTERNAL_NS::thrust::sort_by_key(common_system_t(), key_buffer.first, key_buffer.first+data_size, weights.first);
 
 	//bins content
-	auto bin_contents    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), fContents.size());
-	auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-	auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto bin_contents    = hydra::detail::get_temporary_buffer<double>(common_system_t(), fContents.size());
+	auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 
 	auto reduced_end = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(common_system_t(),
@@ -489,15 +492,63 @@ void DenseHistogram<T,1, detail::BackendPolicy<BACKEND>, detail::unidimensional
 			bin_contents.first+ bin_contents.second,  fContents.begin());
 
 
-    // deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), bin_contents.first );
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), weights.first  );
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
+    // return the buffers to the caching pool
+	hydra::detail::return_temporary_buffer(common_system_t(), bin_contents.first );
+	hydra::detail::return_temporary_buffer(common_system_t(), weights.first  );
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
 
 }
 
+/*
+ * Each chunk fills the histogram, and the contents are accumulated in a separate storage.
+ */
+template<typename T, size_t N, hydra::detail::Backend BACKEND>
+template<typename ...T2, hydra::detail::Backend BACKEND2>
+void DenseHistogram<T, N,  hydra::detail::BackendPolicy<BACKEND>, detail::multidimensional>::Fill(
+		ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T2...>, detail::BackendPolicy<BACKEND2>> const& source)
+{
+	typedef typename ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T2...>,
+			detail::BackendPolicy<BACKEND2>>::iterator source_iterator;
+
+	storage_t contents(fContents.size(), T(0));
+
+	source.ForEachChunk([this, &contents](source_iterator first, source_iterator last, size_t){
+
+		this->Fill(first, last);
+
+		HYDRA_EXTERNAL_NS::thrust::transform(contents.begin(), contents.end(), fContents.begin(),
+				contents.begin(), HYDRA_EXTERNAL_NS::thrust::plus<T>());
+	});
+
+	fContents.swap(contents);
+}
+
+template<typename T, hydra::detail::Backend BACKEND>
+template<typename ...T2, hydra::detail::Backend BACKEND2>
+void DenseHistogram<T, 1, hydra::detail::BackendPolicy<BACKEND>, detail::unidimensional>::Fill(
+		ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T2...>, detail::BackendPolicy<BACKEND2>> const& source)
+{
+	typedef typename ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T2...>,
+			detail::BackendPolicy<BACKEND2>>::iterator source_iterator;
+
+	static_assert(sizeof...(T2)==1, "[Hydra::DenseHistogram] : the source of a one-dimensional histogram must have one column.");
+
+	storage_t contents(fContents.size(), T(0));
+
+	source.ForEachChunk([this, &contents](source_iterator first, source_iterator last, size_t){
+
+		this->Fill(HYDRA_EXTERNAL_NS::thrust::get<0>(first.get_iterator_tuple()),
+				HYDRA_EXTERNAL_NS::thrust::get<0>(last.get_iterator_tuple()));
+
+		HYDRA_EXTERNAL_NS::thrust::transform(contents.begin(), contents.end(), fContents.begin(),
+				contents.begin(), HYDRA_EXTERNAL_NS::thrust::plus<T>());
+	});
+
+	fContents.swap(contents);
+}
+
 template<typename Iterator, typename T, size_t N , hydra::detail::Backend BACKEND>
 DenseHistogram< T, N,  detail::BackendPolicy<BACKEND>, detail::multidimensional>
 make_dense_histogram( detail::BackendPolicy<BACKEND>, std::array<size_t, N> grid,
@@ -0,0 +1,182 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * FirstTouchAllocator.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+/**
+ * \file
+ * \ingroup generic
+ */
+
+#ifndef FIRSTTOUCHALLOCATOR_H_
+#define FIRSTTOUCHALLOCATOR_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/external/thrust/for_each.h>
+#include <hydra/detail/external/thrust/iterator/counting_iterator.h>
+#include <hydra/detail/external/thrust/detail/raw_pointer_cast.h>
+#include <hydra/detail/external/thrust/detail/allocator/allocator_traits.h>
+
+#include <cstddef>
+#include <algorithm>
+
+/**
+ * Stride, in bytes, of the writes touching a new block. It should not exceed the
+ * page size of the system (4 KiB on x86-64).
+ */
+#ifndef HYDRA_PAGE_SIZE
+#define HYDRA_PAGE_SIZE 4096
+#endif
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * Writes one byte in each page of a block, so that the pages are mapped by the
+ * thread processing that part of the block.
+ */
+struct FirstTouchPages
+{
+	//constructor
+	FirstTouchPages(char* data, size_t bytes):
+		fData(data),
+		fBytes(bytes)
+	{}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	FirstTouchPages(FirstTouchPages const& other):
+		fData(other.fData),
+		fBytes(other.fBytes)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	void operator()(size_t page) const
+	{
+		size_t offset = page*HYDRA_PAGE_SIZE;
+
+		fData[ offset < fBytes ? offset : fBytes - 1 ] = 0;
+	}
+
+	char*  fData;
+	size_t fBytes;
+};
+
+/**
+ * \ingroup generic
+ *
+ * \brief Allocator mapping the pages of each new block in parallel, with the static partition of the parallel algorithms.
+ *
+ * The Linux kernel places a page on the NUMA node of the thread that first writes to it. Blocks from
+ * ALLOCATOR (e.g. `thrust::omp::allocator<T>`) are touched, right after allocation, by a `thrust::for_each`
+ * over their pages on the system of the allocator, so that with OpenMP each thread maps the part of
+ * the block it processes later on with the static schedule of the same number of threads (OMP_NUM_THREADS).
+ * The placement does not depend anymore on how the elements are written afterwards,
+ * e.g. by a single thread filling a container with `push_back` after `reserve`.
+ * With TBB the pages are spread over the worker threads, following the auto partitioner.
+ *
+ * The containers of the OMP and TBB backends, and the device containers when the device system is
+ * OMP or TBB, use this allocator if HYDRA_FIRST_TOUCH_ALLOCATION is defined. Pin the threads
+ * with OMP_PROC_BIND and OMP_PLACES, otherwise they can migrate away from their pages.
+ */
+template<typename ALLOCATOR>
+class FirstTouchAllocator: public ALLOCATOR
+{
+	typedef typename HYDRA_EXTERNAL_NS::thrust::detail::allocator_system<ALLOCATOR>::type system_type;
+
+public:
+
+	typedef typename ALLOCATOR::value_type value_type;
+	typedef typename ALLOCATOR::pointer    pointer;
+	typedef typename ALLOCATOR::size_type  size_type;
+
+	template<typename U>
+	struct rebind
+	{
+		typedef FirstTouchAllocator<typename ALLOCATOR::template rebind<U>::other> other;
+	};
+
+	__hydra_host__ __hydra_device__
+	FirstTouchAllocator():
+		ALLOCATOR()
+	{}
+
+	__hydra_host__ __hydra_device__
+	FirstTouchAllocator(FirstTouchAllocator<ALLOCATOR> const& other):
+		ALLOCATOR(other)
+	{}
+
+	template<typename ALLOCATOR2>
+	__hydra_host__ __hydra_device__
+	FirstTouchAllocator(FirstTouchAllocator<ALLOCATOR2> const& other):
+		ALLOCATOR(other)
+	{}
+
+	pointer allocate(size_type n)
+	{
+		pointer block = ALLOCATOR::allocate(n);
+
+		size_t bytes = n*sizeof(value_type);
+
+		if(bytes > 0)
+		{
+			system_type system;
+
+			HYDRA_EXTERNAL_NS::thrust::for_each(system,
+					HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t>(0),
+					HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t>((bytes - 1)/HYDRA_PAGE_SIZE + 2),
+					FirstTouchPages(reinterpret_cast<char*>(
+							HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(block)), bytes));
+		}
+
+		return block;
+	}
+};
+
+/**
+ * Resize a container to exactly n elements, always moving its elements to a new block
+ * without spare capacity. With a FirstTouchAllocator the pages of the new block are mapped
+ * with the partition of n elements. Otherwise they are mapped by the parallel copy of the
+ * elements kept, which also matches it when shrinking or re-placing a container (n <= size()).
+ */
+template<typename Vector>
+inline void first_touch_resize(Vector& vector, size_t n)
+{
+	Vector other;
+
+	other.reserve(n);
+	other.insert(other.end(), vector.begin(), vector.begin() + std::min(n, size_t(vector.size())));
+	other.resize(n);
+
+	vector.swap(other);
+}
+
+}  // namespace detail
+
+}  // namespace hydra
+
+#endif /* FIRSTTOUCHALLOCATOR_H_ */
@@ -123,6 +123,35 @@ public:
 	static constexpr bool value = type::value;
 };
 
+template<typename, typename T>
+struct has_parameter_gradient {
+	static_assert(
+			std::integral_constant<T, false>::value,
+			"Second template parameter needs to be of function type.");
+};
+
+// true if the functor implements ParameterGradient(unsigned int n, T* x, GReal_t* gradient),
+// returning its value and filling the derivatives with respect to its parameters
+template<typename C, typename Ret, typename... Args>
+struct has_parameter_gradient<C, Ret(Args...)> {
+private:
+	template<typename T>
+	static constexpr auto check(T*)
+	-> typename
+	std::is_convertible<
+	decltype( std::declval<T const>().ParameterGradient( std::declval<Args>()... ) ),
+	Ret
+	>::type;
+
+	template<typename>
+	static constexpr std::false_type check(...);
+
+	typedef decltype(check<C>(0)) type;
+
+public:
+	static constexpr bool value = type::value;
+};
+
 template<typename Functor>
 bool HasAnalyticalIntegral( Functor&){
 	return has_analytical_integral<Functor, GReal_t(const GReal_t*,  const GReal_t*)>::value;
@@ -34,9 +34,17 @@
 #include <cmath>
 #include <tuple>
 #include <limits>
-#include <hydra/detail/external/thrust/sort.h>
-#include <hydra/detail/external/thrust/execution_policy.h>
+#include <hydra/detail/external/thrust/reduce.h>
+#include <hydra/detail/external/thrust/transform.h>
+#include <hydra/detail/external/thrust/transform_reduce.h>
+#include <hydra/detail/external/thrust/count.h>
+#include <hydra/detail/external/thrust/copy.h>
+#include <hydra/detail/external/thrust/remove.h>
+#include <hydra/detail/external/thrust/distance.h>
 #include <hydra/detail/external/thrust/functional.h>
+#include <hydra/detail/external/thrust/memory.h>
+#include <hydra/detail/external/thrust/iterator/counting_iterator.h>
+#include <hydra/detail/external/thrust/iterator/transform_iterator.h>
 
 namespace hydra {
 
@@ -44,40 +52,47 @@ template<size_t NRULE, size_t NBIN, hydra::detail::Backend BACKEND>
 std::pair<GReal_t, GReal_t>
 GaussKronrodAdaptiveQuadrature<NRULE,NBIN,hydra::detail::BackendPolicy<BACKEND>>::Accumulate()
 {
+	call_t result = HYDRA_EXTERNAL_NS::thrust::transform_reduce(system_t(),
+			fNodesTable.begin(placeholders::_2, placeholders::_3),
+			fNodesTable.end(placeholders::_2, placeholders::_3),
+			detail::GaussKronrodNodeSum(), call_t(0.0, 0.0), detail::GaussKronrodNodeSum());
 
-	for(size_t index=0; index<fCallTableHost.size() ; index++ )
-		{
+	return std::pair<GReal_t, GReal_t>(HYDRA_EXTERNAL_NS::thrust::get<0>(result),
+			::sqrt(HYDRA_EXTERNAL_NS::thrust::get<1>(result)) );
+}
 
-			auto row = fCallTableHost[index];
+template<size_t NRULE, size_t NBIN, hydra::detail::Backend BACKEND>
+template<typename FUNCTOR>
+void GaussKronrodAdaptiveQuadrature<NRULE,NBIN,hydra::detail::BackendPolicy<BACKEND>>::EvaluateNodes(
+		FUNCTOR const& functor, size_t first_node)
+{
+	size_t nnodes = fNodesTable.size() - first_node;
+	size_t ncalls = nnodes*((NRULE+1)/2);
 
-			size_t  bin        = HYDRA_EXTERNAL_NS::thrust::get<0>(row);
-			GReal_t bin_delta  = HYDRA_EXTERNAL_NS::thrust::get<1>(row)-HYDRA_EXTERNAL_NS::thrust::get<2>(row);
-			GReal_t bin_result = HYDRA_EXTERNAL_NS::thrust::get<2>(row);
-			HYDRA_EXTERNAL_NS::thrust::get<4>(fNodesTable[bin])   +=  bin_result;
-			HYDRA_EXTERNAL_NS::thrust::get<5>(fNodesTable[bin])   +=  bin_delta;
-		}
+	fCallTable.resize(nnodes);
+	fKeys.resize(nnodes);
 
-	GReal_t result=0;
-	GReal_t error2=0;
+	const GReal_t* lower = HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(
+			&(*(fNodesTable.begin(placeholders::_0) + first_node)));
+	const GReal_t* upper = HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(
+			&(*(fNodesTable.begin(placeholders::_1) + first_node)));
 
-	//for(auto row: fNodesTable ) std::cout <<std::setprecision(10)<< row << std::endl;
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> first(0);
 
-	for(size_t node=0; node<fNodesTable.size(); node++ )
-	{
-		//std::cout <<std::setprecision(10)<< fNodesTable[node]<< std::endl;
-		if(HYDRA_EXTERNAL_NS::thrust::get<0>(fNodesTable[node])==1 )
-		{
-			HYDRA_EXTERNAL_NS::thrust::get<5>(fNodesTable[node])= GetError(HYDRA_EXTERNAL_NS::thrust::get<5>(fNodesTable[node]) );
-			HYDRA_EXTERNAL_NS::thrust::get<0>(fNodesTable[node])=0;
-			//std::cout << "====>"<< std::setprecision(10)<< fNodesTable[node]<< std::endl;
-		}
+	auto keys  = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(first,
+			detail::GaussKronrodCallNode<NRULE>());
 
-		result     += HYDRA_EXTERNAL_NS::thrust::get<4>(fNodesTable[node]);
-		error2    += HYDRA_EXTERNAL_NS::thrust::get<5>(fNodesTable[node])*HYDRA_EXTERNAL_NS::thrust::get<5>(fNodesTable[node]);
+	auto calls = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(first,
+			ProcessGaussKronrodAdaptiveQuadrature<FUNCTOR, NRULE>(functor, fRule, lower, upper));
 
-	}
+	//all calls of the new nodes in one launch, summed per node
+	HYDRA_EXTERNAL_NS::thrust::reduce_by_key(system_t(), keys, keys + ncalls, calls,
+			fKeys.begin(), fCallTable.begin(),
+			HYDRA_EXTERNAL_NS::thrust::equal_to<size_t>(), detail::GaussKronrodCallSum());
 
-	return std::pair<GReal_t, GReal_t>(result, sqrt(error2) );
+	HYDRA_EXTERNAL_NS::thrust::transform(system_t(), fCallTable.begin(), fCallTable.end(),
+			fNodesTable.begin(placeholders::_2, placeholders::_3) + first_node,
+			detail::GaussKronrodNodeResult());
 }
 
 template<size_t NRULE, size_t NBIN, hydra::detail::Backend BACKEND>
@@ -85,93 +100,74 @@ template<typename FUNCTOR>
 std::pair<GReal_t, GReal_t>
 GaussKronrodAdaptiveQuadrature<NRULE,NBIN, hydra::detail::BackendPolicy<BACKEND>>::Integrate(FUNCTOR const& functor)
 {
-	std::pair<GReal_t, GReal_t> result(0,0);
-
 	fIterationNumber=0;
-	GBool_t  condition1=0;
-	GBool_t  condition2=0;
 
 	InitNodes();
-	do{
-
-		// do  not split nodes at first iteration
-		if( fIterationNumber>0 ) UpdateNodes();
-
-		//set parameters table
-		SetParametersTable( );
+	EvaluateNodes(functor, 0);
 
-		//set the call table to hold the evaluation results
-		fCallTableHost.resize( fParametersTable.size());
-		fCallTableDevice.resize( fParametersTable.size());
+	std::pair<GReal_t, GReal_t> result = Accumulate();
 
-		//call function in parallel
-		HYDRA_EXTERNAL_NS::thrust::transform(system_t(),fParametersTable.begin(), fParametersTable.end(),
-				fCallTableDevice.begin(),
-				ProcessGaussKronrodAdaptiveQuadrature<FUNCTOR>(functor) );
+	/*
+	 * keep iterating while the error is larger than the required or
+	 * larger than the numerical double precision
+	 */
+	while( result.second > ::fabs(result.first)*fMaxRelativeError &&
+			result.second > std::numeric_limits<GReal_t>::epsilon() )
+	{
+		fIterationNumber++;
 
-		//copy to evaluation result back to the host
-		HYDRA_EXTERNAL_NS::thrust::copy(fCallTableDevice.begin(),  fCallTableDevice.end(),
-				fCallTableHost.begin());
+		//the error budget is shared equally between the nodes
+		GReal_t threshold = ::fabs(result.first)*fMaxRelativeError/::sqrt(GReal_t(fNodesTable.size()));
 
-		/**
-		 * \todo Re-implement Accumulate() using HYDRA_EXTERNAL_NS::thrust::sort + thust::reduce_by_key, maybe not faster but
-		 * more scalable.
-		 */
-		result = Accumulate();
+		size_t first_node = UpdateNodes(
+				std::max(threshold, std::numeric_limits<GReal_t>::epsilon()) );
 
-		fIterationNumber++;
-
-		/*
-		 * keep iterating while the error is larger than the required or
-		 * larger than the numerical double precision
-		 */
+		//nothing left to split, or the maximum number of nodes would be exceeded
+		if( first_node == fNodesTable.size() )
+		{
+			HYDRA_LOG(WARNING, "Gauss-Kronrod adaptive integration stopped before reaching the requested tolerance.")
+			break;
+		}
 
-		condition1 =  result.second > sqrt(result.first*result.first)*fMaxRelativeError;
-		condition2 =  result.second > std::numeric_limits<GReal_t>::epsilon();
+		EvaluateNodes(functor, first_node);
 
+		result = Accumulate();
 	}
-	while( condition1 &&  condition2 );
 
 	return result;
 }
 
 
 template<size_t NRULE, size_t NBIN, hydra::detail::Backend BACKEND>
-void GaussKronrodAdaptiveQuadrature<NRULE,NBIN,hydra::detail::BackendPolicy<BACKEND>>::UpdateNodes()
+size_t GaussKronrodAdaptiveQuadrature<NRULE,NBIN,hydra::detail::BackendPolicy<BACKEND>>::UpdateNodes(GReal_t threshold)
 {
+	detail::GaussKronrodSplitNode predicate(threshold);
 
-	HYDRA_EXTERNAL_NS::thrust::sort(HYDRA_EXTERNAL_NS::thrust::host,
-				fNodesTable.begin(),
-			    fNodesTable.end(),
-				hydra::detail::CompareTuples<5,	HYDRA_EXTERNAL_NS::thrust::greater >());
-
-	auto node = fNodesTable[0];
-
-	GReal_t lower_limits = HYDRA_EXTERNAL_NS::thrust::get<2>(node);
-	GReal_t upper_limits = HYDRA_EXTERNAL_NS::thrust::get<3>(node);
-	GReal_t delta = upper_limits-lower_limits;
+	size_t nsplit = HYDRA_EXTERNAL_NS::thrust::count_if(system_t(),
+			fNodesTable.begin(), fNodesTable.end(), predicate);
 
-	GReal_t delta2 = delta/2.0;
-	node_t new_node1(1, 0, lower_limits ,lower_limits+delta2, 0, 0);
-	node_t new_node2(1, 0, lower_limits+delta2, upper_limits, 0, 0);
+	if(nsplit==0 || fNodesTable.size() + nsplit > fMaxNodes) return fNodesTable.size();
 
-	fNodesTable[0] =  new_node1;
-	fNodesTable.push_back( new_node2);
+	fSplitNodes.resize(nsplit);
 
+	HYDRA_EXTERNAL_NS::thrust::copy_if(system_t(), fNodesTable.begin(), fNodesTable.end(),
+			fSplitNodes.begin(), predicate);
 
-	HYDRA_EXTERNAL_NS::thrust::sort(HYDRA_EXTERNAL_NS::thrust::host,
-			fNodesTable.begin(),
-		    fNodesTable.end(),
-			hydra::detail::CompareTuples<2,	HYDRA_EXTERNAL_NS::thrust::less >());
+	size_t nkept = HYDRA_EXTERNAL_NS::thrust::distance( fNodesTable.begin(),
+			HYDRA_EXTERNAL_NS::thrust::remove_if(system_t(), fNodesTable.begin(), fNodesTable.end(), predicate));
 
+	//the halves of the split nodes are appended to the table
+	fNodesTable.resize(nkept + 2*nsplit);
 
-	for(size_t  i = 0; i<fNodesTable.size(); i++)
-	{
-		HYDRA_EXTERNAL_NS::thrust::get<1>(fNodesTable[i])=i;
-	}
-
-	//for(auto row: fNodesTable) std::cout << row << std::endl;
+	HYDRA_EXTERNAL_NS::thrust::transform(system_t(),
+			HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t>(0),
+			HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t>(2*nsplit),
+			fNodesTable.begin() + nkept,
+			detail::GaussKronrodChildNode(
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(&(*fSplitNodes.begin(placeholders::_0))),
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(&(*fSplitNodes.begin(placeholders::_1))) ));
 
+	return nkept;
 }
 
 
@@ -35,6 +35,7 @@
 #include <cmath>
 #include <tuple>
 #include <limits>
+#include <vector>
 #include <hydra/detail/external/thrust/transform_reduce.h>
 
 namespace hydra {
@@ -55,6 +56,29 @@ GaussKronrodQuadrature<NRULE, NBIN, hydra::detail::BackendPolicy<BACKEND>>::Inte
 	return std::pair<GReal_t, GReal_t>(result.fGaussKronrodCall, error);
 }
 
+template<size_t NRULE, size_t NBIN, hydra::detail::Backend  BACKEND>
+template<typename ...FUNCTORS>
+std::vector<std::pair<GReal_t, GReal_t>>
+GaussKronrodQuadrature<NRULE, NBIN, hydra::detail::BackendPolicy<BACKEND>>::Integrate(HYDRA_EXTERNAL_NS::thrust::tuple<FUNCTORS...> const& functors)
+{
+	typedef GaussKronrodMultiUnary<HYDRA_EXTERNAL_NS::thrust::tuple<FUNCTORS...>> unary_t;
+
+	GaussKronrodMultiCall<unary_t::K> result = HYDRA_EXTERNAL_NS::thrust::transform_reduce(fCallTable.begin(), fCallTable.end(),
+			unary_t(functors), GaussKronrodMultiCall<unary_t::K>(), GaussKronrodMultiBinary<unary_t::K>() );
+
+	std::vector<std::pair<GReal_t, GReal_t>> results;
+
+	for(size_t k=0; k<unary_t::K; k++)
+	{
+		GReal_t error = std::max(std::numeric_limits<GReal_t>::epsilon(),
+				std::pow(200.0*std::fabs(result.fCalls[k].fGaussCall- result.fCalls[k].fGaussKronrodCall ), 1.5));
+
+		results.push_back( std::pair<GReal_t, GReal_t>(result.fCalls[k].fGaussKronrodCall, error) );
+	}
+
+	return results;
+}
+
 }  // namespace hydra
 
 #endif /* GAUSSKRONRODQUADRATURE_INL_ */
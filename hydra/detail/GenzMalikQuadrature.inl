@@ -40,8 +40,13 @@
 #include <hydra/detail/utility/Generic.h>
 #include <hydra/detail/functors/ProcessGenzMalikQuadrature.h>
 #include <hydra/detail/external/thrust/iterator/counting_iterator.h>
+#include <hydra/detail/external/thrust/iterator/transform_iterator.h>
+#include <hydra/detail/external/thrust/reduce.h>
+#include <hydra/detail/external/thrust/functional.h>
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <vector>
 #include <future>
 
 
@@ -51,7 +56,9 @@ namespace hydra {
 
 template<size_t N,hydra::detail::Backend  BACKEND>
 GenzMalikQuadrature<N, hydra::detail::BackendPolicy<BACKEND>>::GenzMalikQuadrature(std::array<GReal_t,N> const& LowerLimit,
-		std::array<GReal_t,N> const& UpperLimit, std::array<size_t, N> const& grid)
+		std::array<GReal_t,N> const& UpperLimit, std::array<size_t, N> const& grid):
+		fMaxRelativeError(0),
+		fMaxBoxes(100000)
 		{
 
 			size_t nboxes = 1;
@@ -86,7 +93,9 @@ GenzMalikQuadrature<N, hydra::detail::BackendPolicy<BACKEND>>::GenzMalikQuadratu
 
 template<size_t N,hydra::detail::Backend  BACKEND>
 GenzMalikQuadrature<N, hydra::detail::BackendPolicy<BACKEND>>::GenzMalikQuadrature(std::array<GReal_t,N> const& LowerLimit,
-		std::array<GReal_t,N> const& UpperLimit, size_t nboxes)
+		std::array<GReal_t,N> const& UpperLimit, size_t nboxes):
+		fMaxRelativeError(0),
+		fMaxBoxes(100000)
 		{
 
 			std::array<size_t, N> grid;
@@ -123,15 +132,19 @@ GenzMalikQuadrature<N, hydra::detail::BackendPolicy<BACKEND>>::GenzMalikQuadratu
 
 template<size_t N, hydra::detail::Backend  BACKEND>
 GenzMalikQuadrature<N, hydra::detail::BackendPolicy<BACKEND>>::GenzMalikQuadrature( GenzMalikQuadrature<N, hydra::detail::BackendPolicy<BACKEND>> const& other):
+fGenzMalikRule(other.GetGenzMalikRule() ),
 fBoxList(other.GetBoxList() ),
-fGenzMalikRule(other.GetGenzMalikRule() )
+fMaxRelativeError(other.GetMaxRelativeError() ),
+fMaxBoxes(other.GetMaxBoxes() )
 {}
 
 template<size_t N, hydra::detail::Backend  BACKEND>
 template<hydra::detail::Backend  BACKEND2>
 GenzMalikQuadrature<N, hydra::detail::BackendPolicy<BACKEND>>::GenzMalikQuadrature( GenzMalikQuadrature<N, hydra::detail::BackendPolicy<BACKEND2>> const& other):
+fGenzMalikRule(other.GetGenzMalikRule() ),
 fBoxList(other.GetBoxList() ),
-fGenzMalikRule(other.GetGenzMalikRule() )
+fMaxRelativeError(other.GetMaxRelativeError() ),
+fMaxBoxes(other.GetMaxBoxes() )
 {}
 
 
@@ -143,6 +156,8 @@ GenzMalikQuadrature<N,hydra::detail::BackendPolicy<BACKEND>>::operator=( GenzMal
 
 	this->fBoxList=other.GetBoxList() ;
 	this->fGenzMalikRule = other.GetGenzMalikRule() ;
+	this->fMaxRelativeError = other.GetMaxRelativeError() ;
+	this->fMaxBoxes = other.GetMaxBoxes() ;
 
 	return *this;
 }
@@ -156,43 +171,249 @@ GenzMalikQuadrature<N,hydra::detail::BackendPolicy<BACKEND>>::operator=( GenzMal
 
 	this->fBoxList=other.GetBoxList() ;
 	this->fGenzMalikRule = other.GetGenzMalikRule() ;
+	this->fMaxRelativeError = other.GetMaxRelativeError() ;
+	this->fMaxBoxes = other.GetMaxBoxes() ;
 
 	return *this;
 }
 
+template<size_t N, hydra::detail::Backend  BACKEND>
+void GenzMalikQuadrature<N,hydra::detail::BackendPolicy<BACKEND>>::SetLimits(size_t first_box)
+{
+	size_t nboxes = fBoxList.size() - first_box;
+
+	std::vector<GReal_t> limits(2*N*nboxes);
+
+	for(size_t i=0; i<nboxes; i++)
+	{
+		for(size_t dim=0; dim<N; dim++)
+		{
+			limits[2*N*i + dim]     = fBoxList[first_box + i].GetLowerLimit(dim);
+			limits[2*N*i + N + dim] = fBoxList[first_box + i].GetUpperLimit(dim);
+		}
+	}
+
+	fLimits = limits;
+}
+
 template<size_t N, hydra::detail::Backend  BACKEND>
 template<typename FUNCTOR>
-std::pair<GReal_t, GReal_t> GenzMalikQuadrature<N,hydra::detail::BackendPolicy<BACKEND>>::Integrate(FUNCTOR const& functor)
+void GenzMalikQuadrature<N,hydra::detail::BackendPolicy<BACKEND>>::EvaluateBoxes(FUNCTOR const& functor, size_t first_box)
 {
+	size_t nboxes = fBoxList.size() - first_box;
+	size_t nrule  = fGenzMalikRule.GetAbscissas().size();
+
+	SetLimits(first_box);
+
+	fKeys.resize(nboxes);
+	fBoxData.resize(nboxes);
 
 	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> first(0);
-	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> last = first + fBoxList.size();
 
+	auto keys = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(first,
+			detail::GenzMalikBoxIndex(nrule));
 
-	HYDRA_EXTERNAL_NS::thrust::for_each(HYDRA_EXTERNAL_NS::thrust::host,first, last,
-				detail::ProcessGenzMalikBox<N, FUNCTOR,const_rule_iterator, box_iterator>(functor,
-						fGenzMalikRule.GetAbscissas().begin(),fGenzMalikRule.GetAbscissas().end(),
-						fBoxList.begin(), fBoxList.end()));
+	auto values = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(first,
+			detail::ProcessGenzMalikBoxes<N, FUNCTOR, const_rule_iterator>(functor,
+					fGenzMalikRule.GetAbscissas().begin(), nrule,
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fLimits.data())));
 
+	HYDRA_EXTERNAL_NS::thrust::reduce_by_key(system_t(), keys, keys + nboxes*nrule, values,
+			fKeys.begin(), fBoxData.begin(),
+			HYDRA_EXTERNAL_NS::thrust::equal_to<size_t>(),
+			detail::ProcessGenzMalikBinaryCall<N>());
 
-	GReal_t integral=0;
+	std::vector<box_data_t> box_data(fBoxData.begin(), fBoxData.end());
 
-	GReal_t    error=0;
+	for(size_t i=0; i<nboxes; i++)
+		fBoxList[first_box + i] = box_data[i];
+}
+
+template<size_t N, hydra::detail::Backend  BACKEND>
+size_t GenzMalikQuadrature<N,hydra::detail::BackendPolicy<BACKEND>>::SplitBoxes(GReal_t budget)
+{
+	//largest errors first
+	std::vector<size_t> order(fBoxList.size());
+
+	for(size_t i=0; i<order.size(); i++) order[i]=i;
+
+	std::sort(order.begin(), order.end(),
+			[this](size_t a, size_t b){ return fBoxList[a].GetError() > fBoxList[b].GetError(); });
+
+	GReal_t remaining = 0.0;
+
+	for(auto const& box: fBoxList) remaining += box.GetError();
 
-		for(auto box:fBoxList)
+	//each bisection adds one box
+	size_t room = fBoxList.size() < fMaxBoxes ? fMaxBoxes - fBoxList.size() : 0;
+
+	std::vector<size_t> split;
+
+	for(size_t i: order)
+	{
+		if( remaining <= budget || split.size() == room ) break;
+
+		remaining -= fBoxList[i].GetError();
+		split.push_back(i);
+	}
+
+	if( split.empty() ) return fBoxList.size();
+
+	std::vector<bool> is_split(fBoxList.size(), false);
+	box_list_type children;
+
+	for(size_t i: split)
+	{
+		is_split[i] = true;
+
+		detail::GenzMalikBox<N> const& box = fBoxList[i];
+
+		//dimension with the largest fourth difference, the widest one in case of a tie
+		size_t  dimension = 0;
+		GReal_t max_diff  = 0.0;
+
+		for(size_t dim=0; dim<N; dim++)
+			max_diff = std::max(max_diff, std::fabs(box.GetFourDifference(dim)));
+
+		GReal_t max_width = 0.0;
+
+		for(size_t dim=0; dim<N; dim++)
 		{
-			integral+= box.GetIntegral();
-			error   +=  box.GetErrorSq();
+			GReal_t width = box.GetUpperLimit(dim) - box.GetLowerLimit(dim);
 
+			if( std::fabs(box.GetFourDifference(dim)) >= max_diff*(1.0 - 1.0e-10) && width > max_width )
+			{
+				dimension = dim;
+				max_width = width;
+			}
+		}
+
+		std::array<GReal_t,N> lower_limit;
+		std::array<GReal_t,N> upper_limit;
+
+		for(size_t dim=0; dim<N; dim++)
+		{
+			lower_limit[dim] = box.GetLowerLimit(dim);
+			upper_limit[dim] = box.GetUpperLimit(dim);
 		}
 
-		error=std::sqrt(error);
+		GReal_t middle = 0.5*(lower_limit[dimension] + upper_limit[dimension]);
+
+		upper_limit[dimension] = middle;
+		children.push_back(detail::GenzMalikBox<N>(lower_limit, upper_limit));
+
+		upper_limit[dimension] = box.GetUpperLimit(dimension);
+		lower_limit[dimension] = middle;
+		children.push_back(detail::GenzMalikBox<N>(lower_limit, upper_limit));
+	}
+
+	box_list_type boxes;
+	boxes.reserve(fBoxList.size() + split.size());
+
+	for(size_t i=0; i<fBoxList.size(); i++)
+		if( !is_split[i] ) boxes.push_back(fBoxList[i]);
 
+	size_t first_box = boxes.size();
+
+	boxes.insert(boxes.end(), children.begin(), children.end());
+	fBoxList.swap(boxes);
+
+	return first_box;
+}
+
+template<size_t N, hydra::detail::Backend  BACKEND>
+std::pair<GReal_t, GReal_t> GenzMalikQuadrature<N,hydra::detail::BackendPolicy<BACKEND>>::Accumulate() const
+{
+	GReal_t integral=0;
+	GReal_t    error=0;
+
+	for(auto const& box:fBoxList)
+	{
+		integral+= box.GetIntegral();
+		error   +=  box.GetError();
+	}
 
 	return std::pair<GReal_t, GReal_t>(integral, error);
 }
 
+template<size_t N, hydra::detail::Backend  BACKEND>
+template<typename FUNCTOR>
+std::pair<GReal_t, GReal_t> GenzMalikQuadrature<N,hydra::detail::BackendPolicy<BACKEND>>::Integrate(FUNCTOR const& functor)
+{
+	EvaluateBoxes(functor, 0);
+
+	std::pair<GReal_t, GReal_t> result = Accumulate();
+
+	while( fMaxRelativeError > 0.0 &&
+			result.second > std::fabs(result.first)*fMaxRelativeError &&
+			result.second > std::numeric_limits<GReal_t>::epsilon() )
+	{
+		//split the largest errors until the unsplit boxes take at most half of the tolerance
+		size_t first_box = SplitBoxes( 0.5*std::fabs(result.first)*fMaxRelativeError );
+
+		if( first_box == fBoxList.size() )
+		{
+			HYDRA_LOG(WARNING, "Genz-Malik adaptive integration stopped at the maximum number of boxes before reaching the requested tolerance.")
+			break;
+		}
+
+		EvaluateBoxes(functor, first_box);
+
+		result = Accumulate();
+	}
+
+	return result;
+}
+
+
+
+template<size_t N, hydra::detail::Backend  BACKEND>
+template<typename ...FUNCTORS>
+std::vector<std::pair<GReal_t, GReal_t>>
+GenzMalikQuadrature<N,hydra::detail::BackendPolicy<BACKEND>>::Integrate(HYDRA_EXTERNAL_NS::thrust::tuple<FUNCTORS...> const& functors)
+{
+	typedef detail::ProcessGenzMalikBoxesMulti<N, HYDRA_EXTERNAL_NS::thrust::tuple<FUNCTORS...>, const_rule_iterator> call_t;
+	typedef detail::GenzMalikMultiCall<call_t::K> sums_t;
+
+	size_t nboxes = fBoxList.size();
+	size_t nrule  = fGenzMalikRule.GetAbscissas().size();
+
+	SetLimits(0);
+
+	fKeys.resize(nboxes);
+	typename system_t::template container<sums_t> box_sums(nboxes);
+
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> first(0);
 
+	auto keys = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(first,
+			detail::GenzMalikBoxIndex(nrule));
+
+	auto values = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(first,
+			call_t(functors, fGenzMalikRule.GetAbscissas().begin(), nrule,
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fLimits.data())));
+
+	HYDRA_EXTERNAL_NS::thrust::reduce_by_key(system_t(), keys, keys + nboxes*nrule, values,
+			fKeys.begin(), box_sums.begin(),
+			HYDRA_EXTERNAL_NS::thrust::equal_to<size_t>(),
+			detail::ProcessGenzMalikMultiBinary<call_t::K>());
+
+	std::vector<sums_t> sums(box_sums.begin(), box_sums.end());
+
+	std::vector<std::pair<GReal_t, GReal_t>> results(call_t::K, std::pair<GReal_t, GReal_t>(0.0, 0.0));
+
+	for(size_t i=0; i<nboxes; i++)
+	{
+		GReal_t factor = fBoxList[i].GetVolume()/hydra::detail::power<2, N>::value;
+
+		for(size_t k=0; k<call_t::K; k++)
+		{
+			results[k].first  += factor*sums[i].fRule7[k];
+			results[k].second += factor*std::fabs(sums[i].fRule7[k] - sums[i].fRule5[k]);
+		}
+	}
+
+	return results;
+}
 
 } // namespace hydra
 
@@ -37,6 +37,7 @@
 #include <hydra/detail/Config.h>
 #include <hydra/Types.h>
 #include <utility>
+#include <vector>
 
 namespace hydra {
 
@@ -54,6 +55,18 @@ struct Integrator{
 	return result;
 	}
 
+	/**
+	 * Integral of the functor and of its derivatives with respect to its parameters,
+	 * calculated from the same function calls. Available for the integrators implementing
+	 * Integrate(functor, gradient) and functors implementing ParameterGradient(n, x, gradient).
+	 * The integral and the error of each derivative are stored in gradient.
+	 */
+	template<typename FUNCTOR>
+	inline std::pair<GReal_t, GReal_t> operator()( FUNCTOR  const & functor, std::vector<std::pair<GReal_t, GReal_t>>& gradient)
+	{
+		return static_cast<ALGORITHM*>(this)->Integrate(functor, gradient);
+	}
+
 
 
 };
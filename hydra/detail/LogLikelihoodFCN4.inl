@@ -0,0 +1,260 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * LogLikelihoodFCN4.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef LOGLIKELIHOODFCN4_INL_
+#define LOGLIKELIHOODFCN4_INL_
+
+#include <hydra/FCN.h>
+#include <hydra/Pdf.h>
+#include <hydra/PDFSumExtendable.h>
+#include <hydra/PDFSumNonExtendable.h>
+#include <hydra/ChunkedSource.h>
+#include <hydra/detail/functors/LogLikelihood1.h>
+#include <hydra/detail/external/thrust/functional.h>
+
+#include <cmath>
+#include <sstream>
+
+namespace hydra {
+
+/**
+ * \ingroup fit
+ * \brief LogLikehood object for not composed models represented by hydra::Pdf objects, on
+ * datasets read in chunks from a hydra::ChunkedSource.
+ */
+template<typename Functor, typename Integrator, typename ...T, hydra::detail::Backend BACKEND>
+class LogLikelihoodFCN< Pdf<Functor,Integrator>, ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> >:
+public FCN<LogLikelihoodFCN< Pdf<Functor,Integrator>, ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> > >
+{
+	typedef ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> source_type;
+	typedef LogLikelihoodFCN< Pdf<Functor,Integrator>, source_type> this_type;
+
+public:
+
+	LogLikelihoodFCN(Pdf<Functor,Integrator> const& functor, source_type const& source):
+		FCN<this_type>(functor, source)
+		{}
+
+	LogLikelihoodFCN(this_type const& other):
+		FCN<this_type>(other)
+		{}
+
+	this_type& operator=(this_type const& other)
+	{
+		if(this==&other) return  *this;
+		FCN<this_type>::operator=(other);
+
+		return  *this;
+	}
+
+	inline double Eval( const std::vector<double>& parameters ) const{
+
+		typedef typename Pdf<Functor,Integrator>::functor_type functor_type;
+
+		if (INFO >= Print::Level()  )
+		{
+			std::ostringstream stringStream;
+			for(size_t i=0; i< parameters.size(); i++){
+				stringStream << "Parameter["<< i<<"] :  " << parameters[i]  << "  ";
+			}
+			HYDRA_LOG(INFO, stringStream.str().c_str() )
+		}
+
+		const_cast< this_type* >(this)->GetPDF().SetParameters(parameters);
+
+		auto NLL = detail::LogLikelihood1<functor_type>(this->GetPDF().GetFunctor());
+
+		GReal_t final = this->GetSource().TransformReduce(NLL, GReal_t(0), HYDRA_EXTERNAL_NS::thrust::plus<GReal_t>());
+
+		return (GReal_t)this->GetDataSize() -final ;
+	}
+
+};
+
+/**
+ * \ingroup fit
+ * \brief LogLikehood object for composed models represented by hydra::PDFSumExtendable<Pdfs...> objects, on
+ * datasets read in chunks from a hydra::ChunkedSource.
+ */
+template<typename ...Pdfs, typename ...T, hydra::detail::Backend BACKEND>
+class LogLikelihoodFCN< PDFSumExtendable<Pdfs...>, ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> >:
+public FCN<LogLikelihoodFCN< PDFSumExtendable<Pdfs...>, ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> > >
+{
+	typedef ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> source_type;
+	typedef LogLikelihoodFCN< PDFSumExtendable<Pdfs...>, source_type> this_type;
+
+public:
+
+	LogLikelihoodFCN(PDFSumExtendable<Pdfs...> const& functor, source_type const& source):
+		FCN<this_type>(functor, source)
+		{}
+
+	LogLikelihoodFCN(this_type const& other):
+		FCN<this_type>(other)
+		{}
+
+	this_type& operator=(this_type const& other)
+	{
+		if(this==&other) return  *this;
+		FCN<this_type>::operator=(other);
+
+		return  *this;
+	}
+
+	inline double Eval( const std::vector<double>& parameters ) const{
+
+		typedef typename PDFSumExtendable<Pdfs...>::functor_type functor_type;
+
+		if (INFO >= Print::Level()  )
+		{
+			std::ostringstream stringStream;
+			for(size_t i=0; i< parameters.size(); i++){
+				stringStream << "Parameter["<< i<<"] :  " << parameters[i]  << "  ";
+			}
+			HYDRA_LOG(INFO, stringStream.str().c_str() )
+		}
+
+		const_cast< this_type* >(this)->GetPDF().SetParameters(parameters);
+
+		auto NLL = detail::LogLikelihood1<functor_type>(this->GetPDF().GetFunctor());
+
+		GReal_t final = this->GetSource().TransformReduce(NLL, GReal_t(0), HYDRA_EXTERNAL_NS::thrust::plus<GReal_t>());
+
+		GReal_t  r = (GReal_t)this->GetDataSize() + this->GetPDF().IsExtended()*
+				( this->GetPDF().GetCoefSum() -	this->GetDataSize()*log(this->GetPDF().GetCoefSum() ) ) - final;
+
+		return r;
+	}
+
+};
+
+/**
+ * \ingroup fit
+ * \brief LogLikehood object for composed models represented by hydra::PDFSumNonExtendable<Pdfs...> objects, on
+ * datasets read in chunks from a hydra::ChunkedSource.
+ */
+template<typename ...Pdfs, typename ...T, hydra::detail::Backend BACKEND>
+class LogLikelihoodFCN< PDFSumNonExtendable<Pdfs...>, ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> >:
+public FCN<LogLikelihoodFCN< PDFSumNonExtendable<Pdfs...>, ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> > >
+{
+	typedef ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> source_type;
+	typedef LogLikelihoodFCN< PDFSumNonExtendable<Pdfs...>, source_type> this_type;
+
+public:
+
+	LogLikelihoodFCN(PDFSumNonExtendable<Pdfs...> const& functor, source_type const& source):
+		FCN<this_type>(functor, source)
+		{}
+
+	LogLikelihoodFCN(this_type const& other):
+		FCN<this_type>(other)
+		{}
+
+	this_type& operator=(this_type const& other)
+	{
+		if(this==&other) return  *this;
+		FCN<this_type>::operator=(other);
+
+		return  *this;
+	}
+
+	inline double Eval( const std::vector<double>& parameters ) const{
+
+		typedef typename PDFSumNonExtendable<Pdfs...>::functor_type functor_type;
+
+		if (INFO >= Print::Level()  )
+		{
+			std::ostringstream stringStream;
+			for(size_t i=0; i< parameters.size(); i++){
+				stringStream << "Parameter["<< i<<"] :  " << parameters[i]  << "  ";
+			}
+			HYDRA_LOG(INFO, stringStream.str().c_str() )
+		}
+
+		const_cast< this_type* >(this)->GetPDF().SetParameters(parameters);
+
+		auto NLL = detail::LogLikelihood1<functor_type>(this->GetPDF().GetFunctor());
+
+		GReal_t final = this->GetSource().TransformReduce(NLL, GReal_t(0), HYDRA_EXTERNAL_NS::thrust::plus<GReal_t>());
+
+		return (GReal_t)this->GetDataSize() - final;
+	}
+
+};
+
+/**
+ * \ingroup fit
+ * \brief Conveniency function to build up loglikehood fcns on datasets read in chunks
+ * @param pdf hydra::Pdf object
+ * @param source hydra::ChunkedSource delivering the dataset
+ * @return
+ */
+template<typename Functor, typename Integrator, typename ...T, hydra::detail::Backend BACKEND>
+auto make_loglikehood_fcn(Pdf<Functor,Integrator> const& pdf,
+		ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> const& source)
+-> LogLikelihoodFCN< Pdf<Functor,Integrator>, ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> >
+{
+	return LogLikelihoodFCN< Pdf<Functor,Integrator>,
+			ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> >(pdf, source);
+}
+
+/**
+ * \ingroup fit
+ * \brief Conveniency function to build up loglikehood fcns on datasets read in chunks
+ * @param pdf hydra::PDFSumExtendable object
+ * @param source hydra::ChunkedSource delivering the dataset
+ * @return
+ */
+template<typename ...Pdfs, typename ...T, hydra::detail::Backend BACKEND>
+auto make_loglikehood_fcn(PDFSumExtendable<Pdfs...> const& pdf,
+		ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> const& source)
+-> LogLikelihoodFCN< PDFSumExtendable<Pdfs...>, ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> >
+{
+	return LogLikelihoodFCN< PDFSumExtendable<Pdfs...>,
+			ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> >(pdf, source);
+}
+
+/**
+ * \ingroup fit
+ * \brief Conveniency function to build up loglikehood fcns on datasets read in chunks
+ * @param pdf hydra::PDFSumNonExtendable object
+ * @param source hydra::ChunkedSource delivering the dataset
+ * @return
+ */
+template<typename ...Pdfs, typename ...T, hydra::detail::Backend BACKEND>
+auto make_loglikehood_fcn(PDFSumNonExtendable<Pdfs...> const& pdf,
+		ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> const& source)
+-> LogLikelihoodFCN< PDFSumNonExtendable<Pdfs...>, ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> >
+{
+	return LogLikelihoodFCN< PDFSumNonExtendable<Pdfs...>,
+			ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> >(pdf, source);
+}
+
+}  // namespace hydra
+
+#endif /* LOGLIKELIHOODFCN4_INL_ */
@@ -0,0 +1,254 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * Miser.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef MISER_INL_
+#define MISER_INL_
+
+#include <limits>
+#include <cmath>
+
+namespace hydra {
+
+template< size_t N,hydra::detail::Backend BACKEND, typename GRND>
+size_t Miser<N,hydra::detail::BackendPolicy<BACKEND>,GRND>::SetRegions(
+		std::vector<hydra::detail::MiserRegion<N>> const& regions, std::vector<size_t> const& calls)
+{
+	std::vector<size_t> offsets(regions.size()+1, 0);
+
+	for(size_t i=0; i<regions.size(); i++)
+		offsets[i+1] = offsets[i] + calls[i];
+
+	fRegions = regions;
+	fOffsets = offsets;
+
+	return offsets.back();
+}
+
+template< size_t N,hydra::detail::Backend BACKEND, typename GRND>
+void Miser<N,hydra::detail::BackendPolicy<BACKEND>,GRND>::Bisect(
+		hydra::detail::MiserRegion<N> const& region,
+		hydra::detail::MiserExploreState<N> const& state, size_t calls,
+		std::vector<hydra::detail::MiserRegion<N>>& children) const
+{
+	GReal_t beta = 2.0/(1.0 + fAlpha);
+
+	size_t  best_dim    = N;
+	GReal_t best_spread = std::numeric_limits<GReal_t>::max();
+	GReal_t weight_low  = 1.0;
+	GReal_t weight_up   = 1.0;
+
+	for(size_t j=0; j<N; j++){
+
+		GReal_t n_low = state.fNLow[j];
+		GReal_t n_up  = state.fN - n_low;
+
+		//variances need at least two calls in each half
+		if(n_low < 2.0 || n_up < 2.0) continue;
+
+		GReal_t mean_low = state.fSumLow[j]/n_low;
+		GReal_t mean_up  = (state.fSum - state.fSumLow[j])/n_up;
+
+		GReal_t var_low  = state.fSum2Low[j]/n_low - mean_low*mean_low;
+		GReal_t var_up   = (state.fSum2 - state.fSum2Low[j])/n_up - mean_up*mean_up;
+
+		GReal_t w_low = ::pow( ::sqrt(var_low > 0.0 ? var_low : 0.0), beta);
+		GReal_t w_up  = ::pow( ::sqrt(var_up  > 0.0 ? var_up  : 0.0), beta);
+
+		if( w_low + w_up < best_spread){
+
+			best_dim    = j;
+			best_spread = w_low + w_up;
+			weight_low  = w_low;
+			weight_up   = w_up;
+		}
+	}
+
+	//no usable estimate: bisect the widest dimension
+	if(best_dim == N){
+
+		GReal_t widest = 0.0;
+
+		for(size_t j=0; j<N; j++){
+
+			GReal_t width = (region.fXUp[j] - region.fXLow[j])/(fXUp[j] - fXLow[j]);
+
+			if(width > widest){ widest = width; best_dim = j; }
+		}
+	}
+
+	if( !(weight_low + weight_up > 0.0) ){ weight_low = 1.0; weight_up = 1.0; }
+
+	size_t calls_low = fMinCalls + size_t( (calls - 2*fMinCalls)*weight_low/(weight_low + weight_up) );
+
+	GReal_t middle = 0.5*(region.fXLow[best_dim] + region.fXUp[best_dim]);
+
+	hydra::detail::MiserRegion<N> low(region);
+	low.fXUp[best_dim] = middle;
+	low.fCalls = calls_low;
+
+	hydra::detail::MiserRegion<N> up(region);
+	up.fXLow[best_dim] = middle;
+	up.fCalls = calls - calls_low;
+
+	children.push_back(low);
+	children.push_back(up);
+}
+
+template< size_t N,hydra::detail::Backend BACKEND, typename GRND>
+template<typename FUNCTOR>
+inline std::pair<GReal_t, GReal_t>
+Miser<N,hydra::detail::BackendPolicy<BACKEND>,GRND>::Integrate(FUNCTOR const& fFunctor)
+{
+	typedef hydra::detail::MiserRegion<N> region_t;
+	typedef hydra::detail::MiserExploreState<N> explore_t;
+
+	assert(fNCalls >= 2*fMinCalls && "HYDRA MESSAGE: Miser needs at least 2*GetMinCalls() calls");
+
+	region_t root;
+
+	for(size_t j=0; j<N; j++){
+		root.fXLow[j] = fXLow[j];
+		root.fXUp[j]  = fXUp[j];
+	}
+	root.fCalls = fNCalls;
+
+	std::vector<region_t> active(1, root);
+	std::vector<region_t> leaves;
+	std::vector<region_t> explored;
+	std::vector<size_t>   calls;
+
+	//global index of the first call of the next launch
+	size_t first_call = 0;
+
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> first(0);
+
+	//one launch per level of the recursion
+	while( !active.empty() ){
+
+		explored.clear();
+		calls.clear();
+
+		for(auto const& region: active){
+
+			size_t estimate_calls = size_t(fEstimateFraction*region.fCalls);
+
+			if(estimate_calls < fMinCalls) estimate_calls = fMinCalls;
+
+			//each half needs at least fMinCalls after the exploration
+			if(region.fCalls < fMinCallsPerBisection || region.fCalls < estimate_calls + 2*fMinCalls){
+				leaves.push_back(region);
+				continue;
+			}
+
+			explored.push_back(region);
+			calls.push_back(estimate_calls);
+		}
+
+		active.clear();
+
+		if( explored.empty() ) break;
+
+		size_t ncalls = SetRegions(explored, calls);
+
+		fKeys.resize(explored.size());
+		fExploreStates.resize(explored.size());
+
+		auto keys = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(first,
+				hydra::detail::MiserRegionIndex(explored.size(),
+						HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fOffsets.data())));
+
+		auto values = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(first,
+				hydra::detail::ProcessCallsMiserExplore<FUNCTOR,N,GRND>(fSeed, first_call, explored.size(),
+						HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fRegions.data()),
+						HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fOffsets.data()), fFunctor));
+
+		HYDRA_EXTERNAL_NS::thrust::reduce_by_key(system_t(), keys, keys + ncalls, values,
+				fKeys.begin(), fExploreStates.begin(),
+				HYDRA_EXTERNAL_NS::thrust::equal_to<size_t>(),
+				hydra::detail::ProcessExploreStatesMiser<N>());
+
+		first_call += ncalls;
+
+		std::vector<explore_t> states(fExploreStates.begin(), fExploreStates.end());
+
+		for(size_t i=0; i<explored.size(); i++)
+			Bisect(explored[i], states[i], explored[i].fCalls - calls[i], active);
+	}
+
+	//plain Monte Carlo in all terminal regions
+	calls.clear();
+
+	for(auto const& region: leaves) calls.push_back(region.fCalls);
+
+	size_t ncalls = SetRegions(leaves, calls);
+
+	fKeys.resize(leaves.size());
+	fLeafStates.resize(leaves.size());
+
+	auto keys = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(first,
+			hydra::detail::MiserRegionIndex(leaves.size(),
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fOffsets.data())));
+
+	auto values = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(first,
+			hydra::detail::ProcessCallsMiserLeaf<FUNCTOR,N,GRND>(fSeed, first_call, leaves.size(),
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fRegions.data()),
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fOffsets.data()), fFunctor));
+
+	HYDRA_EXTERNAL_NS::thrust::reduce_by_key(system_t(), keys, keys + ncalls, values,
+			fKeys.begin(), fLeafStates.begin(),
+			HYDRA_EXTERNAL_NS::thrust::equal_to<size_t>(),
+			hydra::detail::ProcessCallsPlainBinary());
+
+	std::vector<PlainState> states(fLeafStates.begin(), fLeafStates.end());
+
+	GReal_t result   = 0.0;
+	GReal_t variance = 0.0;
+
+	for(size_t i=0; i<leaves.size(); i++){
+
+		GReal_t volume = 1.0;
+
+		for(size_t j=0; j<N; j++)
+			volume *= leaves[i].fXUp[j] - leaves[i].fXLow[j];
+
+		GReal_t n = states[i].fN;
+
+		result   += volume*states[i].fMean;
+		variance += volume*volume*states[i].fM2/(n*(n-1));
+	}
+
+	fNRegions = leaves.size();
+	fResult   = result;
+	fAbsError = ::sqrt(variance);
+
+	return std::make_pair(fResult, fAbsError);
+}
+
+}  // namespace hydra
+
+#endif /* MISER_INL_ */
@@ -142,7 +142,35 @@ PhaseSpace<N,GRND>::AverageOn(hydra::detail::BackendPolicy<BACKEND>const& policy
 		HYDRA_LOG(WARNING, "Not enough energy to generate all decays.Check the mass of the mother particle")
 	}
 
-	return std::make_pair(result.fMean, ::sqrt(result.fM2)/result.fW );
+	return std::make_pair(result.fMean, result.Error() );
+
+}
+
+template <size_t N, typename GRND>
+template<typename FUNCTOR, hydra::detail::Backend BACKEND>
+std::pair<GReal_t, GReal_t>
+PhaseSpace<N,GRND>::AverageOn(hydra::detail::BackendPolicy<BACKEND>const& policy,
+		Vector4R const& mother, FUNCTOR const& functor, size_t n, PhaseSpaceSampling sampling){
+
+	detail::StatsRatio result;
+
+	if (EnergyChecker( mother )){
+
+		detail::AverageMotherVR<N,GRND,FUNCTOR>
+		reducer( mother,fMasses, fSeed,functor, sampling, n);
+
+		result = detail::launch_reducer(policy, reducer );
+
+	}
+	else {
+		HYDRA_LOG(WARNING, "Not enough energy to generate all decays.Check the mass of the mother particle")
+	}
+
+	if( result.fN < 2 ){
+		HYDRA_LOG(WARNING, "Too few samples to estimate the error.")
+	}
+
+	return std::make_pair(result.Ratio(), result.Error() );
 
 }
 
@@ -164,7 +192,7 @@ PhaseSpace<N,GRND>::AverageOn(Iterator begin, Iterator end, FUNCTOR const& funct
 		HYDRA_LOG(WARNING, "Not enough energy to generate all decays.Check the masses of the mother particles")
 	}
 
-	return std::make_pair(result.fMean, ::sqrt(result.fM2)/ result.fW);
+	return std::make_pair(result.fMean, result.Error());
 }
 
 template <size_t N, typename GRND>
@@ -302,6 +330,65 @@ void PhaseSpace<N,GRND>::Generate(hydra::detail::BackendPolicy<BACKEND> const& e
 
 }
 
+//========================
+template <size_t N, typename GRND>
+template<typename FUNCTOR, hydra::detail::Backend BACKEND>
+std::pair<GReal_t, GReal_t>
+PhaseSpace<N,GRND>::AverageOn(MotherTable<N, hydra::detail::BackendPolicy<BACKEND>> const& table,
+		FUNCTOR const& functor) {
+
+	detail::StatsPHSP result ;
+
+	if (TableChecker( table )){
+
+		const GReal_t* columns[detail::MOTHER_NCOLUMNS];
+		table.GetColumns(columns);
+
+		detail::AverageTable<N,GRND,FUNCTOR> reducer( fMasses, fSeed, columns, functor);
+
+		result = detail::launch_reducer(hydra::detail::BackendPolicy<BACKEND>(), table.size(), reducer );
+
+	}
+
+	return std::make_pair(result.fMean, result.Error());
+}
+
+template <size_t N, typename GRND>
+template<typename ...FUNCTOR, typename Iterator, hydra::detail::Backend BACKEND>
+void PhaseSpace<N,GRND>::Evaluate(MotherTable<N, hydra::detail::BackendPolicy<BACKEND>> const& table,
+		Iterator begin, FUNCTOR const& ...functors) {
+
+	if (TableChecker( table )){
+
+		const GReal_t* columns[detail::MOTHER_NCOLUMNS];
+		table.GetColumns(columns);
+
+		detail::EvalTable<N,GRND,FUNCTOR...> evaluator( fMasses, fSeed, columns, functors...);
+
+		detail::launch_evaluator(hydra::detail::BackendPolicy<BACKEND>(), table.size(), begin, evaluator );
+
+	}
+
+}
+
+template <size_t N, typename GRND>
+template<typename Iterator, hydra::detail::Backend BACKEND>
+void PhaseSpace<N,GRND>::Generate(MotherTable<N, hydra::detail::BackendPolicy<BACKEND>> const& table,
+		Iterator daughters_begin){
+
+	if (TableChecker( table )){
+
+		const GReal_t* columns[detail::MOTHER_NCOLUMNS];
+		table.GetColumns(columns);
+
+		detail::DecayTable<N,GRND> decayer( fMasses, fSeed, columns);
+
+		detail::launch_decayer(hydra::detail::BackendPolicy<BACKEND>(), table.size(), daughters_begin, decayer );
+
+	}
+
+}
+
 
 template <size_t N, typename GRND>
 inline GInt_t PhaseSpace<N,GRND>::GetSeed() const	{
@@ -345,9 +432,30 @@ inline bool PhaseSpace<N,GRND>::EnergyChecker( Vector4R const& mother) const {
 				fTeCmTm -= fMasses[n];
 			}
 
-			return (bool) fTeCmTm > 0.0;
+			return fTeCmTm > 0.0;
 }
 
+template <size_t N, typename GRND>
+template<hydra::detail::Backend BACKEND>
+inline bool PhaseSpace<N,GRND>::TableChecker( MotherTable<N, hydra::detail::BackendPolicy<BACKEND>> const& table) const {
+
+	for(size_t i=0; i<N; i++){
+
+		if( table.GetMasses()[i] != fMasses[i] ){
+
+			HYDRA_LOG(WARNING, "The daughter masses of the MotherTable do not match the ones of the PhaseSpace generator.")
+			return false;
+		}
+	}
+
+	if( !table.IsPhysical() ){
+
+		HYDRA_LOG(WARNING, "Not enough energy to generate all decays.Check the masses of the mother particles")
+		return false;
+	}
+
+	return true;
+}
 
 
 }//namespace hydra
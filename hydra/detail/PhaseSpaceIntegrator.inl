@@ -36,9 +36,75 @@ template<typename FUNCTOR>
 std::pair<GReal_t, GReal_t>
 PhaseSpaceIntegrator<N,hydra::detail::BackendPolicy<BACKEND>, GRND>::Integrate(  FUNCTOR  const& functor)
 {
+ if( fTolerance > 0.0 )
+	 return IntegrateAdaptive(functor);
+
+ fNSamplesUsed = fNSamples;
+
+ if( fSampling != PlainSampling )
+	 return	fGenerator.AverageOn(hydra::detail::BackendPolicy<BACKEND>(),  fMother, functor, fNSamples, fSampling );
+
  return	fGenerator.AverageOn(hydra::detail::BackendPolicy<BACKEND>(),  fMother, functor, fNSamples );
 }
 
+template <size_t N, hydra::detail::Backend BACKEND, typename GRND>
+template<typename FUNCTOR>
+std::pair<GReal_t, GReal_t>
+PhaseSpaceIntegrator<N,hydra::detail::BackendPolicy<BACKEND>, GRND>::IntegrateAdaptive(  FUNCTOR  const& functor)
+{
+	fNSamplesUsed = 0;
+
+	GReal_t teCmTm = fMother.mass();
+
+	for(size_t i=0; i<N; i++)
+		teCmTm -= fGenerator.GetMasses()[i];
+
+	if( teCmTm <= 0.0 ){
+
+		HYDRA_LOG(WARNING, "Not enough energy to generate all decays.Check the mass of the mother particle")
+		return std::make_pair(0.0, 0.0);
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	detail::AverageMotherVR<N,GRND,FUNCTOR> reducer( fMother, fGenerator.GetMasses(),
+			fGenerator.GetSeed(), functor, fSampling, fNSamples);
+
+	detail::StatsRatio result;
+
+	for(size_t batch=0; ; batch++ ){
+
+		reducer.SetBatch(batch);
+
+		result = detail::AddStatsRatio()(result,
+				detail::launch_reducer(hydra::detail::BackendPolicy<BACKEND>(), reducer ));
+
+		fNSamplesUsed += reducer.GetNSamples();
+
+		//converged
+		if( result.fN > 1 && result.Error() <= fTolerance*::fabs(result.Ratio()) ) break;
+
+		//out of events. Without any limit set, stop after GetMaxBatches() batches
+		size_t max_samples = (fMaxSamples==0 && fMaxTime <= 0.0) ? fMaxBatches*fNSamples : fMaxSamples;
+
+		if( max_samples > 0 && fNSamplesUsed >= max_samples ) {
+
+			HYDRA_LOG(WARNING, "Maximum number of samples reached before the requested tolerance.")
+			break;
+		}
+
+		//out of time
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+		if( fMaxTime > 0.0 && elapsed.count() >= fMaxTime ) {
+
+			HYDRA_LOG(WARNING, "Time budget exhausted before the requested tolerance.")
+			break;
+		}
+	}
+
+	return std::make_pair(result.Ratio(), result.Error());
+}
 
 }  // namespace hydra
 
@@ -58,6 +58,57 @@ Plain<N,hydra::detail::BackendPolicy<BACKEND>,GRND>::Integrate(FUNCTOR const& fF
 
 }
 
+template< size_t N,hydra::detail::Backend BACKEND, typename GRND>
+template<typename ...FUNCTORS>
+inline std::vector<std::pair<GReal_t, GReal_t>>
+Plain<N,hydra::detail::BackendPolicy<BACKEND>,GRND>::Integrate(HYDRA_EXTERNAL_NS::thrust::tuple<FUNCTORS...> const& fFunctors)
+{
+	return IntegrateMulti( detail::MultiEvaluator<HYDRA_EXTERNAL_NS::thrust::tuple<FUNCTORS...>, false>(fFunctors) );
+}
+
+template< size_t N,hydra::detail::Backend BACKEND, typename GRND>
+template<typename FUNCTOR>
+inline std::pair<GReal_t, GReal_t>
+Plain<N,hydra::detail::BackendPolicy<BACKEND>,GRND>::Integrate(FUNCTOR const& fFunctor, std::vector<std::pair<GReal_t, GReal_t>>& gradient)
+{
+	auto results = IntegrateMulti( detail::MultiEvaluator<FUNCTOR, true>(fFunctor) );
+
+	gradient.resize(results.size() - 1);
+
+	for(size_t k=1; k<results.size(); k++) gradient[k-1] = results[k];
+
+	return results[0];
+}
+
+template< size_t N,hydra::detail::Backend BACKEND, typename GRND>
+template<typename EVALUATOR>
+inline std::vector<std::pair<GReal_t, GReal_t>>
+Plain<N,hydra::detail::BackendPolicy<BACKEND>,GRND>::IntegrateMulti(EVALUATOR const& evaluator)
+{
+	typedef detail::ProcessCallsPlainMultiUnary<EVALUATOR,N,GRND> unary_t;
+
+	// create iterators
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> first(0);
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> last = first + fNCalls;
+
+	// compute the summary statistics of all values in one pass
+	detail::PlainStates<unary_t::K> result = HYDRA_EXTERNAL_NS::thrust::transform_reduce(system_t(), first, last,
+			unary_t(HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fXLow.data()),
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fDeltaX.data()), fSeed, evaluator),
+			detail::PlainStates<unary_t::K>(), detail::ProcessCallsPlainMultiBinary<unary_t::K>() );
+
+	std::vector<std::pair<GReal_t, GReal_t>> results;
+
+	for(size_t k=0; k<unary_t::K; k++)
+		results.push_back( std::make_pair(fVolume*result.fStates[k].fMean,
+				fVolume*sqrt( result.fStates[k].fM2/((fNCalls-1)*(fNCalls-1)) )) );
+
+	fResult   = results[0].first;
+	fAbsError = results[0].second;
+
+	return results;
+}
+
 }
 
 //#endif /* PLAIN_INL_ */
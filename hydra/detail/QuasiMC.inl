@@ -0,0 +1,140 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * QuasiMC.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef QUASIMC_INL_
+#define QUASIMC_INL_
+
+namespace hydra {
+
+template< size_t N,hydra::detail::Backend BACKEND, typename GRND>
+void QuasiMC<N,hydra::detail::BackendPolicy<BACKEND>,GRND>::GenerateScrambling(std::vector<GUInt_t>& generators) const
+{
+	using hydra::detail::SOBOL_BITS;
+	using hydra::detail::QUASIMC_WORDS;
+
+	GRND randEng(fSeed);
+	HYDRA_EXTERNAL_NS::thrust::uniform_int_distribution<GUInt_t> uniDist(0, 0xFFFF);
+
+	auto random_word = [&]() -> GUInt_t {
+		GUInt_t high = uniDist(randEng);
+		return (high << 16) | uniDist(randEng);
+	};
+
+	auto parity = [](GUInt_t x) -> GUInt_t {
+		x ^= x >> 16; x ^= x >> 8; x ^= x >> 4; x ^= x >> 2; x ^= x >> 1;
+		return x & 1u;
+	};
+
+	GUInt_t directions[N][SOBOL_BITS];
+
+	for(size_t j=0; j<N; j++)
+		hydra::detail::sobol_direction_numbers(j, directions[j]);
+
+	generators.resize(fNReplicas*N*QUASIMC_WORDS);
+
+	for(size_t r=0; r<fNReplicas; r++){
+		for(size_t j=0; j<N; j++){
+
+			//lower triangular matrix with unit diagonal acting on the binary digits,
+			//the row of the digit k (bit SOBOL_BITS-1-k) mixes it with the more significant ones
+			GUInt_t rows[SOBOL_BITS];
+
+			for(size_t k=0; k<SOBOL_BITS; k++){
+
+				GUInt_t bit  = 1u << (SOBOL_BITS-1-k);
+				GUInt_t high = ~(bit | (bit-1));
+
+				rows[k] = bit | (random_word() & high);
+			}
+
+			GUInt_t* v = &generators[(r*N + j)*QUASIMC_WORDS];
+
+			for(size_t b=0; b<SOBOL_BITS; b++){
+
+				GUInt_t scrambled = 0;
+
+				for(size_t k=0; k<SOBOL_BITS; k++)
+					scrambled |= parity(rows[k] & directions[j][b]) << (SOBOL_BITS-1-k);
+
+				v[b] = scrambled;
+			}
+
+			v[SOBOL_BITS] = random_word();
+		}
+	}
+}
+
+template< size_t N,hydra::detail::Backend BACKEND, typename GRND>
+template<typename FUNCTOR>
+inline std::pair<GReal_t, GReal_t>
+QuasiMC<N,hydra::detail::BackendPolicy<BACKEND>,GRND>::Integrate(FUNCTOR const& fFunctor)
+{
+	size_t npoints = fNCalls/fNReplicas;
+
+	assert(npoints > 0 && "HYDRA MESSAGE: QuasiMC needs at least one call per replica");
+	assert(npoints <= (size_t(1) << hydra::detail::SOBOL_BITS)
+			&& "HYDRA MESSAGE: QuasiMC supports at most 2^32 calls per replica");
+
+	std::vector<GUInt_t> generators;
+	GenerateScrambling(generators);
+	fGenerators = generators;
+
+	const GReal_t* xlow   = HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fXLow.data());
+	const GReal_t* deltax = HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fDeltaX.data());
+	const GUInt_t* gen    = HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fGenerators.data());
+
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> first(0);
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> last = first + npoints;
+
+	//one launch per replica, the replica estimates are combined on the host
+	GReal_t mean = 0.0;
+	GReal_t m2   = 0.0;
+
+	for(size_t r=0; r<fNReplicas; r++){
+
+		GReal_t sum = HYDRA_EXTERNAL_NS::thrust::transform_reduce(system_t(), first, last,
+				detail::ProcessCallsQuasiMCUnary<FUNCTOR,N>(xlow, deltax,
+						gen + r*N*hydra::detail::QUASIMC_WORDS, fFunctor),
+				GReal_t(0.0), HYDRA_EXTERNAL_NS::thrust::plus<GReal_t>() );
+
+		GReal_t estimate = fVolume*sum/npoints;
+		GReal_t delta    = estimate - mean;
+
+		mean += delta/(r+1);
+		m2   += delta*(estimate - mean);
+	}
+
+	fResult   = mean;
+	fAbsError = ::sqrt( m2/(fNReplicas*(fNReplicas-1)) );
+
+	return std::make_pair(fResult, fAbsError);
+}
+
+}  // namespace hydra
+
+#endif /* QUASIMC_INL_ */
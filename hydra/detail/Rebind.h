@@ -0,0 +1,195 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * Rebind.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+/**
+ * \file
+ * \ingroup generic
+ */
+
+#ifndef REBIND_H_
+#define REBIND_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/BackendPolicy.h>
+#include <hydra/detail/utility/Generic.h>
+#include <hydra/detail/external/thrust/tuple.h>
+#include <hydra/detail/external/thrust/iterator/zip_iterator.h>
+#include <hydra/detail/external/thrust/iterator/iterator_traits.h>
+#include <hydra/detail/external/thrust/detail/raw_pointer_cast.h>
+#include <hydra/detail/external/thrust/detail/allocator/malloc_allocator.h>
+#include <hydra/detail/external/thrust/device_malloc_allocator.h>
+#include <hydra/detail/external/thrust/system/cpp/detail/execution_policy.h>
+
+#include <memory>
+#include <type_traits>
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * Thrust systems accessing plain host memory (cpp, omp and tbb) derive from the cpp system.
+ */
+template<typename System>
+struct is_host_system: std::is_base_of<
+	HYDRA_EXTERNAL_NS::thrust::system::cpp::detail::execution_policy<System>, System>{};
+
+/**
+ * \ingroup generic
+ *
+ * \brief True if the containers of the backend BACKEND are allocated in host memory, as
+ * for the CPP, OMP and TBB backends, and the device backend unless the device system is CUDA.
+ */
+template<typename BACKEND>
+struct is_host_backend: is_host_system< typename HYDRA_EXTERNAL_NS::thrust::iterator_system<
+	typename BACKEND::template container<double>::iterator>::type >{};
+
+/*
+ * Memory resources of the allocators: blocks from allocators with the same resource
+ * can be deallocated by each other.
+ */
+struct host_malloc_resource{};
+
+struct host_new_resource{};
+
+template<typename T, typename System, typename Pointer>
+typename std::conditional<is_host_system<System>::value, host_malloc_resource, void>::type
+memory_resource_of(HYDRA_EXTERNAL_NS::thrust::detail::malloc_allocator<T, System, Pointer> const*);
+
+template<typename T>
+typename std::conditional<is_host_system<HYDRA_EXTERNAL_NS::thrust::device_system_tag>::value,
+	host_malloc_resource, void>::type
+memory_resource_of(HYDRA_EXTERNAL_NS::thrust::device_malloc_allocator<T> const*);
+
+template<typename T>
+host_new_resource memory_resource_of(std::allocator<T> const*);
+
+void memory_resource_of(...);
+
+/*
+ * Resource of an allocator, including the allocators deriving from the ones above
+ * (e.g. thrust::omp::allocator<T> or hydra::detail::FirstTouchAllocator<A>), void if unknown.
+ */
+template<typename Allocator>
+struct memory_resource
+{
+	typedef decltype(memory_resource_of(static_cast<Allocator const*>(0))) type;
+};
+
+/**
+ * \ingroup generic
+ *
+ * \brief True if the storage of the containers of the backend FROM can be handed to the
+ * containers of the backend TO, without copying, i.e. their allocators share a host memory resource.
+ *
+ * The containers of the CPP, OMP and TBB backends, and the device containers on these systems, allocate
+ * with `std::malloc`, while the containers of the host backend allocate with `std::allocator`.
+ * With HYDRA_ALIGNED_ALLOCATION, the former allocate padded blocks with `posix_memalign` instead.
+ */
+template<typename FROM, typename TO>
+struct is_rebindable: std::integral_constant<bool,
+	std::is_same<
+		typename memory_resource<typename FROM::template container<double>::allocator_type>::type,
+		typename memory_resource<typename TO::template container<double>::allocator_type>::type >::value &&
+	!std::is_void<
+		typename memory_resource<typename TO::template container<double>::allocator_type>::type >::value >{};
+
+/*
+ * Hand the storage of 'from' to 'to', leaving 'from' empty.
+ */
+template<typename VectorTo, typename VectorFrom>
+inline void adopt_storage(VectorTo& to, VectorFrom& from)
+{
+	static_assert( std::is_same<
+			typename memory_resource<typename VectorTo::allocator_type>::type,
+			typename memory_resource<typename VectorFrom::allocator_type>::type>::value,
+			"[Hydra::adopt_storage] : the allocators of the containers do not share the memory resource.");
+
+	to.adopt_storage(from);
+}
+
+/*
+ * Convert an iterator over host memory, or a raw pointer, to the iterator Iterator, pointing to
+ * the same element. Zip iterators are converted element by element, from a zip iterator or
+ * from a tuple of iterators or raw pointers.
+ */
+template<typename Iterator>
+struct RebindIterator
+{
+	template<typename Source>
+	static Iterator convert(Source const& source)
+	{
+		return Iterator( typename Iterator::base_type(
+				HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(source.base())) );
+	}
+
+	template<typename Value>
+	static Iterator convert(Value* source)
+	{
+		return Iterator( typename Iterator::base_type(source) );
+	}
+};
+
+template<typename ...Iterators>
+struct RebindIterator< HYDRA_EXTERNAL_NS::thrust::zip_iterator<HYDRA_EXTERNAL_NS::thrust::tuple<Iterators...>> >
+{
+	typedef HYDRA_EXTERNAL_NS::thrust::zip_iterator<HYDRA_EXTERNAL_NS::thrust::tuple<Iterators...>> iterator_type;
+
+	template<typename Source>
+	static iterator_type convert(Source const& source)
+	{
+		return convert_helper(source.get_iterator_tuple(), make_index_sequence<sizeof...(Iterators)>{});
+	}
+
+	template<typename ...Sources>
+	static iterator_type convert(HYDRA_EXTERNAL_NS::thrust::tuple<Sources...> const& sources)
+	{
+		return convert_helper(sources, make_index_sequence<sizeof...(Iterators)>{});
+	}
+
+private:
+
+	template<typename Tuple, size_t ...I>
+	static iterator_type convert_helper(Tuple const& sources, index_sequence<I...>)
+	{
+		return iterator_type( HYDRA_EXTERNAL_NS::thrust::make_tuple(
+				RebindIterator<Iterators>::convert( HYDRA_EXTERNAL_NS::thrust::get<I>(sources) )...) );
+	}
+};
+
+template<typename Iterator, typename Source>
+inline Iterator rebind_iterator(Source const& source)
+{
+	return RebindIterator<Iterator>::convert(source);
+}
+
+}  // namespace detail
+
+}  // namespace hydra
+
+#endif /* REBIND_H_ */
@@ -32,8 +32,11 @@
 #include <hydra/Tuple.h>
 #include <hydra/detail/utility/Utility_Tuple.h>
 #include <hydra/detail/external/thrust/transform_reduce.h>
+#include <hydra/detail/external/thrust/transform.h>
 #include <hydra/detail/functors/ProcessSPlot.h>
 
+#include <array>
+
 
 namespace hydra {
 
@@ -50,7 +53,7 @@ SPlot<PDF1,PDF2,PDFs...>::Generate(InputIterator in_begin, InputIterator in_end,
     //_____________________________________
     // covariance matrix calculation
 
-    matrix_t init;
+    matrix_t init = detail::arrayToTuple(std::array<double, npdfs*npdfs>{});
     matrix_t covmatrix= HYDRA_EXTERNAL_NS::thrust::transform_reduce(system(), in_begin, in_end,
     		detail::CovMatrixUnary<typename PDF1::functor_type, typename  PDF2::functor_type,
 			typename  PDFs::functor_type...>(fCoeficients, fFunctors ),
@@ -71,6 +74,45 @@ SPlot<PDF1,PDF2,PDFs...>::Generate(InputIterator in_begin, InputIterator in_end,
 
 }
 
+template <typename PDF1, typename PDF2, typename ...PDFs>
+template<typename ...T, hydra::detail::Backend BACKEND, typename OutputIterator>
+inline HYDRA_EXTERNAL_NS::Eigen::Matrix<double, sizeof...(PDFs)+2, sizeof...(PDFs)+2>
+SPlot<PDF1,PDF2,PDFs...>::Generate(
+		ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>> const& source,
+		OutputIterator out_begin)	{
+
+	typedef typename ChunkedSource<HYDRA_EXTERNAL_NS::thrust::tuple<T...>,
+			hydra::detail::BackendPolicy<BACKEND>>::iterator source_iterator;
+	typedef typename HYDRA_EXTERNAL_NS::thrust::iterator_system<source_iterator>::type system;
+
+    //_____________________________________
+    // covariance matrix calculation
+
+    matrix_t init = detail::arrayToTuple(std::array<double, npdfs*npdfs>{});
+    matrix_t covmatrix= source.TransformReduce(
+    		detail::CovMatrixUnary<typename PDF1::functor_type, typename  PDF2::functor_type,
+			typename  PDFs::functor_type...>(fCoeficients, fFunctors ),
+    		init, detail::CovMatrixBinary< matrix_t>());
+
+    HYDRA_EXTERNAL_NS::Eigen::Matrix<double, npdfs, npdfs> fCovMatrix;
+
+    SetCovMatrix(covmatrix, fCovMatrix);
+
+    //_____________________________________
+    // calculate the sweights
+
+    detail::SWeights<typename PDF1::functor_type, typename  PDF2::functor_type,
+		typename  PDFs::functor_type...> sweights(fCoeficients, fFunctors, fCovMatrix.inverse() );
+
+    source.ForEachChunk([&](source_iterator first, source_iterator last, size_t first_row){
+
+    	HYDRA_EXTERNAL_NS::thrust::transform(system(), first, last, out_begin + first_row, sweights);
+    });
+
+    return  fCovMatrix;
+
+}
+
 
 } // namespace hydra
 
@@ -0,0 +1,115 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * SobolDirections.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef SOBOLDIRECTIONS_H_
+#define SOBOLDIRECTIONS_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/Types.h>
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * Number of bits of the Sobol points and maximum number of dimensions.
+ */
+constexpr size_t SOBOL_BITS = 32;
+constexpr size_t SOBOL_MAX_DIMENSIONS = 21;
+
+/*
+ * Primitive polynomials and initial direction numbers from
+ * S. Joe and F. Y. Kuo, "Constructing Sobol sequences with better
+ * two-dimensional projections", SIAM J. Sci. Comput. 30, 2635 (2008).
+ * Each row holds the degree s, the coefficients a and m_1...m_s.
+ * The first dimension is the van der Corput sequence and is not listed.
+ */
+inline const GUInt_t (&sobol_polynomials())[SOBOL_MAX_DIMENSIONS-1][9]
+{
+	static const GUInt_t table[SOBOL_MAX_DIMENSIONS-1][9] = {
+			{ 1,  0, 1 },
+			{ 2,  1, 1, 3 },
+			{ 3,  1, 1, 3, 1 },
+			{ 3,  2, 1, 1, 1 },
+			{ 4,  1, 1, 1, 3, 3 },
+			{ 4,  4, 1, 3, 5, 13 },
+			{ 5,  2, 1, 1, 5, 5, 17 },
+			{ 5,  4, 1, 1, 5, 5, 5 },
+			{ 5,  7, 1, 1, 7, 11, 19 },
+			{ 5, 11, 1, 1, 5, 1, 1 },
+			{ 5, 13, 1, 1, 1, 3, 11 },
+			{ 5, 14, 1, 3, 5, 5, 31 },
+			{ 6,  1, 1, 3, 3, 9, 7, 49 },
+			{ 6, 13, 1, 1, 1, 15, 21, 21 },
+			{ 6, 16, 1, 3, 1, 13, 27, 49 },
+			{ 6, 19, 1, 1, 1, 15, 7, 5 },
+			{ 6, 22, 1, 3, 1, 15, 13, 25 },
+			{ 6, 25, 1, 1, 5, 5, 19, 61 },
+			{ 7,  1, 1, 3, 7, 11, 23, 15, 103 },
+			{ 7,  4, 1, 3, 7, 13, 13, 15, 69 }
+	};
+
+	return table;
+}
+
+/*
+ * Fill v with the direction numbers of the Sobol sequence in the dimension dim,
+ * left aligned in SOBOL_BITS bits: v[b] is added (xor) to the point when the
+ * bit b of the index is set.
+ */
+inline void sobol_direction_numbers(size_t dim, GUInt_t (&v)[SOBOL_BITS])
+{
+	if(dim==0){
+
+		for(size_t b=0; b<SOBOL_BITS; b++)
+			v[b] = 1u << (SOBOL_BITS-1-b);
+
+		return;
+	}
+
+	const GUInt_t* row = sobol_polynomials()[dim-1];
+	const size_t   s   = row[0];
+	const GUInt_t  a   = row[1];
+
+	for(size_t b=0; b<s && b<SOBOL_BITS; b++)
+		v[b] = row[2+b] << (SOBOL_BITS-1-b);
+
+	for(size_t b=s; b<SOBOL_BITS; b++){
+
+		v[b] = v[b-s] ^ (v[b-s] >> s);
+
+		for(size_t k=1; k<s; k++)
+			if( (a >> (s-1-k)) & 1u ) v[b] ^= v[b-k];
+	}
+}
+
+}  // namespace detail
+
+}  // namespace hydra
+
+#endif /* SOBOLDIRECTIONS_H_ */
@@ -0,0 +1,380 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * SparseGridQuadrature.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef SPARSEGRIDQUADRATURE_INL_
+#define SPARSEGRIDQUADRATURE_INL_
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <set>
+
+namespace hydra {
+
+template< size_t N,hydra::detail::Backend BACKEND>
+void SparseGridQuadrature<N,hydra::detail::BackendPolicy<BACKEND>>::BuildRules()
+{
+	assert(fMaxLevel > 0 && fMaxLevel < 8*sizeof(size_t)-1
+			&& "HYDRA MESSAGE: SparseGridQuadrature maximum level out of range");
+
+	std::vector<GReal_t> nodes;
+	std::vector<GReal_t> weights;
+	std::vector<GReal_t> previous;
+
+	fRuleOffsets.assign(fMaxLevel+2, 0);
+
+	for(size_t level=0; level<=fMaxLevel; level++){
+
+		size_t n = GetNNodes(level);
+
+		std::vector<GReal_t> x(n, 0.0);
+		std::vector<GReal_t> w(n, 2.0);
+
+		//Clenshaw-Curtis rule with n = m+1 nodes cos(pi*i/m) on [-1,1]
+		if(level > 0){
+
+			size_t m = n-1;
+
+			for(size_t i=0; i<n; i++){
+
+				x[i] = 2*i==m ? 0.0 : ::cos(PI*i/m);
+
+				GReal_t sum = 0.0;
+
+				for(size_t k=1; k<=m/2; k++)
+					sum += (2*k==m ? 1.0 : 2.0)*::cos(2.0*PI*k*i/m)/(4.0*k*k - 1.0);
+
+				w[i] = (i==0 || i==m ? 1.0 : 2.0)*(1.0 - sum)/m;
+			}
+		}
+
+		//difference with the rule of the previous level, whose nodes are nested in this one
+		std::vector<GReal_t> delta(w);
+
+		if(level == 1) delta[1] -= previous[0];
+
+		if(level > 1)
+			for(size_t i=0; i<n; i+=2) delta[i] -= previous[i/2];
+
+		fRuleOffsets[level] = nodes.size();
+
+		nodes.insert(nodes.end(), x.begin(), x.end());
+		weights.insert(weights.end(), delta.begin(), delta.end());
+
+		previous.swap(w);
+	}
+
+	fRuleOffsets[fMaxLevel+1] = nodes.size();
+
+	fRules   = fRuleOffsets;
+	fNodes   = nodes;
+	fWeights = weights;
+}
+
+template< size_t N,hydra::detail::Backend BACKEND>
+size_t SparseGridQuadrature<N,hydra::detail::BackendPolicy<BACKEND>>::Refine(std::vector<size_t>& selected)
+{
+	size_t first_term = fLevels.size();
+	size_t ncalls = 0;
+
+	std::vector<size_t> work(selected);
+	std::vector<size_t> refined;
+	std::set<size_t>    retried;
+
+	for(size_t i: selected) fActive[i] = false;
+
+	//forward neighbours whose backward neighbours are all refined
+	for(size_t w=0; w<work.size(); w++){
+
+		size_t i = work[w];
+		size_t added = 0;
+
+		std::vector<size_t> blocking;
+
+		for(size_t j=0; j<N; j++){
+
+			level_t level = fLevels[i];
+
+			if( ++level[j] > fMaxLevel || fPosition.count(level) ) continue;
+
+			bool admissible = true;
+
+			for(size_t d=0; d<N; d++){
+
+				if(level[d] == 0) continue;
+
+				level_t backward = level;
+				backward[d]--;
+
+				auto it = fPosition.find(backward);
+
+				if( it == fPosition.end() || it->second >= first_term ) admissible = false;
+				else if( fActive[it->second] ){
+
+					blocking.push_back(it->second);
+					admissible = false;
+				}
+			}
+
+			if( !admissible ) continue;
+
+			size_t term_calls = 1;
+
+			for(size_t d=0; d<N; d++) term_calls *= hydra::detail::sparse_grid_new_nodes(level[d]);
+
+			fPosition[level] = fLevels.size();
+			fLevels.push_back(level);
+			fActive.push_back(true);
+
+			ncalls += term_calls;
+			added++;
+		}
+
+		//a term whose forward neighbours are all blocked by active terms, with values too small
+		//to be selected, would leave the error estimate without refinement. The blocking terms
+		//are refined first and the term is tried again.
+		if( added == 0 && !blocking.empty() && !retried.count(i) ){
+
+			retried.insert(i);
+
+			for(size_t b: blocking){
+
+				if( !fActive[b] ) continue;
+
+				fActive[b] = false;
+				work.push_back(b);
+			}
+
+			work.push_back(i);
+			continue;
+		}
+
+		refined.push_back(i);
+	}
+
+	selected.swap(refined);
+
+	return ncalls;
+}
+
+template< size_t N,hydra::detail::Backend BACKEND>
+template<typename FUNCTOR>
+void SparseGridQuadrature<N,hydra::detail::BackendPolicy<BACKEND>>::EvaluateTerms(FUNCTOR const& functor, size_t first_term)
+{
+	typedef hydra::detail::ProcessSparseGridQuadrature<N,FUNCTOR> process_t;
+
+	size_t nterms = fLevels.size() - first_term;
+
+	std::vector<hydra::detail::SparseGridTerm<N>> terms(nterms);
+	std::vector<size_t> offsets(nterms+1, 0);
+	std::vector<size_t> table;
+
+	for(size_t t=0; t<nterms; t++){
+
+		level_t const& level = fLevels[first_term + t];
+
+		//the new nodes of the term are appended to the store
+		size_t new_calls = 1;
+		size_t ncalls    = 1;
+		size_t nblocks   = 1;
+
+		for(size_t j=0; j<N; j++){
+
+			terms[t].fLevel[j] = level[j];
+
+			new_calls *= hydra::detail::sparse_grid_new_nodes(level[j]);
+			ncalls    *= GetNNodes(level[j]);
+			nblocks   *= level[j] + 1;
+		}
+
+		fBlockOffsets.push_back(fStoreSize);
+		fStoreSize += new_calls;
+		fNCalls    += new_calls;
+
+		offsets[t+1] = offsets[t] + ncalls;
+
+		//storage offsets of the blocks of new nodes of all levels m <= level
+		terms[t].fTable = table.size();
+
+		for(size_t b=0; b<nblocks; b++){
+
+			level_t m;
+			size_t  r = b;
+
+			for(size_t j=0; j<N; j++){
+				m[j] = r%(level[j] + 1);
+				r   /= level[j] + 1;
+			}
+
+			table.push_back( fBlockOffsets[ fPosition[m] ] );
+		}
+	}
+
+	fTerms   = terms;
+	fOffsets = offsets;
+	fTable   = table;
+
+	fStore.resize(fStoreSize);
+	fKeys.resize(nterms);
+	fValues.resize(nterms);
+
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> first(0);
+
+	auto keys = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(first,
+			hydra::detail::SparseGridTermIndex(nterms,
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fOffsets.data())));
+
+	auto calls = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(first,
+			process_t(functor, nterms,
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fTerms.data()),
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fOffsets.data()),
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fRules.data()),
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fNodes.data()),
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fWeights.data()),
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fTable.data()),
+					HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fStore.data()),
+					fLowerLimit, fUpperLimit));
+
+	HYDRA_EXTERNAL_NS::thrust::reduce_by_key(system_t(), keys, keys + offsets.back(), calls,
+			fKeys.begin(), fValues.begin(),
+			HYDRA_EXTERNAL_NS::thrust::equal_to<size_t>(),
+			HYDRA_EXTERNAL_NS::thrust::plus<GReal_t>());
+
+	fTermValues.insert(fTermValues.end(), fValues.begin(), fValues.end());
+}
+
+template< size_t N,hydra::detail::Backend BACKEND>
+template<typename FUNCTOR>
+inline std::pair<GReal_t, GReal_t>
+SparseGridQuadrature<N,hydra::detail::BackendPolicy<BACKEND>>::Integrate(FUNCTOR const& fFunctor)
+{
+	fLevels.clear();
+	fTermValues.clear();
+	fActive.clear();
+	fPosition.clear();
+	fBlockOffsets.clear();
+
+	fStoreSize = 0;
+	fNCalls    = 0;
+
+	//classical sparse grid of level two, so that integrands vanishing
+	//at the center or along the axes are not missed
+	fPosition[level_t()] = 0;
+	fLevels.push_back(level_t());
+	fActive.push_back(true);
+
+	EvaluateTerms(fFunctor, 0);
+
+	for(size_t round=0; round<2; round++){
+
+		std::vector<size_t> selected;
+
+		for(size_t i=0; i<fLevels.size(); i++)
+			if(fActive[i]) selected.push_back(i);
+
+		size_t first_term = fLevels.size();
+
+		Refine(selected);
+
+		if( first_term < fLevels.size() ) EvaluateTerms(fFunctor, first_term);
+	}
+
+	GReal_t result = 0.0;
+	GReal_t error  = 0.0;
+
+	while(true){
+
+		result = 0.0;
+		error  = 0.0;
+
+		size_t nrefinable = 0;
+
+		for(size_t i=0; i<fLevels.size(); i++){
+
+			result += fTermValues[i];
+
+			if( !fActive[i] ) continue;
+
+			error += std::fabs(fTermValues[i]);
+
+			for(size_t j=0; j<N; j++)
+				if(fLevels[i][j] < fMaxLevel){ nrefinable++; break;}
+		}
+
+		if( error <= std::fabs(result)*fMaxRelativeError ||
+				error <= std::numeric_limits<GReal_t>::epsilon() ) break;
+
+		if( nrefinable == 0 ){
+
+			HYDRA_LOG(WARNING, "SparseGridQuadrature stopped at the maximum level before reaching the requested tolerance.")
+			break;
+		}
+
+		//refine the active terms above their share of the error
+		GReal_t threshold = error/nrefinable;
+
+		std::vector<size_t> selected;
+
+		for(size_t i=0; i<fLevels.size(); i++){
+
+			if( !fActive[i] || std::fabs(fTermValues[i]) < threshold ) continue;
+
+			for(size_t j=0; j<N; j++)
+				if(fLevels[i][j] < fMaxLevel){ selected.push_back(i); break;}
+		}
+
+		size_t first_term = fLevels.size();
+		size_t ncalls     = Refine(selected);
+
+		if( fNCalls + ncalls > fMaxCalls ){
+
+			HYDRA_LOG(WARNING, "SparseGridQuadrature stopped at the maximum number of calls before reaching the requested tolerance.")
+
+			//undo the refinement
+			for(size_t i=first_term; i<fLevels.size(); i++) fPosition.erase(fLevels[i]);
+			for(size_t i: selected) fActive[i] = true;
+
+			fLevels.resize(first_term);
+			fActive.resize(first_term);
+
+			break;
+		}
+
+		if( first_term < fLevels.size() ) EvaluateTerms(fFunctor, first_term);
+	}
+
+	fNTerms   = fLevels.size();
+	fResult   = result;
+	fAbsError = error;
+
+	return std::make_pair(fResult, fAbsError);
+}
+
+}  // namespace hydra
+
+#endif /* SPARSEGRIDQUADRATURE_INL_ */
@@ -38,6 +38,7 @@
 #include <hydra/detail/external/thrust/iterator/constant_iterator.h>
 #include <hydra/detail/external/thrust/iterator/iterator_traits.h>
 #include <hydra/detail/external/thrust/system/detail/generic/select_system.h>
+#include <hydra/detail/CachingPool.h>
 #include <hydra/detail/external/thrust/iterator/iterator_traits.h>
 
 namespace hydra {
@@ -60,25 +61,25 @@ void SparseHistogram<T, N,  detail::BackendPolicy<BACKEND>, detail::multidimensi
 
 	auto key_functor = detail::GetGlobalBin<N,T>(fGrid, fLowerLimits, fUpperLimits);
 
-	auto weights  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto weights  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
 	hydra::copy(wbegin, wbegin+data_size, weights.first);
 
 	auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 	auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-	auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(), keys_begin, keys_end, key_buffer.first);
 	HYDRA_EXTERNAL_NS::thrust::sort_by_key( common_system_t(), key_buffer.first, key_buffer.first+data_size, weights.first);
 
 	//bins content
-	auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-	auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	auto reduced_end = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(common_system_t(),
 			key_buffer.first, key_buffer.first +  key_buffer.second,
 			weights.first, reduced_keys.first, reduced_values.first);
 
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
+	hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
 
 	size_t histogram_size = HYDRA_EXTERNAL_NS::thrust::distance(reduced_keys.first, reduced_end.first);
 
@@ -89,11 +90,11 @@ void SparseHistogram<T, N,  detail::BackendPolicy<BACKEND>, detail::multidimensi
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(),reduced_keys.first, reduced_end.first,  fBins.begin());
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(),reduced_values.first, reduced_end.second,  fContents.begin());
 
-	// deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
+	// return the buffers to the caching pool
 
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), weights.first  );
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
+	hydra::detail::return_temporary_buffer(common_system_t(), weights.first  );
+	hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+	hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
 
 }
 
@@ -117,25 +118,25 @@ void SparseHistogram<T, N,  detail::BackendPolicy<BACKEND>, detail::multidimensi
 
 	auto key_functor = detail::GetGlobalBin<N,T>(fGrid, fLowerLimits, fUpperLimits);
 
-	auto weights  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto weights  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
 	hydra::copy(wbegin, wbegin+data_size, weights.first);
 
 	auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 	auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-	auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(), keys_begin, keys_end, key_buffer.first);
 	HYDRA_EXTERNAL_NS::thrust::sort_by_key( common_system_t(), key_buffer.first, key_buffer.first+data_size, weights.first);
 
 	//bins content
-	auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-	auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	auto reduced_end = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(common_system_t(),
 			key_buffer.first, key_buffer.first +  key_buffer.second,
 			weights.first, reduced_keys.first, reduced_values.first);
 
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
+	hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
 
 	size_t histogram_size = HYDRA_EXTERNAL_NS::thrust::distance(reduced_keys.first, reduced_end.first);
 
@@ -146,10 +147,10 @@ void SparseHistogram<T, N,  detail::BackendPolicy<BACKEND>, detail::multidimensi
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(),reduced_keys.first, reduced_end.first,  fBins.begin());
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(),reduced_values.first, reduced_end.second,  fContents.begin());
 
-	// deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), weights.first  );
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
+	// return the buffers to the caching pool
+	hydra::detail::return_temporary_buffer(common_system_t(), weights.first  );
+	hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+	hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
 
 }
 
@@ -174,15 +175,15 @@ void SparseHistogram<T, N,  detail::BackendPolicy<BACKEND>, detail::multidimensi
 
 	auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 	auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-	auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::copy( common_system_t(),keys_begin, keys_end, key_buffer.first);
 	HYDRA_EXTERNAL_NS::thrust::sort( common_system_t(),key_buffer.first, key_buffer.first+data_size );
 
 
 	//bins content
-	auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-	auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	//reduction_by_key
 	auto  weights    = HYDRA_EXTERNAL_NS::thrust::constant_iterator<double>(1.0);
@@ -191,7 +192,7 @@ void SparseHistogram<T, N,  detail::BackendPolicy<BACKEND>, detail::multidimensi
 			key_buffer.first, key_buffer.first+data_size,
 			weights, reduced_keys.first, reduced_values.first);
 
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
+	hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
 
 	size_t histogram_size = HYDRA_EXTERNAL_NS::thrust::distance(reduced_keys.first, reduced_end.first);
 
@@ -202,9 +203,9 @@ void SparseHistogram<T, N,  detail::BackendPolicy<BACKEND>, detail::multidimensi
 	HYDRA_EXTERNAL_NS::thrust::copy(reduced_keys.first, reduced_end.first,  fBins.begin());
 	HYDRA_EXTERNAL_NS::thrust::copy(reduced_values.first, reduced_end.second,  fContents.begin());
 
-	// deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
+	// return the buffers to the caching pool
+	hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+	hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
 
 
 }
@@ -228,15 +229,15 @@ void SparseHistogram<T, N,  detail::BackendPolicy<BACKEND>, detail::multidimensi
 
 	auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 	auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-	auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::copy( common_system_t(),keys_begin, keys_end, key_buffer.first);
 	HYDRA_EXTERNAL_NS::thrust::sort( common_system_t(),key_buffer.first, key_buffer.first+data_size );
 
 
 	//bins content
-	auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-	auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	//reduction_by_key
 	auto  weights    = HYDRA_EXTERNAL_NS::thrust::constant_iterator<double>(1.0);
@@ -245,7 +246,7 @@ void SparseHistogram<T, N,  detail::BackendPolicy<BACKEND>, detail::multidimensi
 			key_buffer.first, key_buffer.first+data_size,
 			weights, reduced_keys.first, reduced_values.first);
 
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
+	hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
 
 	size_t histogram_size = HYDRA_EXTERNAL_NS::thrust::distance(reduced_keys.first, reduced_end.first);
 
@@ -256,9 +257,9 @@ void SparseHistogram<T, N,  detail::BackendPolicy<BACKEND>, detail::multidimensi
 	HYDRA_EXTERNAL_NS::thrust::copy(reduced_keys.first, reduced_end.first,  fBins.begin());
 	HYDRA_EXTERNAL_NS::thrust::copy(reduced_values.first, reduced_end.second,  fContents.begin());
 
-	// deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
+	// return the buffers to the caching pool
+	hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+	hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
 
 
 }
@@ -281,14 +282,14 @@ void SparseHistogram<T, 1,  detail::BackendPolicy<BACKEND>, detail::unidimension
 
 	auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 	auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-	auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(), keys_begin, keys_end, key_buffer.first);
 	HYDRA_EXTERNAL_NS::thrust::sort(common_system_t(),key_buffer.first, key_buffer.first+data_size);
 
 	//bins content
-	auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-	auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 	auto weights         = HYDRA_EXTERNAL_NS::thrust::constant_iterator<double>(1.0);
 
 	//reduction_by_key
@@ -296,7 +297,7 @@ void SparseHistogram<T, 1,  detail::BackendPolicy<BACKEND>, detail::unidimension
 			key_buffer.first, key_buffer.first+key_buffer.second,
 			weights, reduced_keys.first, reduced_values.first);
 
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
+	hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
 
     size_t histogram_size = HYDRA_EXTERNAL_NS::thrust::distance(common_system_t(),reduced_keys.first, reduced_end.first);
 
@@ -307,9 +308,9 @@ void SparseHistogram<T, 1,  detail::BackendPolicy<BACKEND>, detail::unidimension
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(), reduced_keys.first, reduced_end.first,  fBins.begin());
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(), reduced_values.first, reduced_end.second,  fContents.begin());
 
-    // deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
+    // return the buffers to the caching pool
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
 
 
 }
@@ -332,14 +333,14 @@ void SparseHistogram<T, 1,  detail::BackendPolicy<BACKEND>, detail::unidimension
 
 	auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 	auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-	auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(), keys_begin, keys_end, key_buffer.first);
 	HYDRA_EXTERNAL_NS::thrust::sort(common_system_t(),key_buffer.first, key_buffer.first+data_size);
 
 	//bins content
-	auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-	auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 	auto weights         = HYDRA_EXTERNAL_NS::thrust::constant_iterator<double>(1.0);
 
 	//reduction_by_key
@@ -347,7 +348,7 @@ void SparseHistogram<T, 1,  detail::BackendPolicy<BACKEND>, detail::unidimension
 			key_buffer.first, key_buffer.first+key_buffer.second,
 			weights, reduced_keys.first, reduced_values.first);
 
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
+	hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
 
 	size_t histogram_size = HYDRA_EXTERNAL_NS::thrust::distance(common_system_t(),reduced_keys.first, reduced_end.first);
 
@@ -358,9 +359,9 @@ void SparseHistogram<T, 1,  detail::BackendPolicy<BACKEND>, detail::unidimension
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(), reduced_keys.first, reduced_end.first,  fBins.begin());
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(), reduced_values.first, reduced_end.second,  fContents.begin());
 
-    // deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
+    // return the buffers to the caching pool
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
 
 
 }
@@ -384,26 +385,26 @@ void SparseHistogram<T, 1,  detail::BackendPolicy<BACKEND>, detail::unidimension
 	auto key_functor = detail::GetGlobalBin<1,T>(fGrid, fLowerLimits, fUpperLimits);
 
 	//work on local copy of data
-	auto weights  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto weights  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
 	hydra::copy(common_system_t(),wbegin, wbegin+data_size, weights.first);
 
 	auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 	auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-	auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(), keys_begin, keys_end, key_buffer.first);
 	HYDRA_EXTERNAL_NS::thrust::sort_by_key(common_system_t(),key_buffer.first, key_buffer.first+data_size, weights.first);
 
 	//bins content
-	auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-	auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	//reduction_by_key
 	auto reduced_end = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(common_system_t(),
 			key_buffer.first, key_buffer.first+data_size,
 			weights.first, reduced_keys.first, reduced_values.first);
 
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
+	hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
 
 	size_t histogram_size = HYDRA_EXTERNAL_NS::thrust::distance(reduced_keys.first, reduced_end.first);
 
@@ -416,10 +417,10 @@ void SparseHistogram<T, 1,  detail::BackendPolicy<BACKEND>, detail::unidimension
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(),reduced_values.first, reduced_end.second,  fContents.begin());
 
 
-    // deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), weights.first  );
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
+    // return the buffers to the caching pool
+	hydra::detail::return_temporary_buffer(common_system_t(), weights.first  );
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
 
 }
 
@@ -443,26 +444,26 @@ void SparseHistogram<T, 1,  detail::BackendPolicy<BACKEND>,detail::unidimensiona
 	auto key_functor = detail::GetGlobalBin<1,T>(fGrid, fLowerLimits, fUpperLimits);
 
 	//work on local copy of data
-	auto weights  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto weights  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
 	hydra::copy(common_system_t(),wbegin, wbegin+data_size, weights.first);
 
 	auto keys_begin = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(begin, key_functor );
 	auto keys_end   = HYDRA_EXTERNAL_NS::thrust::make_transform_iterator(end, key_functor);
-	auto key_buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto key_buffer = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(), keys_begin, keys_end, key_buffer.first);
 	HYDRA_EXTERNAL_NS::thrust::sort_by_key(common_system_t(),key_buffer.first, key_buffer.first+data_size, weights.first);
 
 	//bins content
-	auto reduced_values  = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(common_system_t(), data_size);
-	auto reduced_keys    = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<size_t>(common_system_t(), data_size);
+	auto reduced_values  = hydra::detail::get_temporary_buffer<double>(common_system_t(), data_size);
+	auto reduced_keys    = hydra::detail::get_temporary_buffer<size_t>(common_system_t(), data_size);
 
 	//reduction_by_key
 	auto reduced_end = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(common_system_t(),
 			key_buffer.first, key_buffer.first+data_size,
 			weights.first, reduced_keys.first, reduced_values.first);
 
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), key_buffer.first);
+	hydra::detail::return_temporary_buffer(common_system_t(), key_buffer.first);
 
 	size_t histogram_size = HYDRA_EXTERNAL_NS::thrust::distance(reduced_keys.first, reduced_end.first);
 
@@ -475,10 +476,10 @@ void SparseHistogram<T, 1,  detail::BackendPolicy<BACKEND>,detail::unidimensiona
 	HYDRA_EXTERNAL_NS::thrust::copy(common_system_t(),reduced_values.first, reduced_end.second,  fContents.begin());
 
 
-    // deallocate storage with HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer
-	HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), weights.first  );
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_values.first);
-    HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(common_system_t(), reduced_keys.first);
+    // return the buffers to the caching pool
+	hydra::detail::return_temporary_buffer(common_system_t(), weights.first  );
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_values.first);
+    hydra::detail::return_temporary_buffer(common_system_t(), reduced_keys.first);
 
 }
 
@@ -45,7 +45,15 @@
 
 //thrust
 #include <hydra/detail/external/thrust/transform_reduce.h>
-#include <hydra/detail/external/thrust/sort.h>
+#include <hydra/detail/external/thrust/for_each.h>
+#include <hydra/detail/external/thrust/copy.h>
+#include <hydra/detail/external/thrust/fill.h>
+#include <hydra/detail/external/thrust/reduce.h>
+#include <hydra/detail/external/thrust/scan.h>
+#include <hydra/detail/external/thrust/scatter.h>
+#include <hydra/detail/external/thrust/transform.h>
+
+#include <algorithm>
 
 
 #define USE_ORIGINAL_CHISQ_FORMULA 0
@@ -67,6 +75,79 @@ Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::Integrate(FUNCTOR const&
 
 }
 
+template<size_t N, hydra::detail::Backend  BACKEND, typename GRND>
+template<typename FUNCTOR>
+std::pair<GReal_t, GReal_t>
+Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::WarmIntegrate(FUNCTOR const& fFunctor )
+{
+	if( fState.GetStage() == 0 ) return Integrate(fFunctor);
+
+	fState.SetStage(1);
+	fState.ClearStoredIterations();
+
+	return IntegIterator(fFunctor, 0 );
+
+}
+
+template<size_t N, hydra::detail::Backend  BACKEND, typename GRND>
+template<typename ...FUNCTORS>
+std::vector<std::pair<GReal_t, GReal_t>>
+Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::Integrate(HYDRA_EXTERNAL_NS::thrust::tuple<FUNCTORS...> const& fFunctors )
+{
+	return IntegrateMulti( detail::MultiEvaluator<HYDRA_EXTERNAL_NS::thrust::tuple<FUNCTORS...>, false>(fFunctors) );
+}
+
+template<size_t N, hydra::detail::Backend  BACKEND, typename GRND>
+template<typename FUNCTOR>
+std::pair<GReal_t, GReal_t>
+Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::Integrate(FUNCTOR const& fFunctor, std::vector<std::pair<GReal_t, GReal_t>>& gradient )
+{
+	auto results = IntegrateMulti( detail::MultiEvaluator<FUNCTOR, true>(fFunctor) );
+
+	gradient.resize(results.size() - 1);
+
+	for(size_t k=1; k<results.size(); k++) gradient[k-1] = results[k];
+
+	return results[0];
+}
+
+template<size_t N, hydra::detail::Backend  BACKEND, typename GRND>
+template<typename EVALUATOR>
+std::vector<std::pair<GReal_t, GReal_t>>
+Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::IntegrateMulti(EVALUATOR const& evaluator )
+{
+	GInt_t mode = fState.GetMode();
+
+	if( mode == MODE_ADAPTIVE_STRATIFIED ) fState.SetMode(MODE_IMPORTANCE);
+
+	fMultiSums.assign( EVALUATOR::K, std::array<GReal_t,3>{ {0.0, 0.0, 0.0} } );
+	fMultiIterations = 0;
+
+	fState.SetStage(0);
+
+	//training, only the grid is kept
+	IntegIterator(evaluator, 1 );
+
+	auto first_result = IntegIterator(evaluator, 0 );
+
+	fState.SetMode(mode);
+
+	std::vector<std::pair<GReal_t, GReal_t>> results;
+
+	for(auto const& sums: fMultiSums)
+	{
+		if( sums[1] > 0.0 )
+			results.push_back( std::make_pair( sums[0]/sums[1], sqrt(1.0/sums[1]) ) );
+		else
+			results.push_back( std::make_pair( sums[2]/fMultiIterations, 0.0 ) );
+	}
+
+	//the first value is processed exactly as by Integrate(functor)
+	results[0] = first_result;
+
+	return results;
+}
+
 template<size_t N, hydra::detail::Backend  BACKEND , typename GRND>
 template<typename FUNCTOR>
 std::pair<GReal_t, GReal_t>
@@ -109,7 +190,8 @@ Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::IntegIterator(FUNCTOR con
 		//	if(boxes==1) boxes++;
 		//	std::cout << "boxes  " << boxes << " bins " <<fState.GetNBinsMax()<< std::endl;
 
-			fState.SetMode(MODE_IMPORTANCE);
+			if (fState.GetMode() != MODE_ADAPTIVE_STRATIFIED)
+				fState.SetMode(MODE_IMPORTANCE);
 
 		}
 
@@ -119,8 +201,10 @@ Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::IntegIterator(FUNCTOR con
 		fState.SetCalls( training , fState.GetCallsPerBox() * tot_boxes);
 		//std::cout << "fState.GetCalls "<< fState.GetCalls()<< std::endl;
 
-		/* total volume of x-space/(avg num of calls/bin) */
-		fState.SetJacobian( fState.GetVolume() * pow((GReal_t) bins, (GReal_t)N)/ fState.GetCalls(training) );
+		/* total volume of x-space/(avg num of calls/bin)
+		 * in adaptive stratified mode the average is taken per hypercube */
+		fState.SetJacobian( fState.GetVolume() * pow((GReal_t) bins, (GReal_t)N)/
+				(fState.GetMode() == MODE_ADAPTIVE_STRATIFIED ? tot_boxes : fState.GetCalls(training)) );
 
 		//std::cout << "fState.GetVolume() " << fState.GetVolume() << std::endl;
 
@@ -147,11 +231,6 @@ Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::IntegIterator(FUNCTOR con
 
 	cum_int = 0.0;
 	cum_sig = 0.0;
-	size_t nkeys  = N*fState.GetCalls(training);
-	fFValInput.resize(nkeys);
-	fGlobalBinInput.resize(nkeys);
-	fFValOutput.resize(nkeys);
-	fGlobalBinOutput.resize(nkeys);
 
 	//for (size_t it = 0; it < fState.GetIterations()+fState.GetTrainingIterations(); it++)
 
@@ -162,13 +241,10 @@ Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::IntegIterator(FUNCTOR con
 
 		GReal_t intgrl = 0.0;
 		GReal_t intgrl_sq = 0.0;
-		GReal_t tss = 0.0;
 		GReal_t wgt=0;
 		GReal_t var=0;
 		GReal_t sig=0;
 
-		size_t calls_per_box = fState.GetCallsPerBox();
-		GReal_t jacbin = fState.GetJacobian();
 
 		//if(it >=fState.GetTrainingIterations())	fState.SetItNum(fState.GetItStart() + it);
 		if(!training)	fState.SetItNum(fState.GetItStart() + it);
@@ -181,7 +257,10 @@ Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::IntegIterator(FUNCTOR con
 		 * **********************************************
 		 */
 		auto start_fc = std::chrono::high_resolution_clock::now();
-		ProcessFuncionCalls( fFunctor,training, intgrl,  tss);
+		if(fState.GetMode() == MODE_ADAPTIVE_STRATIFIED)
+			ProcessFuncionCallsAdaptive( fFunctor,training, intgrl,  var);
+		else
+			ProcessFuncionCalls( fFunctor,training, intgrl,  var);
 		auto end_fc = std::chrono::high_resolution_clock::now();
 		std::chrono::duration<double, std::milli> elapsed_fc = end_fc - start_fc;
 		/*
@@ -191,9 +270,6 @@ Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::IntegIterator(FUNCTOR con
 		if(!training)
 		{
 
-			var = tss / (calls_per_box - 1.0);
-
-
 			if (var > 0) {
 				wgt = 1.0 / var;
 			} else if (fState.GetSumOfWeights() > 0) {
@@ -310,10 +386,14 @@ Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::IntegIterator(FUNCTOR con
 
 	fState.SetStage(1);
 
-	fFValInput=rvector_backend();
-	fGlobalBinInput=uvector_backend();
-	fFValOutput=rvector_backend();
-	fGlobalBinOutput=uvector_backend();
+	fPartialDistribution=rvector_backend();
+	fCubeSum=rvector_backend();
+	fCubeSum2=rvector_backend();
+	fEdgeKey=uvector_backend();
+	fEdgeSum=rvector_backend();
+	fEdgeSum2=rvector_backend();
+	fEdgeKeyOutput=uvector_backend();
+	fEdgeSumOutput=rvector_backend();
 
 	return std::make_pair(cum_int, cum_sig);
 
@@ -601,47 +681,249 @@ void Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::RefineGrid() {
 
 template< size_t N, hydra::detail::Backend  BACKEND , typename GRND>
 template<typename FUNCTOR>
-void Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::ProcessFuncionCalls(FUNCTOR const& fFunctor, GBool_t training, GReal_t& integral, GReal_t& tss)
+void Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::ProcessFuncionCalls(FUNCTOR const& fFunctor, GBool_t training, GReal_t& integral, GReal_t& variance)
 {
 	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
-	size_t ncalls = fState.GetCalls(training);
-	size_t nkeys  = N*fState.GetCalls(training);
+	size_t nkeys   = N*fState.GetNBins();
+
+	detail::PartitionVegas<rvector_iterator> partition(fState.GetCalls(training));
+
+	fPartialDistribution.resize(partition.GetNPartials()*nkeys);
+	HYDRA_EXTERNAL_NS::thrust::fill(system_t(), fPartialDistribution.begin(), fPartialDistribution.end(), 0.0);
 
 	// create iterators
 	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> first(0);
-	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> last = first + ncalls;
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> last = first + partition.GetNItems();
 
 
 	fState.CopyStateToDevice();
 
-
+	//the work items accumulate the grid distribution in the private copies of fPartialDistribution
 	detail::ResultVegas init = detail::ResultVegas();
 	detail::ResultVegas result = HYDRA_EXTERNAL_NS::thrust::transform_reduce(system_t(), first, last,
-			detail::ProcessCallsVegas<FUNCTOR,N,system_t ,rvector_iterator,
-			uvector_iterator , GRND>(ncalls, fState, fGlobalBinInput.begin(),fFValInput.begin(), fFunctor)
+			detail::ProcessCallsVegas<FUNCTOR,N,system_t ,rvector_iterator, GRND>(partition, fState,
+					fPartialDistribution.begin(), fFunctor)
 	, init,	detail::ProcessBoxesVegas());
 
+	//merge the copies
+	MergePartialDistributions(partition.GetNPartials(), nkeys);
 
-	/*
-	for(size_t i=0; i< HYDRA_EXTERNAL_NS::thrust::distance( fGlobalBinInput.begin(),fGlobalBinInput.end() ); i++)
-			std::cout <<"<< " << i << " " << fGlobalBinInput[i] << " " << fFValInput[i] << std::endl;
-	 */
+	integral=result.fMean*result.fN  ;
+	variance=sqrt( result.fM2 )/(fState.GetCallsPerBox() - 1.0);
 
-	HYDRA_EXTERNAL_NS::thrust::sort_by_key(system_t(),fGlobalBinInput.begin(),fGlobalBinInput.end(), fFValInput.begin());
-	/*
-	for(size_t i=0; i< HYDRA_EXTERNAL_NS::thrust::distance( fGlobalBin.begin(),fGlobalBin.end() ); i++)
-		std::cout <<"<< " << i << " " << fGlobalBin[i] << " " << fFVal[i] << std::endl;
-	 */
 
-	auto end_iterators = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(system_t(),fGlobalBinInput.begin(),fGlobalBinInput.end(),fFValInput.begin(),
-			fGlobalBinOutput.begin(),  fFValOutput.begin());
+}
+
+template< size_t N, hydra::detail::Backend  BACKEND , typename GRND>
+template<typename FUNCTORS, bool GRADIENT>
+void Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::ProcessFuncionCalls(detail::MultiEvaluator<FUNCTORS,GRADIENT> const& evaluator,
+		GBool_t training, GReal_t& integral, GReal_t& variance)
+{
+	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
+	typedef detail::ProcessCallsVegasMulti<detail::MultiEvaluator<FUNCTORS,GRADIENT>,N,system_t ,rvector_iterator, GRND> calls_t;
+
+	//the training only adapts the grid to the first value
+	if(training)
+	{
+		ProcessFuncionCalls(evaluator.GetFirst(), training, integral, variance);
+		return;
+	}
 
+	size_t nkeys   = N*fState.GetNBins();
 
+	detail::PartitionVegas<rvector_iterator> partition(fState.GetCalls(training));
 
-	HYDRA_EXTERNAL_NS::thrust::copy( fFValOutput.begin(), end_iterators.second, fState.GetDistribution().begin());
-	integral=result.fMean*result.fN  ;
-	tss=sqrt( result.fM2 );
+	fPartialDistribution.resize(partition.GetNPartials()*nkeys);
+	HYDRA_EXTERNAL_NS::thrust::fill(system_t(), fPartialDistribution.begin(), fPartialDistribution.end(), 0.0);
+
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> first(0);
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> last = first + partition.GetNItems();
+
+	fState.CopyStateToDevice();
+
+	detail::ResultVegasMulti<calls_t::K> init = detail::ResultVegasMulti<calls_t::K>();
+	detail::ResultVegasMulti<calls_t::K> result = HYDRA_EXTERNAL_NS::thrust::transform_reduce(system_t(), first, last,
+			calls_t(partition, fState, fPartialDistribution.begin(), evaluator)
+	, init,	detail::ProcessBoxesVegasMulti<calls_t::K>());
+
+	//merge the copies
+	MergePartialDistributions(partition.GetNPartials(), nkeys);
+
+	fMultiIterations++;
+
+	for(size_t k=0; k<calls_t::K; k++)
+	{
+		GReal_t intgrl = result.fResults[k].fMean*result.fResults[k].fN;
+		GReal_t var    = sqrt( result.fResults[k].fM2 )/(fState.GetCallsPerBox() - 1.0);
+
+		if(var > 0.0)
+		{
+			fMultiSums[k][0] += intgrl/var;
+			fMultiSums[k][1] += 1.0/var;
+		}
+
+		fMultiSums[k][2] += intgrl;
+	}
+
+	integral = result.fResults[0].fMean*result.fResults[0].fN;
+	variance = sqrt( result.fResults[0].fM2 )/(fState.GetCallsPerBox() - 1.0);
+}
+
+template< size_t N, hydra::detail::Backend  BACKEND , typename GRND>
+template<typename FUNCTORS, bool GRADIENT>
+void Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::ProcessFuncionCallsAdaptive(detail::MultiEvaluator<FUNCTORS,GRADIENT> const& evaluator,
+		GBool_t training, GReal_t& integral, GReal_t& variance)
+{
+	//not reached, the multiple integrand Integrate(...) switches to importance sampling
+	ProcessFuncionCalls(evaluator, training, integral, variance);
+}
+
+template< size_t N, hydra::detail::Backend  BACKEND , typename GRND>
+void Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::MergePartialDistributions(size_t npartials, size_t nkeys)
+{
+	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
+
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> first(0);
+
+	if( npartials > 1 )
+		HYDRA_EXTERNAL_NS::thrust::for_each(system_t(), first, first + nkeys,
+				detail::MergePartialsVegas<rvector_iterator>(npartials, nkeys, fPartialDistribution.begin()));
+
+	HYDRA_EXTERNAL_NS::thrust::copy( fPartialDistribution.begin(), fPartialDistribution.begin() + nkeys,
+			fState.GetDistribution().begin());
+}
+
+template< size_t N, hydra::detail::Backend  BACKEND , typename GRND>
+void Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::AllocateCalls(GBool_t training)
+{
+	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
+
+	size_t ncubes = 1;
+	for(size_t i=0; i<N; i++) ncubes *= fState.GetNBoxes();
+
+	auto& weights = fState.GetBackendCubeWeights();
+	auto& offsets = fState.GetBackendCubeOffsets();
+
+	if( weights.size() != ncubes ) {
+
+		//number of boxes per dimension of the previous stratification
+		size_t nboxes_old = 0;
+		size_t ncubes_old = weights.size();
+
+		if( ncubes_old > 0 ) {
+
+			nboxes_old = static_cast<size_t>( ::pow(GReal_t(ncubes_old), 1.0/N) + 0.5 );
+
+			size_t n = 1;
+			for(size_t i=0; i<N; i++) n *= nboxes_old;
+
+			if( n != ncubes_old ) nboxes_old = 0;
+		}
+
+		if( nboxes_old > 0 ) {
+
+			//the hypercubes changed: keep the weights learned so far
+			rvector_backend weights_old(weights);
+
+			weights.resize(ncubes);
+
+			HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> first(0);
+
+			HYDRA_EXTERNAL_NS::thrust::transform(system_t(), first, first + ncubes, weights.begin(),
+					detail::RemapCubeWeightsVegas<N, rvector_iterator>(fState.GetNBoxes(), nboxes_old, weights_old.begin()));
+		}
+		else {
+
+			//uniform distribution of calls in the first iteration
+			weights.resize(ncubes);
+			HYDRA_EXTERNAL_NS::thrust::fill(system_t(), weights.begin(), weights.end(), 1.0);
+		}
+	}
+
+	offsets.resize(ncubes + 1);
+
+	GReal_t total_weight = HYDRA_EXTERNAL_NS::thrust::reduce(system_t(), weights.begin(), weights.end(), 0.0);
+
+	if( !(total_weight > 0.0) || fState.GetBeta() == 0.0 ) {
+
+		HYDRA_EXTERNAL_NS::thrust::fill(system_t(), weights.begin(), weights.end(), 1.0);
+		total_weight = ncubes;
+	}
+
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> first(0);
+
+	HYDRA_EXTERNAL_NS::thrust::transform(system_t(), first, first + ncubes, offsets.begin() + 1,
+			detail::AllocateCallsVegas<rvector_iterator>(fState.GetCalls(training), total_weight, weights.begin()));
+
+	offsets[0] = 0;
+
+	HYDRA_EXTERNAL_NS::thrust::inclusive_scan(system_t(), offsets.begin() + 1, offsets.end(), offsets.begin() + 1);
+
+}
+
+template< size_t N, hydra::detail::Backend  BACKEND , typename GRND>
+template<typename FUNCTOR>
+void Vegas<N,hydra::detail::BackendPolicy<BACKEND>, GRND >::ProcessFuncionCallsAdaptive(FUNCTOR const& fFunctor, GBool_t training, GReal_t& integral, GReal_t& variance)
+{
+	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
+
+	//redistribute the calls using the variances measured in the previous iteration
+	AllocateCalls(training);
+
+	size_t ncubes  = fState.GetBackendCubeWeights().size();
+	size_t nkeys   = N*fState.GetNBins();
+
+	detail::PartitionVegas<rvector_iterator> partition(fState.GetBackendCubeOffsets()[ncubes]);
+
+	size_t nitems  = partition.GetNItems();
+
+	fPartialDistribution.resize(partition.GetNPartials()*nkeys);
+	HYDRA_EXTERNAL_NS::thrust::fill(system_t(), fPartialDistribution.begin(), fPartialDistribution.end(), 0.0);
+
+	fCubeSum.resize(ncubes);
+	fCubeSum2.resize(ncubes);
+	fEdgeKey.resize(2*nitems);
+	fEdgeSum.resize(2*nitems);
+	fEdgeSum2.resize(2*nitems);
+	fEdgeKeyOutput.resize(2*nitems);
+	fEdgeSumOutput.resize(2*nitems);
+
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<size_t> first(0);
+
+	fState.CopyStateToDevice();
+
+	HYDRA_EXTERNAL_NS::thrust::for_each(system_t(), first, first + nitems,
+			detail::ProcessCallsVegasPlus<FUNCTOR,N,system_t ,rvector_iterator, uvector_iterator, GRND>(
+					partition, ncubes, fState,
+					fPartialDistribution.begin(), fCubeSum.begin(), fCubeSum2.begin(),
+					fEdgeKey.begin(), fEdgeSum.begin(), fEdgeSum2.begin(), fFunctor) );
+
+	//merge the grid distribution
+	MergePartialDistributions(partition.GetNPartials(), nkeys);
+
+	//merge the hypercubes shared by neighbor work items
+	auto end_sum = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(system_t(), fEdgeKey.begin(), fEdgeKey.end(),
+			fEdgeSum.begin(), fEdgeKeyOutput.begin(), fEdgeSumOutput.begin());
+
+	HYDRA_EXTERNAL_NS::thrust::scatter(system_t(), fEdgeSumOutput.begin(), end_sum.second,
+			fEdgeKeyOutput.begin(), fCubeSum.begin());
+
+	auto end_sum2 = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(system_t(), fEdgeKey.begin(), fEdgeKey.end(),
+			fEdgeSum2.begin(), fEdgeKeyOutput.begin(), fEdgeSumOutput.begin());
+
+	HYDRA_EXTERNAL_NS::thrust::scatter(system_t(), fEdgeSumOutput.begin(), end_sum2.second,
+			fEdgeKeyOutput.begin(), fCubeSum2.begin());
+
+	//integral, variance and weights for the next allocation
+	detail::ResultVegasPlus init = detail::ResultVegasPlus();
+	detail::ResultVegasPlus result = HYDRA_EXTERNAL_NS::thrust::transform_reduce(system_t(), first, first + ncubes,
+			detail::ProcessCubesVegas<rvector_iterator, uvector_iterator>(fState.GetBeta(),
+					fState.GetBackendCubeOffsets().begin(), fCubeSum.begin(), fCubeSum2.begin(),
+					fState.GetBackendCubeWeights().begin()),
+			init, detail::ProcessCubesVegasPlus());
 
+	integral = result.fIntegral;
+	variance = result.fVariance;
 
 }
 
@@ -30,23 +30,37 @@
 #ifndef VEGASSTATE_INL_
 #define VEGASSTATE_INL_
 
+#include <type_traits>
+#include <limits>
+
 namespace hydra {
 
 template<size_t N , hydra::detail::Backend BACKEND>
 VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::VegasState(std::array<GReal_t,N> const& xlower,
 		std::array<GReal_t,N> const& xupper) :
-		fTrainingIterations(1),
-		fTrainedGridFrozen(0),
+		fVerbose(-1),
+		fOStream(std::cout),
 		fNDimensions(N),
 		fNBinsMax(BINS_MAX),
 		fNBins(BINS_MAX),
 		fNBoxes(0),
+		fBackendXLow(N),
+		fBackendXi((BINS_MAX + 1) * N),
+		fBackendDeltaX(N),
+		fXUp(N),
+		fXLow(N),
+		fXi((BINS_MAX + 1) * N),
+		fXin(BINS_MAX + 1),
+		fDeltaX(N),
+		fWeight(BINS_MAX),
+		fDistribution(N * BINS_MAX),
 		fVolume(0),
 		fAlpha(1.5),
+		fBeta(0.75),
 		fMode(MODE_IMPORTANCE),
-		fVerbose(-1),
 		fIterations(5),
 		fStage(0),
+		fTrainedGridFrozen(0),
 		fJacobian(0),
 		fWeightedIntSum(0),
 		fSumOfWeights(0),
@@ -54,6 +68,7 @@ VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::VegasState(std::array<GRea
 		fChiSquare(0),
 		fResult(0),
 		fSigma(10),
+		fTrainingIterations(1),
 		fItStart(0),
 		fItNum(0),
 		fSamples(0),
@@ -62,20 +77,7 @@ VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::VegasState(std::array<GRea
 		fTrainingCalls(5000),
 		fMaxError(0.5e-3),
 		fUseRelativeError(kTrue),
-		fOStream(std::cout),
-		//-------
-		fBackendXLow(N),
-		fBackendDeltaX(N),
-		//fBackendDistribution(N * BINS_MAX),
-		fBackendXi((BINS_MAX + 1) * N),
-		//-------
-		fDistribution(N * BINS_MAX),
-		fDeltaX(N),
-		fXi((BINS_MAX + 1) * N),
-		fXin(BINS_MAX + 1),
-		fWeight(BINS_MAX),
-		fXUp(N),
-		fXLow(N)
+		fScrambledSeeds(kFalse)
 {
 
 	for(size_t i=0; i<N; i++)
@@ -92,18 +94,29 @@ VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::VegasState(std::array<GRea
 
 template<size_t N , hydra::detail::Backend BACKEND>
 VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::VegasState(const GReal_t xlower[N], const GReal_t xupper[N]) :
-		fTrainingIterations(1),
-		fTrainedGridFrozen(0),
+		fVerbose(-1),
+		fOStream(std::cout),
 		fNDimensions(N),
 		fNBinsMax(BINS_MAX),
 		fNBins(BINS_MAX),
 		fNBoxes(0),
+		fBackendXLow(N),
+		fBackendXi((BINS_MAX + 1) * N),
+		fBackendDeltaX(N),
+		fXUp(N),
+		fXLow(N),
+		fXi((BINS_MAX + 1) * N),
+		fXin(BINS_MAX + 1),
+		fDeltaX(N),
+		fWeight(BINS_MAX),
+		fDistribution(N * BINS_MAX),
 		fVolume(0),
 		fAlpha(1.5),
+		fBeta(0.75),
 		fMode(MODE_IMPORTANCE),
-		fVerbose(-1),
 		fIterations(5),
 		fStage(0),
+		fTrainedGridFrozen(0),
 		fJacobian(0),
 		fWeightedIntSum(0),
 		fSumOfWeights(0),
@@ -111,6 +124,7 @@ VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::VegasState(const GReal_t x
 		fChiSquare(0),
 		fResult(0),
 		fSigma(10),
+		fTrainingIterations(1),
 		fItStart(0),
 		fItNum(0),
 		fSamples(0),
@@ -119,20 +133,7 @@ VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::VegasState(const GReal_t x
 		fTrainingCalls(5000),
 		fMaxError(0.5e-3),
 		fUseRelativeError(kTrue),
-		fOStream(std::cout),
-		//-------
-		fBackendXLow(N),
-		fBackendDeltaX(N),
-		//fBackendDistribution(N * BINS_MAX),
-		fBackendXi((BINS_MAX + 1) * N),
-		//-------
-		fDistribution(N * BINS_MAX),
-		fDeltaX(N),
-		fXi((BINS_MAX + 1) * N),
-		fXin(BINS_MAX + 1),
-		fWeight(BINS_MAX),
-		fXUp(N),
-		fXLow(N)
+		fScrambledSeeds(kFalse)
 {
 
 	for(size_t i=0; i<N; i++)
@@ -149,18 +150,36 @@ VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::VegasState(const GReal_t x
 
 template<size_t N , hydra::detail::Backend BACKEND>
 VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::VegasState(VegasState<N,hydra::detail::BackendPolicy<BACKEND>> const& other) :
-        fTrainingIterations(other.GetTrainingIterations()),
-        fTrainedGridFrozen(other.IsTrainedGridFrozen()),
-		fAlpha(other.GetAlpha()),
+		fVerbose(other.GetVerbose()),
+		fOStream(std::cout),
 		fNDimensions(other.GetNDimensions()),
 		fNBinsMax(other.GetNBinsMax()),
 		fNBins(other.GetNBins()),
 		fNBoxes(other.GetNBoxes()),
+		fBackendXLow(other.GetBackendXLow()),
+		fBackendXi(other.GetBackendXi()),
+		fBackendDeltaX(other.GetBackendDeltaX()),
+		fBackendCubeWeights(other.GetBackendCubeWeights()),
+		fBackendCubeOffsets(other.GetBackendCubeOffsets()),
+		fXUp(other.GetXUp()),
+		fXLow(other.GetXLow()),
+		fXi(other.GetXi()),
+		fXin(other.GetXin()),
+		fDeltaX(other.GetDeltaX()),
+		fWeight(other.GetWeight()),
+		fDistribution(other.GetDistribution()),
+		fIterationResult(other.GetIterationResult()),
+		fIterationSigma(other.GetIterationSigma()),
+		fCumulatedResult(other.GetCumulatedResult()),
+		fCumulatedSigma(other.GetCumulatedSigma()),
+		fIterationDuration(other.GetIterationDuration()),
 		fVolume(other.GetVolume()),
+		fAlpha(other.GetAlpha()),
+		fBeta(other.GetBeta()),
 		fMode(other.GetMode()),
-		fVerbose(other.GetVerbose()),
 		fIterations(other.GetIterations()),
 		fStage(other.GetStage()),
+		fTrainedGridFrozen(other.IsTrainedGridFrozen()),
 		fJacobian(other.GetJacobian()),
 		fWeightedIntSum(other.GetWeightedIntSum()),
 		fSumOfWeights(other.GetSumOfWeights()),
@@ -168,48 +187,51 @@ VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::VegasState(VegasState<N,hy
 		fChiSquare(other.GetChiSquare()),
 		fResult(other.GetResult()),
 		fSigma(other.GetSigma()),
+		fTrainingIterations(other.GetTrainingIterations()),
 		fItStart(other.GetItStart()),
 		fItNum(other.GetItNum()),
 		fSamples(other.GetSamples()),
-		fMaxError(other.GetMaxError()),
-		fUseRelativeError(other.IsUseRelativeError()),
 		fCallsPerBox(other.GetCallsPerBox()),
 		fCalls(other.GetCalls()),
 		fTrainingCalls(other.GetTrainingCalls()),
-		fDeltaX(other.GetDeltaX()),
-		fDistribution(other.GetDistribution()),
-		fXi(other.GetXi()),
-		fXin(other.GetXin()),
-		fWeight(other.GetWeight()),
-		fXLow(other.GetXLow()),
-		fXUp(other.GetXUp()),
-		fIterationResult(other.GetIterationResult()),
-		fIterationSigma(other.GetIterationSigma()),
-		fCumulatedResult(other.GetCumulatedResult()),
-		fCumulatedSigma(other.GetCumulatedSigma()),
-		fIterationDuration(other.GetIterationDuration()),
-		fBackendDeltaX(other.GetBackendDeltaX()),
-		fBackendXi(other.GetBackendXi()),
-		fBackendXLow(other.GetBackendXLow()),
-		//fBackendDistribution(other.GetBackendDistribution()),
-		fOStream(std::cout) {}
+		fMaxError(other.GetMaxError()),
+		fUseRelativeError(other.IsUseRelativeError()),
+		fScrambledSeeds(other.IsScrambledSeeds()) {}
 
 template<size_t N , hydra::detail::Backend BACKEND>
 template<hydra::detail::Backend BACKEND2>
 VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::
 VegasState( VegasState<N, hydra::detail::BackendPolicy <BACKEND2>> const& other) :
-        fTrainingIterations(other.GetTrainingIterations()),
-        fTrainedGridFrozen(other.IsTrainedGridFrozen()),
-		fAlpha(other.GetAlpha()),
+		fVerbose(other.GetVerbose()),
+		fOStream(std::cout),
 		fNDimensions(other.GetNDimensions()),
 		fNBinsMax(other.GetNBinsMax()),
 		fNBins(other.GetNBins()),
 		fNBoxes(other.GetNBoxes()),
+		fBackendXLow(other.GetBackendXLow()),
+		fBackendXi(other.GetBackendXi()),
+		fBackendDeltaX(other.GetBackendDeltaX()),
+		fBackendCubeWeights(other.GetBackendCubeWeights()),
+		fBackendCubeOffsets(other.GetBackendCubeOffsets()),
+		fXUp(other.GetXUp()),
+		fXLow(other.GetXLow()),
+		fXi(other.GetXi()),
+		fXin(other.GetXin()),
+		fDeltaX(other.GetDeltaX()),
+		fWeight(other.GetWeight()),
+		fDistribution(other.GetDistribution()),
+		fIterationResult(other.GetIterationResult()),
+		fIterationSigma(other.GetIterationSigma()),
+		fCumulatedResult(other.GetCumulatedResult()),
+		fCumulatedSigma(other.GetCumulatedSigma()),
+		fIterationDuration(other.GetIterationDuration()),
 		fVolume(other.GetVolume()),
+		fAlpha(other.GetAlpha()),
+		fBeta(other.GetBeta()),
 		fMode(other.GetMode()),
-		fVerbose(other.GetVerbose()),
 		fIterations(other.GetIterations()),
 		fStage(other.GetStage()),
+		fTrainedGridFrozen(other.IsTrainedGridFrozen()),
 		fJacobian(other.GetJacobian()),
 		fWeightedIntSum(other.GetWeightedIntSum()),
 		fSumOfWeights(other.GetSumOfWeights()),
@@ -217,31 +239,16 @@ VegasState( VegasState<N, hydra::detail::BackendPolicy <BACKEND2>> const& other)
 		fChiSquare(other.GetChiSquare()),
 		fResult(other.GetResult()),
 		fSigma(other.GetSigma()),
+		fTrainingIterations(other.GetTrainingIterations()),
 		fItStart(other.GetItStart()),
 		fItNum(other.GetItNum()),
 		fSamples(other.GetSamples()),
-		fMaxError(other.GetMaxError()),
-		fUseRelativeError(other.IsUseRelativeError()),
 		fCallsPerBox(other.GetCallsPerBox()),
 		fCalls(other.GetCalls()),
 		fTrainingCalls(other.GetTrainingCalls()),
-		fDeltaX(other.GetDeltaX()),
-		fDistribution(other.GetDistribution()),
-		fXi(other.GetXi()),
-		fXin(other.GetXin()),
-		fWeight(other.GetWeight()),
-		fXLow(other.GetXLow()),
-		fXUp(other.GetXUp()),
-		fIterationResult(other.GetIterationResult()),
-		fIterationSigma(other.GetIterationSigma()),
-		fCumulatedResult(other.GetCumulatedResult()),
-		fCumulatedSigma(other.GetCumulatedSigma()),
-		fIterationDuration(other.GetIterationDuration()),
-		fBackendDeltaX(other.GetBackendDeltaX()),
-		fBackendXi(other.GetBackendXi()),
-		fBackendXLow(other.GetBackendXLow()),
-		//fBackendDistribution(other.GetBackendDistribution()),
-		fOStream(std::cout) {}
+		fMaxError(other.GetMaxError()),
+		fUseRelativeError(other.IsUseRelativeError()),
+		fScrambledSeeds(other.IsScrambledSeeds()) {}
 
 
 
@@ -253,6 +260,7 @@ VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::operator=(VegasState<N,hyd
         fTrainingIterations=other.GetTrainingIterations();
         fTrainedGridFrozen=other.IsTrainedGridFrozen();
 		fAlpha=other.GetAlpha();
+		fBeta=other.GetBeta();
 		fNDimensions=other.GetNDimensions();
 		fNBinsMax=other.GetNBinsMax();
 		fNBins=other.GetNBins();
@@ -274,6 +282,7 @@ VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::operator=(VegasState<N,hyd
 		fSamples=other.GetSamples();
 		fMaxError=other.GetMaxError();
 		fUseRelativeError=other.IsUseRelativeError();
+		fScrambledSeeds=other.IsScrambledSeeds();
 		fCallsPerBox=other.GetCallsPerBox();
 		fCalls=other.GetCalls();
 		fTrainingCalls=other.GetTrainingCalls();
@@ -292,10 +301,10 @@ VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::operator=(VegasState<N,hyd
 		fBackendDeltaX=other.GetBackendDeltaX();
 		fBackendXi=other.GetBackendXi();
 		fBackendXLow=other.GetBackendXLow();
+		fBackendCubeWeights=other.GetBackendCubeWeights();
+		fBackendCubeOffsets=other.GetBackendCubeOffsets();
 		//fBackendDistribution=other.GetBackendDistribution();
 
-		fOStream =other.GetOStream();
-
 		return *this;
 
 }
@@ -310,6 +319,7 @@ VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::operator=( VegasState<N, h
         fTrainingIterations=other.GetTrainingIterations();
         fTrainedGridFrozen=other.IsTrainedGridFrozen();
 		fAlpha=other.GetAlpha();
+		fBeta=other.GetBeta();
 		fNDimensions=other.GetNDimensions();
 		fNBinsMax=other.GetNBinsMax();
 		fNBins=other.GetNBins();
@@ -331,6 +341,7 @@ VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::operator=( VegasState<N, h
 		fSamples=other.GetSamples();
 		fMaxError=other.GetMaxError();
 		fUseRelativeError=other.IsUseRelativeError();
+		fScrambledSeeds=other.IsScrambledSeeds();
 		fCallsPerBox=other.GetCallsPerBox();
 		fCalls=other.GetCalls();
 		fTrainingCalls=other.GetTrainingCalls();
@@ -349,14 +360,254 @@ VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::operator=( VegasState<N, h
 		fBackendDeltaX=other.GetBackendDeltaX();
 		fBackendXi=other.GetBackendXi();
 		fBackendXLow=other.GetBackendXLow();
+		fBackendCubeWeights=other.GetBackendCubeWeights();
+		fBackendCubeOffsets=other.GetBackendCubeOffsets();
 		//fBackendDistribution=other.GetBackendDistribution();
-		fOStream =other.GetOStream();
 
 		return *this;
 }
 
 
 
+
+template<size_t N , hydra::detail::Backend BACKEND>
+constexpr char VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::kStateTag[];
+
+template<size_t N , hydra::detail::Backend BACKEND>
+constexpr GInt_t VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::kStateVersion;
+
+template<size_t N , hydra::detail::Backend BACKEND>
+template<typename T>
+void VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::WriteValue(std::ostream& stream, T const value)
+{
+	typedef typename std::conditional<std::is_floating_point<T>::value, double,
+			typename std::conditional<std::is_signed<T>::value, GLong64_t, GULong64_t>::type >::type store_t;
+
+	store_t x = static_cast<store_t>(value);
+	stream.write(reinterpret_cast<const char*>(&x), sizeof(store_t));
+}
+
+template<size_t N , hydra::detail::Backend BACKEND>
+template<typename T>
+bool VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::ReadValue(std::istream& stream, T& value)
+{
+	typedef typename std::conditional<std::is_floating_point<T>::value, double,
+			typename std::conditional<std::is_signed<T>::value, GLong64_t, GULong64_t>::type >::type store_t;
+
+	store_t x;
+	stream.read(reinterpret_cast<char*>(&x), sizeof(store_t));
+	value = static_cast<T>(x);
+
+	return stream.good();
+}
+
+template<size_t N , hydra::detail::Backend BACKEND>
+template<typename T>
+void VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::WriteVector(std::ostream& stream, std::vector<T> const& values)
+{
+	WriteValue(stream, values.size());
+
+	for(auto x: values) WriteValue(stream, x);
+}
+
+template<size_t N , hydra::detail::Backend BACKEND>
+template<typename T>
+bool VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::ReadVector(std::istream& stream, std::vector<T>& values, size_t max_size)
+{
+	size_t size = 0;
+
+	if( !ReadValue(stream, size) || size > max_size ) return false;
+
+	//do not trust sizes larger than the rest of the file
+	std::streampos position = stream.tellg();
+	stream.seekg(0, std::ios::end);
+	std::streamoff remaining = stream.tellg() - position;
+	stream.seekg(position);
+
+	if( size > static_cast<size_t>(remaining)/sizeof(double) ) return false;
+
+	values.resize(size);
+
+	for(auto& x: values)
+		if( !ReadValue(stream, x) ) return false;
+
+	return true;
+}
+
+template<size_t N , hydra::detail::Backend BACKEND>
+bool VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::SaveState(std::string const& filename) const
+{
+	std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if(!file.is_open()){
+		HYDRA_LOG(WARNING, "Can not open file " << filename << " to save the VegasState.")
+		return false;
+	}
+
+	file.write(kStateTag, sizeof(kStateTag));
+	WriteValue(file, kStateVersion);
+
+	//key
+	WriteValue(file, N);
+	WriteValue(file, fNBins);
+
+	//limits
+	WriteVector(file, fXLow);
+	WriteVector(file, fXUp);
+	WriteVector(file, fDeltaX);
+	WriteValue(file, fVolume);
+
+	//control
+	WriteValue(file, fNBinsMax);
+	WriteValue(file, fNBoxes);
+	WriteValue(file, fAlpha);
+	WriteValue(file, fBeta);
+	WriteValue(file, fMode);
+	WriteValue(file, fIterations);
+	WriteValue(file, fTrainingIterations);
+	WriteValue(file, fTrainedGridFrozen);
+	WriteValue(file, fCallsPerBox);
+	WriteValue(file, fCalls);
+	WriteValue(file, fTrainingCalls);
+	WriteValue(file, fMaxError);
+	WriteValue(file, fUseRelativeError);
+	WriteValue(file, fScrambledSeeds);
+	WriteValue(file, fJacobian);
+
+	//grid
+	WriteVector(file, fXi);
+	WriteVector(file, fDistribution);
+
+	//adaptive stratification
+	std::vector<GReal_t> cube_weights(fBackendCubeWeights.size());
+	HYDRA_EXTERNAL_NS::thrust::copy(fBackendCubeWeights.begin(), fBackendCubeWeights.end(), cube_weights.begin());
+	WriteVector(file, cube_weights);
+
+	std::vector<size_t> cube_offsets(fBackendCubeOffsets.size());
+	HYDRA_EXTERNAL_NS::thrust::copy(fBackendCubeOffsets.begin(), fBackendCubeOffsets.end(), cube_offsets.begin());
+	WriteVector(file, cube_offsets);
+
+	//results
+	WriteValue(file, fStage);
+	WriteValue(file, fItNum);
+	WriteValue(file, fSamples);
+	WriteValue(file, fWeightedIntSum);
+	WriteValue(file, fSumOfWeights);
+	WriteValue(file, fChiSum);
+	WriteValue(file, fChiSquare);
+	WriteValue(file, fResult);
+	WriteValue(file, fSigma);
+	WriteVector(file, fIterationResult);
+	WriteVector(file, fIterationSigma);
+	WriteVector(file, fCumulatedResult);
+	WriteVector(file, fCumulatedSigma);
+	WriteVector(file, fIterationDuration);
+	WriteVector(file, fFunctionCallsDuration);
+
+	if(!file.good()){
+		HYDRA_LOG(WARNING, "Error writing the VegasState to file " << filename << ".")
+		return false;
+	}
+
+	return true;
+}
+
+template<size_t N , hydra::detail::Backend BACKEND>
+bool VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::LoadState(std::string const& filename)
+{
+	std::ifstream file(filename, std::ios::in | std::ios::binary);
+
+	if(!file.is_open()){
+		HYDRA_LOG(WARNING, "Can not open file " << filename << " to load the VegasState.")
+		return false;
+	}
+
+	char tag[sizeof(kStateTag)];
+	file.read(tag, sizeof(kStateTag));
+
+	GInt_t version = 0;
+	size_t ndimensions = 0, nbins = 0;
+
+	if( !file.good() || std::string(tag, sizeof(kStateTag)) != std::string(kStateTag, sizeof(kStateTag)) ||
+		!ReadValue(file, version) || version != kStateVersion ){
+
+		HYDRA_LOG(WARNING, "File " << filename << " does not contain a VegasState or was written by a different version.")
+		return false;
+	}
+
+	if( !ReadValue(file, ndimensions) || !ReadValue(file, nbins) ||
+		ndimensions != N || nbins > BINS_MAX ){
+
+		HYDRA_LOG(WARNING, "VegasState in file " << filename << " has " << ndimensions << " dimensions and "
+				<< nbins << " bins. Expected " << N << " dimensions and at most " << BINS_MAX << " bins.")
+		return false;
+	}
+
+	//read everything in a copy, so the state is untouched in case of error
+	VegasState<N, hydra::detail::BackendPolicy<BACKEND>> other(*this);
+
+	bool ok = true;
+
+	other.fNBins = nbins;
+
+	ok = ok && ReadVector(file, other.fXLow, N) && ReadVector(file, other.fXUp, N)
+			&& ReadVector(file, other.fDeltaX, N) && ReadValue(file, other.fVolume);
+
+	ok = ok && ReadValue(file, other.fNBinsMax) && ReadValue(file, other.fNBoxes)
+			&& ReadValue(file, other.fAlpha) && ReadValue(file, other.fBeta)
+			&& ReadValue(file, other.fMode) && ReadValue(file, other.fIterations)
+			&& ReadValue(file, other.fTrainingIterations) && ReadValue(file, other.fTrainedGridFrozen)
+			&& ReadValue(file, other.fCallsPerBox) && ReadValue(file, other.fCalls)
+			&& ReadValue(file, other.fTrainingCalls) && ReadValue(file, other.fMaxError)
+			&& ReadValue(file, other.fUseRelativeError) && ReadValue(file, other.fScrambledSeeds)
+			&& ReadValue(file, other.fJacobian);
+
+	ok = ok && ReadVector(file, other.fXi, (BINS_MAX + 1) * N)
+			&& ReadVector(file, other.fDistribution, N * BINS_MAX);
+
+	std::vector<GReal_t> cube_weights;
+	std::vector<size_t> cube_offsets;
+
+	ok = ok && ReadVector(file, cube_weights, std::numeric_limits<size_t>::max())
+			&& ReadVector(file, cube_offsets, std::numeric_limits<size_t>::max());
+
+	ok = ok && ReadValue(file, other.fStage) && ReadValue(file, other.fItNum)
+			&& ReadValue(file, other.fSamples) && ReadValue(file, other.fWeightedIntSum)
+			&& ReadValue(file, other.fSumOfWeights) && ReadValue(file, other.fChiSum)
+			&& ReadValue(file, other.fChiSquare) && ReadValue(file, other.fResult)
+			&& ReadValue(file, other.fSigma);
+
+	ok = ok && ReadVector(file, other.fIterationResult, std::numeric_limits<size_t>::max())
+			&& ReadVector(file, other.fIterationSigma, std::numeric_limits<size_t>::max())
+			&& ReadVector(file, other.fCumulatedResult, std::numeric_limits<size_t>::max())
+			&& ReadVector(file, other.fCumulatedSigma, std::numeric_limits<size_t>::max())
+			&& ReadVector(file, other.fIterationDuration, std::numeric_limits<size_t>::max());
+
+	ok = ok && ReadVector(file, other.fFunctionCallsDuration, std::numeric_limits<size_t>::max());
+
+	if( !ok || other.fXi.size() != (BINS_MAX + 1) * N || other.fDistribution.size() != N * BINS_MAX ){
+
+		HYDRA_LOG(WARNING, "File " << filename << " is truncated or corrupted. VegasState not loaded.")
+		return false;
+	}
+
+	other.fBackendCubeWeights.resize(cube_weights.size());
+	HYDRA_EXTERNAL_NS::thrust::copy(cube_weights.begin(), cube_weights.end(), other.fBackendCubeWeights.begin());
+
+	other.fBackendCubeOffsets.resize(cube_offsets.size());
+	HYDRA_EXTERNAL_NS::thrust::copy(cube_offsets.begin(), cube_offsets.end(), other.fBackendCubeOffsets.begin());
+
+	//a grid that went through at least one iteration
+	if(other.fStage < 1 && nbins > 1) other.fStage = 1;
+
+	*this = other;
+
+	SendGridToBackend();
+	CopyStateToDevice();
+
+	return true;
+}
+
 template<size_t N , hydra::detail::Backend BACKEND>
 void VegasState<N, hydra::detail::BackendPolicy<BACKEND>>::ClearStoredIterations()
 {
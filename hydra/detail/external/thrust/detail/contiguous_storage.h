@@ -101,6 +101,15 @@ template<typename T, typename Alloc>
     __hydra_host__ __hydra_device__
     void swap(contiguous_storage &x);
 
+    // takes ownership of a block of n elements, allocated by an allocator
+    // sharing the memory resource of this one. the current block must be deallocated
+    __hydra_host__ __hydra_device__
+    void adopt(pointer p, size_type n);
+
+    // gives up the ownership of the block, without deallocating it
+    __hydra_host__ __hydra_device__
+    void release(void);
+
     __hydra_host__ __hydra_device__
     void default_construct_n(iterator first, size_type n);
 
@@ -186,6 +186,24 @@ __hydra_host__ __hydra_device__
   thrust::swap(m_allocator, x.m_allocator);
 } // end contiguous_storage::swap()
 
+template<typename T, typename Alloc>
+__hydra_host__ __hydra_device__
+  void contiguous_storage<T,Alloc>
+    ::adopt(pointer p, size_type n)
+{
+  m_begin = iterator(p);
+  m_size = n;
+} // end contiguous_storage::adopt()
+
+template<typename T, typename Alloc>
+__hydra_host__ __hydra_device__
+  void contiguous_storage<T,Alloc>
+    ::release(void)
+{
+  m_begin = iterator(pointer(static_cast<T*>(0)));
+  m_size = 0;
+} // end contiguous_storage::release()
+
 template<typename T, typename Alloc>
 __hydra_host__ __hydra_device__
   void contiguous_storage<T,Alloc>
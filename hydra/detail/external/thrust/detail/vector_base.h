@@ -345,6 +345,15 @@ template<typename T, typename Alloc>
      */
     void swap(vector_base &v);
 
+    /*! This method takes the storage of another vector_base, whose allocator shares the memory
+     *  resource of the allocator of this vector_base (e.g. both allocating with \p std::malloc),
+     *  without moving or copying its elements. The elements of this vector_base are destroyed
+     *  and its storage deallocated, while \p v is left empty.
+     *  \param v The vector_base whose storage is taken.
+     */
+    template<typename OtherAlloc>
+    void adopt_storage(vector_base<T,OtherAlloc> &v);
+
     /*! This method removes the element at position pos.
      *  \param pos The position of the element of interest.
      *  \return An iterator pointing to the new location of the element that followed the element
@@ -417,6 +426,8 @@ template<typename T, typename Alloc>
     size_type m_size;
 
   private:
+    template<typename OtherT, typename OtherAlloc> friend class vector_base;
+
     // these methods resolve the ambiguity of the constructor template of form (Iterator, Iterator)
     template<typename IteratorOrIntegralType>
       void init_dispatch(IteratorOrIntegralType begin, IteratorOrIntegralType end, false_type); 
@@ -29,6 +29,7 @@
 #include <hydra/detail/external/thrust/detail/minmax.h>
 #include <hydra/detail/external/thrust/iterator/iterator_traits.h>
 #include <hydra/detail/external/thrust/detail/temporary_array.h>
+#include <hydra/detail/external/thrust/detail/raw_pointer_cast.h>
 
 #include <stdexcept>
 
@@ -564,6 +565,21 @@ template<typename T, typename Alloc>
   thrust::swap(m_size,     v.m_size);
 } // end vector_base::swap()
 
+template<typename T, typename Alloc>
+  template<typename OtherAlloc>
+    void vector_base<T,Alloc>
+      ::adopt_storage(vector_base<T,OtherAlloc> &v)
+{
+  clear();
+  m_storage.deallocate();
+
+  m_storage.adopt(pointer(thrust::raw_pointer_cast(v.m_storage.begin().base())), v.m_storage.size());
+  m_size = v.m_size;
+
+  v.m_storage.release();
+  v.m_size = 0;
+} // end vector_base::adopt_storage()
+
 template<typename T, typename Alloc>
   void vector_base<T,Alloc>
     ::assign(size_type n, const T &x)
@@ -26,6 +26,7 @@
 #include <hydra/detail/external/thrust/iterator/iterator_traits.h>
 #include <hydra/detail/external/thrust/distance.h>
 #include <hydra/detail/external/thrust/for_each.h>
+#include <hydra/detail/external/thrust/system/omp/detail/policy_settings.h>
 
 HYDRA_EXTERNAL_NAMESPACE_BEGIN  namespace thrust
 {
@@ -40,7 +41,7 @@ template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename Size,
          typename UnaryFunction>
-RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
+RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &exec,
                                 RandomAccessIterator first,
                                 Size n,
                                 UnaryFunction f)
@@ -65,13 +66,32 @@ RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
   // use a signed type for the iteration variable or suffer the consequences of warnings
   typedef typename thrust::iterator_difference<RandomAccessIterator>::type DifferenceType;
   DifferenceType signed_n = n;
-#pragma omp parallel for
-  for(DifferenceType i = 0;
-      i < signed_n;
-      ++i)
+
+  // number of threads and chunk size of the policy
+  int threads = thrust::system::omp::detail::num_threads(exec);
+  int grain   = static_cast<int>(thrust::system::omp::detail::grain_size(exec));
+
+  if(grain > 0)
+  {
+#pragma omp parallel for num_threads(threads) schedule(dynamic, grain)
+    for(DifferenceType i = 0;
+        i < signed_n;
+        ++i)
+    {
+      RandomAccessIterator temp = first + i;
+      wrapped_f(*temp);
+    }
+  }
+  else
   {
-    RandomAccessIterator temp = first + i;
-    wrapped_f(*temp);
+#pragma omp parallel for num_threads(threads)
+    for(DifferenceType i = 0;
+        i < signed_n;
+        ++i)
+    {
+      RandomAccessIterator temp = first + i;
+      wrapped_f(*temp);
+    }
   }
 #endif // HYDRA_THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
 
@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file policy_settings.h
+ *  \brief Per policy settings of the OpenMP parallel regions.
+ *
+ *  A policy derived from omp::execution_policy can provide overloads of
+ *  omp_policy_num_threads and omp_policy_grain_size taking the derived
+ *  policy, which are found by argument dependent lookup and take precedence
+ *  over the defaults below.
+ */
+
+#pragma once
+
+#include <hydra/detail/external/thrust/detail/config.h>
+#include <hydra/detail/external/thrust/system/omp/detail/execution_policy.h>
+#include <cstddef>
+
+#if (HYDRA_THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == HYDRA_THRUST_TRUE)
+#include <omp.h>
+#endif
+
+HYDRA_EXTERNAL_NAMESPACE_BEGIN  namespace thrust
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// number of threads of the parallel regions
+template<typename DerivedPolicy>
+inline int omp_policy_num_threads(const execution_policy<DerivedPolicy> &)
+{
+#if (HYDRA_THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == HYDRA_THRUST_TRUE)
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+// iterations per chunk of the parallel loops, scheduled dynamically; 0 for the static schedule
+template<typename DerivedPolicy>
+inline std::size_t omp_policy_grain_size(const execution_policy<DerivedPolicy> &)
+{
+  return 0;
+}
+
+template<typename DerivedPolicy>
+inline int num_threads(execution_policy<DerivedPolicy> &exec)
+{
+  return omp_policy_num_threads(thrust::detail::derived_cast(exec));
+}
+
+template<typename DerivedPolicy>
+inline std::size_t grain_size(execution_policy<DerivedPolicy> &exec)
+{
+  return omp_policy_grain_size(thrust::detail::derived_cast(exec));
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end HYDRA_EXTERNAL_NAMESPACE_BEGIN  namespace thrust
+
+HYDRA_EXTERNAL_NAMESPACE_END
@@ -19,6 +19,7 @@
 #include <hydra/detail/external/thrust/system/omp/detail/reduce.h>
 #include <hydra/detail/external/thrust/system/omp/detail/default_decomposition.h>
 #include <hydra/detail/external/thrust/system/omp/detail/reduce_intervals.h>
+#include <hydra/detail/external/thrust/system/omp/detail/policy_settings.h>
 
 HYDRA_EXTERNAL_NAMESPACE_BEGIN  namespace thrust
 {
@@ -45,7 +46,8 @@ template<typename DerivedPolicy,
   const difference_type n = thrust::distance(first,last);
 
   // determine first and second level decomposition
-  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp1 = thrust::system::omp::detail::default_decomposition(n);
+  // one interval per thread of the policy
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp1(n, 1, thrust::system::omp::detail::num_threads(exec));
   thrust::system::detail::internal::uniform_decomposition<difference_type> decomp2(decomp1.size() + 1, 1, 1);
 
   // allocate storage for the initializer and partial sums
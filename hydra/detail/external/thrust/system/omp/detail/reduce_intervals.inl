@@ -20,6 +20,7 @@
 #include <hydra/detail/external/thrust/iterator/iterator_traits.h>
 #include <hydra/detail/external/thrust/detail/function.h>
 #include <hydra/detail/external/thrust/detail/cstdint.h>
+#include <hydra/detail/external/thrust/system/omp/detail/policy_settings.h>
 
 HYDRA_EXTERNAL_NAMESPACE_BEGIN  namespace thrust
 {
@@ -35,7 +36,7 @@ template <typename DerivedPolicy,
           typename OutputIterator,
           typename BinaryFunction,
           typename Decomposition>
-void reduce_intervals(execution_policy<DerivedPolicy> &,
+void reduce_intervals(execution_policy<DerivedPolicy> &exec,
                       InputIterator input,
                       OutputIterator output,
                       BinaryFunction binary_op,
@@ -60,7 +61,9 @@ void reduce_intervals(execution_policy<DerivedPolicy> &,
   index_type n = static_cast<index_type>(decomp.size());
 
 #if (HYDRA_THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == HYDRA_THRUST_TRUE)
-# pragma omp parallel for
+  int threads = thrust::system::omp::detail::num_threads(exec);
+
+# pragma omp parallel for num_threads(threads)
 #endif // HYDRA_THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
   for(index_type i = 0; i < n; i++)
   {
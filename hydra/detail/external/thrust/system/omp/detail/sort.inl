@@ -28,6 +28,7 @@
 #include <hydra/detail/external/thrust/merge.h>
 #include <hydra/detail/external/thrust/detail/seq.h>
 #include <hydra/detail/external/thrust/detail/temporary_array.h>
+#include <hydra/detail/external/thrust/system/omp/detail/policy_settings.h>
 
 HYDRA_EXTERNAL_NAMESPACE_BEGIN  namespace thrust
 {
@@ -115,7 +116,9 @@ void stable_sort(execution_policy<DerivedPolicy> &exec,
   if(first == last)
     return;
 
-  #pragma omp parallel
+  int threads = thrust::system::omp::detail::num_threads(exec);
+
+  #pragma omp parallel num_threads(threads)
   {
     thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(last - first, 1, omp_get_num_threads());
 
@@ -193,7 +196,9 @@ void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
   if(keys_first == keys_last)
     return;
 
-  #pragma omp parallel
+  int threads = thrust::system::omp::detail::num_threads(exec);
+
+  #pragma omp parallel num_threads(threads)
   {
     thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(keys_last - keys_first, 1, omp_get_num_threads());
 
@@ -21,6 +21,7 @@
 #include <hydra/detail/external/thrust/system/tbb/detail/copy_if.h>
 #include <hydra/detail/external/thrust/iterator/iterator_traits.h>
 #include <hydra/detail/external/thrust/distance.h>
+#include <hydra/detail/external/thrust/system/tbb/detail/policy_settings.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_scan.h>
 
@@ -98,11 +99,12 @@ struct body
 
 } // end copy_if_detail
 
-template<typename InputIterator1,
+template<typename DerivedPolicy,
+         typename InputIterator1,
          typename InputIterator2,
          typename OutputIterator,
          typename Predicate>
-  OutputIterator copy_if(tag,
+  OutputIterator copy_if(execution_policy<DerivedPolicy> &exec,
                          InputIterator1 first,
                          InputIterator1 last,
                          InputIterator2 stencil,
@@ -117,7 +119,11 @@ template<typename InputIterator1,
   if (n != 0)
   {
     Body body(first, stencil, result, pred);
-    ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n), body);
+    Size grain = static_cast<Size>(tbb::detail::grain_size(exec));
+
+    tbb::detail::execute(exec, [&]{
+      ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n,grain), body);
+    });
     thrust::advance(result, body.sum);
   }
 
@@ -20,6 +20,7 @@
 #include <hydra/detail/external/thrust/iterator/iterator_traits.h>
 #include <hydra/detail/external/thrust/distance.h>
 #include <hydra/detail/external/thrust/system/detail/sequential/execution_policy.h>
+#include <hydra/detail/external/thrust/system/tbb/detail/policy_settings.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 
@@ -69,12 +70,16 @@ template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename Size,
          typename UnaryFunction>
-RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
+RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &exec,
                                 RandomAccessIterator first,
                                 Size n,
                                 UnaryFunction f)
 {
-  ::tbb::parallel_for(::tbb::blocked_range<Size>(0,n), for_each_detail::make_body<Size>(first,f));
+  Size grain = static_cast<Size>(tbb::detail::grain_size(exec));
+
+  tbb::detail::execute(exec, [&]{
+    ::tbb::parallel_for(::tbb::blocked_range<Size>(0,n,grain), for_each_detail::make_body<Size>(first,f));
+  });
 
   // return the end of the range
   return first + n;
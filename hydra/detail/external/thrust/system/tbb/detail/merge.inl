@@ -20,6 +20,7 @@
 #include <hydra/detail/external/thrust/merge.h>
 #include <hydra/detail/external/thrust/binary_search.h>
 #include <hydra/detail/external/thrust/detail/seq.h>
+#include <hydra/detail/external/thrust/system/tbb/detail/policy_settings.h>
 #include <tbb/parallel_for.h>
 
 HYDRA_EXTERNAL_NAMESPACE_BEGIN  namespace thrust
@@ -225,7 +226,7 @@ template<typename DerivedPolicy,
          typename InputIterator2,
          typename OutputIterator,
          typename StrictWeakOrdering>
-OutputIterator merge(execution_policy<DerivedPolicy> & /*exec*/,
+OutputIterator merge(execution_policy<DerivedPolicy> &exec,
                      InputIterator1 first1,
                      InputIterator1 last1,
                      InputIterator2 first2,
@@ -238,7 +239,9 @@ OutputIterator merge(execution_policy<DerivedPolicy> & /*exec*/,
   Range range(first1, last1, first2, last2, result, comp);
   Body  body;
 
-  ::tbb::parallel_for(range, body);
+  tbb::detail::execute(exec, [&]{
+    ::tbb::parallel_for(range, body);
+  });
 
   thrust::advance(result, thrust::distance(first1, last1) + thrust::distance(first2, last2));
 
@@ -254,7 +257,7 @@ template <typename DerivedPolicy,
           typename OutputIterator2,
           typename StrictWeakOrdering>
 thrust::pair<OutputIterator1,OutputIterator2>
-  merge_by_key(execution_policy<DerivedPolicy> &/*exec*/,
+  merge_by_key(execution_policy<DerivedPolicy> &exec,
                InputIterator1 keys_first1,
                InputIterator1 keys_last1,
                InputIterator2 keys_first2,
@@ -271,7 +274,9 @@ thrust::pair<OutputIterator1,OutputIterator2>
   Range range(keys_first1, keys_last1, keys_first2, keys_last2, values_first3, values_first4, keys_result, values_result, comp);
   Body  body;
 
-  ::tbb::parallel_for(range, body);
+  tbb::detail::execute(exec, [&]{
+    ::tbb::parallel_for(range, body);
+  });
 
   thrust::advance(keys_result,   thrust::distance(keys_first1, keys_last1) + thrust::distance(keys_first2, keys_last2));
   thrust::advance(values_result, thrust::distance(keys_first1, keys_last1) + thrust::distance(keys_first2, keys_last2));
@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file policy_settings.h
+ *  \brief Per policy settings of the TBB algorithms.
+ *
+ *  A policy derived from tbb::execution_policy can provide overloads of
+ *  tbb_policy_execute and tbb_policy_grain_size taking the derived
+ *  policy, which are found by argument dependent lookup and take precedence
+ *  over the defaults below.
+ */
+
+#pragma once
+
+#include <hydra/detail/external/thrust/detail/config.h>
+#include <hydra/detail/external/thrust/system/tbb/detail/execution_policy.h>
+#include <cstddef>
+
+HYDRA_EXTERNAL_NAMESPACE_BEGIN  namespace thrust
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// run the parallel part of an algorithm, e.g. inside a ::tbb::task_arena
+template<typename DerivedPolicy, typename Function>
+inline void tbb_policy_execute(const execution_policy<DerivedPolicy> &, Function &f)
+{
+  f();
+}
+
+// grain size of the ::tbb::blocked_range of the parallel loops
+template<typename DerivedPolicy>
+inline std::size_t tbb_policy_grain_size(const execution_policy<DerivedPolicy> &)
+{
+  return 1;
+}
+
+template<typename DerivedPolicy, typename Function>
+inline void execute(execution_policy<DerivedPolicy> &exec, Function f)
+{
+  tbb_policy_execute(thrust::detail::derived_cast(exec), f);
+}
+
+template<typename DerivedPolicy>
+inline std::size_t grain_size(execution_policy<DerivedPolicy> &exec)
+{
+  std::size_t grain = tbb_policy_grain_size(thrust::detail::derived_cast(exec));
+
+  return grain > 0 ? grain : 1;
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end HYDRA_EXTERNAL_NAMESPACE_BEGIN  namespace thrust
+
+HYDRA_EXTERNAL_NAMESPACE_END
@@ -23,6 +23,7 @@
 #include <hydra/detail/external/thrust/iterator/iterator_traits.h>
 #include <hydra/detail/external/thrust/distance.h>
 #include <hydra/detail/external/thrust/reduce.h>
+#include <hydra/detail/external/thrust/system/tbb/detail/policy_settings.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_reduce.h>
 
@@ -100,7 +101,7 @@ template<typename DerivedPolicy,
          typename InputIterator, 
          typename OutputType,
          typename BinaryFunction>
-  OutputType reduce(execution_policy<DerivedPolicy> &/*exec*/,
+  OutputType reduce(execution_policy<DerivedPolicy> &exec,
                     InputIterator begin,
                     InputIterator end,
                     OutputType init,
@@ -118,7 +119,11 @@ template<typename DerivedPolicy,
   {
     typedef typename reduce_detail::body<InputIterator,OutputType,BinaryFunction> Body;
     Body reduce_body(begin, init, binary_op);
-    ::tbb::parallel_reduce(::tbb::blocked_range<Size>(0,n), reduce_body);
+    Size grain = static_cast<Size>(tbb::detail::grain_size(exec));
+
+    tbb::detail::execute(exec, [&]{
+      ::tbb::parallel_reduce(::tbb::blocked_range<Size>(0,n,grain), reduce_body);
+    });
     return binary_op(init, reduce_body.sum);
   }
 }
@@ -25,6 +25,7 @@
 #include <hydra/detail/external/thrust/detail/minmax.h>
 #include <hydra/detail/external/thrust/detail/temporary_array.h>
 #include <hydra/detail/external/thrust/detail/range/tail_flags.h>
+#include <hydra/detail/external/thrust/system/tbb/detail/policy_settings.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
 #include <tbb/tbb_thread.h>
@@ -295,7 +296,9 @@ template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typenam
 
   // first count the number of tail flags in each interval
   thrust::detail::tail_flags<Iterator1,BinaryPredicate> tail_flags = thrust::detail::make_tail_flags(keys_first, keys_last, binary_pred);
-  thrust::system::tbb::detail::reduce_intervals(exec, tail_flags.begin(), tail_flags.end(), interval_size, interval_output_offsets.begin() + 1, thrust::plus<size_t>());
+  tbb::detail::execute(exec, [&]{
+    thrust::system::tbb::detail::reduce_intervals(exec, tail_flags.begin(), tail_flags.end(), interval_size, interval_output_offsets.begin() + 1, thrust::plus<size_t>());
+  });
   interval_output_offsets[0] = 0;
 
   // scan the counts to get each body's output offset
@@ -309,9 +312,11 @@ template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typenam
   thrust::detail::temporary_array<carry_type, DerivedPolicy> carries(0, exec, num_intervals - 1);
 
   // force grainsize == 1 with simple_partioner()
-  ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, num_intervals, 1),
-    reduce_by_key_detail::make_serial_reduce_by_key_body(keys_first, values_first, interval_output_offsets.begin(), keys_result, values_result, carries.begin(), n, interval_size, num_intervals, binary_pred, binary_op),
-    ::tbb::simple_partitioner());
+  tbb::detail::execute(exec, [&]{
+    ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, num_intervals, 1),
+      reduce_by_key_detail::make_serial_reduce_by_key_body(keys_first, values_first, interval_output_offsets.begin(), keys_result, values_result, carries.begin(), n, interval_size, num_intervals, binary_pred, binary_op),
+      ::tbb::simple_partitioner());
+  });
 
   difference_type size_of_result = interval_output_offsets[num_intervals];
 
@@ -18,6 +18,7 @@
 
 #include <hydra/detail/external/thrust/detail/config.h>
 #include <hydra/detail/external/thrust/system/tbb/detail/execution_policy.h>
+#include <hydra/detail/external/thrust/system/tbb/detail/policy_settings.h>
 #include <hydra/detail/external/thrust/detail/seq.h>
 
 #include <tbb/parallel_for.h>
@@ -60,20 +61,20 @@ template<typename RandomAccessIterator1, typename RandomAccessIterator2, typenam
 
   void operator()(const ::tbb::blocked_range<Size> &r) const
   {
-    assert(r.size() == 1);
-
-    Size interval_idx = r.begin();
-
-    Size offset_to_first = interval_size * interval_idx;
-    Size offset_to_last = thrust::min(n, offset_to_first + interval_size);
-
-    RandomAccessIterator1 my_first = first + offset_to_first;
-    RandomAccessIterator1 my_last  = first + offset_to_last;
-
-    // carefully pass the init value for the interval with raw_reference_cast
-    typedef typename BinaryFunction::result_type sum_type;
-    result[interval_idx] =
-      thrust::reduce(thrust::seq, my_first + 1, my_last, sum_type(thrust::raw_reference_cast(*my_first)), binary_op);
+    // the range holds several intervals if the grain size of the policy is larger than interval_size
+    for(Size interval_idx = r.begin(); interval_idx != r.end(); ++interval_idx)
+    {
+      Size offset_to_first = interval_size * interval_idx;
+      Size offset_to_last = thrust::min(n, offset_to_first + interval_size);
+
+      RandomAccessIterator1 my_first = first + offset_to_first;
+      RandomAccessIterator1 my_last  = first + offset_to_last;
+
+      // carefully pass the init value for the interval with raw_reference_cast
+      typedef typename BinaryFunction::result_type sum_type;
+      result[interval_idx] =
+        thrust::reduce(thrust::seq, my_first + 1, my_last, sum_type(thrust::raw_reference_cast(*my_first)), binary_op);
+    }
   }
 };
 
@@ -90,7 +91,7 @@ template<typename RandomAccessIterator1, typename RandomAccessIterator2, typenam
 
 
 template<typename DerivedPolicy, typename RandomAccessIterator1, typename Size, typename RandomAccessIterator2, typename BinaryFunction>
-  void reduce_intervals(thrust::tbb::execution_policy<DerivedPolicy> &,
+  void reduce_intervals(thrust::tbb::execution_policy<DerivedPolicy> &exec,
                         RandomAccessIterator1 first,
                         RandomAccessIterator1 last,
                         Size interval_size,
@@ -101,7 +102,12 @@ template<typename DerivedPolicy, typename RandomAccessIterator1, typename Size,
 
   Size num_intervals = reduce_intervals_detail::divide_ri(n, interval_size);
 
-  ::tbb::parallel_for(::tbb::blocked_range<Size>(0, num_intervals, 1), reduce_intervals_detail::make_body(first, result, Size(n), interval_size, binary_op), ::tbb::simple_partitioner());
+  // the grain size of the policy counts elements, the range counts intervals
+  Size grain = reduce_intervals_detail::divide_ri(static_cast<Size>(tbb::detail::grain_size(exec)), interval_size);
+
+  tbb::detail::execute(exec, [&]{
+    ::tbb::parallel_for(::tbb::blocked_range<Size>(0, num_intervals, grain), reduce_intervals_detail::make_body(first, result, Size(n), interval_size, binary_op), ::tbb::simple_partitioner());
+  });
 }
 
 
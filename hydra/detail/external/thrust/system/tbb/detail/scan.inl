@@ -25,6 +25,7 @@
 #include <hydra/detail/external/thrust/detail/type_traits.h>
 #include <hydra/detail/external/thrust/detail/type_traits/function_traits.h>
 #include <hydra/detail/external/thrust/detail/type_traits/iterator/is_output_iterator.h>
+#include <hydra/detail/external/thrust/system/tbb/detail/policy_settings.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_scan.h>
 
@@ -185,10 +186,11 @@ struct exclusive_body
 
 
 
-template<typename InputIterator,
+template<typename DerivedPolicy,
+         typename InputIterator,
          typename OutputIterator,
          typename BinaryFunction>
-  OutputIterator inclusive_scan(tag,
+  OutputIterator inclusive_scan(execution_policy<DerivedPolicy> &exec,
                                 InputIterator first,
                                 InputIterator last,
                                 OutputIterator result,
@@ -226,7 +228,11 @@ template<typename InputIterator,
   {
     typedef typename scan_detail::inclusive_body<InputIterator,OutputIterator,BinaryFunction,ValueType> Body;
     Body scan_body(first, result, binary_op, *first);
-    ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n), scan_body);
+    Size grain = static_cast<Size>(tbb::detail::grain_size(exec));
+
+    tbb::detail::execute(exec, [&]{
+      ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n,grain), scan_body);
+    });
   }
  
   thrust::advance(result, n);
@@ -235,11 +241,12 @@ template<typename InputIterator,
 }
 
 
-template<typename InputIterator,
+template<typename DerivedPolicy,
+         typename InputIterator,
          typename OutputIterator,
          typename T,
          typename BinaryFunction>
-  OutputIterator exclusive_scan(tag,
+  OutputIterator exclusive_scan(execution_policy<DerivedPolicy> &exec,
                                 InputIterator first,
                                 InputIterator last,
                                 OutputIterator result,
@@ -278,7 +285,11 @@ template<typename InputIterator,
   {
     typedef typename scan_detail::exclusive_body<InputIterator,OutputIterator,BinaryFunction,ValueType> Body;
     Body scan_body(first, result, binary_op, init);
-    ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n), scan_body);
+    Size grain = static_cast<Size>(tbb::detail::grain_size(exec));
+
+    tbb::detail::execute(exec, [&]{
+      ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n,grain), scan_body);
+    });
   }
  
   thrust::advance(result, n);
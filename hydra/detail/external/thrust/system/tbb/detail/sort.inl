@@ -21,6 +21,7 @@
 #include <hydra/detail/external/thrust/distance.h>
 #include <hydra/detail/external/thrust/merge.h>
 #include <hydra/detail/external/thrust/detail/seq.h>
+#include <hydra/detail/external/thrust/system/tbb/detail/policy_settings.h>
 #include <tbb/parallel_invoke.h>
 
 HYDRA_EXTERNAL_NAMESPACE_BEGIN  namespace thrust
@@ -231,7 +232,9 @@ void stable_sort(execution_policy<DerivedPolicy> &exec,
 
   thrust::detail::temporary_array<key_type, DerivedPolicy> temp(exec, first, last);
 
-  sort_detail::merge_sort(exec, first, last, temp.begin(), comp, true);
+  tbb::detail::execute(exec, [&]{
+    sort_detail::merge_sort(exec, first, last, temp.begin(), comp, true);
+  });
 }
 
 
@@ -253,7 +256,9 @@ template<typename DerivedPolicy,
   thrust::detail::temporary_array<key_type, DerivedPolicy> temp1(exec, first1, last1);
   thrust::detail::temporary_array<val_type, DerivedPolicy> temp2(exec, first2, last2);
 
-  sort_by_key_detail::merge_sort_by_key(exec, first1, last1, first2, temp1.begin(), temp2.begin(), comp, true);
+  tbb::detail::execute(exec, [&]{
+    sort_by_key_detail::merge_sort_by_key(exec, first1, last1, first2, temp1.begin(), temp2.begin(), comp, true);
+  });
 }
 
 
@@ -104,9 +104,9 @@ struct AverageMother
 		if (_beta)
 		{
 			GReal_t w = _beta / mother.d3mag();
-			fBeta0 = mother.get(0) * w;
-			fBeta1 = mother.get(1) * w;
-			fBeta2 = mother.get(2) * w;
+			fBeta0 = mother.get(1) * w;
+			fBeta1 = mother.get(2) * w;
+			fBeta2 = mother.get(3) * w;
 		}
 		else
 			fBeta0 = fBeta1 = fBeta2 = 0.0;
@@ -307,6 +307,8 @@ struct AverageMother
 		result.fMean = fFunctor(particles_tuple);
 		result.fW    = weight;
 		result.fM2   = 0.0;
+		result.fN    = 1;
+		result.fW2   = weight*weight;
 
 		return result;
 
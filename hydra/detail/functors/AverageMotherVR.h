@@ -0,0 +1,481 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * AverageMotherVR.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef AVERAGEMOTHERVR_H_
+#define AVERAGEMOTHERVR_H_
+
+//hydra
+#include <hydra/detail/Config.h>
+#include <hydra/Types.h>
+#include <hydra/Vector3R.h>
+#include <hydra/Vector4R.h>
+#include <hydra/detail/utility/Utility_Tuple.h>
+#include <hydra/detail/functors/StatsPHSP.h>
+#include <hydra/detail/functors/MotherConstants.h>
+
+//thrust
+#include <hydra/detail/external/thrust/tuple.h>
+#include <hydra/detail/external/thrust/random.h>
+
+#include <cmath>
+
+namespace hydra {
+
+/**
+ * \ingroup phsp
+ * \brief Sampling strategies of the random numbers driving the phase-space generation,
+ * used by the variance reduced hydra::PhaseSpace::AverageOn.
+ *
+ * - PlainSampling: independent events.
+ * - StratifiedSampling: the mass fractions (the first angle for two-body decays) are stratified
+ *   in equal cells, each sweep over all cells being an independent replica.
+ * - AntitheticSampling: events are generated in pairs sharing the mass fractions and with
+ *   reflected angles.
+ * - QuasiRandomSampling: randomly shifted Halton sequence (randomized quasi-Monte Carlo), each shift
+ *   being an independent replica.
+ */
+enum PhaseSpaceSampling {
+	PlainSampling=0,
+	StratifiedSampling,
+	AntitheticSampling,
+	QuasiRandomSampling
+};
+
+namespace detail {
+
+template <size_t N, typename GRND, typename FUNCTOR>
+struct AverageMotherVR
+{
+	//number of random numbers per event: (N-2) mass fractions + 2*(N-1) angles
+	static constexpr size_t NDim = 3*N - 4;
+
+	static_assert( NDim <= 64, "[Hydra::AverageMotherVR] : too many particles in final state for QuasiRandomSampling.");
+
+	//number of independent replicas for StratifiedSampling and QuasiRandomSampling
+	enum { NReplicas = 16 };
+
+	//constructor
+	AverageMotherVR(Vector4R const& mother,
+			const GReal_t* masses,
+			const size_t _seed,
+			FUNCTOR const& functor,
+			PhaseSpaceSampling sampling,
+			size_t nevents):
+			fSeed(_seed),
+			fSampling(sampling),
+			fReplica(0),
+			fOffset(0),
+			fStrata(1),
+			fStrataDims(N > 2 ? N - 2 : 1 ),
+			fNCells(1),
+			fFunctor(functor)
+	{
+		for(size_t i=0; i<N; i++) fMasses[i]=masses[i];
+
+		Vector4R _mother(mother);
+
+		typename MotherConstants<N>::row_type row = MotherConstants<N>(masses)(_mother);
+
+		fTeCmTm = HYDRA_EXTERNAL_NS::thrust::get<MOTHER_TECMTM>(row);
+		fWtMax  = HYDRA_EXTERNAL_NS::thrust::get<MOTHER_WTMAX>(row);
+		fBeta0  = HYDRA_EXTERNAL_NS::thrust::get<MOTHER_BETAX>(row);
+		fBeta1  = HYDRA_EXTERNAL_NS::thrust::get<MOTHER_BETAY>(row);
+		fBeta2  = HYDRA_EXTERNAL_NS::thrust::get<MOTHER_BETAZ>(row);
+
+		for(size_t i=0; i<NDim; i++) fShift[i]=0.0;
+
+		switch(fSampling){
+
+		case StratifiedSampling:
+		{
+			fStrata = size_t( ::pow( GReal_t(nevents/NReplicas), 1.0/fStrataDims ) );
+
+			fStrata = fStrata > 0 ? fStrata : 1;
+
+			for(size_t i=0; i<fStrataDims; i++) fNCells *= fStrata;
+
+			fNEvents = fNCells;
+			fNGroups = nevents/fNCells > 0 ? nevents/fNCells : 1;
+
+			break;
+		}
+
+		case AntitheticSampling:
+
+			fNEvents = nevents/2;
+			fNGroups = fNEvents;
+			break;
+
+		case QuasiRandomSampling:
+
+			fNEvents = nevents/NReplicas;
+			fNGroups = NReplicas;
+			break;
+
+		default:
+
+			fNEvents = nevents;
+			fNGroups = nevents;
+			break;
+		}
+	}
+
+	__hydra_host__ __hydra_device__
+	AverageMotherVR( AverageMotherVR<N, GRND, FUNCTOR> const& other ):
+	fSeed(other.fSeed ),
+	fSampling(other.fSampling ),
+	fReplica(other.fReplica ),
+	fOffset(other.fOffset ),
+	fStrata(other.fStrata ),
+	fStrataDims(other.fStrataDims ),
+	fNCells(other.fNCells ),
+	fNEvents(other.fNEvents ),
+	fNGroups(other.fNGroups ),
+	fTeCmTm(other.fTeCmTm ),
+	fWtMax(other.fWtMax ),
+	fBeta0(other.fBeta0 ),
+	fBeta1(other.fBeta1 ),
+	fBeta2(other.fBeta2 ),
+	fFunctor(other.fFunctor)
+	{
+		for(size_t i=0; i<N; i++) fMasses[i]=other.fMasses[i];
+		for(size_t i=0; i<NDim; i++) fShift[i]=other.fShift[i];
+	}
+
+	/*
+	 * Number of calls to operator() per launch.
+	 * For StratifiedSampling and QuasiRandomSampling one launch covers one replica.
+	 */
+	inline size_t GetNEvents() const { return fNEvents; }
+
+	/*
+	 * Number of launches needed to cover all the replicas.
+	 */
+	inline size_t GetNReplicas() const
+	{
+		return (fSampling==StratifiedSampling || fSampling==QuasiRandomSampling) ?
+				fNGroups : 1;
+	}
+
+	/*
+	 * Number of events generated by all the launches.
+	 */
+	inline size_t GetNSamples() const
+	{
+		return fSampling==AntitheticSampling ? 2*fNEvents : GetNReplicas()*fNEvents;
+	}
+
+	/*
+	 * Select the batch to be generated by the next launches.
+	 * Different batches use independent random numbers,
+	 * so their results can be merged.
+	 */
+	inline void SetBatch(size_t batch)
+	{
+		fOffset = batch*( GetNReplicas()==1 ? fNEvents : fNGroups );
+	}
+
+	/*
+	 * Select the replica to be generated by the next launch.
+	 */
+	inline void SetReplica(size_t replica)
+	{
+		fReplica = fOffset + replica;
+
+		if(fSampling==QuasiRandomSampling){
+
+			GRND randEng( fSeed );
+			randEng.discard( fReplica*NDim );
+			HYDRA_EXTERNAL_NS::thrust::uniform_real_distribution<GReal_t> uniDist(0.0, 1.0);
+
+			for(size_t i=0; i<NDim; i++) fShift[i]=uniDist(randEng);
+		}
+	}
+
+	__hydra_host__      __hydra_device__ inline
+	static GReal_t pdk(const GReal_t a, const GReal_t b,
+			const GReal_t c)
+	{
+		//the PDK function
+		return ::sqrt( (a - b - c) * (a + b + c) * (a - b + c) * (a + b - c) ) / (2 * a);
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	static void bbsort( GReal_t *array, GInt_t n)
+	{
+		// Improved bubble sort
+		for (GInt_t c = 0; c < n; c++)
+		{
+			GInt_t nswap = 0;
+
+			for (GInt_t d = 0; d < n - c - 1; d++)
+			{
+				if (array[d] > array[d + 1]) /* For decreasing order use < */
+				{
+					GReal_t swap = array[d];
+					array[d] = array[d + 1];
+					array[d + 1] = swap;
+					nswap++;
+				}
+			}
+			if (nswap == 0)
+				break;
+		}
+
+	}
+
+	__hydra_host__   __hydra_device__ inline
+	static GReal_t radical_inverse(size_t index, const size_t dim)
+	{
+		const unsigned primes[64] = {
+				  2,   3,   5,   7,  11,  13,  17,  19,  23,  29,  31,  37,  41,  43,  47,  53,
+				 59,  61,  67,  71,  73,  79,  83,  89,  97, 101, 103, 107, 109, 113, 127, 131,
+				137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 211, 223,
+				227, 229, 233, 239, 241, 251, 257, 263, 269, 271, 277, 281, 283, 293, 307, 311 };
+
+		const unsigned base = primes[dim];
+		const GReal_t inv_base = 1.0/base;
+
+		GReal_t f = inv_base;
+		GReal_t r = 0.0;
+
+		while(index > 0){
+			r += f*(index % base);
+			index /= base;
+			f *= inv_base;
+		}
+
+		return r;
+	}
+
+	/*
+	 * Raubold-Lynch generation driven by the numbers in u:
+	 * u[0, N-2) mass fractions, u[N-2+2*(i-1)] and u[N-2+2*(i-1)+1] angles of the i-th step.
+	 */
+	__hydra_host__   __hydra_device__ inline
+	GReal_t process(const GReal_t (&u)[NDim], Vector4R (&daugters)[N]) const
+	{
+
+		GReal_t rno[N];
+		rno[0] = 0.0;
+		rno[N - 1] = 1.0;
+
+		if (N > 2)
+		{
+			for (size_t n = 1; n < N - 1; n++)
+				rno[n] =  u[n-1];
+
+			bbsort(&rno[1], N -2);
+		}
+
+		GReal_t invMas[N], sum = 0.0;
+
+		for (size_t n = 0; n < N; n++)
+		{
+			sum += fMasses[n];
+			invMas[n] = rno[n] * fTeCmTm + sum;
+		}
+
+		//
+		//-----> compute the weight of the current event
+		//
+
+		GReal_t wt = fWtMax;
+
+		GReal_t pd[N];
+
+		for (size_t n = 0; n < N - 1; n++)
+		{
+			pd[n] = pdk(invMas[n + 1], invMas[n], fMasses[n + 1]);
+			wt *= pd[n];
+		}
+
+		//
+		//-----> complete specification of event (Raubold-Lynch method)
+		//
+
+		daugters[0].set(::sqrt((GReal_t) pd[0] * pd[0] + fMasses[0] * fMasses[0]), 0.0,
+				pd[0], 0.0);
+
+		for (size_t i = 1; i < N; i++)
+		{
+
+			daugters[i].set(
+					::sqrt(pd[i - 1] * pd[i - 1] + fMasses[i] * fMasses[i]), 0.0,
+					-pd[i - 1], 0.0);
+
+			GReal_t cZ = 2 * u[N - 2 + 2*(i-1)] -1 ;
+			GReal_t sZ = ::sqrt(1 - cZ * cZ);
+			GReal_t angY = 2 * PI* u[N - 2 + 2*(i-1) + 1];
+			GReal_t cY = ::cos(angY);
+			GReal_t sY = ::sin(angY);
+			for (size_t j = 0; j <= i; j++)
+			{
+
+				GReal_t x = daugters[j].get(1);
+				GReal_t y = daugters[j].get(2);
+				daugters[j].set(1, cZ * x - sZ * y);
+				daugters[j].set(2, sZ * x + cZ * y); // rotation around Z
+
+				x = daugters[j].get(1);
+				GReal_t z = daugters[j].get(3);
+				daugters[j].set(1, cY * x - sY * z);
+				daugters[j].set(3, sY * x + cY * z); // rotation around Y
+			}
+
+			if (i == (N - 1))
+				break;
+
+			GReal_t beta = pd[i] / ::sqrt(pd[i] * pd[i] + invMas[i] * invMas[i]);
+			for (size_t j = 0; j <= i; j++)
+			{
+				daugters[j].applyBoostTo(Vector3R(0, beta, 0));
+			}
+
+		}
+
+		//
+		//---> final boost of all particles to the mother's frame
+		//
+		for (size_t n = 0; n < N; n++)
+		{
+			daugters[n].applyBoostTo(Vector3R(fBeta0, fBeta1, fBeta2));
+		}
+
+		return wt;
+
+	}
+
+	/*
+	 * evaluates the functor on the event generated from u and returns the weight.
+	 */
+	__hydra_host__   __hydra_device__ inline
+	GReal_t evaluate(const GReal_t (&u)[NDim], GReal_t& value)
+	{
+		typedef typename hydra::detail::tuple_type<N,
+				Vector4R>::type Tuple_t;
+
+		Vector4R Particles[N];
+
+		GReal_t weight = process(u, Particles);
+
+		Tuple_t particles_tuple{};
+		detail::assignArrayToTuple(particles_tuple, Particles);
+
+		value = weight*fFunctor(particles_tuple);
+
+		return weight;
+	}
+
+	__hydra_host__  __hydra_device__ inline
+	StatsRatio operator()(size_t evt)
+	{
+		StatsRatio result;
+
+		GReal_t u[NDim];
+
+		if(fSampling==QuasiRandomSampling){
+
+			for(size_t i=0; i<NDim; i++){
+
+				GReal_t x = radical_inverse(evt+1, i) + fShift[i];
+				u[i] = x < 1.0 ? x : x - 1.0;
+			}
+
+			GReal_t a = 0.0;
+			GReal_t b = evaluate(u, a);
+
+			result.AddGroup(a, b);
+
+			return result;
+		}
+
+		size_t index = fSampling==StratifiedSampling ? fReplica*fNCells + evt : fOffset + evt;
+
+		//non-overlapping sub-streams: the replicas and groups need to be independent
+		GRND randEng( fSeed );
+		randEng.discard( index*NDim );
+		HYDRA_EXTERNAL_NS::thrust::uniform_real_distribution<GReal_t> uniDist(0.0, 1.0);
+
+		for(size_t i=0; i<NDim; i++) u[i]=uniDist(randEng);
+
+		if(fSampling==StratifiedSampling){
+
+			size_t cell = evt;
+
+			for(size_t i=0; i<fStrataDims; i++){
+
+				u[i] = ( (cell % fStrata) + u[i] )/fStrata;
+				cell /= fStrata;
+			}
+		}
+
+		GReal_t a = 0.0;
+		GReal_t b = evaluate(u, a);
+
+		if(fSampling==AntitheticSampling){
+
+			for(size_t i=N-2; i<NDim; i++) u[i] = 1.0 - u[i];
+
+			GReal_t a2 = 0.0;
+			b += evaluate(u, a2);
+			a += a2;
+		}
+
+		result.AddGroup(a, b);
+
+		return result;
+	}
+
+	size_t  fSeed;
+	PhaseSpaceSampling fSampling;
+	size_t  fReplica;
+	size_t  fOffset;
+	size_t  fStrata;
+	size_t  fStrataDims;
+	size_t  fNCells;
+	size_t  fNEvents;
+	size_t  fNGroups;
+
+	GReal_t fTeCmTm;
+	GReal_t fWtMax;
+	GReal_t fBeta0;
+	GReal_t fBeta1;
+	GReal_t fBeta2;
+
+	GReal_t fMasses[N];
+	GReal_t fShift[NDim];
+	FUNCTOR fFunctor ;
+
+};
+
+}//namespace detail
+
+}//namespace hydra
+
+#endif /* AVERAGEMOTHERVR_H_ */
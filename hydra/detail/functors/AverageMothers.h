@@ -283,6 +283,8 @@ struct AverageMothers
 		result.fMean = fFunctor(particles1);
 		result.fW    = weight;
 		result.fM2   = 0.0;
+		result.fN    = 1;
+		result.fW2   = weight*weight;
 
 		return result;
 
@@ -0,0 +1,114 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * AverageTable.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef AVERAGETABLE_H_
+#define AVERAGETABLE_H_
+
+//hydra
+#include <hydra/detail/Config.h>
+#include <hydra/Types.h>
+#include <hydra/Vector4R.h>
+#include <hydra/detail/utility/Utility_Tuple.h>
+#include <hydra/detail/functors/DecayTable.h>
+#include <hydra/detail/functors/StatsPHSP.h>
+
+//thrust
+#include <hydra/detail/external/thrust/tuple.h>
+#include <hydra/detail/external/thrust/random.h>
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * Averages a functor over the decays of the mothers stored in a hydra::MotherTable.
+ * The random number stream is the same one used by hydra::detail::AverageMothers.
+ */
+template <size_t N, typename GRND, typename FUNCTOR>
+struct AverageTable: public DecayTableBase<N, GRND>
+{
+
+	typedef DecayTableBase<N, GRND> super_type;
+
+	FUNCTOR fFunctor;
+
+	//constructor
+	AverageTable(const GReal_t* masses, const size_t _seed,
+			const GReal_t* const (&columns)[MOTHER_NCOLUMNS], FUNCTOR const& functor):
+			super_type(masses, _seed, columns),
+			fFunctor(functor)
+	{}
+
+	//copy
+	__hydra_host__      __hydra_device__
+	AverageTable(AverageTable<N, GRND, FUNCTOR> const& other):
+			super_type(other),
+			fFunctor(other.fFunctor)
+	{}
+
+	__hydra_host__  __hydra_device__
+	inline StatsPHSP operator()(const GLong_t evt)
+	{
+		typedef typename hydra::detail::tuple_type<N+1,
+				Vector4R>::type Tuple_t;
+
+		GRND randEng( super_type::hash(evt, this->fSeed) );
+
+		Vector4R Daughters[N];
+
+		GReal_t weight = this->process(randEng, evt, Daughters);
+
+		Vector4R Particles[N+1];
+
+		Particles[0] = this->mother(evt);
+
+		for(size_t i=0; i<N; i++)
+			Particles[i+1] = Daughters[i];
+
+		Tuple_t particles{};
+
+		hydra::detail::assignArrayToTuple(particles, Particles );
+
+		StatsPHSP result;
+
+		result.fMean = fFunctor(particles);
+		result.fW    = weight;
+		result.fM2   = 0.0;
+		result.fN    = 1;
+		result.fW2   = weight*weight;
+
+		return result;
+	}
+
+};
+
+}//namespace detail
+
+}//namespace hydra
+
+#endif /* AVERAGETABLE_H_ */
@@ -68,7 +68,7 @@ struct CheckEnergy
 			fTeCmTm -= fMasses[n];
 		}
 
-		return (bool) fTeCmTm > 0.0;
+		return fTeCmTm > 0.0;
 	}
 };
 
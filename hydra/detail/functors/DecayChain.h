@@ -0,0 +1,431 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * DecayChain.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef DECAYCHAIN_H_
+#define DECAYCHAIN_H_
+
+//std
+#include <type_traits>
+//hydra
+#include <hydra/detail/Config.h>
+#include <hydra/Types.h>
+#include <hydra/Vector3R.h>
+#include <hydra/Vector4R.h>
+#include <hydra/detail/utility/Utility_Tuple.h>
+//thrust
+#include <hydra/detail/external/thrust/tuple.h>
+#include <hydra/detail/external/thrust/random.h>
+
+
+namespace hydra {
+
+namespace detail {
+
+//---------------------------------------
+// compile time helpers for the flattened
+// list of particles of a decay chain
+//---------------------------------------
+template<size_t I, size_t ...N>
+struct chain_element;
+
+template<size_t I, size_t Head, size_t ...Tail>
+struct chain_element<I, Head, Tail...>:
+	std::integral_constant<size_t, (I==0) ? Head: chain_element<(I==0 ? 0 : I-1), Tail...>::value >{};
+
+template<size_t I>
+struct chain_element<I>: std::integral_constant<size_t, 0>{};
+
+template<size_t I, size_t ...N>
+struct chain_offset;
+
+template<size_t I, size_t Head, size_t ...Tail>
+struct chain_offset<I, Head, Tail...>:
+	std::integral_constant<size_t, (I==0) ? 0 : Head + chain_offset<(I==0 ? 0 : I-1), Tail...>::value >{};
+
+template<size_t I>
+struct chain_offset<I>: std::integral_constant<size_t, 0>{};
+
+/**
+ * \ingroup phsp
+ * \brief Fused generator of a decay chain.
+ *
+ * Generates all the decays of a chain for a given event in a single call,
+ * keeping the intermediate states in registers. The decay \f$I>0\f$ is generated
+ * in the rest frame of the particle fMother[I] (flat index in the list of particles of the chain),
+ * which is produced by a previous decay in the chain. Each decay uses the seed of the
+ * corresponding hydra::PhaseSpace object and the same random number stream as
+ * hydra::PhaseSpace::Generate, so the fused and the multi-pass generation produce the same events.
+ */
+template <typename GRND, size_t ...N>
+struct DecayChain
+{
+	constexpr static size_t NDecays    = sizeof...(N);
+	constexpr static size_t NParticles = chain_offset<sizeof...(N), N...>::value;
+
+	//constructor
+	DecayChain(Vector4R const& mother,
+			const GReal_t (&masses)[NParticles],
+			const size_t  (&seeds)[NDecays],
+			const GInt_t  (&mothers)[NDecays],
+			bool store_intermediates):
+		fStoreIntermediates(store_intermediates),
+		fFixedMother(true),
+		fMother(mother)
+	{
+		Init(masses, seeds, mothers);
+		Constants(mother.mass(), &fMasses[0], N0, fTeCmTm[0], fWtMax[0]);
+	}
+
+	DecayChain(const GReal_t (&masses)[NParticles],
+			const size_t  (&seeds)[NDecays],
+			const GInt_t  (&mothers)[NDecays],
+			bool store_intermediates):
+		fStoreIntermediates(store_intermediates),
+		fFixedMother(false),
+		fMother()
+	{
+		Init(masses, seeds, mothers);
+		fTeCmTm[0] = 0.0;
+		fWtMax[0]  = 0.0;
+	}
+
+	//copy
+	__hydra_host__ __hydra_device__
+	DecayChain(DecayChain<GRND, N...> const& other):
+		fStoreIntermediates(other.fStoreIntermediates),
+		fFixedMother(other.fFixedMother),
+		fMother(other.fMother)
+	{
+		for(size_t i=0; i<NParticles; i++){
+			fMasses[i]  = other.fMasses[i];
+			fIsFinal[i] = other.fIsFinal[i];
+		}
+
+		for(size_t i=0; i<NDecays; i++){
+			fSeeds[i]   = other.fSeeds[i];
+			fMothers[i] = other.fMothers[i];
+			fTeCmTm[i]  = other.fTeCmTm[i];
+			fWtMax[i]   = other.fWtMax[i];
+		}
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	static GReal_t pdk(const GReal_t a, const GReal_t b, const GReal_t c)
+	{
+		//the PDK function
+		return ::sqrt( (a - b - c) * (a + b + c) * (a - b + c) * (a + b - c) ) / (2 * a);
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	static void Constants(GReal_t mass, const GReal_t* masses, size_t n,
+			GReal_t& teCmTm, GReal_t& wtMax)
+	{
+		teCmTm = mass; // total energy in C.M. minus the sum of the masses
+
+		for (size_t i = 0; i < n; i++)
+			teCmTm -= masses[i];
+
+		GReal_t emmax = teCmTm + masses[0];
+		GReal_t emmin = 0.0;
+		GReal_t wtmax = 1.0;
+
+		for (size_t i = 1; i < n; i++)
+		{
+			emmin += masses[i - 1];
+			emmax += masses[i];
+			wtmax *= pdk(emmax, emmin, masses[i]);
+		}
+
+		wtMax = 1.0 / wtmax;
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	static void bbsort( GReal_t *array, GInt_t n)
+	{
+		// Improved bubble sort
+		for (GInt_t c = 0; c < n; c++)
+		{
+			GInt_t nswap = 0;
+
+			for (GInt_t d = 0; d < n - c - 1; d++)
+			{
+				if (array[d] > array[d + 1])
+				{
+					GReal_t swap = array[d];
+					array[d] = array[d + 1];
+					array[d + 1] = swap;
+					nswap++;
+				}
+			}
+			if (nswap == 0)
+				break;
+		}
+	}
+
+	/*
+	 * Raubold-Lynch generation of a single n-body decay in the rest frame of the mother,
+	 * followed by the boost to the frame where the mother is given.
+	 */
+	template<size_t n>
+	__hydra_host__ __hydra_device__ inline
+	static GReal_t process(const GInt_t evt, const size_t seed,
+			const GReal_t teCmTm, const GReal_t wtMax, const GReal_t* masses,
+			Vector4R const& mother, Vector4R* daughters)
+	{
+		GRND randEng( seed );
+		randEng.discard(evt+3*n);
+		HYDRA_EXTERNAL_NS::thrust::uniform_real_distribution<GReal_t> uniDist(0.0, 1.0);
+
+		GReal_t rno[n];
+		rno[0] = 0.0;
+		rno[n - 1] = 1.0;
+
+		if (n > 2)
+		{
+			for (size_t i = 1; i < n - 1; i++)
+				rno[i] =  uniDist(randEng) ;
+
+			bbsort(&rno[1], n -2);
+		}
+
+		GReal_t invMas[n], sum = 0.0;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			sum += masses[i];
+			invMas[i] = rno[i] * teCmTm + sum;
+		}
+
+		//
+		//-----> compute the weight of the current event
+		//
+		GReal_t wt = wtMax;
+
+		GReal_t pd[n];
+
+		for (size_t i = 0; i < n - 1; i++)
+		{
+			pd[i] = pdk(invMas[i + 1], invMas[i], masses[i + 1]);
+			wt *= pd[i];
+		}
+
+		//
+		//-----> complete specification of event (Raubold-Lynch method)
+		//
+		daughters[0].set(::sqrt(pd[0] * pd[0] + masses[0] * masses[0]), 0.0, pd[0], 0.0);
+
+		for (size_t i = 1; i < n; i++)
+		{
+			daughters[i].set( ::sqrt(pd[i - 1] * pd[i - 1] + masses[i] * masses[i]), 0.0, -pd[i - 1], 0.0);
+
+			GReal_t cZ = 2 * uniDist(randEng) -1 ;
+			GReal_t sZ = ::sqrt(1 - cZ * cZ);
+			GReal_t angY = 2 * PI* uniDist(randEng);
+			GReal_t cY = ::cos(angY);
+			GReal_t sY = ::sin(angY);
+
+			for (size_t j = 0; j <= i; j++)
+			{
+				GReal_t x = daughters[j].get(1);
+				GReal_t y = daughters[j].get(2);
+				daughters[j].set(1, cZ * x - sZ * y);
+				daughters[j].set(2, sZ * x + cZ * y); // rotation around Z
+
+				x = daughters[j].get(1);
+				GReal_t z = daughters[j].get(3);
+				daughters[j].set(1, cY * x - sY * z);
+				daughters[j].set(3, sY * x + cY * z); // rotation around Y
+			}
+
+			if (i == (n - 1))
+				break;
+
+			GReal_t beta = pd[i] / ::sqrt(pd[i] * pd[i] + invMas[i] * invMas[i]);
+
+			for (size_t j = 0; j <= i; j++)
+				daughters[j].applyBoostTo(0, beta, 0);
+		}
+
+		//
+		//---> final boost of all particles to the mother's frame
+		//
+		for (size_t i = 0; i < n; i++)
+			daughters[i].applyBoostTo(mother);
+
+		return wt;
+	}
+
+	// generate the decay I of the chain and all subsequent decays
+	template<size_t I>
+	__hydra_host__ __hydra_device__ inline
+	typename std::enable_if<(I==NDecays), void>::type
+	decay(const GInt_t, Vector4R const&, Vector4R (&)[NParticles], GReal_t (&)[NDecays]) const {}
+
+	template<size_t I=0>
+	__hydra_host__ __hydra_device__ inline
+	typename std::enable_if<(I<NDecays), void>::type
+	decay(const GInt_t evt, Vector4R const& mother, Vector4R (&particles)[NParticles],
+			GReal_t (&weights)[NDecays]) const
+	{
+		constexpr size_t n      = chain_element<I, N...>::value;
+		constexpr size_t offset = chain_offset<I, N...>::value;
+
+		GReal_t teCmTm = fTeCmTm[I];
+		GReal_t wtMax  = fWtMax[I];
+
+		if(I==0 && !fFixedMother)
+			Constants(mother.mass(), &fMasses[0], n, teCmTm, wtMax);
+
+		weights[I] = process<n>(evt, fSeeds[I], teCmTm, wtMax, &fMasses[offset],
+				I==0 ? mother : particles[fMothers[I]], &particles[offset]);
+
+		decay<I+1>(evt, mother, particles, weights);
+	}
+
+	// write the particles J of decay I into the decay's reference tuple
+	template<size_t I, size_t J, typename Decay>
+	__hydra_host__ __hydra_device__ inline
+	typename std::enable_if<(J==chain_element<I, N...>::value), void>::type
+	write_particles(Decay&, Vector4R (&)[NParticles]) const {}
+
+	template<size_t I, size_t J=0, typename Decay>
+	__hydra_host__ __hydra_device__ inline
+	typename std::enable_if<(J<chain_element<I, N...>::value), void>::type
+	write_particles(Decay& decay, Vector4R (&particles)[NParticles]) const
+	{
+		constexpr size_t index = chain_offset<I, N...>::value + J;
+
+		if(fStoreIntermediates || fIsFinal[index])
+			HYDRA_EXTERNAL_NS::thrust::get<J+1>(decay) =
+					(typename Vector4R::args_type) particles[index];
+
+		write_particles<I, J+1>(decay, particles);
+	}
+
+	// write the decays into the chain's reference tuple
+	template<size_t I, typename Chain>
+	__hydra_host__ __hydra_device__ inline
+	typename std::enable_if<(I==NDecays), void>::type
+	write(Chain&, Vector4R (&)[NParticles], GReal_t const (&)[NDecays]) const {}
+
+	template<size_t I=0, typename Chain>
+	__hydra_host__ __hydra_device__ inline
+	typename std::enable_if<(I<NDecays), void>::type
+	write(Chain& chain, Vector4R (&particles)[NParticles], GReal_t const (&weights)[NDecays]) const
+	{
+		auto& decay = HYDRA_EXTERNAL_NS::thrust::get<I+1>(chain);
+
+		if(fStoreIntermediates)
+			HYDRA_EXTERNAL_NS::thrust::get<0>(decay) = weights[I];
+
+		write_particles<I>(decay, particles);
+
+		write<I+1>(chain, particles, weights);
+	}
+
+	template<typename Chain>
+	__hydra_host__ __hydra_device__ inline
+	void generate(const GInt_t evt, Vector4R const& mother, Chain& chain ) const
+	{
+		Vector4R particles[NParticles];
+		GReal_t  weights[NDecays];
+
+		decay(evt, mother, particles, weights);
+
+		GReal_t weight = 1.0;
+		for(size_t i=0; i<NDecays; i++)
+			weight *= weights[i];
+
+		HYDRA_EXTERNAL_NS::thrust::get<0>(chain) = weight;
+
+		write(chain, particles, weights);
+	}
+
+	// {event index, chain}
+	template<typename Tuple>
+	__hydra_host__ __hydra_device__ inline
+	typename std::enable_if<(HYDRA_EXTERNAL_NS::thrust::tuple_size<Tuple>::value==2), void>::type
+	operator()(Tuple t) const
+	{
+		generate( HYDRA_EXTERNAL_NS::thrust::get<0>(t), fMother, HYDRA_EXTERNAL_NS::thrust::get<1>(t));
+	}
+
+	// {event index, mother, chain}
+	template<typename Tuple>
+	__hydra_host__ __hydra_device__ inline
+	typename std::enable_if<(HYDRA_EXTERNAL_NS::thrust::tuple_size<Tuple>::value==3), void>::type
+	operator()(Tuple t) const
+	{
+		Vector4R mother = HYDRA_EXTERNAL_NS::thrust::get<1>(t);
+		generate( HYDRA_EXTERNAL_NS::thrust::get<0>(t), mother, HYDRA_EXTERNAL_NS::thrust::get<2>(t));
+	}
+
+	bool     fStoreIntermediates;
+	bool     fFixedMother;
+	Vector4R fMother;
+	size_t   fSeeds[NDecays];
+	GInt_t   fMothers[NDecays];
+	GReal_t  fTeCmTm[NDecays];
+	GReal_t  fWtMax[NDecays];
+	GReal_t  fMasses[NParticles];
+	bool     fIsFinal[NParticles];
+
+	constexpr static size_t N0 = chain_element<0, N...>::value;
+
+	void Init(const GReal_t (&masses)[NParticles], const size_t  (&seeds)[NDecays],
+			const GInt_t  (&mothers)[NDecays])
+	{
+		for(size_t i=0; i<NParticles; i++){
+			fMasses[i]  = masses[i];
+			fIsFinal[i] = true;
+		}
+
+		for(size_t i=0; i<NDecays; i++){
+			fSeeds[i]   = seeds[i];
+			fMothers[i] = mothers[i];
+		}
+
+		// the mothers of the subsequent decays are not final states and
+		// have fixed mass, so the kinematic constants can be calculated once.
+		size_t offset = N0;
+		size_t sizes[NDecays]{N...};
+
+		for(size_t i=1; i<NDecays; i++){
+			fIsFinal[fMothers[i]] = false;
+			Constants(fMasses[fMothers[i]], &fMasses[offset], sizes[i], fTeCmTm[i], fWtMax[i]);
+			offset += sizes[i];
+		}
+	}
+
+};
+
+}//namespace detail
+
+}//namespace hydra
+
+#endif /* DECAYCHAIN_H_ */
@@ -104,9 +104,9 @@ struct DecayMother
 		if (_beta)
 		{
 			GReal_t w = _beta / mother.d3mag();
-			fBeta0 = mother.get(0) * w;
-			fBeta1 = mother.get(1) * w;
-			fBeta2 = mother.get(2) * w;
+			fBeta0 = mother.get(1) * w;
+			fBeta1 = mother.get(2) * w;
+			fBeta2 = mother.get(3) * w;
 		}
 		else
 			fBeta0 = fBeta1 = fBeta2 = 0.0;
@@ -0,0 +1,281 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * DecayTable.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef DECAYTABLE_H_
+#define DECAYTABLE_H_
+
+//hydra
+#include <hydra/detail/Config.h>
+#include <hydra/Types.h>
+#include <hydra/Vector3R.h>
+#include <hydra/Vector4R.h>
+#include <hydra/detail/utility/Utility_Tuple.h>
+#include <hydra/detail/functors/MotherConstants.h>
+
+//thrust
+#include <hydra/detail/external/thrust/tuple.h>
+#include <hydra/detail/external/thrust/random.h>
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * Raubold-Lynch generation reading the per-mother constants from
+ * the columns of a hydra::MotherTable.
+ */
+template <size_t N, typename GRND>
+struct DecayTableBase
+{
+
+	size_t  fSeed;
+	GReal_t fMasses[N];
+	const GReal_t* fColumns[MOTHER_NCOLUMNS];
+
+	//constructor
+	DecayTableBase(const GReal_t* masses, const size_t _seed,
+			const GReal_t* const (&columns)[MOTHER_NCOLUMNS] ):
+			fSeed(_seed)
+	{
+		for(size_t i=0; i<N; i++)
+			fMasses[i] = masses[i];
+
+		for(size_t i=0; i<MOTHER_NCOLUMNS; i++)
+			fColumns[i] = columns[i];
+	}
+
+	//copy
+	__hydra_host__      __hydra_device__
+	DecayTableBase(DecayTableBase<N, GRND> const& other):
+			fSeed(other.fSeed)
+	{
+		for(size_t i=0; i<N; i++)
+			fMasses[i] = other.fMasses[i];
+
+		for(size_t i=0; i<MOTHER_NCOLUMNS; i++)
+			fColumns[i] = other.fColumns[i];
+	}
+
+	__hydra_host__      __hydra_device__ inline
+	static GReal_t pdk(const GReal_t a, const GReal_t b,
+			const GReal_t c)
+	{
+		//the PDK function
+		return ::sqrt( (a - b - c) * (a + b + c) * (a - b + c) * (a + b - c) ) / (2 * a);
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	static void bbsort(GReal_t *array, GInt_t n)
+	{
+		// Improved bubble sort
+		for (GInt_t c = 0; c < n; c++)
+		{
+			GInt_t nswap = 0;
+
+			for (GInt_t d = 0; d < n - c - 1; d++)
+			{
+				if (array[d] > array[d + 1]) /* For decreasing order use < */
+				{
+					GReal_t swap = array[d];
+					array[d] = array[d + 1];
+					array[d + 1] = swap;
+					nswap++;
+				}
+			}
+			if (nswap == 0)
+				break;
+		}
+
+	}
+
+	__hydra_host__   __hydra_device__ inline
+	constexpr static size_t hash(const size_t a, const size_t b)
+	{
+		//Matthew Szudzik pairing
+		//http://szudzik.com/ElegantPairing.pdf
+		return   (((2 * a) >=  (2 * b) ? (2 * a) * (2 * a) + (2 * a) + (2 * b) : (2 * a) + (2 * b) * (2 * b)) / 2);
+	}
+
+	__hydra_host__      __hydra_device__ inline
+	Vector4R mother(const size_t idx) const
+	{
+		return Vector4R( fColumns[MOTHER_E][idx], fColumns[MOTHER_PX][idx],
+				fColumns[MOTHER_PY][idx], fColumns[MOTHER_PZ][idx]);
+	}
+
+	/*
+	 * generates the daughters of the mother stored in the row 'idx' of the table.
+	 */
+	__hydra_host__      __hydra_device__ inline
+	GReal_t process(GRND& randEng, const size_t idx, Vector4R (&particles)[N]) const
+	{
+
+		HYDRA_EXTERNAL_NS::thrust::uniform_real_distribution<GReal_t> uniDist(0.0, 1.0);
+
+		const GReal_t teCmTm = fColumns[MOTHER_TECMTM][idx];
+
+		GReal_t rno[N];
+		rno[0] = 0.0;
+
+		if (N > 2)
+		{
+			for (size_t n = 1; n < N - 1; n++)
+				rno[n] = uniDist(randEng) ;
+
+			bbsort(&rno[1], N - 2);
+		}
+
+		rno[N - 1] = 1;
+		GReal_t invMas[N], sum = 0.0;
+
+		for (size_t n = 0; n < N; n++)
+		{
+			sum += fMasses[n];
+			invMas[n] = rno[n] * teCmTm + sum;
+		}
+
+		//-----> compute the weight of the current event
+
+		GReal_t wt  = fColumns[MOTHER_WTMAX][idx];
+
+		GReal_t pd[N];
+
+		for (size_t n = 0; n < N - 1; n++)
+		{
+			pd[n] = pdk(invMas[n + 1], invMas[n], fMasses[n + 1]);
+			wt *= pd[n];
+		}
+
+		//-----> complete specification of event (Raubold-Lynch method)
+
+		particles[0].set(::sqrt(pd[0] * pd[0] + fMasses[0] * fMasses[0]), 0.0,
+				pd[0], 0.0);
+
+		for (size_t i = 1; i < N; i++)
+		{
+
+			particles[i].set(
+					::sqrt(pd[i - 1] * pd[i - 1] + fMasses[i] * fMasses[i]), 0.0,
+					-pd[i - 1], 0.0);
+
+			GReal_t cZ = 2	* uniDist(randEng) -1 ;
+			GReal_t sZ = ::sqrt(1 - cZ * cZ);
+			GReal_t angY = 2.0 * PI	* uniDist(randEng);
+			GReal_t cY = ::cos(angY);
+			GReal_t sY = ::sin(angY);
+			for (size_t j = 0; j <= i; j++)
+			{
+
+				GReal_t x = particles[j].get(1);
+				GReal_t y = particles[j].get(2);
+				particles[j].set(1, cZ * x - sZ * y);
+				particles[j].set(2, sZ * x + cZ * y); // rotation around Z
+
+				x = particles[j].get(1);
+				GReal_t z = particles[j].get(3);
+				particles[j].set(1, cY * x - sY * z);
+				particles[j].set(3, sY * x + cY * z); // rotation around Y
+			}
+
+			if (i == (N - 1))
+				break;
+
+			GReal_t beta = pd[i] / ::sqrt(pd[i] * pd[i] + invMas[i] * invMas[i]);
+			for (size_t j = 0; j <= i; j++)
+			{
+				particles[j].applyBoostTo(0, beta, 0);
+			}
+
+		}
+
+		//
+		//---> final boost of all particles to the mother's frame
+		//
+		Vector3R boost( fColumns[MOTHER_BETAX][idx], fColumns[MOTHER_BETAY][idx],
+				fColumns[MOTHER_BETAZ][idx]);
+
+		for (size_t n = 0; n < N; n++)
+		{
+			particles[n].applyBoostTo(boost);
+		}
+
+		//
+		//---> return the weight of event
+		//
+		return wt;
+
+	}
+
+};
+
+/*
+ * Generates the daughters of the mothers stored in a hydra::MotherTable.
+ * The random number stream is the same one used by hydra::detail::DecayMothers.
+ */
+template <size_t N, typename GRND>
+struct DecayTable: public DecayTableBase<N, GRND>
+{
+
+	typedef DecayTableBase<N, GRND> super_type;
+
+	//constructor
+	DecayTable(const GReal_t* masses, const size_t _seed,
+			const GReal_t* const (&columns)[MOTHER_NCOLUMNS] ):
+			super_type(masses, _seed, columns)
+	{}
+
+	//copy
+	__hydra_host__      __hydra_device__
+	DecayTable(DecayTable<N, GRND> const& other):
+			super_type(other)
+	{}
+
+	template<typename Tuple>
+	__hydra_host__  __hydra_device__
+	inline GReal_t operator()(const GLong_t evt, Tuple &particles)
+	{
+
+		GRND randEng( this->fSeed );
+		randEng.discard(evt+3*N);
+
+		Vector4R Particles[N];
+
+		GReal_t weight = this->process(randEng, evt, Particles);
+
+		hydra::detail::assignArrayToTuple(particles,  Particles );
+
+		return weight;
+	}
+
+};
+
+}//namespace detail
+
+}//namespace hydra
+
+#endif /* DECAYTABLE_H_ */
@@ -0,0 +1,306 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * KinematicsKernel.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef KINEMATICSKERNEL_H_
+#define KINEMATICSKERNEL_H_
+
+//hydra
+#include <hydra/detail/Config.h>
+#include <hydra/Types.h>
+#include <hydra/Vector4R.h>
+#include <hydra/ColumnSpan.h>
+#include <hydra/detail/utility/Utility_Tuple.h>
+
+//thrust
+#include <hydra/detail/external/thrust/tuple.h>
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * Plain description of one kinematic quantity. The particles entering
+ * each four-vector are encoded as bit masks over the final state.
+ */
+struct KinematicEntry
+{
+	enum Type {
+		ENTRY_MASS2       = 0,
+		ENTRY_COSHELICITY = 1,
+		ENTRY_PLANESANGLE = 2,
+		ENTRY_BOOSTED     = 3
+	};
+
+	GInt_t   fType;
+	GUInt_t  fMasks[3];
+	GUInt_t  fComponent; //four-vector component, only for ENTRY_BOOSTED
+	GUInt_t  fFrame;     //index of the boost in the kernel, only for ENTRY_BOOSTED
+};
+
+/*
+ * Evaluates M kinematic quantities for each event, reading the
+ * daughters directly from the columns of a hydra::Decays container.
+ * The boost matrices for the distinct frames requested are calculated
+ * only once per event and reused by all quantities referring to them.
+ */
+template <size_t N, size_t M>
+struct KinematicsKernel
+{
+	const GReal_t* __restrict__ fColumns[N][4];
+	KinematicEntry fEntries[M];
+	GUInt_t        fFrames[M];
+	size_t         fNFrames;
+
+	//constructor
+	KinematicsKernel(const GReal_t* const (&columns)[N][4],
+			KinematicEntry const (&entries)[M],
+			GUInt_t const (&frames)[M], size_t nframes):
+		fNFrames(nframes)
+	{
+		for(size_t i=0; i<N; i++)
+			for(size_t j=0; j<4; j++)
+				fColumns[i][j] = columns[i][j];
+
+		for(size_t i=0; i<M; i++){
+			fEntries[i] = entries[i];
+			fFrames[i]  = frames[i];
+		}
+	}
+
+	//copy
+	__hydra_host__      __hydra_device__
+	KinematicsKernel(KinematicsKernel<N,M> const& other):
+		fNFrames(other.fNFrames)
+	{
+		for(size_t i=0; i<N; i++)
+			for(size_t j=0; j<4; j++)
+				fColumns[i][j] = other.fColumns[i][j];
+
+		for(size_t i=0; i<M; i++){
+			fEntries[i] = other.fEntries[i];
+			fFrames[i]  = other.fFrames[i];
+		}
+	}
+
+	__hydra_host__      __hydra_device__ inline
+	static Vector4R combine(const GUInt_t mask, const Vector4R (&particles)[N])
+	{
+		Vector4R p(0.0, 0.0, 0.0, 0.0);
+
+		for(size_t i=0; i<N; i++)
+			if( (mask==0) || (mask & (1u<<i)) ) p += particles[i];
+
+		return p;
+	}
+
+	/*
+	 * Lorentz transformation to the rest frame of p,
+	 * stored row-wise.
+	 */
+	__hydra_host__      __hydra_device__ inline
+	static void boost_matrix(Vector4R const& p, GReal_t (&L)[16])
+	{
+		GReal_t e  = p.get(0);
+		GReal_t b[3]  = { -p.get(1)/e, -p.get(2)/e, -p.get(3)/e };
+		GReal_t b2 = b[0]*b[0] + b[1]*b[1] + b[2]*b[2];
+
+		for(size_t i=0; i<16; i++) L[i] = (i%5==0) ? 1.0 : 0.0;
+
+		if( !(b2 > 0.0 && b2 < 1.0) ) return;
+
+		GReal_t gamma = 1.0/::sqrt(1.0 - b2);
+		GReal_t gb2   = (gamma - 1.0)/b2;
+
+		L[0] = gamma;
+
+		for(size_t i=0; i<3; i++){
+
+			L[i+1]     = gamma*b[i];
+			L[4*(i+1)] = gamma*b[i];
+
+			for(size_t j=0; j<3; j++)
+				L[4*(i+1) + j+1] += gb2*b[i]*b[j];
+		}
+	}
+
+	__hydra_host__      __hydra_device__ inline
+	static GReal_t cos_decay_angle(Vector4R const& p, Vector4R const& q, Vector4R const& d)
+	{
+		GReal_t pd  = p*d;
+		GReal_t pq  = p*q;
+		GReal_t qd  = q*d;
+		GReal_t mp2 = p.mass2();
+		GReal_t mq2 = q.mass2();
+		GReal_t md2 = d.mass2();
+
+		return (pd * mq2 - pq * qd)
+				/ ::sqrt((pq * pq - mq2 * mp2) * (qd * qd - mq2 * md2));
+	}
+
+	__hydra_host__      __hydra_device__ inline
+	static GReal_t chi_angle(Vector4R const& d2, Vector4R const& d3, Vector4R const& h1)
+	{
+		Vector4R D = d2 + d3;
+
+		Vector4R d1_perp = d2 - (D.dot(d2) / D.dot(D)) * D;
+		Vector4R h1_perp = h1 - (D.dot(h1) / D.dot(D)) * D;
+
+		// orthogonal to both D and d1_perp
+		Vector4R d1_prime = D.cross(d1_perp);
+
+		d1_perp  = d1_perp / d1_perp.d3mag();
+		d1_prime = d1_prime / d1_prime.d3mag();
+
+		return ::atan2(d1_prime.dot(h1_perp), d1_perp.dot(h1_perp));
+	}
+
+	__hydra_host__      __hydra_device__ inline
+	void evaluate(const size_t evt, GReal_t (&result)[M]) const
+	{
+		Vector4R particles[N];
+
+		for(size_t i=0; i<N; i++)
+			particles[i] = Vector4R(fColumns[i][0][evt], fColumns[i][1][evt],
+					fColumns[i][2][evt], fColumns[i][3][evt]);
+
+		GReal_t boosts[M][16];
+
+		for(size_t f=0; f<fNFrames; f++)
+			boost_matrix( combine(fFrames[f], particles), boosts[f]);
+
+		for(size_t i=0; i<M; i++)
+		{
+			KinematicEntry const& entry = fEntries[i];
+
+			switch(entry.fType)
+			{
+
+			case KinematicEntry::ENTRY_MASS2:
+
+				result[i] = combine(entry.fMasks[0], particles).mass2();
+				break;
+
+			case KinematicEntry::ENTRY_COSHELICITY:
+
+				result[i] = cos_decay_angle( combine(entry.fMasks[0], particles),
+						combine(entry.fMasks[1], particles),
+						combine(entry.fMasks[2], particles));
+				break;
+
+			case KinematicEntry::ENTRY_PLANESANGLE:
+
+				result[i] = chi_angle( combine(entry.fMasks[0], particles),
+						combine(entry.fMasks[1], particles),
+						combine(entry.fMasks[2], particles));
+				break;
+
+			case KinematicEntry::ENTRY_BOOSTED:
+			{
+				Vector4R p = combine(entry.fMasks[0], particles);
+				const GReal_t* row = &boosts[entry.fFrame][4*entry.fComponent];
+
+				result[i] = row[0]*p.get(0) + row[1]*p.get(1)
+						  + row[2]*p.get(2) + row[3]*p.get(3);
+				break;
+			}
+
+			default:
+				result[i] = 0.0;
+			}
+		}
+	}
+
+	__hydra_host__      __hydra_device__ inline
+	auto operator()(const size_t evt) const
+	-> decltype(hydra::detail::arrayToTuple<GReal_t, M>( (GReal_t*) nullptr ))
+	{
+		GReal_t result[M];
+
+		evaluate(evt, result);
+
+		return hydra::detail::arrayToTuple<GReal_t, M>(&result[0]);
+	}
+
+};
+
+/*
+ * Evaluates the kinematic quantities of each event, as KinematicsKernel,
+ * writing them directly to the raw columns of the output container.
+ */
+template <size_t N, size_t M, typename ...T>
+struct KinematicsWriter
+{
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<ColumnSpan<T>...> spans_type;
+
+	//constructor
+	KinematicsWriter(KinematicsKernel<N,M> const& kernel, spans_type const& output):
+		fKernel(kernel),
+		fOutput(output)
+	{}
+
+	//copy
+	__hydra_host__      __hydra_device__
+	KinematicsWriter(KinematicsWriter<N,M,T...> const& other):
+		fKernel(other.fKernel),
+		fOutput(other.fOutput)
+	{}
+
+	template<size_t I>
+	__hydra_host__      __hydra_device__ inline
+	typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I == M), void>::type
+	write(const size_t, GReal_t const (&)[M]) const {}
+
+	template<size_t I=0>
+	__hydra_host__      __hydra_device__ inline
+	typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I < M), void>::type
+	write(const size_t evt, GReal_t const (&result)[M]) const
+	{
+		HYDRA_EXTERNAL_NS::thrust::get<I>(fOutput)[evt] = result[I];
+
+		write<I+1>(evt, result);
+	}
+
+	__hydra_host__      __hydra_device__ inline
+	void operator()(const size_t evt) const
+	{
+		GReal_t result[M];
+
+		fKernel.evaluate(evt, result);
+
+		write(evt, result);
+	}
+
+	KinematicsKernel<N,M> fKernel;
+	spans_type            fOutput;
+};
+
+}//namespace detail
+
+}//namespace hydra
+
+#endif /* KINEMATICSKERNEL_H_ */
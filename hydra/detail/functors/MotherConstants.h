@@ -0,0 +1,132 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * MotherConstants.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef MOTHERCONSTANTS_H_
+#define MOTHERCONSTANTS_H_
+
+//hydra
+#include <hydra/detail/Config.h>
+#include <hydra/Types.h>
+#include <hydra/Vector4R.h>
+
+//thrust
+#include <hydra/detail/external/thrust/tuple.h>
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * column layout of hydra::MotherTable
+ */
+enum {
+	MOTHER_E  = 0,
+	MOTHER_PX = 1,
+	MOTHER_PY = 2,
+	MOTHER_PZ = 3,
+	MOTHER_TECMTM = 4,
+	MOTHER_WTMAX  = 5,
+	MOTHER_BETAX  = 6,
+	MOTHER_BETAY  = 7,
+	MOTHER_BETAZ  = 8,
+	MOTHER_NCOLUMNS = 9
+};
+
+/*
+ * Calculates the mass dependent constants of the Raubold-Lynch generation
+ * for a mother particle: the available kinetic energy, the inverse of the maximum
+ * weight and the boost to the mother's frame.
+ */
+template <size_t N>
+struct MotherConstants
+{
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<GReal_t, GReal_t, GReal_t, GReal_t,
+			GReal_t, GReal_t, GReal_t, GReal_t, GReal_t> row_type;
+
+	GReal_t fMasses[N];
+
+	//constructor
+	MotherConstants(const GReal_t* masses )
+	{
+		for(size_t i=0; i<N; i++)
+			fMasses[i] = masses[i];
+	}
+
+	//copy
+	__hydra_host__      __hydra_device__
+	MotherConstants(MotherConstants<N> const& other)
+	{
+		for(size_t i=0; i<N; i++)
+			fMasses[i] = other.fMasses[i];
+	}
+
+	__hydra_host__      __hydra_device__ inline
+	static GReal_t pdk(const GReal_t a, const GReal_t b,
+			const GReal_t c)
+	{
+		//the PDK function
+		return ::sqrt( (a - b - c) * (a + b + c) * (a - b + c) * (a + b - c) ) / (2 * a);
+	}
+
+	template<typename Type>
+	__hydra_host__ __hydra_device__
+	inline row_type operator()(Type& particle)
+	{
+		Vector4R mother = particle;
+
+		GReal_t teCmTm = mother.mass();
+
+		for (size_t n = 0; n < N; n++)
+		{
+			teCmTm -= fMasses[n];
+		}
+
+		GReal_t emmax = teCmTm + fMasses[0];
+		GReal_t emmin = 0.0;
+		GReal_t wtmax = 1.0;
+
+		for (size_t n = 1; n < N; n++)
+		{
+			emmin += fMasses[n - 1];
+			emmax += fMasses[n];
+			wtmax *= pdk(emmax, emmin, fMasses[n]);
+		}
+
+		GReal_t e = mother.get(0);
+
+		return row_type( mother.get(0), mother.get(1), mother.get(2), mother.get(3),
+				teCmTm, 1.0/wtmax,
+				mother.get(1)/e, mother.get(2)/e, mother.get(3)/e );
+	}
+};
+
+}//namespace detail
+
+}//namespace hydra
+
+#endif /* MOTHERCONSTANTS_H_ */
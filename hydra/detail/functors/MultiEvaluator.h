@@ -0,0 +1,128 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * MultiEvaluator.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+/**
+ * \file
+ * \ingroup numerical_integration
+ */
+
+#ifndef MULTIEVALUATOR_H_
+#define MULTIEVALUATOR_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/Types.h>
+#include <hydra/detail/FunctorTraits.h>
+#include <hydra/detail/utility/Utility_Tuple.h>
+#include <hydra/detail/external/thrust/tuple.h>
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * MultiEvaluator calculates K values at each point, which the integrators
+ * reduce together in a single pass:
+ *  - MultiEvaluator<tuple<F...>, false>: the value of each functor of the tuple.
+ *  - MultiEvaluator<F, true>: the value of F followed by its derivatives with respect
+ *    to its parameters, from F::ParameterGradient(n, x, gradient).
+ * The first value drives the adaptation of the integrators (e.g. the hydra::Vegas grid).
+ */
+template<typename FUNCTORS, bool GRADIENT=false>
+struct MultiEvaluator;
+
+template<typename ...FUNCTORS>
+struct MultiEvaluator<HYDRA_EXTERNAL_NS::thrust::tuple<FUNCTORS...>, false>
+{
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<FUNCTORS...> functors_type;
+	typedef typename HYDRA_EXTERNAL_NS::thrust::tuple_element<0, functors_type>::type first_type;
+
+	static const size_t K = HYDRA_EXTERNAL_NS::thrust::tuple_size<functors_type>::value;
+
+	//constructor
+	MultiEvaluator(functors_type const& functors):
+		fFunctors(functors)
+	{}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	MultiEvaluator(MultiEvaluator<functors_type, false> const& other):
+		fFunctors(other.fFunctors)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	first_type const& GetFirst() const { return HYDRA_EXTERNAL_NS::thrust::get<0>(fFunctors); }
+
+	template<size_t N>
+	__hydra_host__ __hydra_device__ inline
+	void operator()(GReal_t (&x)[N], GReal_t* values)
+	{
+		detail::eval_tuple_to_array(values, fFunctors, detail::arrayToTuple<GReal_t, N>(x));
+	}
+
+	functors_type fFunctors;
+};
+
+template<typename FUNCTOR>
+struct MultiEvaluator<FUNCTOR, true>
+{
+	static_assert( has_parameter_gradient<FUNCTOR, GReal_t(unsigned int, GReal_t*, GReal_t*)>::value,
+			"[Hydra::MultiEvaluator] : the functor does not implement ParameterGradient(unsigned int n, T* x, GReal_t* gradient).");
+
+	typedef FUNCTOR first_type;
+
+	static const size_t K = FUNCTOR::parameter_count + 1;
+
+	//constructor
+	MultiEvaluator(FUNCTOR const& functor):
+		fFunctor(functor)
+	{}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	MultiEvaluator(MultiEvaluator<FUNCTOR, true> const& other):
+		fFunctor(other.fFunctor)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	first_type const& GetFirst() const { return fFunctor; }
+
+	template<size_t N>
+	__hydra_host__ __hydra_device__ inline
+	void operator()(GReal_t (&x)[N], GReal_t* values)
+	{
+		values[0] = fFunctor.ParameterGradient(N, &x[0], values + 1);
+	}
+
+	FUNCTOR fFunctor;
+};
+
+}// namespace detail
+
+}// namespace hydra
+
+#endif /* MULTIEVALUATOR_H_ */
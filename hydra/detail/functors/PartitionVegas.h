@@ -0,0 +1,182 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * PartitionVegas.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+/**
+ * \file
+ * \ingroup numerical_integration
+ */
+
+#ifndef PARTITIONVEGAS_H_
+#define PARTITIONVEGAS_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/Types.h>
+#include <hydra/detail/external/thrust/iterator/iterator_traits.h>
+#include <hydra/detail/external/thrust/detail/raw_pointer_cast.h>
+#include <hydra/detail/external/thrust/system/cpp/detail/execution_policy.h>
+#include <hydra/detail/external/thrust/system/omp/detail/execution_policy.h>
+#include <hydra/detail/external/thrust/system/omp/detail/policy_settings.h>
+#include <hydra/detail/external/thrust/system/tbb/detail/execution_policy.h>
+
+#include <cstddef>
+#include <thread>
+
+/**
+ * Number of private copies of the Vegas grid distribution when the calls run on CUDA.
+ * The work items add their contributions with atomicAdd to the copy (item % HYDRA_VEGAS_CUDA_PARTIALS).
+ */
+#ifndef HYDRA_VEGAS_CUDA_PARTIALS
+#define HYDRA_VEGAS_CUDA_PARTIALS 256
+#endif
+
+/**
+ * Calls processed by each work item of Vegas when the calls run on CUDA.
+ */
+#ifndef HYDRA_VEGAS_CUDA_GRAIN
+#define HYDRA_VEGAS_CUDA_GRAIN 16
+#endif
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * Number of private copies of the grid distribution of Vegas for the system of Iterator, and number
+ * of calls per work item. The host systems use one copy per worker thread and one work item per copy,
+ * processing a contiguous range of calls, so that the copies are written without synchronization.
+ * CUDA uses HYDRA_VEGAS_CUDA_PARTIALS copies shared by work items of HYDRA_VEGAS_CUDA_GRAIN calls.
+ */
+template<typename Iterator>
+struct PartitionVegas
+{
+	typedef typename HYDRA_EXTERNAL_NS::thrust::iterator_system<Iterator>::type system_type;
+
+	PartitionVegas(size_t ncalls):
+		fNCalls(ncalls),
+		fNPartials(1),
+		fGrain(1)
+	{
+		fNPartials = partials( system_type() );
+
+		if( fNPartials > ncalls ) fNPartials = ncalls > 0 ? ncalls : 1;
+
+		fGrain = grain( system_type() );
+	}
+
+	inline size_t GetNCalls() const { return fNCalls; }
+
+	inline size_t GetNPartials() const { return fNPartials; }
+
+	inline size_t GetGrain() const { return fGrain; }
+
+	inline size_t GetNItems() const { return fNCalls > 0 ? (fNCalls + fGrain - 1)/fGrain : 1; }
+
+private:
+
+	inline size_t partials(HYDRA_EXTERNAL_NS::thrust::system::cpp::tag) const
+	{ return 1; }
+
+	inline size_t partials(HYDRA_EXTERNAL_NS::thrust::system::omp::tag system) const
+	{
+		int threads = HYDRA_EXTERNAL_NS::thrust::system::omp::detail::omp_policy_num_threads(system);
+
+		return threads > 0 ? threads : 1;
+	}
+
+	inline size_t partials(HYDRA_EXTERNAL_NS::thrust::system::tbb::tag) const
+	{
+		size_t threads = std::thread::hardware_concurrency();
+
+		return threads > 0 ? threads : 1;
+	}
+
+	template<typename System>
+	inline size_t partials(System const&) const
+	{ return HYDRA_VEGAS_CUDA_PARTIALS; }
+
+	inline size_t grain(HYDRA_EXTERNAL_NS::thrust::system::cpp::tag) const
+	{ return (fNCalls + fNPartials - 1)/fNPartials; }
+
+	inline size_t grain(HYDRA_EXTERNAL_NS::thrust::system::omp::tag) const
+	{ return (fNCalls + fNPartials - 1)/fNPartials; }
+
+	inline size_t grain(HYDRA_EXTERNAL_NS::thrust::system::tbb::tag) const
+	{ return (fNCalls + fNPartials - 1)/fNPartials; }
+
+	template<typename System>
+	inline size_t grain(System const&) const
+	{ return HYDRA_VEGAS_CUDA_GRAIN; }
+
+	size_t fNCalls;
+	size_t fNPartials;
+	size_t fGrain;
+};
+
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ < 600
+/*
+ * atomicAdd(double*, double) is only provided for compute capability 6.0 and newer.
+ */
+__hydra_device__ inline
+double atomic_add_vegas(double* address, double value)
+{
+	unsigned long long int* address_as_ull = reinterpret_cast<unsigned long long int*>(address);
+	unsigned long long int old = *address_as_ull;
+	unsigned long long int assumed;
+
+	do {
+		assumed = old;
+		old = atomicCAS(address_as_ull, assumed,
+				__double_as_longlong(value + __longlong_as_double(assumed)));
+	} while (assumed != old);
+
+	return __longlong_as_double(old);
+}
+#endif
+
+/*
+ * Adds value to the element of a private copy of the grid distribution. The copies are
+ * shared by several work items only on CUDA.
+ */
+template<typename Iterator>
+__hydra_host__ __hydra_device__ inline
+void accumulate_vegas(Iterator element, GReal_t value)
+{
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ < 600
+	atomic_add_vegas( HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(&(*element)), value);
+#elif defined(__CUDA_ARCH__)
+	atomicAdd( HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(&(*element)), value);
+#else
+	*element += value;
+#endif
+}
+
+}  // namespace detail
+
+}  // namespace hydra
+
+#endif /* PARTITIONVEGAS_H_ */
@@ -0,0 +1,292 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * ProcessCallsMiser.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+/**
+ * \file
+ * \ingroup numerical_integration
+ */
+
+#ifndef PROCESSCALLSMISER_H_
+#define PROCESSCALLSMISER_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/Types.h>
+#include <hydra/PlainState.h>
+#include <hydra/detail/utility/Utility_Tuple.h>
+#include <hydra/detail/external/thrust/functional.h>
+#include <hydra/detail/external/thrust/random.h>
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * Sub-volume of the integration region, with the number of calls assigned to it.
+ */
+template<size_t N>
+struct MiserRegion
+{
+	GReal_t fXLow[N];
+	GReal_t fXUp[N];
+	size_t  fCalls;
+};
+
+/*
+ * Sums of f and f^2 over the exploration calls of one sub-volume,
+ * in total and restricted to the lower half of each dimension.
+ */
+template<size_t N>
+struct MiserExploreState
+{
+	GReal_t fN;
+	GReal_t fSum;
+	GReal_t fSum2;
+	GReal_t fNLow[N];
+	GReal_t fSumLow[N];
+	GReal_t fSum2Low[N];
+};
+
+template<size_t N>
+struct ProcessExploreStatesMiser
+		:public HYDRA_EXTERNAL_NS::thrust::binary_function< MiserExploreState<N> const&,
+		 MiserExploreState<N> const& , MiserExploreState<N> >
+{
+	__hydra_host__ __hydra_device__ inline
+	MiserExploreState<N> operator()(MiserExploreState<N> const& x, MiserExploreState<N> const& y)
+	{
+		MiserExploreState<N> result;
+
+		result.fN    = x.fN    + y.fN;
+		result.fSum  = x.fSum  + y.fSum;
+		result.fSum2 = x.fSum2 + y.fSum2;
+
+		for(size_t j=0; j<N; j++){
+			result.fNLow[j]    = x.fNLow[j]    + y.fNLow[j];
+			result.fSumLow[j]  = x.fSumLow[j]  + y.fSumLow[j];
+			result.fSum2Low[j] = x.fSum2Low[j] + y.fSum2Low[j];
+		}
+
+		return result;
+	}
+};
+
+// MiserRegionIndex gives the sub-volume of the call 'index', used as key of the reductions.
+struct MiserRegionIndex
+{
+	//constructor
+	MiserRegionIndex(size_t nregions, const size_t* offsets):
+		fNRegions(nregions),
+		fOffsets(offsets)
+	{}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	MiserRegionIndex(MiserRegionIndex const& other):
+		fNRegions(other.fNRegions),
+		fOffsets(other.fOffsets)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	size_t operator()(size_t index) const
+	{
+		//last region with offset <= index
+		size_t first = 0;
+		size_t count = fNRegions;
+
+		while(count > 0){
+
+			size_t step = count/2;
+
+			if( fOffsets[first + step + 1] <= index){
+				first += step + 1;
+				count -= step + 1;
+			}
+			else count = step;
+		}
+
+		return first;
+	}
+
+	size_t fNRegions;
+	const size_t* __restrict__ fOffsets;
+};
+
+/*
+ * Calls of all sub-volumes of one level are processed by a single launch.
+ * The call 'index' belongs to the sub-volume whose range [fOffsets[r], fOffsets[r+1])
+ * contains it. The random numbers are seeded with the global counter fFirstCall + index.
+ */
+template <typename FUNCTOR, size_t N, typename GRND>
+struct ProcessCallsMiserBase
+{
+	//constructor
+	ProcessCallsMiserBase(size_t seed, size_t first_call, size_t nregions,
+			const MiserRegion<N>* regions, const size_t* offsets, FUNCTOR const& functor):
+		fSeed(seed),
+		fFirstCall(first_call),
+		fNRegions(nregions),
+		fRegions(regions),
+		fOffsets(offsets),
+		fFunctor(functor)
+	{}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	ProcessCallsMiserBase(ProcessCallsMiserBase<FUNCTOR,N,GRND> const& other):
+		fSeed(other.fSeed),
+		fFirstCall(other.fFirstCall),
+		fNRegions(other.fNRegions),
+		fRegions(other.fRegions),
+		fOffsets(other.fOffsets),
+		fFunctor(other.fFunctor)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	size_t get_region(const size_t index) const
+	{
+		return MiserRegionIndex(fNRegions, fOffsets)(index);
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	static size_t scramble(size_t z)
+	{
+		//splitmix64 finalizer
+		z += 0x9e3779b97f4a7c15ULL;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	void get_point(const size_t index, MiserRegion<N> const& region, GReal_t (&x)[N]) const
+	{
+		GRND randEng( scramble( scramble(fSeed) ^ (fFirstCall + index) ) );
+		HYDRA_EXTERNAL_NS::thrust::uniform_real_distribution<GReal_t> uniDist(0.0, 1.0);
+
+		for (size_t j = 0; j < N; j++)
+			x[j] = region.fXLow[j] + uniDist(randEng)*(region.fXUp[j] - region.fXLow[j]);
+	}
+
+	size_t fSeed;
+	size_t fFirstCall;
+	size_t fNRegions;
+	const MiserRegion<N>* __restrict__ fRegions;
+	const size_t* __restrict__ fOffsets;
+	FUNCTOR fFunctor;
+};
+
+// ProcessCallsMiserExplore samples one call of a sub-volume being explored
+// and books it in the lower half of the dimensions where it falls there.
+template <typename FUNCTOR, size_t N, typename GRND>
+struct ProcessCallsMiserExplore: ProcessCallsMiserBase<FUNCTOR,N,GRND>
+{
+	typedef ProcessCallsMiserBase<FUNCTOR,N,GRND> super_type;
+
+	//constructor
+	ProcessCallsMiserExplore(size_t seed, size_t first_call, size_t nregions,
+			const MiserRegion<N>* regions, const size_t* offsets, FUNCTOR const& functor):
+		super_type(seed, first_call, nregions, regions, offsets, functor)
+	{}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	ProcessCallsMiserExplore(ProcessCallsMiserExplore<FUNCTOR,N,GRND> const& other):
+		super_type(other)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	MiserExploreState<N> operator()(size_t index)
+	{
+		MiserRegion<N> const& region = this->fRegions[this->get_region(index)];
+
+		GReal_t x[N];
+		this->get_point(index, region, x);
+
+		GReal_t fval = this->fFunctor( detail::arrayToTuple<GReal_t, N>(x));
+
+		MiserExploreState<N> result;
+
+		result.fN    = 1.0;
+		result.fSum  = fval;
+		result.fSum2 = fval*fval;
+
+		for (size_t j = 0; j < N; j++){
+
+			bool low = x[j] < 0.5*(region.fXLow[j] + region.fXUp[j]);
+
+			result.fNLow[j]    = low ? 1.0 : 0.0;
+			result.fSumLow[j]  = low ? fval : 0.0;
+			result.fSum2Low[j] = low ? fval*fval : 0.0;
+		}
+
+		return result;
+	}
+};
+
+// ProcessCallsMiserLeaf samples one call of a terminal sub-volume.
+template <typename FUNCTOR, size_t N, typename GRND>
+struct ProcessCallsMiserLeaf: ProcessCallsMiserBase<FUNCTOR,N,GRND>
+{
+	typedef ProcessCallsMiserBase<FUNCTOR,N,GRND> super_type;
+
+	//constructor
+	ProcessCallsMiserLeaf(size_t seed, size_t first_call, size_t nregions,
+			const MiserRegion<N>* regions, const size_t* offsets, FUNCTOR const& functor):
+		super_type(seed, first_call, nregions, regions, offsets, functor)
+	{}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	ProcessCallsMiserLeaf(ProcessCallsMiserLeaf<FUNCTOR,N,GRND> const& other):
+		super_type(other)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	PlainState operator()(size_t index)
+	{
+		GReal_t x[N];
+		this->get_point(index, this->fRegions[this->get_region(index)], x);
+
+		GReal_t fval = this->fFunctor( detail::arrayToTuple<GReal_t, N>(x));
+
+		PlainState result;
+		result.fN    = 1;
+		result.fMin  = fval;
+		result.fMax  = fval;
+		result.fMean = fval;
+		result.fM2   = 0;
+
+		return result;
+	}
+};
+
+}// namespace detail
+
+}// namespace hydra
+
+#endif /* PROCESSCALLSMISER_H_ */
@@ -41,6 +41,7 @@
 #include <hydra/detail/external/thrust/functional.h>
 #include <hydra/detail/external/thrust/extrema.h>
 #include <hydra/detail/utility/Utility_Tuple.h>
+#include <hydra/detail/functors/MultiEvaluator.h>
 #include <hydra/detail/external/thrust/random.h>
 
 namespace hydra {
@@ -148,6 +149,90 @@ struct ProcessCallsPlainBinary
     }
 };
 
+/*
+ * Statistics of K integrands evaluated at the same sample points.
+ */
+template<size_t K>
+struct PlainStates
+{
+	PlainState fStates[K];
+};
+
+// ProcessCallsPlainMultiUnary calculates the K values of the MultiEvaluator EVALUATOR at the
+// point of the call 'index' (the same point as ProcessCallsPlainUnary).
+template <typename EVALUATOR, size_t N, typename GRND=HYDRA_EXTERNAL_NS::thrust::random::default_random_engine>
+struct ProcessCallsPlainMultiUnary
+{
+	static const size_t K = EVALUATOR::K;
+
+	//constructor
+	ProcessCallsPlainMultiUnary(const GReal_t* XLow, const GReal_t* DeltaX, size_t seed, EVALUATOR const& evaluator):
+		fSeed(seed),
+		fXLow(XLow),
+		fDeltaX(DeltaX),
+		fEvaluator(evaluator)
+	{}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	ProcessCallsPlainMultiUnary( ProcessCallsPlainMultiUnary<EVALUATOR,N, GRND> const& other):
+		fSeed(other.fSeed),
+		fXLow(other.fXLow),
+		fDeltaX(other.fDeltaX),
+		fEvaluator(other.fEvaluator)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	PlainStates<K> operator()(size_t index)
+	{
+		GRND randEng(fSeed);
+		randEng.discard(index);
+		HYDRA_EXTERNAL_NS::thrust::uniform_real_distribution<GReal_t> uniDist(0.0, 1.0);
+
+		GReal_t x[N];
+
+		for (size_t j = 0; j < N; j++)
+			x[j] = fXLow[j] + uniDist(randEng)*fDeltaX[j];
+
+		GReal_t fval[K];
+		fEvaluator(x, fval);
+
+		PlainStates<K> result;
+
+		for (size_t k = 0; k < K; k++){
+			result.fStates[k].fN    = 1;
+			result.fStates[k].fMin  = fval[k];
+			result.fStates[k].fMax  = fval[k];
+			result.fStates[k].fMean = fval[k];
+			result.fStates[k].fM2   = 0;
+		}
+
+		return result;
+	}
+
+	size_t fSeed;
+	const GReal_t* __restrict__ fXLow;
+	const GReal_t* __restrict__ fDeltaX;
+	EVALUATOR fEvaluator;
+};
+
+// ProcessCallsPlainMultiBinary merges the statistics of each integrand.
+template<size_t K>
+struct ProcessCallsPlainMultiBinary
+	: public HYDRA_EXTERNAL_NS::thrust::binary_function<PlainStates<K> const&, PlainStates<K> const&, PlainStates<K> >
+{
+	__hydra_host__ __hydra_device__ inline
+	PlainStates<K> operator()(PlainStates<K> const& x, PlainStates<K> const& y)
+	{
+		PlainStates<K> result;
+
+		for (size_t k = 0; k < K; k++)
+			result.fStates[k] = ProcessCallsPlainBinary()(x.fStates[k], y.fStates[k]);
+
+		return result;
+	}
+};
+
 }// namespace detail
 
 }// namespace hydra
@@ -0,0 +1,109 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * ProcessCallsQuasiMC.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+/**
+ * \file
+ * \ingroup numerical_integration
+ */
+
+#ifndef PROCESSCALLSQUASIMC_H_
+#define PROCESSCALLSQUASIMC_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/Types.h>
+#include <hydra/detail/SobolDirections.h>
+#include <hydra/detail/utility/Utility_Tuple.h>
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * Number of words stored per dimension and replica:
+ * the scrambled direction numbers followed by the digital shift.
+ */
+constexpr size_t QUASIMC_WORDS = SOBOL_BITS + 1;
+
+// ProcessCallsQuasiMCUnary evaluates the functor on the point 'index'
+// of one scrambled replica of the Sobol sequence. The point is calculated
+// directly from the bits of the index, so that calls are independent.
+template <typename FUNCTOR, size_t N>
+struct ProcessCallsQuasiMCUnary
+{
+	//constructor
+	ProcessCallsQuasiMCUnary(const GReal_t* XLow, const GReal_t* DeltaX,
+			const GUInt_t* generators, FUNCTOR const& functor):
+		fXLow(XLow),
+		fDeltaX(DeltaX),
+		fGenerators(generators),
+		fFunctor(functor)
+	{}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	ProcessCallsQuasiMCUnary( ProcessCallsQuasiMCUnary<FUNCTOR,N> const& other):
+		fXLow(other.fXLow),
+		fDeltaX(other.fDeltaX),
+		fGenerators(other.fGenerators),
+		fFunctor(other.fFunctor)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	GReal_t operator()(size_t index)
+	{
+		GReal_t x[N];
+
+		for (size_t j = 0; j < N; j++) {
+
+			const GUInt_t* v = fGenerators + j*QUASIMC_WORDS;
+
+			GUInt_t y = v[SOBOL_BITS];
+
+			for(size_t b=0, i=index; i>0; b++, i >>= 1)
+				if(i & 1) y ^= v[b];
+
+			// center of the elementary interval, never 0 or 1
+			GReal_t r = (GReal_t(y) + 0.5)/4294967296.0;
+
+			x[j] = fXLow[j] + r*fDeltaX[j];
+		}
+
+		return fFunctor( detail::arrayToTuple<GReal_t, N>(x));
+	}
+
+	const GReal_t* __restrict__ fXLow;
+	const GReal_t* __restrict__ fDeltaX;
+	const GUInt_t* __restrict__ fGenerators;
+	FUNCTOR fFunctor;
+};
+
+}// namespace detail
+
+}// namespace hydra
+
+#endif /* PROCESSCALLSQUASIMC_H_ */
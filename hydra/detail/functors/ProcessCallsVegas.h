@@ -38,6 +38,8 @@
 #include <hydra/detail/Config.h>
 #include <hydra/Types.h>
 #include <hydra/detail/utility/Utility_Tuple.h>
+#include <hydra/detail/functors/MultiEvaluator.h>
+#include <hydra/detail/functors/PartitionVegas.h>
 #include <hydra/detail/external/thrust/tuple.h>
 #include <hydra/detail/external/thrust/functional.h>
 #include <hydra/detail/external/thrust/random.h>
@@ -86,53 +88,64 @@ struct ProcessBoxesVegas
 };
 
 
+/*
+ * Processes a contiguous range of calls per work item (see PartitionVegas). The contributions
+ * of the calls to the grid distribution, f^2 per dimension and bin, are accumulated in one of
+ * the private copies of NDimensions*NBins elements of the output buffer, which is zeroed
+ * before the launch.
+ */
 template<typename FUNCTOR, size_t NDimensions, typename  BACKEND,
-typename IteratorBackendReal, typename IteratorBackendUInt,
+typename IteratorBackendReal,
 typename GRND=HYDRA_EXTERNAL_NS::thrust::random::default_random_engine>
 struct ProcessCallsVegas;
 
 template<typename FUNCTOR, size_t NDimensions,  hydra::detail::Backend  BACKEND,
-typename IteratorBackendReal, typename IteratorBackendUInt, typename GRND>
+typename IteratorBackendReal, typename GRND>
 struct ProcessCallsVegas<FUNCTOR,  NDimensions, hydra::detail::BackendPolicy<BACKEND>,
-IteratorBackendReal,  IteratorBackendUInt, GRND>
+IteratorBackendReal, GRND>
 {
 
 	typedef   ProcessCallsVegas<FUNCTOR,  NDimensions, hydra::detail::BackendPolicy<BACKEND>,
-			IteratorBackendReal,  IteratorBackendUInt, GRND> this_t;
+			IteratorBackendReal, GRND> this_t;
 
 	typedef  hydra::VegasState<NDimensions,hydra::detail::BackendPolicy<BACKEND>> state_t;
 
 public :
 
-	ProcessCallsVegas( size_t NBoxes, state_t& fState,	IteratorBackendUInt begin_bins,
-			IteratorBackendReal begin_real,  FUNCTOR const& functor):
-				fNBoxes( NBoxes ),
-				fSeed(fState.GetItNum()),
+	template<typename Iterator>
+	ProcessCallsVegas( PartitionVegas<Iterator> const& partition, state_t& fState,
+			IteratorBackendReal begin_distribution,  FUNCTOR const& functor):
 				fNBins(fState.GetNBins()),
+				fNCalls( partition.GetNCalls() ),
+				fNPartials( partition.GetNPartials() ),
+				fGrain( partition.GetGrain() ),
 				fNBoxesPerDimension(fState.GetNBoxes()),
 				fNCallsPerBox(fState.GetCallsPerBox()),
 				fJacobian( fState.GetJacobian() ),
+				fSeed(fState.GetItNum()),
+				fScrambledSeeds(fState.IsScrambledSeeds() || fState.GetMode() == MODE_ADAPTIVE_STRATIFIED),
+				fDistribution( begin_distribution ),
 				fXi(fState.GetBackendXi().begin() ),
 				fXLow( fState.GetBackendXLow().begin() ),
 				fDeltaX( fState.GetBackendDeltaX().begin() ),
-				fGlobalBin( begin_bins ),
-				fFVals( begin_real ),
 				fFunctor(functor)
 				{}
 
 	__hydra_host__ __hydra_device__
 	ProcessCallsVegas( this_t const& other):
-	fSeed(other.fSeed),
 	fNBins(other.fNBins),
-	fNBoxes(other.fNBoxes),
+	fNCalls(other.fNCalls),
+	fNPartials(other.fNPartials),
+	fGrain(other.fGrain),
 	fNBoxesPerDimension(other.fNBoxesPerDimension),
 	fNCallsPerBox(other.fNCallsPerBox),
 	fJacobian(other.fJacobian),
+	fSeed(other.fSeed),
+	fScrambledSeeds(other.fScrambledSeeds),
+	fDistribution(other.fDistribution),
 	fXi(other.fXi),
 	fXLow(other.fXLow),
 	fDeltaX(other.fDeltaX),
-	fGlobalBin(other.fGlobalBin),
-	fFVals(other.fFVals),
 	fFunctor(other.fFunctor)
 	{}
 
@@ -165,14 +178,32 @@ public :
 		return  C ;
 	}
 
+	__hydra_host__   __hydra_device__ inline
+	size_t scramble(size_t z)
+	{
+		//splitmix64 finalizer: seeds of consecutive calls give
+		//strongly correlated first draws of linear congruential engines
+		//(see VegasState::SetScrambledSeeds)
+		if( !fScrambledSeeds ) return z;
+
+		z += 0x9e3779b97f4a7c15ULL;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+
 
 	__hydra_host__   __hydra_device__ inline
 	void get_point(const size_t  index, GReal_t &volume, GInt_t (&bin)[NDimensions], GReal_t (&x)[NDimensions] )
 	{
+		get_point(index, index/fNCallsPerBox, volume, bin, x);
+	}
 
-		size_t box = index/fNCallsPerBox;
+	__hydra_host__   __hydra_device__ inline
+	void get_point(const size_t  index, const size_t box, GReal_t &volume, GInt_t (&bin)[NDimensions], GReal_t (&x)[NDimensions] )
+	{
 
-		GRND randEng( hash(fSeed,index) );
+		GRND randEng( scramble( hash(fSeed,index) ) );
 		//randEng.discard(index);
 		HYDRA_EXTERNAL_NS::thrust::uniform_real_distribution<GReal_t> uniDist(0.0, 1.0);
 
@@ -206,62 +237,542 @@ public :
 	}
 
 	__hydra_host__ __hydra_device__ inline
-	size_t GetDistributionIndex(size_t index,  const GUInt_t dim) const
-	{ return index*NDimensions + dim; }
+	size_t GetDistributionIndex(size_t partial, const GUInt_t bin, const GUInt_t dim) const
+	{ return (partial*fNBins + bin)*NDimensions + dim; }
+
+	/*
+	 * first and last calls of a work item
+	 */
+	__hydra_host__ __hydra_device__ inline
+	size_t GetFirstCall(size_t item) const
+	{ return item*fGrain < fNCalls ? item*fGrain : fNCalls; }
 
 	__hydra_host__ __hydra_device__ inline
-	GUInt_t GetDistributionKey( const GUInt_t bin, const GUInt_t dim) const
-	{ return bin * NDimensions + dim; }
+	size_t GetLastCall(size_t item) const
+	{ return (item + 1)*fGrain < fNCalls ? (item + 1)*fGrain : fNCalls; }
 
 
 	__hydra_host__ __hydra_device__ inline
-	ResultVegas operator()( size_t index)
+	ResultVegas operator()( size_t item)
 	{
+		size_t first   = GetFirstCall(item);
+		size_t last    = GetLastCall(item);
+		size_t partial = item % fNPartials;
+
+		ProcessBoxesVegas merger;
 
-		GReal_t volume = 1.0;
-		GReal_t x[NDimensions];
-		GInt_t bin[NDimensions];
 		ResultVegas result;
+		result.fN    = 0.0;
+		result.fMean = 0.0;
+		result.fM2   = 0.0;
+
+		for(size_t index = first; index < last; index++)
+		{
+			GReal_t volume = 1.0;
+			GReal_t x[NDimensions];
+			GInt_t bin[NDimensions];
 
-		get_point( index, volume, bin, x );
+			get_point( index, volume, bin, x );
 
-		GReal_t fval = fJacobian*volume*fFunctor( detail::arrayToTuple<GReal_t, NDimensions>(x));
+			GReal_t fval = fJacobian*volume*fFunctor( detail::arrayToTuple<GReal_t, NDimensions>(x));
 
-		for (GUInt_t j = 0; j < NDimensions; j++)
-		{
+			for (GUInt_t j = 0; j < NDimensions; j++)
+				accumulate_vegas(fDistribution + GetDistributionIndex(partial, bin[j], j ), fval*fval);
 
-		    fGlobalBin[ GetDistributionIndex(index, j ) ] = GetDistributionKey(bin[j], j);
-			fFVals[GetDistributionIndex(index, j )]=fval*fval;
+			ResultVegas call;
+			call.fN    = 1.0;
+			call.fMean = fval;
+			call.fM2   = 0.0;
 
+			result = merger(result, call);
 		}
 
-		result.fN    = 1.0;
-		result.fMean = fval;
-		result.fM2   = 0.0;
-
 		return result;
 
 	}
 
-private:
+protected:
 
 	size_t  fNBins;
-	size_t  fNBoxes;
+	size_t  fNCalls;
+	size_t  fNPartials;
+	size_t  fGrain;
 	size_t  fNBoxesPerDimension;
 	size_t  fNCallsPerBox;
 
 	GReal_t fJacobian;
 	GInt_t  fSeed;
-	IteratorBackendUInt fGlobalBin;
-	IteratorBackendReal fFVals;
+	GBool_t fScrambledSeeds;
+	IteratorBackendReal fDistribution;
 	IteratorBackendReal  fXi;
 	IteratorBackendReal  fXLow;
 	IteratorBackendReal  fDeltaX;
 
 	FUNCTOR fFunctor;
 
+};
+
+/*
+ * Results of K integrands evaluated at the same calls.
+ */
+template<size_t K>
+struct ResultVegasMulti
+{
+	ResultVegas fResults[K];
+};
+
+template<size_t K>
+struct ProcessBoxesVegasMulti
+		:public HYDRA_EXTERNAL_NS::thrust::binary_function< ResultVegasMulti<K> const&, ResultVegasMulti<K> const& , ResultVegasMulti<K> >
+{
+    __hydra_host__ __hydra_device__ inline
+    ResultVegasMulti<K> operator()(ResultVegasMulti<K> const& x, ResultVegasMulti<K> const& y)
+    {
+    	ResultVegasMulti<K> result;
+
+    	for(size_t k=0; k<K; k++)
+    		result.fResults[k] = ProcessBoxesVegas()(x.fResults[k], y.fResults[k]);
+
+    	return result;
+    }
+};
+
+/*
+ * Calculates the K values of the MultiEvaluator EVALUATOR at the calls of ProcessCallsVegas.
+ * The grid distribution is accumulated from the first value only.
+ */
+template<typename EVALUATOR, size_t NDimensions, typename  BACKEND,
+typename IteratorBackendReal,
+typename GRND=HYDRA_EXTERNAL_NS::thrust::random::default_random_engine>
+struct ProcessCallsVegasMulti:
+		public ProcessCallsVegas<typename EVALUATOR::first_type,
+		NDimensions, BACKEND, IteratorBackendReal, GRND>
+{
+	typedef ProcessCallsVegas<typename EVALUATOR::first_type,
+			NDimensions, BACKEND, IteratorBackendReal, GRND> super_t;
+
+	typedef typename super_t::state_t state_t;
+
+	static const size_t K = EVALUATOR::K;
+
+	template<typename Iterator>
+	ProcessCallsVegasMulti( PartitionVegas<Iterator> const& partition, state_t& fState,
+			IteratorBackendReal begin_distribution,  EVALUATOR const& evaluator):
+				super_t(partition, fState, begin_distribution, evaluator.GetFirst()),
+				fEvaluator(evaluator)
+				{}
+
+	__hydra_host__ __hydra_device__
+	ProcessCallsVegasMulti( ProcessCallsVegasMulti<EVALUATOR, NDimensions, BACKEND, IteratorBackendReal, GRND> const& other):
+		super_t(other),
+		fEvaluator(other.fEvaluator)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	ResultVegasMulti<K> operator()( size_t item)
+	{
+		size_t first   = this->GetFirstCall(item);
+		size_t last    = this->GetLastCall(item);
+		size_t partial = item % this->fNPartials;
+
+		ProcessBoxesVegasMulti<K> merger;
 
+		ResultVegasMulti<K> result;
+
+		for(size_t k = 0; k < K; k++){
+			result.fResults[k].fN    = 0.0;
+			result.fResults[k].fMean = 0.0;
+			result.fResults[k].fM2   = 0.0;
+		}
+
+		for(size_t index = first; index < last; index++)
+		{
+			GReal_t volume = 1.0;
+			GReal_t x[NDimensions];
+			GInt_t bin[NDimensions];
+
+			this->get_point( index, volume, bin, x );
+
+			GReal_t fval[K];
+			fEvaluator(x, fval);
+
+			ResultVegasMulti<K> call;
+
+			for(size_t k = 0; k < K; k++){
+				call.fResults[k].fN    = 1.0;
+				call.fResults[k].fMean = this->fJacobian*volume*fval[k];
+				call.fResults[k].fM2   = 0.0;
+			}
+
+			for (GUInt_t j = 0; j < NDimensions; j++)
+				accumulate_vegas(this->fDistribution + this->GetDistributionIndex(partial, bin[j], j ),
+						call.fResults[0].fMean*call.fResults[0].fMean);
+
+			result = merger(result, call);
+		}
+
+		return result;
+	}
+
+	EVALUATOR fEvaluator;
+};
+
+/*
+ * Sums the private copies of the grid distribution into the first one.
+ */
+template<typename IteratorBackendReal>
+struct MergePartialsVegas
+{
+	MergePartialsVegas( size_t NPartials, size_t NKeys, IteratorBackendReal begin_distribution):
+		fNPartials(NPartials),
+		fNKeys(NKeys),
+		fDistribution(begin_distribution)
+	{}
+
+	__hydra_host__ __hydra_device__
+	MergePartialsVegas( MergePartialsVegas<IteratorBackendReal> const& other):
+		fNPartials(other.fNPartials),
+		fNKeys(other.fNKeys),
+		fDistribution(other.fDistribution)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	void operator()( size_t key)
+	{
+		GReal_t sum = 0.0;
+
+		for(size_t partial = 0; partial < fNPartials; partial++)
+			sum += fDistribution[partial*fNKeys + key];
+
+		fDistribution[key] = sum;
+	}
+
+private:
+
+	size_t fNPartials;
+	size_t fNKeys;
+	IteratorBackendReal fDistribution;
+};
+
+
+struct ResultVegasPlus
+{
+	GReal_t fIntegral;
+	GReal_t fVariance;
+	GReal_t fWeight;
+};
+
+struct ProcessCubesVegasPlus
+		:public HYDRA_EXTERNAL_NS::thrust::binary_function< ResultVegasPlus const&, ResultVegasPlus const& , ResultVegasPlus >
+{
+	__hydra_host__ __hydra_device__ inline
+	ResultVegasPlus operator()(ResultVegasPlus const& x, ResultVegasPlus const& y)
+	{
+		ResultVegasPlus result;
+
+		result.fIntegral = x.fIntegral + y.fIntegral;
+		result.fVariance = x.fVariance + y.fVariance;
+		result.fWeight   = x.fWeight   + y.fWeight;
+
+		return result;
+	}
+};
+
+/*
+ * Adaptive stratification (VEGAS+). The calls are ordered by hypercube, the first call
+ * of the hypercube h being fCubeOffsets[h]. Each work item stores the sums of f and f^2
+ * of the hypercubes entirely contained in its range of calls directly in fCubeSum/fCubeSum2.
+ * The partial sums of its first and last hypercubes, that can be shared with the neighbor
+ * work items, go to the slots 2*item and 2*item+1 of the fEdge* buffers.
+ */
+template<typename FUNCTOR, size_t NDimensions, typename  BACKEND,
+typename IteratorBackendReal, typename IteratorBackendUInt,
+typename GRND=HYDRA_EXTERNAL_NS::thrust::random::default_random_engine>
+struct ProcessCallsVegasPlus;
+
+template<typename FUNCTOR, size_t NDimensions,  hydra::detail::Backend  BACKEND,
+typename IteratorBackendReal, typename IteratorBackendUInt, typename GRND>
+struct ProcessCallsVegasPlus<FUNCTOR,  NDimensions, hydra::detail::BackendPolicy<BACKEND>,
+IteratorBackendReal,  IteratorBackendUInt, GRND>:
+	public ProcessCallsVegas<FUNCTOR,  NDimensions, hydra::detail::BackendPolicy<BACKEND>, IteratorBackendReal, GRND>
+{
+	typedef ProcessCallsVegas<FUNCTOR,  NDimensions, hydra::detail::BackendPolicy<BACKEND>,
+			IteratorBackendReal, GRND> super_t;
+
+	typedef   ProcessCallsVegasPlus<FUNCTOR,  NDimensions, hydra::detail::BackendPolicy<BACKEND>,
+			IteratorBackendReal,  IteratorBackendUInt, GRND> this_t;
+
+	typedef  hydra::VegasState<NDimensions,hydra::detail::BackendPolicy<BACKEND>> state_t;
+
+public :
+
+	template<typename Iterator>
+	ProcessCallsVegasPlus( PartitionVegas<Iterator> const& partition, size_t NCubes, state_t& fState,
+			IteratorBackendReal begin_distribution,
+			IteratorBackendReal begin_cube_sum, IteratorBackendReal begin_cube_sum2,
+			IteratorBackendUInt begin_edge_key,
+			IteratorBackendReal begin_edge_sum, IteratorBackendReal begin_edge_sum2,
+			FUNCTOR const& functor):
+				super_t(partition, fState, begin_distribution, functor),
+				fNCubes(NCubes),
+				fCubeOffsets(fState.GetBackendCubeOffsets().begin()),
+				fCubeSum(begin_cube_sum),
+				fCubeSum2(begin_cube_sum2),
+				fEdgeKey(begin_edge_key),
+				fEdgeSum(begin_edge_sum),
+				fEdgeSum2(begin_edge_sum2)
+				{}
+
+	__hydra_host__ __hydra_device__
+	ProcessCallsVegasPlus( this_t const& other):
+	super_t(other),
+	fNCubes(other.fNCubes),
+	fCubeOffsets(other.fCubeOffsets),
+	fCubeSum(other.fCubeSum),
+	fCubeSum2(other.fCubeSum2),
+	fEdgeKey(other.fEdgeKey),
+	fEdgeSum(other.fEdgeSum),
+	fEdgeSum2(other.fEdgeSum2)
+	{}
+
+	/*
+	 * hypercube containing the call 'index'
+	 */
+	__hydra_host__ __hydra_device__ inline
+	size_t find_cube(const size_t index) const
+	{
+		size_t lo = 0, hi = fNCubes;
+
+		while( hi - lo > 1)
+		{
+			size_t mid = (lo + hi)/2;
+
+			if( fCubeOffsets[mid] <= index ) lo = mid;
+			else hi = mid;
+		}
+
+		return lo;
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	void operator()( size_t item)
+	{
+		size_t first   = this->GetFirstCall(item);
+		size_t last    = this->GetLastCall(item);
+		size_t partial = item % this->fNPartials;
+
+		size_t first_cube = find_cube(first);
+		size_t cube       = first_cube;
+		size_t cube_end   = fCubeOffsets[cube + 1];
+		GReal_t ncalls    = cube_end - fCubeOffsets[cube];
+
+		GReal_t sum  = 0.0;
+		GReal_t sum2 = 0.0;
+
+		for(size_t index = first; index < last; index++)
+		{
+			if( index == cube_end )
+			{
+				store(item, first_cube, cube, sum, sum2);
+
+				cube++;
+				cube_end = fCubeOffsets[cube + 1];
+				ncalls   = cube_end - fCubeOffsets[cube];
+				sum  = 0.0;
+				sum2 = 0.0;
+			}
+
+			GReal_t volume = 1.0;
+			GReal_t x[NDimensions];
+			GInt_t bin[NDimensions];
+
+			this->get_point( index, cube, volume, bin, x );
+
+			GReal_t fval = this->fJacobian*volume*this->fFunctor( detail::arrayToTuple<GReal_t, NDimensions>(x));
+
+			for (GUInt_t j = 0; j < NDimensions; j++)
+				accumulate_vegas(this->fDistribution + this->GetDistributionIndex(partial, bin[j], j ), fval*fval/ncalls);
+
+			sum  += fval;
+			sum2 += fval*fval;
+		}
+
+		//last hypercube of the range
+		if( cube == first_cube )
+		{
+			set_edge(2*item, cube, sum, sum2);
+			set_edge(2*item + 1, cube, 0.0, 0.0);
+		}
+		else set_edge(2*item + 1, cube, sum, sum2);
+
+	}
+
+private:
+
+	__hydra_host__ __hydra_device__ inline
+	void set_edge(const size_t slot, const size_t cube, const GReal_t sum, const GReal_t sum2)
+	{
+		fEdgeKey[slot]  = cube;
+		fEdgeSum[slot]  = sum;
+		fEdgeSum2[slot] = sum2;
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	void store(const size_t item, const size_t first_cube, const size_t cube, const GReal_t sum, const GReal_t sum2)
+	{
+		if( cube == first_cube ) set_edge(2*item, cube, sum, sum2);
+		else {
+			fCubeSum[cube]  = sum;
+			fCubeSum2[cube] = sum2;
+		}
+	}
+
+	size_t fNCubes;
+	IteratorBackendUInt fCubeOffsets;
+	IteratorBackendReal fCubeSum;
+	IteratorBackendReal fCubeSum2;
+	IteratorBackendUInt fEdgeKey;
+	IteratorBackendReal fEdgeSum;
+	IteratorBackendReal fEdgeSum2;
+
+};
+
+/*
+ * Integral and variance of the mean in each hypercube. The weight
+ * sigma^beta used to distribute the calls in the next iteration
+ * is stored in fCubeWeights.
+ */
+template<typename IteratorBackendReal, typename IteratorBackendUInt>
+struct ProcessCubesVegas
+{
+	ProcessCubesVegas( GReal_t beta, IteratorBackendUInt begin_offsets,
+			IteratorBackendReal begin_cube_sum, IteratorBackendReal begin_cube_sum2,
+			IteratorBackendReal begin_cube_weights):
+		fBeta(beta),
+		fCubeOffsets(begin_offsets),
+		fCubeSum(begin_cube_sum),
+		fCubeSum2(begin_cube_sum2),
+		fCubeWeights(begin_cube_weights)
+	{}
+
+	__hydra_host__ __hydra_device__
+	ProcessCubesVegas( ProcessCubesVegas<IteratorBackendReal, IteratorBackendUInt> const& other):
+		fBeta(other.fBeta),
+		fCubeOffsets(other.fCubeOffsets),
+		fCubeSum(other.fCubeSum),
+		fCubeSum2(other.fCubeSum2),
+		fCubeWeights(other.fCubeWeights)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	ResultVegasPlus operator()( size_t cube)
+	{
+		GReal_t n    = fCubeOffsets[cube+1] - fCubeOffsets[cube];
+		GReal_t sum  = fCubeSum[cube];
+		GReal_t sum2 = fCubeSum2[cube];
+
+		//unbiased variance of f in the hypercube
+		GReal_t var = (sum2 - sum*sum/n)/(n - 1.0);
+		var = var > 0.0 ? var : 0.0;
+
+		fCubeWeights[cube] = ::pow(var, 0.5*fBeta);
+
+		ResultVegasPlus result;
+		result.fIntegral = sum/n;
+		result.fVariance = var/n;
+		result.fWeight   = fCubeWeights[cube];
+
+		return result;
+	}
+
+private:
+
+	GReal_t fBeta;
+	IteratorBackendUInt fCubeOffsets;
+	IteratorBackendReal fCubeSum;
+	IteratorBackendReal fCubeSum2;
+	IteratorBackendReal fCubeWeights;
+};
+
+/*
+ * Weight of each hypercube of a new stratification, taken from the hypercube of the previous
+ * stratification containing its centre, when the number of boxes per dimension changes.
+ */
+template<size_t NDimensions, typename IteratorBackendReal>
+struct RemapCubeWeightsVegas
+{
+	RemapCubeWeightsVegas( size_t nboxes, size_t nboxes_old, IteratorBackendReal begin_cube_weights_old):
+		fNBoxes(nboxes),
+		fNBoxesOld(nboxes_old),
+		fCubeWeightsOld(begin_cube_weights_old)
+	{}
+
+	__hydra_host__ __hydra_device__
+	RemapCubeWeightsVegas( RemapCubeWeightsVegas<NDimensions, IteratorBackendReal> const& other):
+		fNBoxes(other.fNBoxes),
+		fNBoxesOld(other.fNBoxesOld),
+		fCubeWeightsOld(other.fCubeWeightsOld)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	GReal_t operator()( size_t cube)
+	{
+		size_t cube_old = 0;
+		size_t stride   = 1;
+
+		//the last dimension is the fastest running index (see ProcessCallsVegas::GetBoxCoordinate)
+		for(size_t j = 0; j < NDimensions; j++)
+		{
+			size_t b     = cube % fNBoxes;
+			size_t b_old = ((2*b + 1)*fNBoxesOld)/(2*fNBoxes);
+
+			cube_old += b_old*stride;
+			stride   *= fNBoxesOld;
+			cube     /= fNBoxes;
+		}
+
+		return fCubeWeightsOld[cube_old];
+	}
+
+private:
+
+	size_t fNBoxes;
+	size_t fNBoxesOld;
+	IteratorBackendReal fCubeWeightsOld;
+};
+
+/*
+ * Number of calls in each hypercube, proportional to its weight, with at least two calls.
+ */
+template<typename IteratorBackendReal>
+struct AllocateCallsVegas
+{
+	AllocateCallsVegas( GReal_t ncalls, GReal_t total_weight, IteratorBackendReal begin_cube_weights):
+		fNCalls(ncalls),
+		fTotalWeight(total_weight),
+		fCubeWeights(begin_cube_weights)
+	{}
+
+	__hydra_host__ __hydra_device__
+	AllocateCallsVegas( AllocateCallsVegas<IteratorBackendReal> const& other):
+		fNCalls(other.fNCalls),
+		fTotalWeight(other.fTotalWeight),
+		fCubeWeights(other.fCubeWeights)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	size_t operator()( size_t cube)
+	{
+		size_t n = static_cast<size_t>( fNCalls*fCubeWeights[cube]/fTotalWeight );
+
+		return n > 2 ? n : 2;
+	}
+
+private:
 
+	GReal_t fNCalls;
+	GReal_t fTotalWeight;
+	IteratorBackendReal fCubeWeights;
 };
 
 }// namespace detail
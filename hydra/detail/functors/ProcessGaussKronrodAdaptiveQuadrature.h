@@ -31,62 +31,226 @@
 
 #include <hydra/detail/Config.h>
 #include <hydra/Types.h>
-#include <hydra/Collection.h>
+#include <hydra/GaussKronrodRule.h>
+#include <hydra/detail/external/thrust/tuple.h>
+#include <hydra/detail/external/thrust/functional.h>
 
-namespace hydra {
+#include <limits>
 
+namespace hydra {
 
-template <typename FUNCTOR>
+/*
+ * Evaluates one pair of abscissae (call) of the Gauss-Kronrod rule in one node.
+ * The calls of the nodes [0, n) are numbered node*(NRULE+1)/2 + call,
+ * so all calls of a round are processed by a single launch.
+ */
+template <typename FUNCTOR, size_t NRULE>
 struct ProcessGaussKronrodAdaptiveQuadrature
 {
-	typedef HYDRA_EXTERNAL_NS::thrust::tuple<GUInt_t, double, double> result_row_t;
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<double, double> result_row_t;
+
+	constexpr static size_t NCALLS = (NRULE+1)/2;
 
 	ProcessGaussKronrodAdaptiveQuadrature()=delete;
 
-	ProcessGaussKronrodAdaptiveQuadrature(FUNCTOR functor):
-		fFunctor(functor)
+	ProcessGaussKronrodAdaptiveQuadrature(FUNCTOR functor, GaussKronrodRule<NRULE> const& rule,
+			const GReal_t* lower, const GReal_t* upper):
+		fFunctor(functor),
+		fRule(rule),
+		fLower(lower),
+		fUpper(upper)
 	{}
 
 	__hydra_host__ __hydra_device__ inline
-	ProcessGaussKronrodAdaptiveQuadrature(ProcessGaussKronrodAdaptiveQuadrature<FUNCTOR> const& other ):
-	fFunctor(other.fFunctor)
+	ProcessGaussKronrodAdaptiveQuadrature(ProcessGaussKronrodAdaptiveQuadrature<FUNCTOR, NRULE> const& other ):
+		fFunctor(other.fFunctor),
+		fRule(other.fRule),
+		fLower(other.fLower),
+		fUpper(other.fUpper)
 	{}
 
 	__hydra_host__ __hydra_device__ inline
 	ProcessGaussKronrodAdaptiveQuadrature&
-	operator=(ProcessGaussKronrodAdaptiveQuadrature<FUNCTOR> const& other )
+	operator=(ProcessGaussKronrodAdaptiveQuadrature<FUNCTOR, NRULE> const& other )
 	{
 		if( this== &other) return *this;
 
-		fFunctor=other.fFunctor;
+		fFunctor = other.fFunctor;
+		fRule    = other.fRule;
+		fLower   = other.fLower;
+		fUpper   = other.fUpper;
+
 		return *this;
 	}
 
-	template<typename T>
 	__hydra_host__ __hydra_device__ inline
-	result_row_t operator()(T row)
+	result_row_t operator()(size_t index)
 	{
-		GUInt_t bin                      = HYDRA_EXTERNAL_NS::thrust::get<0>(row);
-		GReal_t abscissa_X_P             = HYDRA_EXTERNAL_NS::thrust::get<1>(row);
-		GReal_t abscissa_X_M             = HYDRA_EXTERNAL_NS::thrust::get<2>(row);
-		GReal_t abscissa_Weight          = HYDRA_EXTERNAL_NS::thrust::get<3>(row);
-		GReal_t rule_GaussKronrod_Weight = HYDRA_EXTERNAL_NS::thrust::get<4>(row);
-		GReal_t rule_Gauss_Weight        = HYDRA_EXTERNAL_NS::thrust::get<5>(row);
+		size_t node = index/NCALLS;
+		size_t call = index%NCALLS;
+
+		GReal_t abscissa_X_P    = 0;
+		GReal_t abscissa_X_M    = 0;
+		GReal_t abscissa_Weight = 0;
 
-	//	GaussKronrodCall result;
+		HYDRA_EXTERNAL_NS::thrust::tie(abscissa_X_P, abscissa_X_M, abscissa_Weight)
+			= fRule.GetAbscissa(call, fLower[node], fUpper[node]);
 
-		GReal_t function_call    = abscissa_Weight*(fFunctor(abscissa_X_P)
+		GReal_t function_call = abscissa_Weight*(fFunctor(abscissa_X_P)
 				+ fFunctor(abscissa_X_M) ) ;
-		GReal_t fGaussCall        = function_call*rule_Gauss_Weight;
-		GReal_t fGaussKronrodCall = function_call*rule_GaussKronrod_Weight;
 
-		//printf("%d %f %f\n", bin, fGaussCall, fGaussKronrodCall);
-		return result_row_t(bin, fGaussCall, fGaussKronrodCall);
+		return result_row_t(function_call*fRule.GaussWeight[call],
+				function_call*fRule.KronrodWeight[call]);
 	}
 
 	FUNCTOR fFunctor;
+	GaussKronrodRule<NRULE> fRule;
+	const GReal_t* __restrict__ fLower;
+	const GReal_t* __restrict__ fUpper;
+};
+
+namespace detail {
+
+/*
+ * Node of the call 'index', used as key to sum the calls of each node.
+ */
+template <size_t NRULE>
+struct GaussKronrodCallNode
+{
+	__hydra_host__ __hydra_device__ inline
+	size_t operator()(size_t index) const
+	{
+		return index/((NRULE+1)/2);
+	}
+};
+
+/*
+ * Sum of (gauss, kronrod) pairs.
+ */
+struct GaussKronrodCallSum
+{
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<double, double> result_row_t;
+
+	__hydra_host__ __hydra_device__ inline
+	result_row_t operator()(result_row_t const& x, result_row_t const& y) const
+	{
+		return result_row_t(HYDRA_EXTERNAL_NS::thrust::get<0>(x) + HYDRA_EXTERNAL_NS::thrust::get<0>(y),
+				HYDRA_EXTERNAL_NS::thrust::get<1>(x) + HYDRA_EXTERNAL_NS::thrust::get<1>(y));
+	}
+};
+
+/*
+ * Integral and error of a node, from the Gauss and Kronrod sums.
+ */
+struct GaussKronrodNodeResult
+{
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<double, double> result_row_t;
+
+	__hydra_host__ __hydra_device__ inline
+	static GReal_t GetError( GReal_t delta)
+	{
+		GReal_t error = ::pow(200.0*::fabs(delta ), 1.5);
+
+		return error > std::numeric_limits<GReal_t>::epsilon() ? error : std::numeric_limits<GReal_t>::epsilon();
+	}
+
+	template<typename T>
+	__hydra_host__ __hydra_device__ inline
+	result_row_t operator()(T const& calls) const
+	{
+		GReal_t gauss   = HYDRA_EXTERNAL_NS::thrust::get<0>(calls);
+		GReal_t kronrod = HYDRA_EXTERNAL_NS::thrust::get<1>(calls);
+
+		return result_row_t(kronrod, GetError(gauss - kronrod));
+	}
+};
+
+/*
+ * Sum of the integrals and of the squared errors of the nodes.
+ */
+struct GaussKronrodNodeSum
+{
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<double, double> result_row_t;
+
+	template<typename T>
+	__hydra_host__ __hydra_device__ inline
+	result_row_t operator()(T const& node) const
+	{
+		GReal_t error = HYDRA_EXTERNAL_NS::thrust::get<1>(node);
+
+		return result_row_t(HYDRA_EXTERNAL_NS::thrust::get<0>(node), error*error);
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	result_row_t operator()(result_row_t const& x, result_row_t const& y) const
+	{
+		return GaussKronrodCallSum()(x, y);
+	}
+};
+
+/*
+ * Selects the nodes with error above the threshold, which can still be halved.
+ * Rows are (lower, upper, integral, error).
+ */
+struct GaussKronrodSplitNode
+{
+	GaussKronrodSplitNode(GReal_t threshold):
+		fThreshold(threshold)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	GaussKronrodSplitNode(GaussKronrodSplitNode const& other):
+		fThreshold(other.fThreshold)
+	{}
+
+	template<typename T>
+	__hydra_host__ __hydra_device__ inline
+	bool operator()(T const& node) const
+	{
+		GReal_t lower  = HYDRA_EXTERNAL_NS::thrust::get<0>(node);
+		GReal_t upper  = HYDRA_EXTERNAL_NS::thrust::get<1>(node);
+		GReal_t middle = 0.5*(lower + upper);
+
+		return HYDRA_EXTERNAL_NS::thrust::get<3>(node) > fThreshold
+				&& middle > lower && middle < upper;
+	}
+
+	GReal_t fThreshold;
+};
+
+/*
+ * Halves of the split nodes: the child 2*i+k is the half k of the node i.
+ */
+struct GaussKronrodChildNode
+{
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<double, double, double, double> node_t;
+
+	GaussKronrodChildNode(const GReal_t* lower, const GReal_t* upper):
+		fLower(lower),
+		fUpper(upper)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	GaussKronrodChildNode(GaussKronrodChildNode const& other):
+		fLower(other.fLower),
+		fUpper(other.fUpper)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	node_t operator()(size_t index) const
+	{
+		GReal_t lower  = fLower[index/2];
+		GReal_t upper  = fUpper[index/2];
+		GReal_t middle = 0.5*(lower + upper);
+
+		return index%2 ? node_t(middle, upper, 0.0, 0.0) : node_t(lower, middle, 0.0, 0.0);
+	}
+
+	const GReal_t* __restrict__ fLower;
+	const GReal_t* __restrict__ fUpper;
 };
 
+}  // namespace detail
 
 }  // namespace hydra
 
@@ -32,6 +32,9 @@
 #include <hydra/detail/Config.h>
 #include <hydra/Types.h>
 #include <hydra/Collection.h>
+#include <hydra/detail/utility/Utility_Tuple.h>
+#include <hydra/detail/external/thrust/functional.h>
+#include <hydra/detail/external/thrust/tuple.h>
 
 namespace hydra {
 
@@ -103,7 +106,7 @@ struct GaussKronrodUnary
 
 		GaussKronrodCall result;
 
-		GReal_t function_call    = abscissa_Weight*(fFunctor(abscissa_X_M)
+		GReal_t function_call    = abscissa_Weight*(fFunctor(abscissa_X_P)
 				+ fFunctor(abscissa_X_M) ) ;
 
 		result.fGaussCall        = function_call*rule_Gauss_Weight;
@@ -135,6 +138,85 @@ struct GaussKronrodBinary: public HYDRA_EXTERNAL_NS::thrust::binary_function<Gau
 };
 
 
+/*
+ * Gauss and Gauss-Kronrod sums of K integrands evaluated at the same abscissas.
+ */
+template<size_t K>
+struct GaussKronrodMultiCall
+{
+	__hydra_host__ __hydra_device__ inline
+	GaussKronrodMultiCall()
+	{
+		for(size_t k=0; k<K; k++) fCalls[k] = GaussKronrodCall();
+	}
+
+	GaussKronrodCall fCalls[K];
+};
+
+template <typename FUNCTORS>
+struct GaussKronrodMultiUnary
+{
+	static const size_t K = HYDRA_EXTERNAL_NS::thrust::tuple_size<FUNCTORS>::value;
+
+	GaussKronrodMultiUnary()=delete;
+
+	GaussKronrodMultiUnary(FUNCTORS const& functors):
+	fFunctors(functors)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	GaussKronrodMultiUnary(GaussKronrodMultiUnary<FUNCTORS> const& other ):
+	fFunctors(other.fFunctors)
+	{}
+
+	template<typename T>
+	__hydra_host__ __hydra_device__ inline
+	GaussKronrodMultiCall<K> operator()(T row)
+	{
+		GReal_t abscissa_X_P             = HYDRA_EXTERNAL_NS::thrust::get<0>(row);
+		GReal_t abscissa_X_M             = HYDRA_EXTERNAL_NS::thrust::get<1>(row);
+		GReal_t abscissa_Weight          = HYDRA_EXTERNAL_NS::thrust::get<2>(row);
+		GReal_t rule_GaussKronrod_Weight = HYDRA_EXTERNAL_NS::thrust::get<3>(row);
+		GReal_t rule_Gauss_Weight        = HYDRA_EXTERNAL_NS::thrust::get<4>(row);
+
+		GReal_t fval_p[K];
+		GReal_t fval_m[K];
+
+		detail::eval_tuple_to_array(fval_p, fFunctors, abscissa_X_P);
+		detail::eval_tuple_to_array(fval_m, fFunctors, abscissa_X_M);
+
+		GaussKronrodMultiCall<K> result;
+
+		for(size_t k=0; k<K; k++)
+		{
+			GReal_t function_call = abscissa_Weight*(fval_p[k] + fval_m[k]);
+
+			result.fCalls[k].fGaussCall        = function_call*rule_Gauss_Weight;
+			result.fCalls[k].fGaussKronrodCall = function_call*rule_GaussKronrod_Weight;
+		}
+
+		return result;
+	}
+
+	FUNCTORS fFunctors;
+};
+
+template<size_t K>
+struct GaussKronrodMultiBinary: public HYDRA_EXTERNAL_NS::thrust::binary_function<GaussKronrodMultiCall<K> const&,
+		GaussKronrodMultiCall<K> const&, GaussKronrodMultiCall<K>>
+{
+	 __hydra_host__ __hydra_device__ inline
+	 GaussKronrodMultiCall<K> operator()( GaussKronrodMultiCall<K> const& x, GaussKronrodMultiCall<K> const& y)
+	 {
+		 GaussKronrodMultiCall<K> result;
+
+		 for(size_t k=0; k<K; k++)
+			 result.fCalls[k] = GaussKronrodBinary()(x.fCalls[k], y.fCalls[k]);
+
+		 return result;
+	 }
+};
+
 }  // namespace hydra
 
 
@@ -67,7 +67,8 @@ struct ProcessGenzMalikUnaryCall
 
 	ProcessGenzMalikUnaryCall()=delete;
 
-	ProcessGenzMalikUnaryCall(GReal_t * __restrict__ lowerLimit, GReal_t * __restrict__ upperLimit, FUNCTOR const& functor):
+	__hydra_host__ __hydra_device__
+	ProcessGenzMalikUnaryCall(const GReal_t * __restrict__ lowerLimit, const GReal_t * __restrict__ upperLimit, FUNCTOR const& functor):
 			fFunctor(functor)
 
 	{
@@ -122,8 +123,8 @@ struct ProcessGenzMalikUnaryCall
 
 		GReal_t _temp[N+2]{0};
 		GReal_t fval  = fFunctor(args);
-		_temp[0]      = fval*HYDRA_EXTERNAL_NS::thrust::get<1>(rule_abscissa);//w7;
-		_temp[1]      = fval*HYDRA_EXTERNAL_NS::thrust::get<0>(rule_abscissa);//w5;
+		_temp[0]      = fval*HYDRA_EXTERNAL_NS::thrust::get<0>(rule_abscissa);//w5;
+		_temp[1]      = fval*HYDRA_EXTERNAL_NS::thrust::get<1>(rule_abscissa);//w7;
 
 		GReal_t fourdiff      = fval*HYDRA_EXTERNAL_NS::thrust::get<3>(rule_abscissa);//w_four_diff;
 
@@ -230,75 +231,154 @@ struct ProcessGenzMalikBinaryCall:
 
 
 
-template <size_t N, typename FUNCTOR, typename RuleIterator, typename BoxIterator>
-struct ProcessGenzMalikBox
+/*
+ * Boxes are evaluated in batches: the call 'index' evaluates the rule abscissa index%nrule
+ * of the box index/nrule, whose limits are stored as {lower[N], upper[N]} in fLimits.
+ */
+struct GenzMalikBoxIndex
 {
+	//constructor
+	GenzMalikBoxIndex(size_t nrule):
+		fNRule(nrule)
+	{}
 
-	ProcessGenzMalikBox(){};
-
-	ProcessGenzMalikBox(FUNCTOR const& functor,
-				RuleIterator begin, RuleIterator end, BoxIterator box_begin, BoxIterator box_end):
-			fFunctor(functor),
-			fBoxBegin(box_begin),
-			fBoxEnd(box_end),
-			fRuleBegin(begin),
-			fRuleEnd(end)
-		{}
-
-	__hydra_host__ __hydra_device__
-	ProcessGenzMalikBox(ProcessGenzMalikBox< N, FUNCTOR, RuleIterator,BoxIterator > const& other ):
-	fFunctor(other.fFunctor),
-	fBoxBegin(other.fBoxBegin),
-	fBoxEnd(other.fBoxEnd),
-	fRuleBegin(other.fRuleBegin),
-	fRuleEnd(other.fRuleEnd)
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	GenzMalikBoxIndex(GenzMalikBoxIndex const& other):
+		fNRule(other.fNRule)
 	{}
 
 	__hydra_host__ __hydra_device__ inline
-	ProcessGenzMalikBox< N, FUNCTOR, RuleIterator,BoxIterator >&
-	operator=(ProcessGenzMalikBox< N, FUNCTOR, RuleIterator,BoxIterator > const& other )
+	size_t operator()(size_t index) const
 	{
-		if( this== &other) return *this;
+		return index/fNRule;
+	}
 
-		fFunctor=other.fFunctor;
-		fBoxBegin=other.fBoxBegin;
-		fBoxEnd=other.fBoxEnd;
-		fRuleBegin=other.fRuleBegin;
-		fRuleEnd=other.fRuleEnd;
+	size_t fNRule;
+};
 
-		return *this;
-	}
+template <size_t N, typename FUNCTOR, typename RuleIterator>
+struct ProcessGenzMalikBoxes
+{
+	typedef typename hydra::detail::tuple_type<N+2, GReal_t>::type data_type;
+
+	//constructor
+	ProcessGenzMalikBoxes(FUNCTOR const& functor, RuleIterator rule, size_t nrule, const GReal_t* limits):
+		fFunctor(functor),
+		fRule(rule),
+		fNRule(nrule),
+		fLimits(limits)
+	{}
 
-	__hydra_host__
-	inline void operator()(size_t index)
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	ProcessGenzMalikBoxes(ProcessGenzMalikBoxes<N, FUNCTOR, RuleIterator> const& other):
+		fFunctor(other.fFunctor),
+		fRule(other.fRule),
+		fNRule(other.fNRule),
+		fLimits(other.fLimits)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	data_type operator()(size_t index)
 	{
-		typedef typename hydra::detail::tuple_type<N+2, GReal_t>::type tuple_t;
-		/*
-		typedef hydra::mc_device_vector<tuple_t > device_super_t;
-		typedef hydra::mc_host_vector<tuple_t > host_super_t;
-		typedef multivector<device_super_t> device_rvector_t;
-		typedef multivector<host_super_t> host_rvector_t;
-*/
-		auto box_result =
-				HYDRA_EXTERNAL_NS::thrust::transform_reduce( fRuleBegin, fRuleEnd,
-				ProcessGenzMalikUnaryCall<N, FUNCTOR, RuleIterator>(fBoxBegin[index].GetLowerLimit(), fBoxBegin[index].GetUpperLimit(), fFunctor),
-				tuple_t() ,
-				ProcessGenzMalikBinaryCall<N>());
-
-		fBoxBegin[index]=box_result;
+		const GReal_t* lower = fLimits + 2*N*(index/fNRule);
 
+		return ProcessGenzMalikUnaryCall<N, FUNCTOR, RuleIterator>(lower, lower + N, fFunctor)(fRule[index%fNRule]);
 	}
 
 	FUNCTOR fFunctor;
-	BoxIterator  fBoxBegin;
-	BoxIterator  fBoxEnd;
-	RuleIterator fRuleBegin;
-	RuleIterator fRuleEnd;
+	RuleIterator fRule;
+	size_t fNRule;
+	const GReal_t* __restrict__ fLimits;
+};
+
+
+
+/*
+ * Degree five and seven sums of K integrands over one box.
+ */
+template<size_t K>
+struct GenzMalikMultiCall
+{
+	GReal_t fRule5[K];
+	GReal_t fRule7[K];
+};
+
+template <size_t N, typename FUNCTORS, typename RuleIterator>
+struct ProcessGenzMalikBoxesMulti
+{
+	static const size_t K = HYDRA_EXTERNAL_NS::thrust::tuple_size<FUNCTORS>::value;
+
+	//transformation of the rule abscissas to the box
+	typedef ProcessGenzMalikUnaryCall<N, FUNCTORS, RuleIterator> unary_t;
+
+	//constructor
+	ProcessGenzMalikBoxesMulti(FUNCTORS const& functors, RuleIterator rule, size_t nrule, const GReal_t* limits):
+		fFunctors(functors),
+		fRule(rule),
+		fNRule(nrule),
+		fLimits(limits)
+	{}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	ProcessGenzMalikBoxesMulti(ProcessGenzMalikBoxesMulti<N, FUNCTORS, RuleIterator> const& other):
+		fFunctors(other.fFunctors),
+		fRule(other.fRule),
+		fNRule(other.fNRule),
+		fLimits(other.fLimits)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	GenzMalikMultiCall<K> operator()(size_t index)
+	{
+		const GReal_t* lower = fLimits + 2*N*(index/fNRule);
+
+		typename unary_t::rule_abscissa_t rule_abscissa = fRule[index%fNRule];
+		typename unary_t::abscissa_t args;
+
+		unary_t(lower, lower + N, fFunctors).get_transformed_abscissa(rule_abscissa, args);
 
+		GReal_t fval[K];
+		detail::eval_tuple_to_array(fval, fFunctors, args);
 
+		GenzMalikMultiCall<K> result;
+
+		for(size_t k=0; k<K; k++)
+		{
+			result.fRule5[k] = fval[k]*HYDRA_EXTERNAL_NS::thrust::get<0>(rule_abscissa);
+			result.fRule7[k] = fval[k]*HYDRA_EXTERNAL_NS::thrust::get<1>(rule_abscissa);
+		}
+
+		return result;
+	}
+
+	FUNCTORS fFunctors;
+	RuleIterator fRule;
+	size_t fNRule;
+	const GReal_t* __restrict__ fLimits;
 };
 
+template<size_t K>
+struct ProcessGenzMalikMultiBinary:
+		public HYDRA_EXTERNAL_NS::thrust::binary_function< GenzMalikMultiCall<K> const&,
+		GenzMalikMultiCall<K> const&, GenzMalikMultiCall<K> >
+{
+	__hydra_host__ __hydra_device__ inline
+	GenzMalikMultiCall<K> operator()(GenzMalikMultiCall<K> const& x, GenzMalikMultiCall<K> const& y)
+	{
+		GenzMalikMultiCall<K> result;
+
+		for(size_t k=0; k<K; k++)
+		{
+			result.fRule5[k] = x.fRule5[k] + y.fRule5[k];
+			result.fRule7[k] = x.fRule7[k] + y.fRule7[k];
+		}
 
+		return result;
+	}
+};
 
 }  // namespace detail
 
@@ -0,0 +1,243 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * ProcessSparseGridQuadrature.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+/**
+ * \file
+ * \ingroup numerical_integration
+ */
+
+#ifndef PROCESSSPARSEGRIDQUADRATURE_H_
+#define PROCESSSPARSEGRIDQUADRATURE_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/Types.h>
+#include <hydra/detail/utility/Utility_Tuple.h>
+
+#include <array>
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * Tensor product of one dimensional difference rules, with level fLevel[j] in dimension j.
+ * Its nodes are the union of the blocks of new nodes of all levels m <= fLevel. The storage offsets
+ * of these blocks are found in the block table from position fTable, in mixed radix order of m.
+ */
+template<size_t N>
+struct SparseGridTerm
+{
+	size_t fLevel[N];
+	size_t fTable;
+};
+
+/*
+ * Number of nodes of the rule of 'level' which are not in the lower levels.
+ */
+__hydra_host__ __hydra_device__ inline
+size_t sparse_grid_new_nodes(size_t level)
+{
+	return level < 2 ? level + 1 : size_t(1) << (level - 1);
+}
+
+/*
+ * Lowest level containing the node 'i' of the rule of 'level', and its position in the new nodes of that level.
+ */
+__hydra_host__ __hydra_device__ inline
+void sparse_grid_block(size_t i, size_t level, size_t& block_level, size_t& position)
+{
+	size_t m = size_t(1) << level;
+
+	if( level==0 || 2*i == m ){ block_level = 0; position = 0; return; }
+
+	if( i==0 || i==m ){ block_level = 1; position = i==0 ? 0 : 1; return; }
+
+	block_level = level;
+
+	while( !(i&1) ){ i >>= 1; block_level--; }
+
+	position = (i - 1)/2;
+}
+
+// SparseGridTermIndex gives the term of the call 'index', used as key of the reduction.
+struct SparseGridTermIndex
+{
+	//constructor
+	SparseGridTermIndex(size_t nterms, const size_t* offsets):
+		fNTerms(nterms),
+		fOffsets(offsets)
+	{}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	SparseGridTermIndex(SparseGridTermIndex const& other):
+		fNTerms(other.fNTerms),
+		fOffsets(other.fOffsets)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	size_t operator()(size_t index) const
+	{
+		//last term with offset <= index
+		size_t first = 0;
+		size_t count = fNTerms;
+
+		while(count > 0){
+
+			size_t step = count/2;
+
+			if( fOffsets[first + step + 1] <= index){
+				first += step + 1;
+				count -= step + 1;
+			}
+			else count = step;
+		}
+
+		return first;
+	}
+
+	size_t fNTerms;
+	const size_t* __restrict__ fOffsets;
+};
+
+/*
+ * Calls of all terms of one refinement round are processed by a single launch.
+ * The call 'index' belongs to the term whose range [fOffsets[t], fOffsets[t+1]) contains it,
+ * and index - fOffsets[t] is decomposed in one node of the difference rule per dimension.
+ * The function is evaluated only at the nodes which are new in this term and stored, the values at
+ * the nodes of the lower levels are read from the store, filled by the previous rounds.
+ * It returns the function value times the product of the weights.
+ */
+template<size_t N, typename FUNCTOR>
+struct ProcessSparseGridQuadrature
+{
+	//constructor
+	ProcessSparseGridQuadrature(FUNCTOR const& functor, size_t nterms, const SparseGridTerm<N>* terms,
+			const size_t* offsets, const size_t* rules, const GReal_t* nodes, const GReal_t* weights,
+			const size_t* table, GReal_t* store,
+			std::array<GReal_t,N> const& lower_limit, std::array<GReal_t,N> const& upper_limit):
+		fNTerms(nterms),
+		fTerms(terms),
+		fOffsets(offsets),
+		fRules(rules),
+		fNodes(nodes),
+		fWeights(weights),
+		fTable(table),
+		fStore(store),
+		fFunctor(functor)
+	{
+		for(size_t j=0; j<N; j++){
+			fCenter[j]    = 0.5*(upper_limit[j] + lower_limit[j]);
+			fHalfWidth[j] = 0.5*(upper_limit[j] - lower_limit[j]);
+		}
+	}
+
+	//copy
+	__hydra_host__ __hydra_device__ inline
+	ProcessSparseGridQuadrature(ProcessSparseGridQuadrature<N,FUNCTOR> const& other):
+		fNTerms(other.fNTerms),
+		fTerms(other.fTerms),
+		fOffsets(other.fOffsets),
+		fRules(other.fRules),
+		fNodes(other.fNodes),
+		fWeights(other.fWeights),
+		fTable(other.fTable),
+		fStore(other.fStore),
+		fFunctor(other.fFunctor)
+	{
+		for(size_t j=0; j<N; j++){
+			fCenter[j]    = other.fCenter[j];
+			fHalfWidth[j] = other.fHalfWidth[j];
+		}
+	}
+
+	__hydra_host__ __hydra_device__ inline
+	GReal_t operator()(size_t index)
+	{
+		size_t term = SparseGridTermIndex(fNTerms, fOffsets)(index);
+
+		SparseGridTerm<N> const& rule = fTerms[term];
+
+		size_t node = index - fOffsets[term];
+
+		GReal_t x[N];
+		GReal_t weight = 1.0;
+
+		size_t block       = 0;
+		size_t block_radix = 1;
+		size_t position    = 0;
+		size_t radix       = 1;
+		bool   is_new      = true;
+
+		for(size_t j=0; j<N; j++){
+
+			size_t level = rule.fLevel[j];
+			size_t size  = level==0 ? 1 : (size_t(1) << level) + 1;
+			size_t i     = node%size;
+
+			node /= size;
+
+			x[j]    = fCenter[j] + fHalfWidth[j]*fNodes[fRules[level] + i];
+			weight *= fHalfWidth[j]*fWeights[fRules[level] + i];
+
+			size_t block_level, block_position;
+
+			sparse_grid_block(i, level, block_level, block_position);
+
+			block       += block_level*block_radix;
+			block_radix *= level + 1;
+			position    += block_position*radix;
+			radix       *= sparse_grid_new_nodes(block_level);
+			is_new       = is_new && block_level == level;
+		}
+
+		GReal_t* value = fStore + fTable[rule.fTable + block] + position;
+
+		if(is_new) *value = fFunctor( detail::arrayToTuple<GReal_t, N>(x));
+
+		return weight*(*value);
+	}
+
+	size_t fNTerms;
+	const SparseGridTerm<N>* __restrict__ fTerms;
+	const size_t*  __restrict__ fOffsets;
+	const size_t*  __restrict__ fRules;
+	const GReal_t* __restrict__ fNodes;
+	const GReal_t* __restrict__ fWeights;
+	const size_t*  __restrict__ fTable;
+	GReal_t* fStore;
+	GReal_t fCenter[N];
+	GReal_t fHalfWidth[N];
+	FUNCTOR fFunctor;
+};
+
+}// namespace detail
+
+}// namespace hydra
+
+#endif /* PROCESSSPARSEGRIDQUADRATURE_H_ */
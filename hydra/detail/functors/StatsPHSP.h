@@ -35,6 +35,12 @@ namespace hydra {
 
 namespace detail {
 
+/*
+ * Weighted mean fMean of the values f of fN events with weights w, fW = sum(w).
+ * fM2 = sum(w*(f - fMean)^2), fW2 = sum(w^2), fT = sum(w^2*(f - fMean)) and
+ * fS = sum(w^2*(f - fMean)^2), the last three giving the standard error of
+ * the mean as for the ratio sum(w*f)/sum(w) of StatsRatio.
+ */
 struct StatsPHSP
 {
 
@@ -42,19 +48,42 @@ struct StatsPHSP
 	StatsPHSP():
 		fMean(0),
 		fM2(0),
-		fW(0)
+		fW(0),
+		fN(0),
+		fW2(0),
+		fT(0),
+		fS(0)
 		{}
 
 	__hydra_host__ __hydra_device__
 	StatsPHSP(StatsPHSP const& other):
 	fMean(other.fMean),
 	fM2(other.fM2),
-	fW(other.fW)
+	fW(other.fW),
+	fN(other.fN),
+	fW2(other.fW2),
+	fT(other.fT),
+	fS(other.fS)
 	{}
 
+	/*
+	 * standard error of fMean
+	 */
+	__hydra_host__ __hydra_device__ inline
+	GReal_t Error() const
+	{
+		if( fN < 2 ) return 0.0;
+
+		return ::sqrt( (fS > 0.0 ? fS : 0.0)*fN/(fN - 1.0) )/fW;
+	}
+
 	GReal_t fMean;
     GReal_t fM2;
     GReal_t fW;
+    size_t  fN;
+    GReal_t fW2;
+    GReal_t fT;
+    GReal_t fS;
 
 };
 
@@ -80,12 +109,109 @@ struct AddStatsPHSP
         result.fM2   = x.fM2   +  y.fM2;
         result.fM2  += delta2 * (x.fW) * (y.fW) /w;
 
+        //moments of x and y shifted to the new mean
+        GReal_t dx = x.fMean - result.fMean;
+        GReal_t dy = y.fMean - result.fMean;
+
+        result.fN   = x.fN  + y.fN;
+        result.fW2  = x.fW2 + y.fW2;
+        result.fT   = x.fT  + dx*x.fW2 + y.fT + dy*y.fW2;
+        result.fS   = x.fS  + dx*(2.0*x.fT + dx*x.fW2)
+                    + y.fS  + dy*(2.0*y.fT + dy*y.fW2);
+
         return result;
     }
 
 };
 
 
+/*
+ * Sums needed to estimate the ratio <w*f>/<w> and its error
+ * from fN independent groups of events: fA = sum(w*f) and fB = sum(w),
+ * fAA, fAB and fBB the corresponding second moments over the groups.
+ */
+struct StatsRatio
+{
+
+	__hydra_host__ __hydra_device__
+	StatsRatio():
+		fN(0),
+		fA(0),
+		fB(0),
+		fAA(0),
+		fAB(0),
+		fBB(0)
+		{}
+
+	__hydra_host__ __hydra_device__
+	StatsRatio(StatsRatio const& other):
+		fN(other.fN),
+		fA(other.fA),
+		fB(other.fB),
+		fAA(other.fAA),
+		fAB(other.fAB),
+		fBB(other.fBB)
+	{}
+
+	__hydra_host__ __hydra_device__ inline
+	void AddGroup(GReal_t a, GReal_t b)
+	{
+		fN  += 1;
+		fA  += a;
+		fB  += b;
+		fAA += a*a;
+		fAB += a*b;
+		fBB += b*b;
+	}
+
+	/*
+	 * ratio fA/fB and its standard error, sqrt(n/(n-1)*sum((a - r*b)^2))/sum(b),
+	 * with r = fA/fB, i.e. StatsPHSP::Error() if each group is one event
+	 */
+	__hydra_host__ __hydra_device__ inline
+	GReal_t Ratio() const { return fA/fB; }
+
+	__hydra_host__ __hydra_device__ inline
+	GReal_t Error() const
+	{
+		if( fN < 2 ) return 0.0;
+
+		GReal_t r = fA/fB;
+		GReal_t s = fAA - 2.0*r*fAB + r*r*fBB;
+
+		return ::sqrt( (s > 0.0 ? s : 0.0)*fN/(fN - 1.0) )/fB;
+	}
+
+	size_t  fN;
+	GReal_t fA;
+	GReal_t fB;
+	GReal_t fAA;
+	GReal_t fAB;
+	GReal_t fBB;
+
+};
+
+struct AddStatsRatio
+		:public HYDRA_EXTERNAL_NS::thrust::binary_function< StatsRatio const&, StatsRatio const&, StatsRatio >
+{
+
+	__hydra_host__ __hydra_device__ inline
+	StatsRatio operator()( StatsRatio const& x, StatsRatio const& y)
+	{
+		StatsRatio result = StatsRatio();
+
+		result.fN  = x.fN  + y.fN;
+		result.fA  = x.fA  + y.fA;
+		result.fB  = x.fB  + y.fB;
+		result.fAA = x.fAA + y.fAA;
+		result.fAB = x.fAB + y.fAB;
+		result.fBB = x.fBB + y.fBB;
+
+		return result;
+	}
+
+};
+
 }//namespace detail
 
 
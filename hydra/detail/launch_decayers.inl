@@ -46,10 +46,17 @@
 #include <hydra/detail/functors/EvalMothers.h>
 #include <hydra/detail/functors/AverageMother.h>
 #include <hydra/detail/functors/AverageMothers.h>
+#include <hydra/detail/functors/AverageMotherVR.h>
+#include <hydra/detail/functors/DecayChain.h>
+#include <hydra/detail/functors/DecayTable.h>
+#include <hydra/detail/functors/EvalTable.h>
+#include <hydra/detail/functors/AverageTable.h>
 
 #include <hydra/detail/utility/Utility_Tuple.h>
 
 #include <hydra/detail/external/thrust/iterator/counting_iterator.h>
+#include <hydra/detail/external/thrust/iterator/zip_iterator.h>
+#include <hydra/detail/external/thrust/for_each.h>
 #include <hydra/detail/external/thrust/sequence.h>
 #include <hydra/detail/external/thrust/tuple.h>
 #include <hydra/detail/external/thrust/transform.h>
@@ -107,6 +114,36 @@ namespace detail {
 	}
 
 
+	template<size_t N, hydra::detail::Backend BACKEND, typename FUNCTOR, typename GRND>
+	inline StatsRatio launch_reducer(hydra::detail::BackendPolicy<BACKEND>const& policy,
+			detail::AverageMotherVR<N, GRND,FUNCTOR>& evaluator)
+	{
+		HYDRA_EXTERNAL_NS::thrust::counting_iterator<GLong_t> first(0);
+		HYDRA_EXTERNAL_NS::thrust::counting_iterator<GLong_t> last = first + evaluator.GetNEvents();
+
+		StatsRatio init = StatsRatio();
+
+		if( evaluator.GetNReplicas() == 1 )
+			return HYDRA_EXTERNAL_NS::thrust::transform_reduce(policy , first, last,
+				evaluator, init, detail::AddStatsRatio() );
+
+		//each replica is one independent group
+		StatsRatio result = StatsRatio();
+
+		for(size_t replica=0; replica < evaluator.GetNReplicas(); replica++ ){
+
+			evaluator.SetReplica(replica);
+
+			StatsRatio partial = HYDRA_EXTERNAL_NS::thrust::transform_reduce(policy , first, last,
+					evaluator, init, detail::AddStatsRatio() );
+
+			result.AddGroup(partial.fA, partial.fB);
+		}
+
+		return result;
+	}
+
+
 	template<size_t N, typename FUNCTOR, typename GRND, typename Iterator>
 	inline StatsPHSP launch_reducer(Iterator begin, Iterator end,
 			detail::AverageMothers<N, GRND,FUNCTOR> const& evaluator)
@@ -214,6 +251,86 @@ namespace detail {
 
 
 
+	//-------------------------------
+
+	template<typename GRND, size_t ...N, typename Iterator>
+	inline void launch_decayer(Iterator begin, Iterator end, DecayChain<GRND, N...> const& decayer)
+	{
+
+		size_t nevents = HYDRA_EXTERNAL_NS::thrust::distance(begin, end);
+		HYDRA_EXTERNAL_NS::thrust::counting_iterator<GLong_t> first(0);
+		HYDRA_EXTERNAL_NS::thrust::counting_iterator<GLong_t> last = first + nevents;
+
+		HYDRA_EXTERNAL_NS::thrust::for_each(HYDRA_EXTERNAL_NS::thrust::make_zip_iterator(first, begin),
+				HYDRA_EXTERNAL_NS::thrust::make_zip_iterator(last, end), decayer);
+
+		return;
+	}
+
+	template<typename GRND, size_t ...N,	typename IteratorMother, typename Iterator>
+	inline void launch_decayer(IteratorMother mbegin, IteratorMother mend, Iterator begin,
+			DecayChain<GRND, N...> const& decayer)
+	{
+
+		size_t nevents = HYDRA_EXTERNAL_NS::thrust::distance(mbegin, mend);
+		HYDRA_EXTERNAL_NS::thrust::counting_iterator<GLong_t> first(0);
+		HYDRA_EXTERNAL_NS::thrust::counting_iterator<GLong_t> last = first + nevents;
+
+		HYDRA_EXTERNAL_NS::thrust::for_each(HYDRA_EXTERNAL_NS::thrust::make_zip_iterator(first, mbegin, begin),
+				HYDRA_EXTERNAL_NS::thrust::make_zip_iterator(last, mend, begin + nevents), decayer);
+
+		return;
+	}
+
+	//-------------------------------
+
+	template<size_t N, typename GRND, typename Iterator, hydra::detail::Backend BACKEND>
+	inline void launch_decayer( hydra::detail::BackendPolicy<BACKEND> const& exec_policy, size_t nevents,
+			Iterator begin, DecayTable<N, GRND> const& decayer)
+	{
+
+		HYDRA_EXTERNAL_NS::thrust::counting_iterator<GLong_t> first(0);
+		HYDRA_EXTERNAL_NS::thrust::counting_iterator<GLong_t> last = first + nevents;
+
+		auto begin_weights = HYDRA_EXTERNAL_NS::thrust::get<0>(begin.get_iterator_tuple());
+
+		auto begin_temp = hydra::detail::dropFirst( begin.get_iterator_tuple() );
+
+		auto begin_particles = HYDRA_EXTERNAL_NS::thrust::make_zip_iterator(begin_temp);
+
+		HYDRA_EXTERNAL_NS::thrust::transform(exec_policy, first, last, begin_particles, begin_weights, decayer);
+
+		return;
+	}
+
+	template<size_t N, typename FUNCTOR, typename ...FUNCTORS, typename GRND,
+	                   typename Iterator, hydra::detail::Backend BACKEND>
+	inline void launch_evaluator( hydra::detail::BackendPolicy<BACKEND> const& exec_policy, size_t nevents,
+			Iterator begin, detail::EvalTable<N, GRND,FUNCTOR, FUNCTORS...> const& evaluator) {
+
+		HYDRA_EXTERNAL_NS::thrust::counting_iterator<GLong_t> first(0);
+		HYDRA_EXTERNAL_NS::thrust::counting_iterator<GLong_t> last = first + nevents;
+
+		HYDRA_EXTERNAL_NS::thrust::transform(exec_policy, first, last, begin, evaluator);
+
+	}
+
+	template<size_t N, typename FUNCTOR, typename GRND, hydra::detail::Backend BACKEND>
+	inline StatsPHSP launch_reducer(hydra::detail::BackendPolicy<BACKEND>const& exec_policy, size_t nevents,
+			detail::AverageTable<N, GRND,FUNCTOR> const& evaluator)
+	{
+
+		HYDRA_EXTERNAL_NS::thrust::counting_iterator<GLong_t> first(0);
+		HYDRA_EXTERNAL_NS::thrust::counting_iterator<GLong_t> last = first + nevents;
+
+		StatsPHSP init = StatsPHSP();
+
+		StatsPHSP result = HYDRA_EXTERNAL_NS::thrust::transform_reduce(exec_policy, first, last,
+				evaluator, init,detail::AddStatsPHSP() );
+
+		return result;
+	}
+
 }// namespace detail
 
 
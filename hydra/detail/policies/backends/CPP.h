@@ -31,6 +31,8 @@
 
 #include <hydra/detail/Config.h>
 #include <hydra/detail/BackendPolicy.h>
+#include <hydra/detail/CachingPool.h>
+#include <hydra/detail/AlignedAllocator.h>
 #include <hydra/detail/external/thrust/system/cpp/detail/par.h>
 #include <hydra/detail/external/thrust/system/cpp/vector.h>
 
@@ -46,12 +48,15 @@ static const cpp_t    _cpp_;
 }  // namespace cpp
 
 template<>
-struct BackendPolicy<Backend::Cpp>: HYDRA_EXTERNAL_NS::thrust::execution_policy<cpp::cpp_t>
+struct BackendPolicy<Backend::Cpp>:
+	HYDRA_EXTERNAL_NS::thrust::system::cpp::detail::execution_policy<BackendPolicy<Backend::Cpp>>,
+	CachingPolicy<BackendPolicy<Backend::Cpp>, HYDRA_EXTERNAL_NS::thrust::system::cpp::tag>
 {
 	const cpp::cpp_t backend= cpp::_cpp_;
 
 	template<typename T>
-	using   container = HYDRA_EXTERNAL_NS::thrust::cpp::vector<T> ;
+	using   container = HYDRA_EXTERNAL_NS::thrust::cpp::vector<T,
+			hydra::detail::aligned_allocator_t<HYDRA_EXTERNAL_NS::thrust::cpp::allocator<T>>> ;
 
 
 };
@@ -31,6 +31,7 @@
 
 #include <hydra/detail/Config.h>
 #include <hydra/detail/BackendPolicy.h>
+#include <hydra/detail/CachingPool.h>
 #include <hydra/detail/external/thrust/system/cuda/detail/par.h>
 #include <hydra/detail/external/thrust/system/cuda/vector.h>
 
@@ -46,7 +47,9 @@ static const cuda_t    _cuda_;
 }  // namespace cuda
 
 template<>
-struct BackendPolicy<Backend::Cuda>: HYDRA_EXTERNAL_NS::thrust::execution_policy<cuda::cuda_t>
+struct BackendPolicy<Backend::Cuda>:
+	HYDRA_EXTERNAL_NS::thrust::system::cuda::detail::execution_policy<BackendPolicy<Backend::Cuda>>,
+	CachingPolicy<BackendPolicy<Backend::Cuda>, HYDRA_EXTERNAL_NS::thrust::system::cuda::tag>
 {
 	const cuda::cuda_t backend= cuda::_cuda_;
 
@@ -32,6 +32,7 @@
 
 #include <hydra/detail/Config.h>
 #include <hydra/detail/BackendPolicy.h>
+#include <hydra/detail/CachingPool.h>
 #include <hydra/detail/external/thrust/execution_policy.h>
 #include <hydra/Containers.h>
 
@@ -47,7 +48,9 @@ static const device_t   _device_;
 }  // namespace device
 
 template<>
-struct BackendPolicy<Backend::Device>: HYDRA_EXTERNAL_NS::thrust::device_execution_policy<device::device_t>
+struct BackendPolicy<Backend::Device>:
+	HYDRA_EXTERNAL_NS::thrust::device_execution_policy<BackendPolicy<Backend::Device>>,
+	CachingPolicy<BackendPolicy<Backend::Device>, HYDRA_EXTERNAL_NS::thrust::device_system_tag>
 {
 	const device::device_t backend= device::_device_;
 
@@ -31,6 +31,7 @@
 
 #include <hydra/detail/Config.h>
 #include <hydra/detail/BackendPolicy.h>
+#include <hydra/detail/CachingPool.h>
 #include <hydra/detail/external/thrust/execution_policy.h>
 #include <hydra/Containers.h>
 
@@ -47,7 +48,9 @@ static const host_t   _host_;
 
 
 template<>
-struct BackendPolicy<Backend::Host>: HYDRA_EXTERNAL_NS::thrust::host_execution_policy<host::host_t>
+struct BackendPolicy<Backend::Host>:
+	HYDRA_EXTERNAL_NS::thrust::host_execution_policy<BackendPolicy<Backend::Host>>,
+	CachingPolicy<BackendPolicy<Backend::Host>, HYDRA_EXTERNAL_NS::thrust::host_system_tag>
 {
 	const host::host_t backend= host::_host_;
 
@@ -31,8 +31,12 @@
 
 #include <hydra/detail/Config.h>
 #include <hydra/detail/BackendPolicy.h>
+#include <hydra/detail/CachingPool.h>
+#include <hydra/detail/FirstTouchAllocator.h>
+#include <hydra/detail/AlignedAllocator.h>
 #include <hydra/detail/external/thrust/system/omp/detail/par.h>
 #include <hydra/detail/external/thrust/system/omp/vector.h>
+#include <hydra/detail/external/thrust/system/omp/detail/policy_settings.h>
 
 namespace hydra {
 
@@ -46,13 +50,71 @@ static const omp_t    _omp_;
 }  // namespace omp
 
 template<>
-struct BackendPolicy<Backend::Omp>: HYDRA_EXTERNAL_NS::thrust::execution_policy<omp::omp_t>
+struct BackendPolicy<Backend::Omp>:
+	HYDRA_EXTERNAL_NS::thrust::system::omp::detail::execution_policy<BackendPolicy<Backend::Omp>>,
+	CachingPolicy<BackendPolicy<Backend::Omp>, HYDRA_EXTERNAL_NS::thrust::system::omp::tag>
 {
 	const omp::omp_t backend= omp::_omp_;
 
+#ifdef HYDRA_FIRST_TOUCH_ALLOCATION
 	template<typename T>
-	using   container = HYDRA_EXTERNAL_NS::thrust::omp::vector<T> ;
-
+	using   container = HYDRA_EXTERNAL_NS::thrust::omp::vector<T,
+			hydra::detail::FirstTouchAllocator<
+				hydra::detail::aligned_allocator_t<HYDRA_EXTERNAL_NS::thrust::omp::allocator<T>>>> ;
+#else
+	template<typename T>
+	using   container = HYDRA_EXTERNAL_NS::thrust::omp::vector<T,
+			hydra::detail::aligned_allocator_t<HYDRA_EXTERNAL_NS::thrust::omp::allocator<T>>> ;
+#endif
+
+	BackendPolicy():
+		fThreads(0),
+		fGrain(0)
+	{}
+
+	/**
+	 * Policy limiting the parallel regions of the calls it is passed to, e.g.
+	 * `hydra::omp::sys_t(4, 1024)`. Concurrent pipelines can share the machine
+	 * without oversubscription. The thread affinity follows OMP_PROC_BIND and OMP_PLACES.
+	 * @param threads number of threads of each parallel region, 0 for the OpenMP default (omp_get_max_threads()).
+	 * @param grain iterations per chunk of the parallel loops, which are then scheduled dynamically;
+	 * 0 for the static schedule.
+	 */
+	explicit BackendPolicy(int threads, size_t grain=0):
+		fThreads(threads),
+		fGrain(grain)
+	{}
+
+	BackendPolicy(BackendPolicy<Backend::Omp> const& other):
+		HYDRA_EXTERNAL_NS::thrust::system::omp::detail::execution_policy<BackendPolicy<Backend::Omp>>(other),
+		CachingPolicy<BackendPolicy<Backend::Omp>, HYDRA_EXTERNAL_NS::thrust::system::omp::tag>(other),
+		fThreads(other.GetThreads()),
+		fGrain(other.GetGrain())
+	{}
+
+	inline int GetThreads() const {
+		return fThreads;
+	}
+
+	inline size_t GetGrain() const {
+		return fGrain;
+	}
+
+	friend inline int omp_policy_num_threads(BackendPolicy<Backend::Omp> const& policy)
+	{
+		return policy.GetThreads() > 0 ? policy.GetThreads() :
+				HYDRA_EXTERNAL_NS::thrust::system::omp::detail::omp_policy_num_threads(omp::_omp_);
+	}
+
+	friend inline size_t omp_policy_grain_size(BackendPolicy<Backend::Omp> const& policy)
+	{
+		return policy.GetGrain();
+	}
+
+private:
+
+	int    fThreads;
+	size_t fGrain;
 };
 
 }  // namespace detail
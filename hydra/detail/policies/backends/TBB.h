@@ -31,8 +31,13 @@
 
 #include <hydra/detail/Config.h>
 #include <hydra/detail/BackendPolicy.h>
+#include <hydra/detail/CachingPool.h>
+#include <hydra/detail/FirstTouchAllocator.h>
+#include <hydra/detail/AlignedAllocator.h>
 #include <hydra/detail/external/thrust/system/tbb/detail/par.h>
 #include <hydra/detail/external/thrust/system/tbb/vector.h>
+#include <hydra/detail/external/thrust/system/tbb/detail/policy_settings.h>
+#include <tbb/task_arena.h>
 
 namespace hydra {
 
@@ -47,13 +52,73 @@ static const tbb_t    _tbb_;
 }  // namespace tbb
 
 template<>
-struct BackendPolicy<Backend::Tbb>: HYDRA_EXTERNAL_NS::thrust::execution_policy<tbb::tbb_t>
+struct BackendPolicy<Backend::Tbb>:
+	HYDRA_EXTERNAL_NS::thrust::system::tbb::detail::execution_policy<BackendPolicy<Backend::Tbb>>,
+	CachingPolicy<BackendPolicy<Backend::Tbb>, HYDRA_EXTERNAL_NS::thrust::system::tbb::tag>
 {
 	const tbb::tbb_t backend= tbb::_tbb_;
 
+#ifdef HYDRA_FIRST_TOUCH_ALLOCATION
 	template<typename T>
-	using   container = HYDRA_EXTERNAL_NS::thrust::tbb::vector<T> ;
-
+	using   container = HYDRA_EXTERNAL_NS::thrust::tbb::vector<T,
+			hydra::detail::FirstTouchAllocator<
+				hydra::detail::aligned_allocator_t<HYDRA_EXTERNAL_NS::thrust::tbb::allocator<T>>>> ;
+#else
+	template<typename T>
+	using   container = HYDRA_EXTERNAL_NS::thrust::tbb::vector<T,
+			hydra::detail::aligned_allocator_t<HYDRA_EXTERNAL_NS::thrust::tbb::allocator<T>>> ;
+#endif
+
+	BackendPolicy():
+		fArena(0),
+		fGrain(1)
+	{}
+
+	/**
+	 * Policy running the calls it is passed to inside a task arena, e.g.
+	 * `hydra::tbb::sys_t(arena)`. Pipelines running concurrently with policies on
+	 * different arenas share the cores as set by the concurrency of each arena
+	 * (and its constraints, e.g. NUMA node, with oneTBB), instead of oversubscribing them.
+	 * The arena is not owned by the policy and must outlive its use.
+	 * @param arena task arena.
+	 * @param grain grain size of the ::tbb::blocked_range of the parallel loops.
+	 */
+	explicit BackendPolicy(::tbb::task_arena& arena, size_t grain=1):
+		fArena(&arena),
+		fGrain(grain)
+	{}
+
+	BackendPolicy(BackendPolicy<Backend::Tbb> const& other):
+		HYDRA_EXTERNAL_NS::thrust::system::tbb::detail::execution_policy<BackendPolicy<Backend::Tbb>>(other),
+		CachingPolicy<BackendPolicy<Backend::Tbb>, HYDRA_EXTERNAL_NS::thrust::system::tbb::tag>(other),
+		fArena(other.GetArena()),
+		fGrain(other.GetGrain())
+	{}
+
+	inline ::tbb::task_arena* GetArena() const {
+		return fArena;
+	}
+
+	inline size_t GetGrain() const {
+		return fGrain;
+	}
+
+	template<typename Function>
+	friend inline void tbb_policy_execute(BackendPolicy<Backend::Tbb> const& policy, Function& f)
+	{
+		if(policy.GetArena()) policy.GetArena()->execute(f);
+		else f();
+	}
+
+	friend inline size_t tbb_policy_grain_size(BackendPolicy<Backend::Tbb> const& policy)
+	{
+		return policy.GetGrain();
+	}
+
+private:
+
+	::tbb::task_arena* fArena;
+	size_t fGrain;
 };
 
 }  // namespace detail
@@ -434,14 +434,14 @@ namespace hydra {
 	 __hydra_host__  __hydra_device__
 	 inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<I == (sizeof...(OtherTypes) + 1) &&
 	              are_all_same<FistType,OtherTypes...>::value, void>::type
-	 tupleToArray(HYDRA_EXTERNAL_NS::thrust::tuple<FistType, OtherTypes...> const &,  typename std::remove_reference<FistType>::type*)
+	 tupleToArray(HYDRA_EXTERNAL_NS::thrust::tuple<FistType, OtherTypes...> const &,  typename std::remove_const<typename std::remove_reference<FistType>::type>::type*)
 	 {}
 
 	 template<size_t I = 0, typename FistType, typename ...OtherTypes>
 	 __hydra_host__  __hydra_device__
 	 inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I < sizeof...(OtherTypes)+1) &&
 	           are_all_same<FistType,OtherTypes...>::value, void >::type
-	 tupleToArray(HYDRA_EXTERNAL_NS::thrust::tuple<FistType, OtherTypes...> const & t,  typename std::remove_reference<FistType>::type* Array)
+	 tupleToArray(HYDRA_EXTERNAL_NS::thrust::tuple<FistType, OtherTypes...> const & t,  typename std::remove_const<typename std::remove_reference<FistType>::type>::type* Array)
 	 {
 
 		 Array[I] = HYDRA_EXTERNAL_NS::thrust::get<I>(t);
@@ -657,6 +657,26 @@ namespace hydra {
 	 }
 
 
+	 //----------------------------------------------------------
+	 // given a tuple of functors, evaluate all elements
+	 // taking as argument ArgType const& arg and
+	 // store the results in the array r
+	 template<size_t I = 0, typename Return_Type, typename ArgType, typename Tup>
+	 __hydra_host__  __hydra_device__
+	 inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<I == HYDRA_EXTERNAL_NS::thrust::tuple_size<Tup>::value, void>::type
+	 eval_tuple_to_array(Return_Type* , Tup&, ArgType const&)
+	 {}
+
+	 template<size_t I = 0, typename Return_Type, typename ArgType, typename Tup>
+	 __hydra_host__  __hydra_device__
+	 inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I < HYDRA_EXTERNAL_NS::thrust::tuple_size<Tup>::value), void >::type
+	 eval_tuple_to_array(Return_Type* r, Tup& t, ArgType const& arg)
+	 {
+		 r[I] = (Return_Type) HYDRA_EXTERNAL_NS::thrust::get<I>(t)(arg);
+		 eval_tuple_to_array<I + 1, Return_Type, ArgType, Tup>( r , t, arg);
+	 }
+
+
 	 //----------------------------------------------------------
 	 // given a tuple of functors, evaluate and multiply
 	 // element taking as argument ArgType &
@@ -90,6 +90,23 @@ public:
 
 	}
 
+	/**
+	 * Value and derivatives with respect to the mean and the sigma, used by
+	 * the integrators to calculate the gradient of the normalization.
+	 */
+	template<typename T>
+	__hydra_host__ __hydra_device__ inline
+	double ParameterGradient(unsigned int, T*x, double* gradient)  const	{
+		double d  = x[ArgIndex] - _par[0];
+		double s2 = _par[1]*_par[1];
+		double f  = exp(-d*d/(2.0 * s2 ));
+
+		gradient[0] = f*d/s2;
+		gradient[1] = f*d*d/(s2*_par[1]);
+
+		return f;
+	}
+
 };
 
 class GaussianAnalyticalIntegral: public Integrator<GaussianAnalyticalIntegral>
@@ -32,10 +32,13 @@
 #include <array>
 #include <hydra/detail/Config.h>
 #include <hydra/detail/BackendPolicy.h>
+#include <hydra/detail/FirstTouchAllocator.h>
+#include <hydra/detail/Rebind.h>
 #include <hydra/detail/utility/Utility_Tuple.h>
 #include <hydra/detail/functors/Caster.h>
 #include <hydra/Tuple.h>
 #include <hydra/Placeholders.h>
+#include <hydra/GenericRange.h>
 #include <hydra/detail/external/thrust/iterator/zip_iterator.h>
 #include <hydra/detail/external/thrust/iterator/iterator_traits.h>
 #include <hydra/detail/external/thrust/tuple.h>
@@ -150,6 +153,12 @@ public:
 		HYDRA_EXTERNAL_NS::thrust::copy(other.begin(), other.end(), begin());
 	}
 
+	template< hydra::detail::Backend BACKEND2>
+	multiarray(multiarray<T,N,detail::BackendPolicy<BACKEND2>>&& other )
+	{
+		__move_from(other, detail::is_rebindable<detail::BackendPolicy<BACKEND2>, system_t>{});
+	}
+
 	template< typename Iterator>
 	multiarray(Iterator first, Iterator last )
 	{
@@ -185,6 +194,14 @@ public:
 		return *this;
 	}
 
+	template< hydra::detail::Backend BACKEND2>
+	multiarray<T,N,detail::BackendPolicy<BACKEND> >&
+	operator=(multiarray<T,N,detail::BackendPolicy<BACKEND2> >&& other )
+	{
+		__move_from(other, detail::is_rebindable<detail::BackendPolicy<BACKEND2>, system_t>{});
+		return *this;
+	}
+
 
 	inline void pop_back()
 	{
@@ -238,6 +255,15 @@ public:
 		this->__reserve(size);
 	}
 
+	/**
+	 * Resize to exactly size elements, moving each column to new storage, so that the pages of the
+	 * columns are mapped by the threads processing them on NUMA machines (see multivector::numa_resize).
+	 */
+	inline void numa_resize(size_type size)
+	{
+		this->__numa_resize(size);
+	}
+
 	inline iterator erase(iterator pos)
 	{
 		size_type position = HYDRA_EXTERNAL_NS::thrust::distance(begin(), pos);
@@ -651,6 +677,25 @@ public:
 
 private:
 
+	template<typename T2, size_t N2, typename BACKEND2>
+	friend class multiarray;
+
+	//__________________________________________
+	// move from other backends
+	template<typename Other>
+	inline void __move_from(Other& other, std::true_type)
+	{
+		for( size_t i=0; i<N; i++)
+			detail::adopt_storage(fData[i], other.fData[i]);
+	}
+
+	template<typename Other>
+	inline void __move_from(Other& other, std::false_type)
+	{
+		__resize(other.size());
+		HYDRA_EXTERNAL_NS::thrust::copy(other.begin(), other.end(), begin());
+	}
+
 	//__________________________________________
 	// caster accessors
 	template<typename Functor>
@@ -764,6 +809,20 @@ private:
 		__reserve<I + 1>(size);
 	}
 
+	//__________________________________________
+	// numa_resize
+	template<size_t I>
+	 inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I == N), void >::type
+	__numa_resize(size_type ){}
+
+	template<size_t I=0>
+	 inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I < N), void >::type
+	__numa_resize(size_type n )
+	{
+		detail::first_touch_resize(std::get<I>(fData), n);
+		__numa_resize<I + 1>(n);
+	}
+
 	//__________________________________________
 	// erase
 	template<size_t I>
@@ -1214,6 +1273,54 @@ private:
 };
 
 
+/**
+ * Move the columns of a multiarray to a multiarray of the backend BACKEND2 without copying,
+ * e.g. `hydra::rebind<hydra::omp::sys_t>(std::move(data))`. The allocators of the two backends
+ * must share the memory resource (hydra::detail::is_rebindable). \p other is left empty.
+ */
+template<typename BACKEND2, hydra::detail::Backend BACKEND, typename T, size_t N>
+inline multiarray<T, N, BACKEND2>
+rebind(multiarray<T, N, detail::BackendPolicy<BACKEND>>&& other )
+{
+	static_assert( detail::is_rebindable<detail::BackendPolicy<BACKEND>, BACKEND2>::value,
+			"[Hydra::rebind] : the containers of the two backends do not share the memory resource.");
+
+	return multiarray<T, N, BACKEND2>(std::move(other));
+}
+
+/**
+ * Non-owning range over the columns of a multiarray, with the iterators of a multiarray
+ * of the backend BACKEND2. Both backends must allocate in host memory (hydra::detail::is_host_backend).
+ * The range is invalidated by the operations invalidating the iterators of \p other.
+ */
+template<typename BACKEND2, hydra::detail::Backend BACKEND, typename T, size_t N>
+inline GenericRange<typename multiarray<T, N, BACKEND2>::iterator>
+rebind_view(multiarray<T, N, detail::BackendPolicy<BACKEND>>& other )
+{
+	typedef typename multiarray<T, N, BACKEND2>::iterator iterator;
+
+	static_assert( detail::is_host_backend<detail::BackendPolicy<BACKEND>>::value &&
+			detail::is_host_backend<BACKEND2>::value,
+			"[Hydra::rebind_view] : the containers of both backends must be allocated in host memory.");
+
+	return make_range( detail::rebind_iterator<iterator>(other.begin()),
+			detail::rebind_iterator<iterator>(other.end()) );
+}
+
+template<typename BACKEND2, hydra::detail::Backend BACKEND, typename T, size_t N>
+inline GenericRange<typename multiarray<T, N, BACKEND2>::const_iterator>
+rebind_view(multiarray<T, N, detail::BackendPolicy<BACKEND>> const& other )
+{
+	typedef typename multiarray<T, N, BACKEND2>::const_iterator iterator;
+
+	static_assert( detail::is_host_backend<detail::BackendPolicy<BACKEND>>::value &&
+			detail::is_host_backend<BACKEND2>::value,
+			"[Hydra::rebind_view] : the containers of both backends must be allocated in host memory.");
+
+	return make_range( detail::rebind_iterator<iterator>(other.begin()),
+			detail::rebind_iterator<iterator>(other.end()) );
+}
+
 template<unsigned int I,  hydra::detail::Backend BACKEND, typename T, size_t N>
 inline auto
 get(multiarray<T,N, detail::BackendPolicy<BACKEND>> const& other  )
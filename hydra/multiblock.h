@@ -0,0 +1,949 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * multiblock.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+/**
+ * \file
+ * \ingroup generic
+ */
+
+#ifndef MULTIBLOCK_H_
+#define MULTIBLOCK_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/BackendPolicy.h>
+#include <hydra/detail/FirstTouchAllocator.h>
+#include <hydra/detail/Rebind.h>
+#include <hydra/detail/BlockIterator.h>
+#include <hydra/detail/utility/Generic.h>
+#include <hydra/detail/FunctorTraits.h>
+#include <hydra/Tuple.h>
+#include <hydra/Placeholders.h>
+#include <hydra/GenericRange.h>
+#include <hydra/detail/external/thrust/copy.h>
+#include <hydra/detail/external/thrust/fill.h>
+#include <hydra/detail/external/thrust/distance.h>
+#include <hydra/detail/external/thrust/logical.h>
+#include <hydra/detail/external/thrust/tuple.h>
+#include <hydra/detail/external/thrust/iterator/zip_iterator.h>
+#include <hydra/detail/external/thrust/iterator/reverse_iterator.h>
+#include <hydra/detail/external/thrust/iterator/iterator_traits.h>
+#include <hydra/detail/external/thrust/iterator/transform_iterator.h>
+#include <hydra/detail/external/thrust/detail/raw_pointer_cast.h>
+
+#include <type_traits>
+#include <algorithm>
+
+namespace hydra {
+
+namespace detail {
+
+/*
+ * Number of bytes of one row of the columns T...
+ */
+template<typename ...T>
+struct block_row_size;
+
+template<>
+struct block_row_size<>: std::integral_constant<size_t, 0>{};
+
+template<typename Head, typename ...Tail>
+struct block_row_size<Head, Tail...>:
+	std::integral_constant<size_t, sizeof(Head) + block_row_size<Tail...>::value>{};
+
+/*
+ * Position of the column I in a row of the columns T...
+ */
+template<size_t I, typename ...T>
+struct block_column_offset;
+
+template<typename Head, typename ...Tail>
+struct block_column_offset<0, Head, Tail...>: std::integral_constant<size_t, 0>{};
+
+template<size_t I, typename Head, typename ...Tail>
+struct block_column_offset<I, Head, Tail...>:
+	std::integral_constant<size_t, sizeof(Head) + block_column_offset<I-1, Tail...>::value>{};
+
+/*
+ * Largest alignment of the columns T...
+ */
+template<typename ...T>
+struct block_alignment;
+
+template<>
+struct block_alignment<>: std::integral_constant<size_t, 1>{};
+
+template<typename Head, typename ...Tail>
+struct block_alignment<Head, Tail...>: std::integral_constant<size_t,
+	(alignof(Head) > block_alignment<Tail...>::value) ? alignof(Head) : block_alignment<Tail...>::value>{};
+
+/*
+ * True if the W values of each column, stored one column after the other
+ * from the position Offset of a block, are aligned.
+ */
+template<size_t W, size_t Offset, typename ...T>
+struct block_columns_aligned;
+
+template<size_t W, size_t Offset>
+struct block_columns_aligned<W, Offset>: std::true_type{};
+
+template<size_t W, size_t Offset, typename Head, typename ...Tail>
+struct block_columns_aligned<W, Offset, Head, Tail...>: std::integral_constant<bool,
+	(Offset % alignof(Head) == 0) && block_columns_aligned<W, Offset + W*sizeof(Head), Tail...>::value>{};
+
+/*
+ * Storage of W rows of the columns T...: the W values of the first column,
+ * then the W values of the second, and so on.
+ */
+template<size_t W, typename ...T>
+struct alignas(block_alignment<T...>::value) Block
+{
+	unsigned char fBytes[W*block_row_size<T...>::value];
+};
+
+}  // namespace detail
+
+template<typename T, size_t W, typename BACKEND>
+class multiblock;
+
+/**
+ * \ingroup generic
+ *
+ * \brief This class implements storage in AoSoA layout: the table is stored as an array of blocks of W rows,
+ * each block holding the W values of the first column, then the W values of the second column, and so on.
+ *
+ * A row is read from a single block, instead of one array per column as in hydra::multivector, so that the
+ * number of memory streams accessed by the algorithms processing all the columns does not grow with the number
+ * of columns, while the W values of each column in a block are contiguous. hydra::multiblock has the iterator
+ * and column interface of hydra::multivector: the iterators are zip iterators of the columns, which can be
+ * selected with placeholders, e.g. `data.begin(_1)`, and converted with a caster, e.g. `data.begin(caster)`.
+ *
+ * \warning Experimental: the iterators compute the block and the lane of each access, which costs more than
+ * the pointer increments of hydra::multivector, and no algorithm of Hydra processes the blocks as a whole yet.
+ *
+ * \tparam T hydra::tuple of the types of the columns.
+ * \tparam W number of rows in each block. The values of each column must be aligned in the blocks, which is
+ * the case if W is a multiple of the alignment of the columns.
+ * \tparam BACKEND memory space of the storage.
+ */
+template<typename ...T, size_t W, hydra::detail::Backend BACKEND>
+class multiblock< HYDRA_EXTERNAL_NS::thrust::tuple<T...>, W, hydra::detail::BackendPolicy<BACKEND>>
+{
+	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
+
+	static_assert(W > 0, "[Hydra::multiblock] : the width of the blocks must be positive.");
+
+	static_assert(sizeof...(T) > 0, "[Hydra::multiblock] : the table must have at least one column.");
+
+	static_assert(detail::block_columns_aligned<W, 0, T...>::value,
+			"[Hydra::multiblock] : the columns are not aligned in the blocks, use a width multiple of their alignment.");
+
+public:
+
+	constexpr static size_t width = W;
+
+	typedef detail::Block<W, T...> block_type;
+	typedef typename system_t::template container<block_type> storage_t;
+
+private:
+
+	typedef typename HYDRA_EXTERNAL_NS::thrust::iterator_system<
+			typename storage_t::iterator>::type memory_system_t;
+
+	//column iterators
+	template<typename Type>
+	using iterator_v = detail::BlockIterator<Type, W, sizeof(block_type), memory_system_t>;
+
+	template<typename Type>
+	using const_iterator_v = detail::BlockIterator<const Type, W, sizeof(block_type), memory_system_t>;
+
+	template<typename Type>
+	using reverse_iterator_v = HYDRA_EXTERNAL_NS::thrust::reverse_iterator<iterator_v<Type>>;
+
+	template<typename Type>
+	using const_reverse_iterator_v = HYDRA_EXTERNAL_NS::thrust::reverse_iterator<const_iterator_v<Type>>;
+
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<T...> tuple_type;
+
+public:
+
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple< iterator_v<T>...   >              iterator_t;
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple< const_iterator_v<T>...  >         const_iterator_t;
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple< reverse_iterator_v<T>...>         reverse_iterator_t;
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple< const_reverse_iterator_v<T>... >  const_reverse_iterator_t;
+
+	//zipped iterators
+	typedef HYDRA_EXTERNAL_NS::thrust::zip_iterator<iterator_t>                 iterator;
+	typedef HYDRA_EXTERNAL_NS::thrust::zip_iterator<const_iterator_t>           const_iterator;
+	typedef HYDRA_EXTERNAL_NS::thrust::zip_iterator<reverse_iterator_t>         reverse_iterator;
+	typedef HYDRA_EXTERNAL_NS::thrust::zip_iterator<const_reverse_iterator_t>   const_reverse_iterator;
+
+	//stl-like typedefs
+	typedef size_t size_type;
+	typedef typename HYDRA_EXTERNAL_NS::thrust::iterator_traits<iterator>::difference_type difference_type;
+	typedef typename HYDRA_EXTERNAL_NS::thrust::iterator_traits<iterator>::reference reference;
+	typedef typename HYDRA_EXTERNAL_NS::thrust::iterator_traits<const_iterator>::reference const_reference;
+	typedef typename HYDRA_EXTERNAL_NS::thrust::iterator_traits<iterator>::value_type value_type;
+	typedef typename HYDRA_EXTERNAL_NS::thrust::iterator_traits<iterator>::iterator_category iterator_category;
+
+	//cast iterators
+	template<typename Functor>
+	using caster_iterator = HYDRA_EXTERNAL_NS::thrust::transform_iterator< Functor,
+			iterator, typename std::result_of<Functor(tuple_type&)>::type >;
+
+	template<typename Functor>
+	using caster_reverse_iterator = HYDRA_EXTERNAL_NS::thrust::transform_iterator< Functor,
+			reverse_iterator, typename std::result_of<Functor(tuple_type&)>::type >;
+
+	//selected columns
+	template<typename Iterators,  unsigned int I1, unsigned int I2,unsigned int ...IN>
+	using columns_iterator = HYDRA_EXTERNAL_NS::thrust::zip_iterator< HYDRA_EXTERNAL_NS::thrust::tuple<
+			typename HYDRA_EXTERNAL_NS::thrust::tuple_element< I1, Iterators >::type,
+			typename HYDRA_EXTERNAL_NS::thrust::tuple_element< I2, Iterators >::type,
+			typename HYDRA_EXTERNAL_NS::thrust::tuple_element< IN, Iterators >::type...> >;
+
+	/**
+	 * Default constructor. This constructor creates an empty \p multiblock.
+	 */
+	multiblock():
+		fData(),
+		fSize(0)
+	{}
+
+	/**
+	 * Constructor initializing the multiblock with \p n entries.
+	 * @param n The number of elements to initially create.
+	 */
+	multiblock(size_t n):
+		fData(),
+		fSize(0)
+	{
+		__resize(n);
+	}
+
+	/**
+	 * Constructor initializing the multiblock with \p n copies of \p value .
+	 * @param n number of elements
+	 * @param value value to be copied
+	 */
+	multiblock(size_t n, value_type const& value):
+		fData(),
+		fSize(0)
+	{
+		__resize(n);
+		HYDRA_EXTERNAL_NS::thrust::fill(begin(), end(), value);
+	}
+
+	/**
+	 * Copy constructor
+	 * @param other
+	 */
+	multiblock(multiblock<tuple_type, W, system_t> const& other):
+		fData(other.__data()),
+		fSize(other.size())
+	{}
+
+	/**
+	 * Move constructor
+	 * @param other
+	 */
+	multiblock(multiblock<tuple_type, W, system_t>&& other):
+		fData(other.__move()),
+		fSize(other.size())
+	{
+		other.fSize = 0;
+	}
+
+	/**
+	 * Copy constructor from a multiblock allocated in a different backend. The blocks are copied as they are.
+	 * @param other
+	 */
+	template< hydra::detail::Backend BACKEND2>
+	multiblock(multiblock<tuple_type, W, detail::BackendPolicy<BACKEND2>> const& other):
+		fData(),
+		fSize(0)
+	{
+		__copy_from(other);
+	}
+
+	/**
+	 * Move constructor from a multiblock allocated in a different backend. If the allocators
+	 * of the two backends share the memory resource (hydra::detail::is_rebindable), the storage
+	 * of \p other is handed over without copying. Otherwise the blocks are copied.
+	 * @param other
+	 */
+	template< hydra::detail::Backend BACKEND2>
+	multiblock(multiblock<tuple_type, W, detail::BackendPolicy<BACKEND2>>&& other):
+		fData(),
+		fSize(0)
+	{
+		__move_from(other, detail::is_rebindable<detail::BackendPolicy<BACKEND2>, system_t>{});
+	}
+
+	/**
+	 * Copy the rows in the range [first, last), e.g. from a hydra::multivector.
+	 */
+	template< typename Iterator>
+	multiblock(Iterator first, Iterator last):
+		fData(),
+		fSize(0)
+	{
+		__resize( HYDRA_EXTERNAL_NS::thrust::distance(first, last) );
+		HYDRA_EXTERNAL_NS::thrust::copy(first, last, begin());
+	}
+
+	/**
+	 * Assignment operator
+	 * @param other
+	 * @return
+	 */
+	multiblock<tuple_type, W, system_t>&
+	operator=(multiblock<tuple_type, W, system_t> const& other)
+	{
+		if(this==&other) return *this;
+
+		fData = other.__data();
+		fSize = other.size();
+
+		return *this;
+	}
+
+	/**
+	 * Move-assignment operator
+	 * @param other
+	 * @return
+	 */
+	multiblock<tuple_type, W, system_t>&
+	operator=(multiblock<tuple_type, W, system_t>&& other)
+	{
+		if(this==&other) return *this;
+
+		fData = other.__move();
+		fSize = other.size();
+		other.fSize = 0;
+
+		return *this;
+	}
+
+	/**
+	 * Assignment operator for multiblocks allocated in different backends.
+	 * @param other
+	 * @return
+	 */
+	template< hydra::detail::Backend BACKEND2>
+	multiblock<tuple_type, W, system_t>&
+	operator=(multiblock<tuple_type, W, detail::BackendPolicy<BACKEND2>> const& other)
+	{
+		__copy_from(other);
+
+		return *this;
+	}
+
+	/**
+	 * Move-assignment operator for multiblocks allocated in different backends,
+	 * handing over the storage of \p other without copying when possible.
+	 * @param other
+	 * @return
+	 */
+	template< hydra::detail::Backend BACKEND2>
+	multiblock<tuple_type, W, system_t>&
+	operator=(multiblock<tuple_type, W, detail::BackendPolicy<BACKEND2>>&& other)
+	{
+		__move_from(other, detail::is_rebindable<detail::BackendPolicy<BACKEND2>, system_t>{});
+
+		return *this;
+	}
+
+	inline void pop_back()
+	{
+		__resize(fSize - 1);
+	}
+
+	inline void	push_back(value_type const& value)
+	{
+		__resize(fSize + 1);
+		begin()[fSize - 1] = value;
+	}
+
+	template<typename Functor, typename Obj>
+	inline void	push_back(Functor  const& functor, Obj const& obj)
+	{
+		push_back( functor(obj) );
+	}
+
+	inline size_type size() const
+	{
+		return fSize;
+	}
+
+	inline size_type capacity() const
+	{
+		return fData.capacity()*W;
+	}
+
+	inline bool empty() const
+	{
+		return fSize == 0;
+	}
+
+	inline void resize(size_type size)
+	{
+		__resize(size);
+	}
+
+	inline void clear()
+	{
+		fData.clear();
+		fSize = 0;
+	}
+
+	inline void shrink_to_fit()
+	{
+		fData.shrink_to_fit();
+	}
+
+	inline void reserve(size_type size)
+	{
+		fData.reserve( __nblocks(size) );
+	}
+
+	/**
+	 * Resize to exactly size elements, moving the blocks to new storage, so that their pages
+	 * are mapped by the threads processing them on NUMA machines (see multivector::numa_resize).
+	 */
+	inline void numa_resize(size_type size)
+	{
+		size_type old_size = fSize;
+
+		detail::first_touch_resize(fData, __nblocks(size));
+		fSize = size;
+
+		__clear_tail(old_size);
+	}
+
+	inline iterator erase(iterator pos)
+	{
+		size_type position = HYDRA_EXTERNAL_NS::thrust::distance(begin(), pos);
+
+		return __erase(position, position + 1);
+	}
+
+	inline iterator erase(iterator first, iterator last)
+	{
+		size_type first_position = HYDRA_EXTERNAL_NS::thrust::distance(begin(), first);
+		size_type last_position  = HYDRA_EXTERNAL_NS::thrust::distance(begin(), last);
+
+		return __erase(first_position, last_position);
+	}
+
+	inline iterator insert(iterator pos, const value_type &x)
+	{
+		size_type position = HYDRA_EXTERNAL_NS::thrust::distance(begin(), pos);
+
+		__insert(position, 1, x);
+
+		return begin() + position;
+	}
+
+	inline void insert(iterator pos, size_type n, const value_type &x)
+	{
+		size_type position = HYDRA_EXTERNAL_NS::thrust::distance(begin(), pos);
+
+		__insert(position, n, x);
+	}
+
+	template< typename InputIterator>
+	inline void insert(iterator pos, InputIterator first, InputIterator last)
+	{
+		size_type position = HYDRA_EXTERNAL_NS::thrust::distance(begin(), pos);
+		size_type n        = HYDRA_EXTERNAL_NS::thrust::distance(first, last);
+
+		multiblock<tuple_type, W, system_t> tail(begin() + position, end());
+
+		__resize(fSize + n);
+		HYDRA_EXTERNAL_NS::thrust::copy(first, last, begin() + position);
+		HYDRA_EXTERNAL_NS::thrust::copy(tail.begin(), tail.end(), begin() + position + n);
+	}
+
+	inline reference front()
+	{
+		return *begin();
+	}
+
+	inline const_reference front() const
+	{
+		return *cbegin();
+	}
+
+	inline reference back()
+	{
+		return *(end()-1);
+	}
+
+	inline const_reference back() const
+	{
+		return *(cend()-1);
+	}
+
+	//non-constant access
+	inline iterator begin()
+	{
+		return iterator( __columns(0, detail::make_index_sequence<sizeof...(T)>{}) );
+	}
+
+	inline iterator end()
+	{
+		return iterator( __columns(fSize, detail::make_index_sequence<sizeof...(T)>{}) );
+	}
+
+	inline reverse_iterator rbegin()
+	{
+		return reverse_iterator( __reverse_columns(fSize, detail::make_index_sequence<sizeof...(T)>{}) );
+	}
+
+	inline reverse_iterator rend()
+	{
+		return reverse_iterator( __reverse_columns(0, detail::make_index_sequence<sizeof...(T)>{}) );
+	}
+
+	//constant access
+	inline const_iterator begin() const
+	{
+		return cbegin();
+	}
+
+	inline const_iterator end() const
+	{
+		return cend();
+	}
+
+	inline const_reverse_iterator rbegin() const
+	{
+		return crbegin();
+	}
+
+	inline const_reverse_iterator rend() const
+	{
+		return crend();
+	}
+
+	inline const_iterator cbegin() const
+	{
+		return const_iterator( __columns(0, detail::make_index_sequence<sizeof...(T)>{}) );
+	}
+
+	inline const_iterator cend() const
+	{
+		return const_iterator( __columns(fSize, detail::make_index_sequence<sizeof...(T)>{}) );
+	}
+
+	inline const_reverse_iterator crbegin() const
+	{
+		return const_reverse_iterator( __reverse_columns(fSize, detail::make_index_sequence<sizeof...(T)>{}) );
+	}
+
+	inline const_reverse_iterator crend() const
+	{
+		return const_reverse_iterator( __reverse_columns(0, detail::make_index_sequence<sizeof...(T)>{}) );
+	}
+
+	//converting access
+	template<typename Functor>
+	inline caster_iterator<Functor> begin( Functor const& caster )
+	{
+		return caster_iterator<Functor>(begin(), caster);
+	}
+
+	template<typename Functor>
+	inline caster_iterator<Functor> end( Functor const& caster )
+	{
+		return caster_iterator<Functor>(end(), caster);
+	}
+
+	template<typename Functor>
+	inline caster_reverse_iterator<Functor> rbegin( Functor const& caster )
+	{
+		return caster_reverse_iterator<Functor>(rbegin(), caster);
+	}
+
+	template<typename Functor>
+	inline caster_reverse_iterator<Functor> rend( Functor const& caster )
+	{
+		return caster_reverse_iterator<Functor>(rend(), caster);
+	}
+
+	//columns access
+	template<unsigned int I1, unsigned int I2,unsigned int ...IN >
+	inline columns_iterator< iterator_t, I1, I2,IN...>
+	begin(placeholders::placeholder<I1> c1, placeholders::placeholder<I2> c2, placeholders::placeholder<IN> ...cn)
+	{
+		return __select(begin().get_iterator_tuple(), c1, c2, cn...);
+	}
+
+	template<unsigned int I1, unsigned int I2,unsigned int ...IN >
+	inline columns_iterator< iterator_t, I1, I2,IN...>
+	end(placeholders::placeholder<I1> c1, placeholders::placeholder<I2> c2, placeholders::placeholder<IN> ...cn)
+	{
+		return __select(end().get_iterator_tuple(), c1, c2, cn...);
+	}
+
+	template<unsigned int I1, unsigned int I2,unsigned int ...IN >
+	inline columns_iterator< const_iterator_t, I1, I2,IN...>
+	begin(placeholders::placeholder<I1> c1, placeholders::placeholder<I2> c2, placeholders::placeholder<IN> ...cn) const
+	{
+		return __select(cbegin().get_iterator_tuple(), c1, c2, cn...);
+	}
+
+	template<unsigned int I1, unsigned int I2,unsigned int ...IN >
+	inline columns_iterator< const_iterator_t, I1, I2,IN...>
+	end(placeholders::placeholder<I1> c1, placeholders::placeholder<I2> c2, placeholders::placeholder<IN> ...cn) const
+	{
+		return __select(cend().get_iterator_tuple(), c1, c2, cn...);
+	}
+
+	template<unsigned int I1, unsigned int I2,unsigned int ...IN >
+	inline columns_iterator< const_iterator_t, I1, I2,IN...>
+	cbegin(placeholders::placeholder<I1> c1, placeholders::placeholder<I2> c2, placeholders::placeholder<IN> ...cn) const
+	{
+		return __select(cbegin().get_iterator_tuple(), c1, c2, cn...);
+	}
+
+	template<unsigned int I1, unsigned int I2,unsigned int ...IN >
+	inline columns_iterator< const_iterator_t, I1, I2,IN...>
+	cend(placeholders::placeholder<I1> c1, placeholders::placeholder<I2> c2, placeholders::placeholder<IN> ...cn) const
+	{
+		return __select(cend().get_iterator_tuple(), c1, c2, cn...);
+	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, iterator_t>::type
+	begin(placeholders::placeholder<I> )
+	{
+		return HYDRA_EXTERNAL_NS::thrust::get<I>(begin().get_iterator_tuple());
+	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, iterator_t>::type
+	end(placeholders::placeholder<I> )
+	{
+		return HYDRA_EXTERNAL_NS::thrust::get<I>(end().get_iterator_tuple());
+	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, reverse_iterator_t>::type
+	rbegin(placeholders::placeholder<I> )
+	{
+		return HYDRA_EXTERNAL_NS::thrust::get<I>(rbegin().get_iterator_tuple());
+	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, reverse_iterator_t>::type
+	rend(placeholders::placeholder<I> )
+	{
+		return HYDRA_EXTERNAL_NS::thrust::get<I>(rend().get_iterator_tuple());
+	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, const_iterator_t>::type
+	begin(placeholders::placeholder<I> ) const
+	{
+		return HYDRA_EXTERNAL_NS::thrust::get<I>(cbegin().get_iterator_tuple());
+	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, const_iterator_t>::type
+	end(placeholders::placeholder<I> ) const
+	{
+		return HYDRA_EXTERNAL_NS::thrust::get<I>(cend().get_iterator_tuple());
+	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, const_iterator_t>::type
+	cbegin(placeholders::placeholder<I> ) const
+	{
+		return HYDRA_EXTERNAL_NS::thrust::get<I>(cbegin().get_iterator_tuple());
+	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, const_iterator_t>::type
+	cend(placeholders::placeholder<I> ) const
+	{
+		return HYDRA_EXTERNAL_NS::thrust::get<I>(cend().get_iterator_tuple());
+	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, const_reverse_iterator_t>::type
+	rbegin(placeholders::placeholder<I> ) const
+	{
+		return HYDRA_EXTERNAL_NS::thrust::get<I>(crbegin().get_iterator_tuple());
+	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, const_reverse_iterator_t>::type
+	rend(placeholders::placeholder<I> ) const
+	{
+		return HYDRA_EXTERNAL_NS::thrust::get<I>(crend().get_iterator_tuple());
+	}
+
+	/**
+	 * Range over the values of the column I. The values are not contiguous, as in
+	 * hydra::multivector::column, but in blocks of W values.
+	 */
+	template<unsigned int I>
+	inline GenericRange<typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, const_iterator_t>::type>
+	column(placeholders::placeholder<I> c) const
+	{
+		return make_range(cbegin(c), cend(c));
+	}
+
+	/**
+	 * Constant reference to the blocks.
+	 */
+	inline const storage_t& blocks() const
+	{
+		return fData;
+	}
+
+	//
+	template<typename Functor>
+	inline caster_iterator<Functor> operator[](Functor const& caster)
+	{	return begin(caster) ;	}
+
+	//
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, iterator_t>::type
+	operator[](placeholders::placeholder<I> index)
+	{	return begin(index) ;	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, const_iterator_t>::type
+	operator[](placeholders::placeholder<I> index) const
+	{	return cbegin(index); }
+
+	//
+	inline reference operator[](size_t n)
+	{	return begin()[n] ;	}
+
+	inline const_reference operator[](size_t n) const
+	{	return cbegin()[n]; }
+
+private:
+
+	template<typename T2, size_t W2, typename BACKEND2>
+	friend class multiblock;
+
+	const storage_t& __data() const { return fData; }
+
+	storage_t __move() { return std::move(fData); }
+
+	inline static size_type __nblocks(size_type n)
+	{
+		return (n + W - 1)/W;
+	}
+
+	//__________________________________________
+	// copy and move from other backends
+	template<typename Other>
+	inline void __copy_from(Other const& other)
+	{
+		fData.resize( other.__data().size() );
+		HYDRA_EXTERNAL_NS::thrust::copy(other.__data().begin(), other.__data().end(), fData.begin());
+		fSize = other.size();
+	}
+
+	template<typename Other>
+	inline void __move_from(Other& other, std::true_type)
+	{
+		detail::adopt_storage(fData, other.fData);
+		fSize = other.fSize;
+		other.fSize = 0;
+	}
+
+	template<typename Other>
+	inline void __move_from(Other& other, std::false_type)
+	{
+		__copy_from(other);
+	}
+
+	//__________________________________________
+	// resize
+	inline void __resize(size_type n)
+	{
+		size_type old_size = fSize;
+
+		fData.resize( __nblocks(n) );
+		fSize = n;
+
+		__clear_tail(old_size);
+	}
+
+	/*
+	 * New blocks are value initialized. The rows of the last block of the previous
+	 * size, beyond it, may hold values of removed rows and are cleared.
+	 */
+	inline void __clear_tail(size_type old_size)
+	{
+		if( fSize <= old_size ) return;
+
+		size_type last = std::min(fSize, __nblocks(old_size)*W);
+
+		if( last > old_size )
+			HYDRA_EXTERNAL_NS::thrust::fill(begin() + old_size, begin() + last, value_type());
+	}
+
+	//__________________________________________
+	// erase and insert
+	inline iterator __erase(size_type first_position, size_type last_position)
+	{
+		multiblock<tuple_type, W, system_t> tail(begin() + last_position, end());
+
+		HYDRA_EXTERNAL_NS::thrust::copy(tail.begin(), tail.end(), begin() + first_position);
+		__resize(fSize - (last_position - first_position));
+
+		return begin() + first_position;
+	}
+
+	inline void __insert(size_type position, size_type n, const value_type &x)
+	{
+		multiblock<tuple_type, W, system_t> tail(begin() + position, end());
+
+		__resize(fSize + n);
+		HYDRA_EXTERNAL_NS::thrust::fill(begin() + position, begin() + position + n, x);
+		HYDRA_EXTERNAL_NS::thrust::copy(tail.begin(), tail.end(), begin() + position + n);
+	}
+
+	//__________________________________________
+	// column iterators at the row index
+	template<size_t ...I>
+	inline iterator_t __columns(size_type index, detail::index_sequence<I...>)
+	{
+		unsigned char* base = reinterpret_cast<unsigned char*>(
+				HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fData.data()) );
+
+		return iterator_t( iterator_v<T>(base + W*detail::block_column_offset<I, T...>::value, index)... );
+	}
+
+	template<size_t ...I>
+	inline const_iterator_t __columns(size_type index, detail::index_sequence<I...>) const
+	{
+		const unsigned char* base = reinterpret_cast<const unsigned char*>(
+				HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(fData.data()) );
+
+		return const_iterator_t( const_iterator_v<T>(base + W*detail::block_column_offset<I, T...>::value, index)... );
+	}
+
+	template<size_t ...I>
+	inline reverse_iterator_t __reverse_columns(size_type index, detail::index_sequence<I...> seq)
+	{
+		iterator_t columns = __columns(index, seq);
+
+		return reverse_iterator_t( reverse_iterator_v<T>( HYDRA_EXTERNAL_NS::thrust::get<I>(columns) )... );
+	}
+
+	template<size_t ...I>
+	inline const_reverse_iterator_t __reverse_columns(size_type index, detail::index_sequence<I...> seq) const
+	{
+		const_iterator_t columns = __columns(index, seq);
+
+		return const_reverse_iterator_t( const_reverse_iterator_v<T>( HYDRA_EXTERNAL_NS::thrust::get<I>(columns) )... );
+	}
+
+	template<typename Iterators, unsigned int I1, unsigned int I2,unsigned int ...IN >
+	inline static columns_iterator< Iterators, I1, I2,IN...>
+	__select(Iterators const& columns, placeholders::placeholder<I1>, placeholders::placeholder<I2>,
+			placeholders::placeholder<IN>...)
+	{
+		return HYDRA_EXTERNAL_NS::thrust::make_zip_iterator(
+				HYDRA_EXTERNAL_NS::thrust::make_tuple(
+						HYDRA_EXTERNAL_NS::thrust::get<I1>(columns),
+						HYDRA_EXTERNAL_NS::thrust::get<I2>(columns),
+						HYDRA_EXTERNAL_NS::thrust::get<IN>(columns)...));
+	}
+
+	storage_t fData;
+	size_type fSize;
+};
+
+template<unsigned int I, typename ...T, size_t W, hydra::detail::Backend BACKEND>
+inline auto
+begin(multiblock<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, W, detail::BackendPolicy<BACKEND>> const& other  )
+-> decltype(other.begin(placeholders::placeholder<I>{}))
+{
+	return other.begin(placeholders::placeholder<I>{});
+}
+
+template<unsigned int I, typename ...T, size_t W, hydra::detail::Backend BACKEND>
+inline auto
+end(multiblock<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, W, detail::BackendPolicy<BACKEND>> const& other  )
+-> decltype(other.end(placeholders::placeholder<I>{}))
+{
+	return other.end(placeholders::placeholder<I>{});
+}
+
+template<unsigned int I, typename ...T, size_t W, hydra::detail::Backend BACKEND>
+inline auto
+begin(multiblock<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, W, detail::BackendPolicy<BACKEND>>& other  )
+-> decltype(other.begin(placeholders::placeholder<I>{}))
+{
+	return other.begin(placeholders::placeholder<I>{});
+}
+
+template<unsigned int I, typename ...T, size_t W, hydra::detail::Backend BACKEND>
+inline auto
+end(multiblock<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, W, detail::BackendPolicy<BACKEND>>& other  )
+-> decltype(other.end(placeholders::placeholder<I>{}))
+{
+	return other.end(placeholders::placeholder<I>{});
+}
+
+template<typename ...T, size_t W, hydra::detail::Backend BACKEND1, hydra::detail::Backend BACKEND2>
+bool operator==(const multiblock<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, W, hydra::detail::BackendPolicy<BACKEND1>>& lhs,
+                const multiblock<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, W, hydra::detail::BackendPolicy<BACKEND2>>& rhs){
+
+	auto comparison = []__hydra_host__ __hydra_device__(
+			HYDRA_EXTERNAL_NS::thrust::tuple< HYDRA_EXTERNAL_NS::thrust::tuple<T...>,
+				HYDRA_EXTERNAL_NS::thrust::tuple<T...> > const& values)
+	{
+			return HYDRA_EXTERNAL_NS::thrust::get<0>(values)== HYDRA_EXTERNAL_NS::thrust::get<1>(values);
+
+	};
+
+	return lhs.size() == rhs.size() && HYDRA_EXTERNAL_NS::thrust::all_of(
+			HYDRA_EXTERNAL_NS::thrust::make_zip_iterator(lhs.begin(), rhs.begin()),
+			HYDRA_EXTERNAL_NS::thrust::make_zip_iterator(lhs.end()  , rhs.end()  ), comparison);
+}
+
+template<typename ...T, size_t W, hydra::detail::Backend BACKEND1, hydra::detail::Backend BACKEND2>
+bool operator!=(const multiblock<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, W, hydra::detail::BackendPolicy<BACKEND1>>& lhs,
+                const multiblock<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, W, hydra::detail::BackendPolicy<BACKEND2>>& rhs){
+
+	return !(lhs == rhs);
+}
+
+}  // namespace hydra
+
+#endif /* MULTIBLOCK_H_ */
@@ -32,10 +32,15 @@
 
 #include <hydra/detail/Config.h>
 #include <hydra/detail/BackendPolicy.h>
+#include <hydra/detail/FirstTouchAllocator.h>
+#include <hydra/detail/AlignedAllocator.h>
+#include <hydra/detail/Rebind.h>
 #include <hydra/detail/utility/Utility_Tuple.h>
 #include <hydra/detail/functors/Caster.h>
 #include <hydra/Tuple.h>
 #include <hydra/Placeholders.h>
+#include <hydra/GenericRange.h>
+#include <hydra/ColumnSpan.h>
 #include <hydra/detail/external/thrust/iterator/zip_iterator.h>
 #include <hydra/detail/external/thrust/iterator/iterator_traits.h>
 #include <hydra/detail/external/thrust/tuple.h>
@@ -115,6 +120,10 @@ public:
 	typedef HYDRA_EXTERNAL_NS::thrust::zip_iterator<reverse_iterator_t>	 		 reverse_iterator;
 	typedef HYDRA_EXTERNAL_NS::thrust::zip_iterator<const_reverse_iterator_t>	 const_reverse_iterator;
 
+	//raw access to the columns
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple< ColumnSpan<T>...       > 	spans_t;
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple< ColumnSpan<const T>... > 	const_spans_t;
+
 	 //stl-like typedefs
 	 typedef size_t size_type;
 	 typedef typename HYDRA_EXTERNAL_NS::thrust::iterator_traits<iterator>::reference reference;
@@ -202,6 +211,19 @@ public:
 		HYDRA_EXTERNAL_NS::thrust::copy(other.begin(), other.end(), begin());
 	}
 
+	/**
+	 * Move constructor for containers allocated in different backends. If the allocators
+	 * of the two backends share the memory resource (hydra::detail::is_rebindable), as for the CPP,
+	 * OMP and TBB backends, the columns of \p other are handed over without copying.
+	 * Otherwise the elements are copied.
+	 * @param other
+	 */
+	template< hydra::detail::Backend BACKEND2>
+	multivector(multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>,detail::BackendPolicy<BACKEND2>>&& other )
+	{
+		__move_from(other, detail::is_rebindable<detail::BackendPolicy<BACKEND2>, system_t>{});
+	}
+
 	/*! This constructor builds a \p multivector from a range.
 	 *  \param first The beginning of the range.
 	 *  \param last The end of the range.
@@ -256,6 +278,20 @@ public:
 		return *this;
 	}
 
+	/**
+	 * Move-assignment operator for containers allocated in different backends,
+	 * handing over the columns of \p other without copying when possible.
+	 * @param other
+	 * @return
+	 */
+	template< hydra::detail::Backend BACKEND2>
+	multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>,detail::BackendPolicy<BACKEND>>&
+	operator=(multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>,detail::BackendPolicy<BACKEND2> >&& other )
+	{
+		__move_from(other, detail::is_rebindable<detail::BackendPolicy<BACKEND2>, system_t>{});
+		return *this;
+	}
+
 
     /*! This method erases the last element of this \p multivector, invalidating
      *  all iterators and references to it.
@@ -349,6 +385,18 @@ public:
 		__reserve(size);
 	}
 
+	/*! \brief Resizes this \p multivector to exactly new_size elements, moving each column to new storage.
+	 *
+	 *  Unlike resize(), no spare capacity is kept and the storage is reallocated even if the size does not change,
+	 *  so that the pages of the columns are mapped by the threads processing them on NUMA machines.
+	 *  See hydra::detail::FirstTouchAllocator and HYDRA_FIRST_TOUCH_ALLOCATION.
+	 *  \param new_size Number of elements this \p multivector should contain.
+	 */
+	inline void numa_resize(size_type new_size)
+	{
+		__numa_resize(new_size);
+	}
+
     /*! This method removes the element at position pos.
      *  \param pos The position of the element of interest.
      *  \return An iterator pointing to the new location of the element that followed the element
@@ -733,6 +781,22 @@ public:
 		return HYDRA_EXTERNAL_NS::thrust::get<I>(fData);
 	}
 
+	/*! \brief Raw pointers to the columns, with the number of elements, in the memory of the backend.
+	 *
+	 *  The columns do not overlap. With HYDRA_ALIGNED_ALLOCATION, the pointers are aligned to HYDRA_ALIGNMENT
+	 *  bytes and the columns can be read up to ColumnSpan::padded_size().
+	 *  The spans are invalidated by the operations reallocating the columns (e.g. resize or push_back).
+	 */
+	inline spans_t spans()
+	{
+		return __spans(detail::make_index_sequence<N>{});
+	}
+
+	inline const_spans_t spans() const
+	{
+		return __cspans(detail::make_index_sequence<N>{});
+	}
+
 
 	template<typename Functor>
 	 inline caster_iterator<Functor> operator[](Functor const& caster)
@@ -776,6 +840,54 @@ public:
 
 private:
 
+	template<typename Type, typename BACKEND2>
+	friend class multivector;
+
+	//__________________________________________
+	// move from other backends
+	template<typename Other>
+	inline void __move_from(Other& other, std::true_type)
+	{
+		__adopt(other.fData);
+	}
+
+	template<typename Other>
+	inline void __move_from(Other& other, std::false_type)
+	{
+		__resize(other.size());
+		HYDRA_EXTERNAL_NS::thrust::copy(other.begin(), other.end(), begin());
+	}
+
+	//__________________________________________
+	// spans
+	template<size_t ...I>
+	inline spans_t __spans(detail::index_sequence<I...>)
+	{
+		return spans_t( ColumnSpan<T>(
+				HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(HYDRA_EXTERNAL_NS::thrust::get<I>(fData).data()), size(),
+				detail::padded_size<T, typename vector<T>::allocator_type>(size()))... );
+	}
+
+	template<size_t ...I>
+	inline const_spans_t __cspans(detail::index_sequence<I...>) const
+	{
+		return const_spans_t( ColumnSpan<const T>(
+				HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(HYDRA_EXTERNAL_NS::thrust::get<I>(fData).data()), size(),
+				detail::padded_size<T, typename vector<T>::allocator_type>(size()))... );
+	}
+
+	template<size_t I, typename Storage>
+	inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I == N), void >::type
+	__adopt(Storage& ){}
+
+	template<size_t I=0, typename Storage>
+	inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I < N), void >::type
+	__adopt(Storage& storage)
+	{
+		detail::adopt_storage(HYDRA_EXTERNAL_NS::thrust::get<I>(fData),
+				HYDRA_EXTERNAL_NS::thrust::get<I>(storage));
+		__adopt<I + 1>(storage);
+	}
 
 	//__________________________________________
 	// caster accessors
@@ -891,6 +1003,20 @@ private:
 		__reserve<I + 1>(size);
 	}
 
+	//__________________________________________
+	// numa_resize
+	template<size_t I>
+	 inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I == N), void >::type
+	__numa_resize(size_type ){}
+
+	template<size_t I=0>
+	 inline typename HYDRA_EXTERNAL_NS::thrust::detail::enable_if<(I < N), void >::type
+	__numa_resize(size_type n )
+	{
+		detail::first_touch_resize(HYDRA_EXTERNAL_NS::thrust::get<I>(fData), n);
+		__numa_resize<I + 1>(n);
+	}
+
 	//__________________________________________
 	// erase
 	template<size_t I>
@@ -1326,6 +1452,55 @@ private:
 
 };
 
+/**
+ * Move the columns of a multivector to a multivector of the backend BACKEND2 without copying,
+ * e.g. `hydra::rebind<hydra::omp::sys_t>(std::move(data))`. The allocators of the two backends
+ * must share the memory resource (hydra::detail::is_rebindable). \p other is left empty.
+ */
+template<typename BACKEND2, hydra::detail::Backend BACKEND, typename ...T>
+inline multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, BACKEND2>
+rebind(multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, detail::BackendPolicy<BACKEND>>&& other )
+{
+	static_assert( detail::is_rebindable<detail::BackendPolicy<BACKEND>, BACKEND2>::value,
+			"[Hydra::rebind] : the containers of the two backends do not share the memory resource.");
+
+	return multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, BACKEND2>(std::move(other));
+}
+
+/**
+ * Non-owning range over the columns of a multivector, with the iterators of a multivector
+ * of the backend BACKEND2, e.g. to process with OpenMP a multivector allocated on the TBB backend.
+ * Both backends must allocate in host memory (hydra::detail::is_host_backend).
+ * The range is invalidated by the operations invalidating the iterators of \p other.
+ */
+template<typename BACKEND2, hydra::detail::Backend BACKEND, typename ...T>
+inline GenericRange<typename multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, BACKEND2>::iterator>
+rebind_view(multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, detail::BackendPolicy<BACKEND>>& other )
+{
+	typedef typename multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, BACKEND2>::iterator iterator;
+
+	static_assert( detail::is_host_backend<detail::BackendPolicy<BACKEND>>::value &&
+			detail::is_host_backend<BACKEND2>::value,
+			"[Hydra::rebind_view] : the containers of both backends must be allocated in host memory.");
+
+	return make_range( detail::rebind_iterator<iterator>(other.begin()),
+			detail::rebind_iterator<iterator>(other.end()) );
+}
+
+template<typename BACKEND2, hydra::detail::Backend BACKEND, typename ...T>
+inline GenericRange<typename multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, BACKEND2>::const_iterator>
+rebind_view(multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, detail::BackendPolicy<BACKEND>> const& other )
+{
+	typedef typename multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, BACKEND2>::const_iterator iterator;
+
+	static_assert( detail::is_host_backend<detail::BackendPolicy<BACKEND>>::value &&
+			detail::is_host_backend<BACKEND2>::value,
+			"[Hydra::rebind_view] : the containers of both backends must be allocated in host memory.");
+
+	return make_range( detail::rebind_iterator<iterator>(other.begin()),
+			detail::rebind_iterator<iterator>(other.end()) );
+}
+
 template<unsigned int I,  hydra::detail::Backend BACKEND, typename ...T>
 inline auto
 get(multivector<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, detail::BackendPolicy<BACKEND>> const& other  )
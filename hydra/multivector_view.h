@@ -0,0 +1,580 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * multivector_view.h
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#ifndef MULTIVECTOR_VIEW_H_
+#define MULTIVECTOR_VIEW_H_
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/BackendPolicy.h>
+#include <hydra/detail/Rebind.h>
+#include <hydra/detail/utility/Generic.h>
+#include <hydra/multivector.h>
+#include <hydra/GenericRange.h>
+#include <hydra/ColumnSpan.h>
+#include <hydra/Placeholders.h>
+#include <hydra/detail/external/thrust/iterator/zip_iterator.h>
+#include <hydra/detail/external/thrust/iterator/iterator_traits.h>
+#include <hydra/detail/external/thrust/iterator/transform_iterator.h>
+#include <hydra/detail/external/thrust/tuple.h>
+
+#include <type_traits>
+
+namespace hydra {
+
+template<typename T, typename BACKEND>
+class multivector_view;
+
+/**
+ * @brief Non-owning view, with the interface of hydra::multivector, of a table stored in SoA layout
+ * in memory managed elsewhere (e.g. columns read by an I/O layer), given by one pointer per column
+ * and the number of rows. The pointers are in the memory space of the backend.
+ *
+ * The iterators of a \p multivector_view are the ones of a hydra::multivector of the same columns and backend,
+ * so that it can be passed wherever these are accepted, e.g. to hydra::make_loglikehood_fcn,
+ * hydra::DenseHistogram::Fill or hydra::eval, without copies. The view does not allocate, copy or
+ * release the columns, which must outlive it. Copies of a view refer to the same columns.
+ *
+ * A view of const columns, e.g. `multivector_view<hydra::tuple<const double, const double>, BACKEND>`,
+ * is read-only: all its iterators are the const iterators of the hydra::multivector.
+ */
+template<typename ...T, hydra::detail::Backend BACKEND>
+class multivector_view< HYDRA_EXTERNAL_NS::thrust::tuple<T...>, hydra::detail::BackendPolicy<BACKEND>>
+{
+	typedef hydra::detail::BackendPolicy<BACKEND> system_t;
+	typedef multivector< HYDRA_EXTERNAL_NS::thrust::tuple<typename std::remove_const<T>::type...>, system_t> container_t;
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<typename std::remove_const<T>::type...> tuple_type;
+
+	constexpr static size_t N = sizeof...(T);
+
+	constexpr static bool read_only = detail::all_true<std::is_const<T>::value...>::value;
+
+	static_assert( read_only || detail::all_true<!std::is_const<T>::value...>::value,
+			"[Hydra::multivector_view] : the columns of a view must be either all const or all non-const.");
+
+	template<typename Mutable, typename Const>
+	using access_type = typename std::conditional<read_only, Const, Mutable>::type;
+
+public:
+
+	typedef access_type<typename container_t::iterator_t,
+			typename container_t::const_iterator_t>             iterator_t;
+	typedef typename container_t::const_iterator_t          const_iterator_t;
+	typedef access_type<typename container_t::reverse_iterator_t,
+			typename container_t::const_reverse_iterator_t>     reverse_iterator_t;
+	typedef typename container_t::const_reverse_iterator_t  const_reverse_iterator_t;
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<T*...>         pointer_t;
+	typedef HYDRA_EXTERNAL_NS::thrust::tuple<ColumnSpan<T>...> spans_t;
+
+	//zip iterator
+	typedef access_type<typename container_t::iterator,
+			typename container_t::const_iterator>               iterator;
+	typedef typename container_t::const_iterator         const_iterator;
+	typedef access_type<typename container_t::reverse_iterator,
+			typename container_t::const_reverse_iterator>       reverse_iterator;
+	typedef typename container_t::const_reverse_iterator const_reverse_iterator;
+
+	//stl-like typedefs
+	typedef size_t size_type;
+	typedef access_type<typename container_t::reference,
+			typename container_t::const_reference>              reference;
+	typedef typename container_t::const_reference   const_reference;
+	typedef typename container_t::value_type        value_type;
+	typedef typename container_t::iterator_category iterator_category;
+
+	template<typename Functor>
+	using caster_iterator = HYDRA_EXTERNAL_NS::thrust::transform_iterator< Functor,
+			iterator, typename std::result_of<Functor(tuple_type&)>::type >;
+
+	template<typename Functor>
+	using caster_reverse_iterator = HYDRA_EXTERNAL_NS::thrust::transform_iterator< Functor,
+			reverse_iterator, typename std::result_of<Functor(tuple_type&)>::type >;
+
+	template<typename Iterators,  unsigned int I1, unsigned int I2,unsigned int ...IN>
+	using columns_iterator = typename container_t::template columns_iterator<Iterators, I1, I2, IN...>;
+
+	template<unsigned int I>
+	using column_iterator = typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, iterator_t>::type;
+
+	template<unsigned int I>
+	using const_column_iterator = typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, const_iterator_t>::type;
+
+	/**
+	 * Default constructor. This constructor creates an empty \p multivector_view.
+	 */
+	multivector_view():
+		fBegin(detail::rebind_iterator<iterator>(pointer_t())),
+		fSize(0)
+	{}
+
+	/**
+	 * View of \p n rows, stored in the columns pointed by \p columns.
+	 * @param n number of rows
+	 * @param columns pointers to the first element of each column.
+	 */
+	multivector_view(size_t n, T* ...columns):
+		fBegin(detail::rebind_iterator<iterator>(HYDRA_EXTERNAL_NS::thrust::make_tuple(columns...))),
+		fSize(n)
+	{}
+
+	/**
+	 * View of \p n rows, stored in the columns pointed by \p columns.
+	 * @param columns tuple with the pointers to the first element of each column.
+	 * @param n number of rows
+	 */
+	multivector_view(pointer_t const& columns, size_t n):
+		fBegin(detail::rebind_iterator<iterator>(columns)),
+		fSize(n)
+	{}
+
+	/**
+	 * View of the range [first, last) of a hydra::multivector of the same backend.
+	 */
+	multivector_view(iterator first, iterator last):
+		fBegin(first),
+		fSize(HYDRA_EXTERNAL_NS::thrust::distance(first, last))
+	{}
+
+	/**
+	 * Read-only view of the range [first, last) of a hydra::multivector of the same backend.
+	 */
+	template<typename Iterator>
+	multivector_view(Iterator first, Iterator last,
+			typename std::enable_if< read_only &&
+				std::is_same<Iterator, typename container_t::iterator>::value, void>::type* = 0 ):
+		fBegin(detail::rebind_iterator<iterator>(first)),
+		fSize(HYDRA_EXTERNAL_NS::thrust::distance(first, last))
+	{}
+
+	/**
+	 * View of all rows of a hydra::multivector of the same backend. The view is invalidated by
+	 * the operations invalidating the iterators of \p other.
+	 */
+	multivector_view(container_t& other):
+		fBegin(detail::rebind_iterator<iterator>(other.begin())),
+		fSize(other.size())
+	{}
+
+	multivector_view(multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, system_t> const& other):
+		fBegin(other.fBegin),
+		fSize(other.fSize)
+	{}
+
+	multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, system_t>&
+	operator=(multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, system_t> const& other)
+	{
+		if(this==&other) return *this;
+
+		fBegin = other.fBegin;
+		fSize  = other.fSize;
+
+		return *this;
+	}
+
+	/*!
+	 *  Returns the number of rows in this \p multivector_view.
+	 */
+	inline size_type size() const
+	{
+		return fSize;
+	}
+
+	/*!
+	 *  Returns true if this \p multivector_view has no rows.
+	 */
+	inline bool empty() const
+	{
+		return fSize == 0;
+	}
+
+	/*!
+	 *  Returns the pointers to the first element of each column.
+	 */
+	inline pointer_t data() const
+	{
+		return __data(detail::make_index_sequence<N>{});
+	}
+
+	/*!
+	 *  Returns the columns as hydra::ColumnSpan objects, i.e. raw pointers and the number of rows.
+	 *  The columns are not assumed to be padded: ColumnSpan::padded_size() is the number of rows.
+	 */
+	inline spans_t spans() const
+	{
+		return __spans(detail::make_index_sequence<N>{});
+	}
+
+	/*!
+	 * Returns a view of the rows [first, last) of this \p multivector_view.
+	 */
+	inline multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, system_t>
+	subview(size_type first, size_type last) const
+	{
+		return multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, system_t>(fBegin + first, fBegin + last);
+	}
+
+	inline reference front()
+	{
+		return fBegin[0];
+	}
+
+	inline const_reference front() const
+	{
+		return cbegin()[0];
+	}
+
+	inline reference back()
+	{
+		return fBegin[fSize-1];
+	}
+
+	inline const_reference back() const
+	{
+		return cbegin()[fSize-1];
+	}
+
+	//non-constant access
+	inline iterator begin()
+	{
+		return fBegin;
+	}
+
+	inline iterator end()
+	{
+		return fBegin + fSize;
+	}
+
+	template<typename Functor>
+	inline caster_iterator<Functor> begin( Functor const& caster )
+	{
+		return caster_iterator<Functor>(begin(), caster);
+	}
+
+	template<typename Functor>
+	inline caster_iterator<Functor> end( Functor const& caster )
+	{
+		return caster_iterator<Functor>(end(), caster);
+	}
+
+	template<typename Functor>
+	inline caster_reverse_iterator<Functor> rbegin( Functor const& caster )
+	{
+		return caster_reverse_iterator<Functor>(rbegin(), caster);
+	}
+
+	template<typename Functor>
+	inline caster_reverse_iterator<Functor> rend( Functor const& caster )
+	{
+		return caster_reverse_iterator<Functor>(rend(), caster);
+	}
+
+	inline reverse_iterator rbegin()
+	{
+		return __reverse<reverse_iterator_t>(end(), detail::make_index_sequence<N>{});
+	}
+
+	inline reverse_iterator rend()
+	{
+		return __reverse<reverse_iterator_t>(begin(), detail::make_index_sequence<N>{});
+	}
+
+	//constant access
+	inline const_iterator begin() const
+	{
+		return cbegin();
+	}
+
+	inline const_iterator end() const
+	{
+		return cend();
+	}
+
+	inline const_reverse_iterator rbegin() const
+	{
+		return crbegin();
+	}
+
+	inline const_reverse_iterator rend() const
+	{
+		return crend();
+	}
+
+	inline const_iterator cbegin() const
+	{
+		return detail::rebind_iterator<const_iterator>(fBegin);
+	}
+
+	inline const_iterator cend() const
+	{
+		return detail::rebind_iterator<const_iterator>(fBegin + fSize);
+	}
+
+	inline const_reverse_iterator crbegin() const
+	{
+		return __reverse<const_reverse_iterator_t>(cend(), detail::make_index_sequence<N>{});
+	}
+
+	inline const_reverse_iterator crend() const
+	{
+		return __reverse<const_reverse_iterator_t>(cbegin(), detail::make_index_sequence<N>{});
+	}
+
+	//non-constant access to columns
+	template<unsigned int I1, unsigned int I2,unsigned int ...IN >
+	inline columns_iterator< iterator_t, I1, I2,IN...>
+	begin(placeholders::placeholder<I1> c1, placeholders::placeholder<I2> c2, placeholders::placeholder<IN> ...cn)
+	{
+		return HYDRA_EXTERNAL_NS::thrust::make_zip_iterator(
+				HYDRA_EXTERNAL_NS::thrust::make_tuple(begin(c1), begin(c2), begin(cn)...));
+	}
+
+	template<unsigned int I1, unsigned int I2,unsigned int ...IN >
+	inline columns_iterator< iterator_t, I1, I2,IN...>
+	end(placeholders::placeholder<I1> c1, placeholders::placeholder<I2> c2, placeholders::placeholder<IN> ...cn)
+	{
+		return HYDRA_EXTERNAL_NS::thrust::make_zip_iterator(
+				HYDRA_EXTERNAL_NS::thrust::make_tuple(end(c1), end(c2), end(cn)...));
+	}
+
+	template<unsigned int I>
+	inline column_iterator<I> begin(placeholders::placeholder<I> )
+	{
+		return HYDRA_EXTERNAL_NS::thrust::get<I>(fBegin.get_iterator_tuple());
+	}
+
+	template<unsigned int I>
+	inline column_iterator<I> end(placeholders::placeholder<I> )
+	{
+		return HYDRA_EXTERNAL_NS::thrust::get<I>(fBegin.get_iterator_tuple()) + fSize;
+	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, reverse_iterator_t>::type
+	rbegin(placeholders::placeholder<I> c)
+	{
+		return typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, reverse_iterator_t>::type(end(c));
+	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, reverse_iterator_t>::type
+	rend(placeholders::placeholder<I> c)
+	{
+		return typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, reverse_iterator_t>::type(begin(c));
+	}
+
+	//constant access to columns
+	template<unsigned int I1, unsigned int I2,unsigned int ...IN >
+	inline columns_iterator< const_iterator_t, I1, I2,IN...>
+	begin(placeholders::placeholder<I1> c1, placeholders::placeholder<I2> c2, placeholders::placeholder<IN> ...cn) const
+	{
+		return cbegin(c1, c2, cn...);
+	}
+
+	template<unsigned int I1, unsigned int I2,unsigned int ...IN >
+	inline columns_iterator< const_iterator_t, I1, I2,IN...>
+	end(placeholders::placeholder<I1> c1, placeholders::placeholder<I2> c2, placeholders::placeholder<IN> ...cn) const
+	{
+		return cend(c1, c2, cn...);
+	}
+
+	template<unsigned int I>
+	inline const_column_iterator<I> begin(placeholders::placeholder<I> c) const
+	{
+		return cbegin(c);
+	}
+
+	template<unsigned int I>
+	inline const_column_iterator<I> end(placeholders::placeholder<I> c) const
+	{
+		return cend(c);
+	}
+
+	template<unsigned int I1, unsigned int I2,unsigned int ...IN >
+	inline columns_iterator< const_iterator_t, I1, I2,IN...>
+	cbegin(placeholders::placeholder<I1> c1, placeholders::placeholder<I2> c2, placeholders::placeholder<IN> ...cn) const
+	{
+		return HYDRA_EXTERNAL_NS::thrust::make_zip_iterator(
+				HYDRA_EXTERNAL_NS::thrust::make_tuple(cbegin(c1), cbegin(c2), cbegin(cn)...));
+	}
+
+	template<unsigned int I1, unsigned int I2,unsigned int ...IN >
+	inline columns_iterator< const_iterator_t, I1, I2,IN...>
+	cend(placeholders::placeholder<I1> c1, placeholders::placeholder<I2> c2, placeholders::placeholder<IN> ...cn) const
+	{
+		return HYDRA_EXTERNAL_NS::thrust::make_zip_iterator(
+				HYDRA_EXTERNAL_NS::thrust::make_tuple(cend(c1), cend(c2), cend(cn)...));
+	}
+
+	template<unsigned int I>
+	inline const_column_iterator<I> cbegin(placeholders::placeholder<I> ) const
+	{
+		return detail::rebind_iterator<const_column_iterator<I>>(
+				HYDRA_EXTERNAL_NS::thrust::get<I>(fBegin.get_iterator_tuple()));
+	}
+
+	template<unsigned int I>
+	inline const_column_iterator<I> cend(placeholders::placeholder<I> ) const
+	{
+		return detail::rebind_iterator<const_column_iterator<I>>(
+				HYDRA_EXTERNAL_NS::thrust::get<I>(fBegin.get_iterator_tuple()) + fSize);
+	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, const_reverse_iterator_t>::type
+	rbegin(placeholders::placeholder<I> c) const
+	{
+		return typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, const_reverse_iterator_t>::type(cend(c));
+	}
+
+	template<unsigned int I>
+	inline typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, const_reverse_iterator_t>::type
+	rend(placeholders::placeholder<I> c) const
+	{
+		return typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, const_reverse_iterator_t>::type(cbegin(c));
+	}
+
+	/*!
+	 * Returns a non-owning range over the column I.
+	 */
+	template<unsigned int I>
+	inline GenericRange<column_iterator<I>>
+	column(placeholders::placeholder<I> c)
+	{
+		return make_range(begin(c), end(c));
+	}
+
+	template<unsigned int I>
+	inline GenericRange<const_column_iterator<I>>
+	column(placeholders::placeholder<I> c) const
+	{
+		return make_range(cbegin(c), cend(c));
+	}
+
+	template<typename Functor>
+	inline caster_iterator<Functor> operator[](Functor const& caster)
+	{	return this->begin(caster) ;	}
+
+	template<unsigned int I>
+	inline column_iterator<I> operator[](placeholders::placeholder<I> index)
+	{	return begin(index) ;	}
+
+	template<unsigned int I>
+	inline const_column_iterator<I> operator[](placeholders::placeholder<I> index) const
+	{	return cbegin(index); }
+
+	/*! \brief Subscript access to the rows of this view.
+	 *  \param n The index of the row.
+	 *  \return Read/write reference to data.
+	 */
+	inline reference operator[](size_t n)
+	{	return fBegin[n] ;	}
+
+	inline const_reference operator[](size_t n) const
+	{	return cbegin()[n]; }
+
+private:
+
+	template<typename ReverseTuple, typename Iterator, size_t ...I>
+	inline HYDRA_EXTERNAL_NS::thrust::zip_iterator<ReverseTuple>
+	__reverse(Iterator const& it, detail::index_sequence<I...> ) const
+	{
+		return HYDRA_EXTERNAL_NS::thrust::make_zip_iterator( HYDRA_EXTERNAL_NS::thrust::make_tuple(
+				typename HYDRA_EXTERNAL_NS::thrust::tuple_element<I, ReverseTuple>::type(
+						HYDRA_EXTERNAL_NS::thrust::get<I>(it.get_iterator_tuple()))...) );
+	}
+
+	template<size_t ...I>
+	inline pointer_t __data(detail::index_sequence<I...> ) const
+	{
+		return pointer_t( HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(
+				HYDRA_EXTERNAL_NS::thrust::get<I>(fBegin.get_iterator_tuple()).base())... );
+	}
+
+	template<size_t ...I>
+	inline spans_t __spans(detail::index_sequence<I...> ) const
+	{
+		return spans_t( ColumnSpan<T>( HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(
+				HYDRA_EXTERNAL_NS::thrust::get<I>(fBegin.get_iterator_tuple()).base()), fSize, fSize)... );
+	}
+
+	iterator  fBegin;
+	size_type fSize;
+};
+
+/**
+ * Make a \p multivector_view of \p n rows on the backend of \p policy, from one pointer per column.
+ */
+template<hydra::detail::Backend BACKEND, typename ...T>
+inline multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, detail::BackendPolicy<BACKEND>>
+make_multivector_view(detail::BackendPolicy<BACKEND> const&, size_t n, T* ...columns)
+{
+	return multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, detail::BackendPolicy<BACKEND>>(n, columns...);
+}
+
+template<unsigned int I,  hydra::detail::Backend BACKEND, typename ...T>
+inline auto
+get(multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, detail::BackendPolicy<BACKEND>> const& other  )
+-> decltype(other.column(placeholders::placeholder<I>{}))
+{
+	return other.column(placeholders::placeholder<I>{});
+}
+
+template<unsigned int I,  hydra::detail::Backend BACKEND, typename ...T>
+inline auto
+begin(multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, detail::BackendPolicy<BACKEND>> const& other  )
+-> decltype(other.begin(placeholders::placeholder<I>{}))
+{
+	return other.begin(placeholders::placeholder<I>{});
+}
+
+template<unsigned int I,  hydra::detail::Backend BACKEND, typename ...T>
+inline auto
+end(multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, detail::BackendPolicy<BACKEND>> const& other  )
+-> decltype(other.end(placeholders::placeholder<I>{}))
+{
+	return other.end(placeholders::placeholder<I>{});
+}
+
+template<unsigned int I,  hydra::detail::Backend BACKEND, typename ...T>
+inline auto
+begin(multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, detail::BackendPolicy<BACKEND>>& other  )
+-> decltype(other.begin(placeholders::placeholder<I>{}))
+{
+	return other.begin(placeholders::placeholder<I>{});
+}
+
+template<unsigned int I,  hydra::detail::Backend BACKEND, typename ...T>
+inline auto
+end(multivector_view<HYDRA_EXTERNAL_NS::thrust::tuple<T...>, detail::BackendPolicy<BACKEND>>& other  )
+-> decltype(other.end(placeholders::placeholder<I>{}))
+{
+	return other.end(placeholders::placeholder<I>{});
+}
+
+}  // namespace hydra
+
+#endif /* MULTIVECTOR_VIEW_H_ */
@@ -0,0 +1,144 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * caching_pool.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+#include <vector>
+
+#include <hydra/device/System.h>
+#include <hydra/detail/external/thrust/sort.h>
+#include <hydra/detail/external/thrust/sequence.h>
+#include <hydra/detail/external/thrust/functional.h>
+#include <hydra/detail/external/thrust/memory.h>
+
+TEST_CASE( "CachingPool","hydra::detail::CachingPool" ) {
+
+	typedef hydra::device::sys_t::caching_pool_type pool_t;
+
+	pool_t& pool = hydra::device::sys.GetCachingPool();
+
+	const size_t max_cached_bytes = pool.GetMaxCachedBytes();
+
+	pool.Release();
+
+	SECTION( "size classes" )
+	{
+		REQUIRE( pool_t::SizeClass(1)    == 256 );
+		REQUIRE( pool_t::SizeClass(256)  == 256 );
+		REQUIRE( pool_t::SizeClass(257)  == 320 );
+		REQUIRE( pool_t::SizeClass(1000) == 1024 );
+		REQUIRE( pool_t::SizeClass(1025) == 1280 );
+
+		//at most 25% of padding
+		for(size_t bytes=257; bytes<(1<<20); bytes+=997){
+
+			REQUIRE( pool_t::SizeClass(bytes) >= bytes );
+			REQUIRE( pool_t::SizeClass(bytes) <= bytes + bytes/4 );
+		}
+	}
+
+	SECTION( "blocks are reused" )
+	{
+		char* first = pool.Allocate(10000);
+
+		REQUIRE( pool.GetAllocatedBytes() >= 10000 );
+		REQUIRE( pool.GetCachedBytes() == 0 );
+
+		pool.Deallocate(first);
+
+		REQUIRE( pool.GetAllocatedBytes() == 0 );
+		REQUIRE( pool.GetCachedBytes() >= 10000 );
+
+		//same size class
+		char* second = pool.Allocate(9990);
+
+		REQUIRE( second == first );
+		REQUIRE( pool.GetCachedBytes() == 0 );
+
+		pool.Deallocate(second);
+	}
+
+	SECTION( "Trim, Release and high-water mark" )
+	{
+		char* small = pool.Allocate(1000);
+		char* large = pool.Allocate(100000);
+
+		pool.Deallocate(small);
+		pool.Deallocate(large);
+
+		size_t cached = pool.GetCachedBytes();
+
+		//the largest blocks are freed first
+		pool.Trim(cached - 1);
+
+		REQUIRE( pool.GetCachedBytes() == pool_t::SizeClass(1000) );
+
+		pool.Release();
+
+		REQUIRE( pool.GetCachedBytes() == 0 );
+
+		//no caching
+		pool.SetMaxCachedBytes(0);
+
+		pool.Deallocate( pool.Allocate(1000) );
+
+		REQUIRE( pool.GetCachedBytes() == 0 );
+	}
+
+	SECTION( "temporary buffers of the backend policy" )
+	{
+		hydra::device::vector<double> data(1000000);
+
+		HYDRA_EXTERNAL_NS::thrust::sequence(hydra::device::sys, data.begin(), data.end());
+
+		HYDRA_EXTERNAL_NS::thrust::sort(hydra::device::sys, data.begin(), data.end(),
+				HYDRA_EXTERNAL_NS::thrust::greater<double>());
+
+		REQUIRE( data[0] == 999999.0 );
+		REQUIRE( data[999999] == 0.0 );
+
+		//all buffers returned
+		REQUIRE( pool.GetAllocatedBytes() == 0 );
+
+		//buffers requested with the policy come from the pool and are kept for the next request
+		auto buffer = HYDRA_EXTERNAL_NS::thrust::get_temporary_buffer<double>(hydra::device::sys, 1000);
+
+		REQUIRE( buffer.second == 1000 );
+		REQUIRE( pool.GetAllocatedBytes() == pool_t::SizeClass(1000*sizeof(double)) );
+
+		HYDRA_EXTERNAL_NS::thrust::return_temporary_buffer(hydra::device::sys, buffer.first);
+
+		REQUIRE( pool.GetAllocatedBytes() == 0 );
+		REQUIRE( pool.GetCachedBytes() >= pool_t::SizeClass(1000*sizeof(double)) );
+	}
+
+	pool.SetMaxCachedBytes(max_cached_bytes);
+	pool.Release();
+}
@@ -0,0 +1,164 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * chains.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+#include <cmath>
+
+#include <hydra/device/System.h>
+#include <hydra/Vector4R.h>
+#include <hydra/PhaseSpace.h>
+#include <hydra/Chains.h>
+#include <hydra/Decays.h>
+#include <hydra/Placeholders.h>
+
+using namespace hydra::placeholders;
+
+TEST_CASE( "Chains","hydra::Chains" ) {
+
+	// B0 -> J/psi K pi, J/psi -> mu+ mu-
+	const double masses1[3]{ 3.0969, 0.493677, 0.13957061 };
+	const double masses2[2]{ 0.1056583745, 0.1056583745 };
+
+	hydra::Vector4R B0(5.27955, 0.0, 0.0, 0.0);
+
+	hydra::PhaseSpace<3> phsp1(masses1);
+	hydra::PhaseSpace<2> phsp2(masses2);
+
+	const size_t nentries = 10000;
+
+	//multi-pass generation, decay by decay
+	auto reference = hydra::make_chain<3,2>(hydra::device::sys, nentries);
+
+	phsp1.Generate(B0, reference.GetDecays(_0).begin(), reference.GetDecays(_0).end());
+	phsp2.Generate(reference.GetDecays(_0).GetDaughters(0).begin(), reference.GetDecays(_0).GetDaughters(0).end(),
+			reference.GetDecays(_1).begin());
+
+	auto same_particle = [](hydra::Vector4R const& p, hydra::Vector4R const& q){
+
+		for(int k=0; k<4; k++)
+			if( p.get(k) != Approx(q.get(k)).epsilon(1.0e-12).margin(1.0e-12) ) return false;
+
+		return true;
+	};
+
+	SECTION( "Generate(mother, links, ...) reproduces the multi-pass chain" )
+	{
+		auto chain = hydra::make_chain<3,2>(hydra::device::sys, nentries);
+
+		chain.Generate(B0, {{0,0}}, phsp1, phsp2);
+
+		auto& decays1 = chain.GetDecays(_0);
+		auto& decays2 = chain.GetDecays(_1);
+
+		for(size_t i=0; i<nentries; i++)
+		{
+			double weight1 = reference.GetDecays(_0).GetWeights()[i];
+			double weight2 = reference.GetDecays(_1).GetWeights()[i];
+
+			REQUIRE( weight1*weight2 > 0.0 );
+
+			REQUIRE( decays1.GetWeights()[i] == Approx(weight1).epsilon(1.0e-12) );
+			REQUIRE( decays2.GetWeights()[i] == Approx(weight2).epsilon(1.0e-12) );
+			REQUIRE( chain.GetWeights()[i]   == Approx(weight1*weight2).epsilon(1.0e-12) );
+
+			for(size_t j=0; j<3; j++)
+				REQUIRE( same_particle(decays1.GetParticles(j)[i], reference.GetDecays(_0).GetParticles(j)[i]) );
+
+			for(size_t j=0; j<2; j++)
+				REQUIRE( same_particle(decays2.GetParticles(j)[i], reference.GetDecays(_1).GetParticles(j)[i]) );
+		}
+	}
+
+	SECTION( "GenerateFinalState(mother, links, ...) reproduces the final state of the multi-pass chain" )
+	{
+		auto chain = hydra::make_chain<3,2>(hydra::device::sys, nentries);
+
+		chain.GenerateFinalState(B0, {{0,0}}, phsp1, phsp2);
+
+		for(size_t i=0; i<nentries; i++)
+		{
+			double weight = reference.GetDecays(_0).GetWeights()[i]*reference.GetDecays(_1).GetWeights()[i];
+
+			REQUIRE( chain.GetWeights()[i] == Approx(weight).epsilon(1.0e-12) );
+
+			//K and pi
+			for(size_t j=1; j<3; j++)
+				REQUIRE( same_particle(chain.GetDecays(_0).GetParticles(j)[i], reference.GetDecays(_0).GetParticles(j)[i]) );
+
+			//mu+ and mu-
+			for(size_t j=0; j<2; j++)
+				REQUIRE( same_particle(chain.GetDecays(_1).GetParticles(j)[i], reference.GetDecays(_1).GetParticles(j)[i]) );
+		}
+	}
+
+	SECTION( "Generate(mothers, links, ...) reproduces the multi-pass chain" )
+	{
+		//moving B0 mesons from Upsilon(4S) -> B0 B0bar
+		const double masses0[2]{ 5.27955, 5.27955 };
+
+		hydra::PhaseSpace<2> phsp0(masses0);
+
+		hydra::Decays<2, hydra::device::sys_t> upsilon(nentries);
+
+		phsp0.Generate(hydra::Vector4R(::sqrt(10.5794*10.5794 + 1.0), 0.0, 0.0, 1.0), upsilon.begin(), upsilon.end());
+
+		auto mothers = upsilon.GetDaughters(0);
+
+		auto multi = hydra::make_chain<3,2>(hydra::device::sys, nentries);
+
+		phsp1.Generate(mothers.begin(), mothers.end(), multi.GetDecays(_0).begin());
+		phsp2.Generate(multi.GetDecays(_0).GetDaughters(0).begin(), multi.GetDecays(_0).GetDaughters(0).end(),
+				multi.GetDecays(_1).begin());
+
+		auto fused = hydra::make_chain<3,2>(hydra::device::sys, nentries);
+
+		fused.Generate(mothers.begin(), mothers.end(), {{0,0}}, phsp1, phsp2);
+
+		for(size_t i=0; i<nentries; i++)
+		{
+			double weight1 = multi.GetDecays(_0).GetWeights()[i];
+			double weight2 = multi.GetDecays(_1).GetWeights()[i];
+
+			REQUIRE( weight1*weight2 > 0.0 );
+
+			REQUIRE( fused.GetDecays(_0).GetWeights()[i] == Approx(weight1).epsilon(1.0e-12) );
+			REQUIRE( fused.GetDecays(_1).GetWeights()[i] == Approx(weight2).epsilon(1.0e-12) );
+			REQUIRE( fused.GetWeights()[i] == Approx(weight1*weight2).epsilon(1.0e-12) );
+
+			for(size_t j=0; j<3; j++)
+				REQUIRE( same_particle(fused.GetDecays(_0).GetParticles(j)[i], multi.GetDecays(_0).GetParticles(j)[i]) );
+
+			for(size_t j=0; j<2; j++)
+				REQUIRE( same_particle(fused.GetDecays(_1).GetParticles(j)[i], multi.GetDecays(_1).GetParticles(j)[i]) );
+		}
+	}
+
+}
@@ -0,0 +1,175 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * chunked_source.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+
+#include <hydra/device/System.h>
+#include <hydra/multivector.h>
+#include <hydra/multiarray.h>
+#include <hydra/ChunkedSource.h>
+#include <hydra/ColumnarFile.h>
+#include <hydra/Random.h>
+#include <hydra/Pdf.h>
+#include <hydra/AddPdf.h>
+#include <hydra/LogLikelihoodFCN.h>
+#include <hydra/SPlot.h>
+#include <hydra/DenseHistogram.h>
+#include <hydra/GaussKronrodQuadrature.h>
+#include <hydra/functions/Gaussian.h>
+#include <hydra/functions/Exponential.h>
+#include <hydra/Placeholders.h>
+#include <hydra/detail/external/thrust/copy.h>
+
+#include <cstdio>
+#include <vector>
+
+TEST_CASE( "ChunkedSource","hydra::ChunkedSource" ) {
+
+	using namespace hydra::placeholders;
+
+	typedef hydra::multivector<hydra::tuple<double, double>, hydra::device::sys_t> table_t;
+
+	//chunk sizes not dividing the number of rows
+	const size_t n = 100003;
+	const double min = 0.0, max = 10.0;
+	const std::string filename = "hydra_test_chunked_source.hcol";
+
+	table_t data(n);
+
+	hydra::Random<> generator(1234);
+	generator.Uniform(min, max, data.begin(_0), data.end(_0));
+	generator.Exp(2.0, data.begin(_1), data.end(_1));
+
+	hydra::write_columnar(filename, data, {"x", "y"});
+
+	hydra::ColumnarFile file(filename);
+
+	auto mapped = file.GetChunkedSource<double, double>(hydra::device::sys, 10000);
+
+	auto copied = hydra::make_chunked_source<double, double>(hydra::device::sys, n, 7777,
+			[&data](size_t first, size_t m, table_t& chunk){
+
+		HYDRA_EXTERNAL_NS::thrust::copy(data.begin() + first, data.begin() + first + m, chunk.begin());
+	});
+
+	REQUIRE( mapped.GetNChunks() == 11 );
+	REQUIRE( copied.GetNChunks() == 13 );
+
+	//model
+	hydra::Parameter mean  = hydra::Parameter::Create().Name("Mean").Value(2.5).Error(0.0001).Limits(0.0, 10.0);
+	hydra::Parameter sigma = hydra::Parameter::Create().Name("Sigma").Value(0.5).Error(0.0001).Limits(0.01, 1.5);
+	hydra::Parameter tau   = hydra::Parameter::Create().Name("Tau").Value(-0.5).Error(0.0001).Limits(-10.0, 10.0);
+
+	hydra::GaussKronrodQuadrature<61, 50, hydra::device::sys_t> quadrature(min, max);
+
+	auto gaussian    = hydra::make_pdf(hydra::Gaussian<0>(mean, sigma), quadrature);
+	auto exponential = hydra::make_pdf(hydra::Exponential<0>(tau), quadrature);
+
+	hydra::Parameter ng("N_Gauss", n/2, 1, 0, 2.0*n);
+	hydra::Parameter ne("N_Exp",   n/2, 1, 0, 2.0*n);
+
+	auto model = hydra::add_pdfs({ng, ne}, gaussian, exponential);
+	model.SetExtended(1);
+
+	SECTION( "log-likelihood: chunked and in memory" )
+	{
+		auto fcn_memory = hydra::make_loglikehood_fcn(model, data.begin(), data.end());
+		auto fcn_mapped = hydra::make_loglikehood_fcn(model, mapped);
+		auto fcn_copied = hydra::make_loglikehood_fcn(model, copied);
+
+		auto pdf_memory = hydra::make_loglikehood_fcn(gaussian, data.begin(), data.end());
+		auto pdf_mapped = hydra::make_loglikehood_fcn(gaussian, mapped);
+
+		//copies of the estimators keep the source and the number of entries
+		auto fcn_copy = fcn_mapped;
+
+		REQUIRE( fcn_mapped.GetDataSize() == n );
+		REQUIRE( fcn_copy.GetDataSize() == n );
+		REQUIRE( fcn_copy.GetSource().GetNRows() == n );
+
+		for(int k=0; k<3; k++){
+
+			std::vector<double> parameters{ n/2.0, n/2.0, 2.5 + 0.1*k, 0.5, -0.5 };
+
+			double expected = fcn_memory(parameters);
+
+			REQUIRE( fcn_mapped(parameters) == Approx(expected).epsilon(1.0e-10) );
+			REQUIRE( fcn_copied(parameters) == Approx(expected).epsilon(1.0e-10) );
+			REQUIRE( fcn_copy(parameters)   == Approx(expected).epsilon(1.0e-10) );
+
+			std::vector<double> pdf_parameters{ 2.5 + 0.1*k, 0.5 };
+
+			REQUIRE( pdf_mapped(pdf_parameters) == Approx(pdf_memory(pdf_parameters)).epsilon(1.0e-10) );
+		}
+	}
+
+	SECTION( "histograms: chunked and in memory" )
+	{
+		hydra::DenseHistogram<double, 1, hydra::device::sys_t> h_memory(100, min, max), h_mapped(100, min, max);
+
+		h_memory.Fill(data.begin(_0), data.end(_0));
+		h_mapped.Fill(file.GetChunkedSource<double>(hydra::device::sys, 3000));
+
+		for(size_t i=0; i<102; i++)
+			REQUIRE( h_mapped.GetBinContent(i) == h_memory.GetBinContent(i) );
+
+		hydra::DenseHistogram<double, 2, hydra::device::sys_t>
+			h2_memory({10, 10}, {min, min}, {max, 20.0}), h2_copied({10, 10}, {min, min}, {max, 20.0});
+
+		h2_memory.Fill(data.begin(), data.end());
+		h2_copied.Fill(copied);
+
+		for(size_t i=0; i<h2_memory.GetContents().size(); i++)
+			REQUIRE( h2_copied.GetContents()[i] == h2_memory.GetContents()[i] );
+	}
+
+	SECTION( "sPlot: chunked and in memory" )
+	{
+		auto splot = hydra::make_splot(model);
+
+		hydra::multiarray<double, 2, hydra::device::sys_t> sweights_memory(n), sweights_mapped(n);
+
+		auto covariance_memory = splot.Generate(data.begin(), data.end(), sweights_memory.begin());
+		auto covariance_mapped = splot.Generate(mapped, sweights_mapped.begin());
+
+		for(size_t i=0; i<2; i++)
+			for(size_t j=0; j<2; j++)
+				REQUIRE( covariance_mapped(i, j) == Approx(covariance_memory(i, j)).epsilon(1.0e-8) );
+
+		for(size_t i=0; i<n; i+=97){
+
+			REQUIRE( hydra::get<0>(sweights_mapped[i]) == Approx(hydra::get<0>(sweights_memory[i])).epsilon(1.0e-8) );
+			REQUIRE( hydra::get<1>(sweights_mapped[i]) == Approx(hydra::get<1>(sweights_memory[i])).epsilon(1.0e-8) );
+		}
+	}
+
+	std::remove(filename.c_str());
+}
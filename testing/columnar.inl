@@ -0,0 +1,211 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * columnar.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+
+#include <hydra/device/System.h>
+#include <hydra/multivector.h>
+#include <hydra/multiarray.h>
+#include <hydra/Decays.h>
+#include <hydra/ColumnarFile.h>
+#include <hydra/ChunkedSource.h>
+#include <hydra/Placeholders.h>
+#include <hydra/detail/external/thrust/sequence.h>
+#include <hydra/detail/external/thrust/fill.h>
+
+#include <cstdio>
+#include <stdexcept>
+#include <type_traits>
+
+TEST_CASE( "ColumnarFile","hydra::ColumnarFile" ) {
+
+	using namespace hydra::placeholders;
+
+	const size_t n = 1000;
+	const std::string filename = "hydra_test_columnar.hcol";
+
+	SECTION( "multivector: round trip" )
+	{
+		hydra::multivector<hydra::tuple<double, int, float>, hydra::device::sys_t> data(n);
+
+		for(size_t i=0; i<n; i++) data[i] = hydra::make_tuple(0.5*i, -int(i), float(i));
+
+		hydra::write_columnar(filename, data, {"x", "k", "y"});
+
+		hydra::ColumnarFile file(filename);
+
+		REQUIRE( file.GetAccess() == hydra::kColumnarReadOnly );
+		REQUIRE( file.GetNColumns() == 3 );
+		REQUIRE( file.GetColumnName(1) == "k" );
+		REQUIRE( file.GetColumnType(0) == hydra::kColumnFloat64 );
+		REQUIRE( file.GetColumnType(1) == hydra::kColumnInt32 );
+		REQUIRE( file.GetColumnType(2) == hydra::kColumnFloat32 );
+		REQUIRE( file.GetNRows(2) == n );
+
+		auto view = file.GetView<double, int, float>(hydra::device::sys);
+
+		REQUIRE( view.size() == n );
+
+		for(size_t i=0; i<n; i++){
+
+			REQUIRE( hydra::get<0>(view[i]) == 0.5*i );
+			REQUIRE( hydra::get<1>(view[i]) == -int(i) );
+			REQUIRE( hydra::get<2>(view[i]) == float(i) );
+		}
+
+		auto named = file.GetView<float, double>(hydra::device::sys, {"y", "x"});
+
+		REQUIRE( hydra::get<0>(named[n-1]) == float(n-1) );
+		REQUIRE( hydra::get<1>(named[n-1]) == 0.5*(n-1) );
+
+		//the columns are aligned to 64 bytes in the file
+		REQUIRE( reinterpret_cast<uintptr_t>(file.GetColumn<float>(2)) % 64 == 0 );
+
+		REQUIRE_THROWS_AS( file.GetView<float>(hydra::device::sys, 0), std::invalid_argument );
+		REQUIRE_THROWS_AS( file.GetColumnIndex("z"), std::out_of_range );
+	}
+
+	SECTION( "read-only mapping" )
+	{
+		hydra::multivector<hydra::tuple<double, double>, hydra::device::sys_t> data(n, hydra::make_tuple(1.0, 2.0));
+
+		hydra::write_columnar(filename, data);
+
+		hydra::ColumnarFile file(filename);
+
+		auto view = file.GetView<double, double>(hydra::device::sys);
+
+		typedef decltype(view) view_t;
+
+		REQUIRE( (std::is_same<view_t::iterator, view_t::const_iterator>::value) );
+		REQUIRE( (std::is_same<decltype(file.GetColumn<double>(0)), double const*>::value) );
+
+		REQUIRE_THROWS_AS( (file.GetMutableView<double, double>(hydra::device::sys)), std::logic_error );
+		REQUIRE_THROWS_AS( file.GetMutableColumn<double>(0), std::logic_error );
+	}
+
+	SECTION( "copy-on-write mapping" )
+	{
+		hydra::multivector<hydra::tuple<double, double>, hydra::device::sys_t> data(n, hydra::make_tuple(1.0, 2.0));
+
+		hydra::write_columnar(filename, data);
+
+		{
+			hydra::ColumnarFile file(filename, hydra::kColumnarCopyOnWrite);
+
+			auto view = file.GetMutableView<double, double>(hydra::device::sys);
+
+			view[0] = hydra::make_tuple(-1.0, -2.0);
+
+			REQUIRE( file.GetColumn<double>(0)[0] == -1.0 );
+			REQUIRE( file.GetColumn<double>(1)[0] == -2.0 );
+		}
+
+		//the file is not modified
+		hydra::ColumnarFile file(filename);
+
+		REQUIRE( file.GetColumn<double>(0)[0] == 1.0 );
+		REQUIRE( file.GetColumn<double>(1)[0] == 2.0 );
+	}
+
+	SECTION( "multiarray: round trip" )
+	{
+		hydra::multiarray<double, 3, hydra::device::sys_t> data(n, hydra::make_tuple(1.0, 2.0, 3.0));
+
+		hydra::write_columnar(filename, data);
+
+		hydra::ColumnarFile file(filename);
+
+		auto view = file.GetView<double, double, double>(hydra::device::sys, {"0", "1", "2"});
+
+		REQUIRE( view.size() == n );
+		REQUIRE( hydra::get<2>(view[n-1]) == 3.0 );
+	}
+
+	SECTION( "Decays: round trip" )
+	{
+		hydra::Decays<2, hydra::device::sys_t> decays(n);
+
+		HYDRA_EXTERNAL_NS::thrust::sequence(decays.GetWeights().begin(), decays.GetWeights().end());
+		HYDRA_EXTERNAL_NS::thrust::fill(decays.GetDaughters(1).begin(), decays.GetDaughters(1).end(),
+				hydra::make_tuple(1.0, 0.1, 0.2, 0.3));
+
+		hydra::write_columnar(filename, decays);
+
+		hydra::ColumnarFile file(filename);
+
+		auto view = file.GetView<double, double, double, double>(hydra::device::sys,
+				{"weights", "p1_0", "p1_1", "p1_3"});
+
+		REQUIRE( file.GetNColumns() == 9 );
+
+		for(size_t i=0; i<n; i++){
+
+			REQUIRE( hydra::get<0>(view[i]) == double(i) );
+			REQUIRE( hydra::get<1>(view[i]) == 1.0 );
+			REQUIRE( hydra::get<2>(view[i]) == 0.1 );
+			REQUIRE( hydra::get<3>(view[i]) == 0.3 );
+		}
+	}
+
+	SECTION( "ChunkedSource over the mapped columns" )
+	{
+		hydra::multivector<hydra::tuple<double, double>, hydra::device::sys_t> data(n);
+
+		for(size_t i=0; i<n; i++) data[i] = hydra::make_tuple(double(i), 1.0);
+
+		hydra::write_columnar(filename, data);
+
+		hydra::ColumnarFile file(filename);
+
+		auto source = file.GetChunkedSource<double, double>(hydra::device::sys, 300);
+
+		REQUIRE( source.GetNChunks() == 4 );
+
+		double sum = 0;
+		size_t rows = 0;
+
+		source.ForEachChunk([&](decltype(source)::iterator first, decltype(source)::iterator last, size_t first_row){
+
+			REQUIRE( hydra::get<0>(*first) == double(first_row) );
+
+			for(auto it = first; it != last; it++){
+				sum += hydra::get<0>(*it);
+				rows++;
+			}
+		});
+
+		REQUIRE( rows == n );
+		REQUIRE( sum == 0.5*n*(n-1) );
+	}
+
+	std::remove(filename.c_str());
+}
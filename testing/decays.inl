@@ -0,0 +1,73 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * decays.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+
+#include <hydra/device/System.h>
+#include <hydra/Decays.h>
+#include <hydra/detail/external/thrust/sequence.h>
+
+TEST_CASE( "Decays","hydra::Decays" ) {
+
+	typedef hydra::Decays<2, hydra::device::sys_t> decays_t;
+
+	decays_t decays(10);
+
+	HYDRA_EXTERNAL_NS::thrust::sequence(decays.GetWeights().begin(), decays.GetWeights().end());
+
+	SECTION( "insert and erase" )
+	{
+		decays_t::value_type decay = decays[3];
+
+		HYDRA_EXTERNAL_NS::thrust::get<0>(decay) = 100.0;
+
+		decays.insert(decays.begin() + 2, decay);     // 0 1 100 2 3 ... 9
+		decays.insert(decays.begin() + 5, 3, decay);  // 0 1 100 2 3 100 100 100 4 ... 9
+		decays.erase(decays.begin());                 // 1 100 2 3 100 100 100 4 ... 9
+		decays.erase(decays.begin() + 1, decays.begin() + 3);
+
+		decays_t other(2);
+
+		decays.insert(decays.begin(), other.begin(), other.end());
+
+		const double expected[13]{ 0, 0, 1, 3, 100, 100, 100, 4, 5, 6, 7, 8, 9 };
+
+		REQUIRE( decays.size() == 13 );
+
+		for(size_t i=0; i<13; i++)
+			REQUIRE( HYDRA_EXTERNAL_NS::thrust::get<0>(decays[i]) == expected[i] );
+
+		//the particles are inserted with the weights
+		REQUIRE( decays.GetDaughters(1).size() == 13 );
+		REQUIRE( decays[4] == decay );
+	}
+
+}
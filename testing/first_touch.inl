@@ -0,0 +1,195 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * first_touch.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+#include <vector>
+
+#include <hydra/device/System.h>
+#include <hydra/Tuple.h>
+#include <hydra/multivector.h>
+#include <hydra/Decays.h>
+#include <hydra/Vector4R.h>
+#include <hydra/PhaseSpace.h>
+#include <hydra/detail/FirstTouchAllocator.h>
+#include <hydra/detail/AlignedAllocator.h>
+#include <hydra/detail/external/thrust/sort.h>
+#include <hydra/detail/external/thrust/reduce.h>
+#include <hydra/detail/external/thrust/sequence.h>
+#include <hydra/detail/external/thrust/functional.h>
+
+TEST_CASE( "numa_resize","hydra::multivector, hydra::Decays" ) {
+
+	SECTION( "multivector: grow and shrink" )
+	{
+		hydra::multivector<hydra::tuple<double, int>, hydra::device::sys_t> table(1000);
+
+		for(size_t i=0; i<1000; i++) table[i] = hydra::make_tuple(0.5*i, int(i));
+
+		table.numa_resize(1500);
+
+		REQUIRE( table.size() == 1500 );
+		REQUIRE( table.capacity() == 1500 );
+
+		for(size_t i=0; i<1000; i++)
+			REQUIRE( table[i] == hydra::make_tuple(0.5*i, int(i)) );
+
+		table.numa_resize(300);
+
+		REQUIRE( table.size() == 300 );
+		REQUIRE( table.capacity() == 300 );
+
+		for(size_t i=0; i<300; i++)
+			REQUIRE( table[i] == hydra::make_tuple(0.5*i, int(i)) );
+
+		//same size, new storage
+		table.numa_resize(300);
+
+		for(size_t i=0; i<300; i++)
+			REQUIRE( table[i] == hydra::make_tuple(0.5*i, int(i)) );
+	}
+
+	SECTION( "Decays: grow and shrink" )
+	{
+		const double masses[3]{ 0.13957061, 0.13957061, 0.13957061 };
+
+		hydra::Vector4R mother(0.78265, 0.0, 0.0, 0.0);
+
+		hydra::PhaseSpace<3> phsp(masses);
+
+		hydra::Decays<3, hydra::device::sys_t> decays(1000);
+
+		phsp.Generate(mother, decays.begin(), decays.end());
+
+		hydra::Decays<3, hydra::device::sys_t> original(decays);
+
+		decays.numa_resize(1500);
+
+		REQUIRE( decays.size() == 1500 );
+		REQUIRE( decays.capacity() == 1500 );
+
+		for(size_t i=0; i<1000; i++) REQUIRE( decays[i] == original[i] );
+
+		decays.numa_resize(300);
+
+		REQUIRE( decays.size() == 300 );
+		REQUIRE( decays.capacity() == 300 );
+
+		for(size_t i=0; i<300; i++) REQUIRE( decays[i] == original[i] );
+	}
+
+}
+
+#ifdef _OPENMP
+
+#include <hydra/detail/external/thrust/system/omp/vector.h>
+
+TEST_CASE( "FirstTouchAllocator","hydra::detail::FirstTouchAllocator" ) {
+
+	//the containers of the OMP backend with HYDRA_FIRST_TOUCH_ALLOCATION
+	typedef HYDRA_EXTERNAL_NS::thrust::omp::vector<double,
+			hydra::detail::FirstTouchAllocator<
+				hydra::detail::aligned_allocator_t<HYDRA_EXTERNAL_NS::thrust::omp::allocator<double>>>> first_touch_vector;
+
+	typedef HYDRA_EXTERNAL_NS::thrust::omp::vector<double,
+			hydra::detail::aligned_allocator_t<HYDRA_EXTERNAL_NS::thrust::omp::allocator<double>>> default_vector;
+
+	const size_t n = 100000;
+
+	SECTION( "construction, sort and reduce" )
+	{
+		first_touch_vector touched(n, 1.0);
+		default_vector     other(n, 1.0);
+
+		for(size_t i=0; i<n; i++){
+			touched[i] = double((i*7919)%n);
+			other[i]   = touched[i];
+		}
+
+		HYDRA_EXTERNAL_NS::thrust::sort(touched.begin(), touched.end());
+		HYDRA_EXTERNAL_NS::thrust::sort(other.begin(), other.end());
+
+		for(size_t i=0; i<n; i++) REQUIRE( touched[i] == other[i] );
+
+		REQUIRE( HYDRA_EXTERNAL_NS::thrust::reduce(touched.begin(), touched.end())
+				== HYDRA_EXTERNAL_NS::thrust::reduce(other.begin(), other.end()) );
+	}
+
+	SECTION( "reserve, push_back and resize" )
+	{
+		first_touch_vector touched;
+		default_vector     other;
+
+		touched.reserve(n/2);
+		other.reserve(n/2);
+
+		//the second half reallocates
+		for(size_t i=0; i<n; i++){
+			touched.push_back(0.25*i);
+			other.push_back(0.25*i);
+		}
+
+		REQUIRE( touched.size() == other.size() );
+
+		touched.resize(n + 10, -1.0);
+		other.resize(n + 10, -1.0);
+
+		for(size_t i=0; i<n + 10; i++) REQUIRE( touched[i] == other[i] );
+
+		//copies between the allocators
+		default_vector copy(touched);
+		first_touch_vector back(copy);
+
+		for(size_t i=0; i<n + 10; i++) REQUIRE( back[i] == other[i] );
+	}
+
+	SECTION( "first_touch_resize" )
+	{
+		first_touch_vector touched(n);
+
+		HYDRA_EXTERNAL_NS::thrust::sequence(touched.begin(), touched.end());
+
+		hydra::detail::first_touch_resize(touched, 2*n);
+
+		REQUIRE( touched.size() == 2*n );
+		REQUIRE( touched.capacity() == 2*n );
+
+		for(size_t i=0; i<n; i++) REQUIRE( touched[i] == double(i) );
+
+		hydra::detail::first_touch_resize(touched, n/2);
+
+		REQUIRE( touched.size() == n/2 );
+
+		for(size_t i=0; i<n/2; i++) REQUIRE( touched[i] == double(i) );
+	}
+
+}
+
+#endif //_OPENMP
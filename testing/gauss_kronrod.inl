@@ -0,0 +1,133 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * gauss_kronrod.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+#include <cmath>
+
+#include <hydra/device/System.h>
+#include <hydra/GaussKronrodQuadrature.h>
+#include <hydra/GaussKronrodAdaptiveQuadrature.h>
+#include <hydra/Function.h>
+#include <hydra/FunctionWrapper.h>
+#include <hydra/Tuple.h>
+
+TEST_CASE( "GaussKronrodQuadrature","hydra::GaussKronrodQuadrature" ) {
+
+	SECTION( "multiple integrands in one pass" )
+	{
+		auto cosine = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+			return ::cos(x[0]);
+		});
+
+		auto peak = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+			return ::exp(-0.5*x[0]*x[0]/0.01);
+		});
+
+		hydra::GaussKronrodQuadrature<61, 50, hydra::device::sys_t> quadrature(-1.0, 2.0);
+
+		auto results = quadrature.Integrate( hydra::make_tuple(cosine, peak) );
+
+		REQUIRE( results.size() == 2 );
+
+		auto first  = quadrature.Integrate(cosine);
+		auto second = quadrature.Integrate(peak);
+
+		REQUIRE( results[0].first  == Approx(first.first).epsilon(1.0e-12) );
+		REQUIRE( results[0].second == Approx(first.second).epsilon(1.0e-6) );
+		REQUIRE( results[1].first  == Approx(second.first).epsilon(1.0e-12) );
+		REQUIRE( results[1].second == Approx(second.second).epsilon(1.0e-6) );
+
+		REQUIRE( results[0].first  == Approx(::sin(2.0) + ::sin(1.0)).epsilon(1.0e-12) );
+	}
+
+}
+
+TEST_CASE( "GaussKronrodAdaptiveQuadrature","hydra::GaussKronrodAdaptiveQuadrature" ) {
+
+	SECTION( "narrow Gaussian" )
+	{
+		const double mean = 0.3, sigma = 1.0e-3;
+
+		auto peak = hydra::wrap_lambda( [=] __hydra_dual__ (unsigned int, double* x){
+
+			double t = (x[0] - mean)/sigma;
+
+			return ::exp(-0.5*t*t);
+		});
+
+		const double integral = sigma*::sqrt(0.5*PI)*( ::erf((1.0 - mean)/(sigma*::sqrt(2.0)))
+				- ::erf((-1.0 - mean)/(sigma*::sqrt(2.0))) );
+
+		hydra::GaussKronrodAdaptiveQuadrature<61, 10, hydra::device::sys_t> quadrature(-1.0, 1.0, 1.0e-8);
+
+		auto result = quadrature.Integrate(peak);
+
+		REQUIRE( result.second < 1.0e-8*::fabs(result.first) );
+		REQUIRE( ::fabs(result.first - integral) <= result.second );
+		REQUIRE( quadrature.GetNumberOfNodes() > 10 );
+	}
+
+	SECTION( "integrable singularity" )
+	{
+		auto inverse_sqrt = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+			return 1.0/::sqrt(x[0]);
+		});
+
+		hydra::GaussKronrodAdaptiveQuadrature<61, 10, hydra::device::sys_t> quadrature(0.0, 1.0, 1.0e-6);
+
+		auto result = quadrature.Integrate(inverse_sqrt);
+
+		REQUIRE( result.second < 1.0e-6*::fabs(result.first) );
+		REQUIRE( ::fabs(result.first - 2.0) <= result.second );
+	}
+
+	SECTION( "unreachable tolerance" )
+	{
+		auto inverse_sqrt = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+			return 1.0/::sqrt(x[0]);
+		});
+
+		hydra::GaussKronrodAdaptiveQuadrature<61, 10, hydra::device::sys_t> quadrature(0.0, 1.0, 1.0e-30);
+
+		quadrature.SetMaxNodes(1000);
+
+		auto result = quadrature.Integrate(inverse_sqrt);
+
+		REQUIRE( quadrature.GetNumberOfNodes() <= 1000 );
+		REQUIRE( result.second > 1.0e-30*::fabs(result.first) );
+		REQUIRE( result.first == Approx(2.0).epsilon(1.0e-6) );
+	}
+
+}
@@ -0,0 +1,170 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * genzmalik.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+#include <array>
+#include <cmath>
+
+#include <hydra/device/System.h>
+#include <hydra/GenzMalikQuadrature.h>
+#include <hydra/Function.h>
+#include <hydra/FunctionWrapper.h>
+#include <hydra/Tuple.h>
+
+TEST_CASE( "GenzMalikQuadrature","hydra::GenzMalikQuadrature" ) {
+
+	constexpr size_t N = 3;
+
+	SECTION( "degree seven polynomial" )
+	{
+		std::array<double,N> min{ 0.0, 0.0, 0.0 };
+		std::array<double,N> max{ 1.0, 1.0, 1.0 };
+
+		// integral 1/9 + 1/5 + 1/8
+		auto polynomial = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+			return x[0]*x[0]*x[1]*x[1] + x[2]*x[2]*x[2]*x[2] + x[0]*x[1]*x[2];
+		});
+
+		std::array<size_t,N> grid{ 2, 2, 2 };
+
+		hydra::GenzMalikQuadrature<N, hydra::device::sys_t> quadrature(min, max, grid);
+
+		auto result = quadrature.Integrate(polynomial);
+
+		REQUIRE( result.first == Approx(1.0/9.0 + 1.0/5.0 + 1.0/8.0).epsilon(1.0e-12) );
+	}
+
+	SECTION( "adaptive subdivision" )
+	{
+		std::array<double,N> min{ -1.0, -1.0, -1.0 };
+		std::array<double,N> max{  1.0,  1.0,  1.0 };
+
+		const double sigma = 0.1;
+
+		// normalized Gaussian peak, the limits are at 10 sigma
+		auto peak = hydra::wrap_lambda( [=] __hydra_dual__ (unsigned int, double* x){
+
+			double r2 = 0.0;
+
+			for(size_t i=0; i<N; i++) r2 += x[i]*x[i];
+
+			return ::exp(-0.5*r2/(sigma*sigma))/::pow(2.0*PI*sigma*sigma, 1.5);
+		});
+
+		const double integral = ::pow(::erf(1.0/(sigma*::sqrt(2.0))), 3.0);
+
+		hydra::GenzMalikQuadrature<N, hydra::device::sys_t> quadrature(min, max, 8);
+
+		size_t initial_boxes = quadrature.GetBoxList().size();
+
+		quadrature.SetMaxRelativeError(1.0e-6);
+
+		auto result = quadrature.Integrate(peak);
+
+		REQUIRE( quadrature.GetBoxList().size() > initial_boxes );
+		REQUIRE( result.second <= 1.0e-6*::fabs(result.first) );
+		REQUIRE( result.first == Approx(integral).epsilon(1.0e-5) );
+	}
+
+	SECTION( "multiple integrands in one pass" )
+	{
+		std::array<double,N> min{ -1.0, -1.0, -1.0 };
+		std::array<double,N> max{  1.0,  1.0,  1.0 };
+
+		auto polynomial = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+			return x[0]*x[0]*x[1]*x[1] + x[2]*x[2]*x[2]*x[2] + x[0]*x[1]*x[2];
+		});
+
+		auto peak = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+			double r2 = 0.0;
+
+			for(size_t i=0; i<N; i++) r2 += x[i]*x[i];
+
+			return ::exp(-0.5*r2/0.01);
+		});
+
+		hydra::GenzMalikQuadrature<N, hydra::device::sys_t> quadrature(min, max, 4);
+
+		//refine the boxes on the peak, the tuple integration uses them as they are
+		quadrature.SetMaxRelativeError(1.0e-4);
+		quadrature.Integrate(peak);
+
+		size_t nboxes = quadrature.GetBoxList().size();
+
+		auto results = quadrature.Integrate( hydra::make_tuple(peak, polynomial) );
+
+		REQUIRE( results.size() == 2 );
+		REQUIRE( quadrature.GetBoxList().size() == nboxes );
+
+		//the tolerance is already reached, so the single functor integrations keep the same boxes
+		auto first = quadrature.Integrate(peak);
+
+		REQUIRE( quadrature.GetBoxList().size() == nboxes );
+
+		quadrature.SetMaxRelativeError(0.0);
+
+		auto second = quadrature.Integrate(polynomial);
+
+		REQUIRE( results[0].first  == Approx(first.first).epsilon(1.0e-12) );
+		REQUIRE( results[0].second == Approx(first.second).epsilon(1.0e-12) );
+		REQUIRE( results[1].first  == Approx(second.first).epsilon(1.0e-12) );
+		REQUIRE( results[1].second == Approx(second.second).epsilon(1.0e-12) );
+	}
+
+	SECTION( "maximum number of boxes" )
+	{
+		std::array<double,N> min{ -1.0, -1.0, -1.0 };
+		std::array<double,N> max{  1.0,  1.0,  1.0 };
+
+		auto peak = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+			double r2 = 0.0;
+
+			for(size_t i=0; i<N; i++) r2 += x[i]*x[i];
+
+			return ::exp(-0.5*r2/0.0025);
+		});
+
+		hydra::GenzMalikQuadrature<N, hydra::device::sys_t> quadrature(min, max, 8);
+
+		quadrature.SetMaxRelativeError(1.0e-12);
+		quadrature.SetMaxBoxes(1000);
+
+		quadrature.Integrate(peak);
+
+		REQUIRE( quadrature.GetBoxList().size() <= 1000 );
+		REQUIRE( quadrature.GetBoxList().size() > 8 );
+	}
+
+}
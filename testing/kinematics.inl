@@ -0,0 +1,104 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * kinematics.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+#include <array>
+#include <cmath>
+
+#include <hydra/device/System.h>
+#include <hydra/Vector4R.h>
+#include <hydra/PhaseSpace.h>
+#include <hydra/Decays.h>
+#include <hydra/Kinematics.h>
+#include <hydra/multivector.h>
+#include <hydra/functions/CosHelicityAngle.h>
+
+TEST_CASE( "compute_kinematics","hydra::compute_kinematics" ) {
+
+	typedef hydra::Decays<3, hydra::device::sys_t> decays_t;
+
+	typedef hydra::multivector<hydra::tuple<double, double, double, double, double, double, double>,
+			hydra::device::sys_t> table_t;
+
+	// B0 -> J/psi K pi
+	const double masses[3]{ 3.0969, 0.493677, 0.13957061 };
+
+	hydra::Vector4R mother(5.27955, 0.0, 0.0, 0.0);
+
+	hydra::PhaseSpace<3> phsp(masses);
+
+	decays_t decays(10000);
+
+	phsp.Generate(mother, decays.begin(), decays.end());
+
+	std::array<hydra::KinematicVariable, 7> variables{ {
+		hydra::KinematicVariable::MassSquared({0,1}),
+		hydra::KinematicVariable::MassSquared({1,2}),
+		hydra::KinematicVariable::CosHelicity({}, {1,2}, {1}),
+		hydra::KinematicVariable::CosHelicity({}, {0,1}, {0}),
+		hydra::KinematicVariable::Boosted({1}, 0, {1,2}),
+		hydra::KinematicVariable::Boosted({1}, 3, {1,2}),
+		hydra::KinematicVariable::Boosted({1,2}, 1, {1,2})
+	} };
+
+	table_t table;
+
+	hydra::compute_kinematics(decays, variables, table);
+
+	REQUIRE( table.size() == decays.size() );
+
+	hydra::CosHelicityAngle cos_helicity;
+
+	for(size_t i=0; i<decays.size(); i++)
+	{
+		hydra::Vector4R p0 = decays.GetParticles(0)[i];
+		hydra::Vector4R p1 = decays.GetParticles(1)[i];
+		hydra::Vector4R p2 = decays.GetParticles(2)[i];
+
+		hydra::Vector4R p12 = p1 + p2;
+
+		hydra::Vector4R boosted = p1;
+		boosted.applyBoostTo(p12, true);
+
+		auto row = table[i];
+
+		REQUIRE( hydra::get<0>(row) == Approx( (p0 + p1).mass2() ).epsilon(1.0e-10) );
+		REQUIRE( hydra::get<1>(row) == Approx( p12.mass2() ).epsilon(1.0e-10) );
+		REQUIRE( hydra::get<2>(row) == Approx( cos_helicity(p0 + p12, p12, p1) ).margin(1.0e-9) );
+		REQUIRE( hydra::get<3>(row) == Approx( cos_helicity(p0 + p12, p0 + p1, p0) ).margin(1.0e-9) );
+		REQUIRE( hydra::get<4>(row) == Approx( boosted.get(0) ).epsilon(1.0e-10) );
+		REQUIRE( hydra::get<5>(row) == Approx( boosted.get(3) ).margin(1.0e-9) );
+
+		//the frame is at rest in its own rest frame
+		REQUIRE( hydra::get<6>(row) == Approx(0.0).margin(1.0e-9) );
+	}
+
+}
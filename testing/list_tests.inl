@@ -30,6 +30,27 @@
 #define LIST_TESTS_INL_
 
 #include <testing/multivector.inl>
+#include <testing/mothertable.inl>
+#include <testing/phasespace_average.inl>
+#include <testing/vegas.inl>
+#include <testing/quasimc.inl>
+#include <testing/miser.inl>
+#include <testing/genzmalik.inl>
+#include <testing/sparsegrid.inl>
+#include <testing/caching_pool.inl>
+#include <testing/rebind.inl>
+#include <testing/columnar.inl>
+#include <testing/chunked_source.inl>
+#include <testing/decays.inl>
+#include <testing/multiblock.inl>
+#include <testing/spans.inl>
+#include <testing/reduced_precision.inl>
+#include <testing/gauss_kronrod.inl>
+#include <testing/plain.inl>
+#include <testing/policies.inl>
+#include <testing/kinematics.inl>
+#include <testing/first_touch.inl>
+#include <testing/chains.inl>
 //#include <testing/multiarray.inl>
 
 #endif /* LIST_TESTS_INL_ */
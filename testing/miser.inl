@@ -0,0 +1,105 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * miser.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+#include <cmath>
+
+#include <hydra/device/System.h>
+#include <hydra/Miser.h>
+#include <hydra/Plain.h>
+#include <hydra/Function.h>
+#include <hydra/FunctionWrapper.h>
+
+TEST_CASE( "Miser","hydra::Miser" ) {
+
+	constexpr size_t N = 3;
+
+	double min[N]{ -1.0, -1.0, -1.0 };
+	double max[N]{  1.0,  1.0,  1.0 };
+
+	// indicator of the unit ball, integral 4*pi/3
+	auto ball = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+		double r2 = 0.0;
+
+		for(size_t i=0; i<N; i++) r2 += x[i]*x[i];
+
+		return r2 < 1.0 ? 1.0 : 0.0;
+	});
+
+	// narrow Gaussian in a corner, where the stratification pays off
+	auto peak = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+		double r2 = 0.0;
+
+		for(size_t i=0; i<N; i++) r2 += (x[i] - 0.5)*(x[i] - 0.5);
+
+		return ::exp(-0.5*r2/0.01)/::pow(2.0*PI*0.01, 1.5);
+	});
+
+	const size_t calls = 500000;
+
+	SECTION( "known integral" )
+	{
+		hydra::Miser<N, hydra::device::sys_t> miser(min, max, calls);
+
+		auto result = miser.Integrate(ball);
+
+		REQUIRE( result.second > 0.0 );
+		REQUIRE( ::fabs(result.first - 4.0*PI/3.0) < 5.0*result.second );
+		REQUIRE( result.first  == miser.GetResult() );
+		REQUIRE( result.second == miser.GetAbsError() );
+	}
+
+	SECTION( "error below plain Monte Carlo" )
+	{
+		hydra::Miser<N, hydra::device::sys_t> miser(min, max, calls);
+		hydra::Plain<N, hydra::device::sys_t> plain(min, max, calls);
+
+		auto stratified = miser.Integrate(peak);
+		auto random     = plain.Integrate(peak);
+
+		REQUIRE( ::fabs(stratified.first - 1.0) < 5.0*stratified.second );
+		REQUIRE( stratified.second < random.second );
+	}
+
+	SECTION( "no recursion below the minimum number of calls" )
+	{
+		hydra::Miser<N, hydra::device::sys_t> miser(min, max, 1000);
+
+		miser.SetMinCallsPerBisection(2000);
+
+		auto result = miser.Integrate(ball);
+
+		REQUIRE( ::fabs(result.first - 4.0*PI/3.0) < 5.0*result.second );
+	}
+
+}
@@ -0,0 +1,128 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * mothertable.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+#include <catch/catch.hpp>
+#include <vector>
+
+#include <hydra/device/System.h>
+#include <hydra/Vector4R.h>
+#include <hydra/Decays.h>
+#include <hydra/multivector.h>
+#include <hydra/PhaseSpace.h>
+#include <hydra/MotherTable.h>
+#include <hydra/Function.h>
+#include <hydra/FunctionWrapper.h>
+#include <hydra/detail/external/thrust/copy.h>
+
+TEST_CASE( "MotherTable","hydra::MotherTable" ) {
+
+	const double masses[3]{ 0.13957061, 0.493677, 0.13957061 };
+
+	const size_t nmothers = 1000;
+
+	typedef hydra::multivector<hydra::tuple<double,double,double,double>, hydra::device::sys_t> mothers_t;
+
+	mothers_t mothers(nmothers);
+
+	for(size_t i=0; i<nmothers; i++)
+		mothers[i] = hydra::make_tuple(2.0 + 0.001*(i%7), 0.01*(i%13), -0.02*(i%5), 0.5 + 0.001*i);
+
+	hydra::PhaseSpace<3> phsp(masses);
+
+	hydra::MotherTable<3, hydra::device::sys_t> table(masses, mothers.begin(), mothers.end());
+
+	SECTION( "columns" )
+	{
+		REQUIRE( table.size() == nmothers );
+		REQUIRE( table.IsPhysical() == true );
+
+		std::vector<double> tecmtm(nmothers), px(nmothers);
+
+		HYDRA_EXTERNAL_NS::thrust::copy(table.GetData().begin(hydra::detail::MOTHER_TECMTM),
+				table.GetData().end(hydra::detail::MOTHER_TECMTM), tecmtm.begin());
+		HYDRA_EXTERNAL_NS::thrust::copy(table.GetData().begin(hydra::detail::MOTHER_PX),
+				table.GetData().end(hydra::detail::MOTHER_PX), px.begin());
+
+		for(size_t i=0; i<nmothers; i++){
+
+			hydra::Vector4R mother(mothers[i]);
+
+			REQUIRE( tecmtm[i] == Approx(mother.mass() - masses[0] - masses[1] - masses[2]) );
+			REQUIRE( px[i]     == Approx(mother.get(1)) );
+		}
+	}
+
+	SECTION( "unphysical mothers" )
+	{
+		mothers_t light(1, hydra::make_tuple(0.5, 0.0, 0.0, 0.0));
+
+		hydra::MotherTable<3, hydra::device::sys_t> unphysical(masses, light.begin(), light.end());
+
+		REQUIRE( unphysical.IsPhysical() == false );
+	}
+
+	SECTION( "Generate(table, ...) == Generate(mothers, ...)" )
+	{
+		hydra::Decays<3, hydra::device::sys_t> from_table(nmothers);
+		hydra::Decays<3, hydra::device::sys_t> from_mothers(nmothers);
+
+		phsp.Generate(table, from_table.begin());
+		phsp.Generate(mothers.begin(), mothers.end(), from_mothers.begin());
+
+		for(size_t i=0; i<nmothers; i++){
+
+			auto decay_table   = from_table[i];
+			auto decay_mothers = from_mothers[i];
+
+			REQUIRE( hydra::get<0>(decay_table) == Approx( hydra::get<0>(decay_mothers) ) );
+
+			hydra::Vector4R p_table   = hydra::get<2>(decay_table);
+			hydra::Vector4R p_mothers = hydra::get<2>(decay_mothers);
+
+			for(unsigned j=0; j<4; j++)
+				REQUIRE( p_table.get(j) == Approx( p_mothers.get(j) ) );
+		}
+	}
+
+	SECTION( "AverageOn(table, ...) == AverageOn(mothers, ...)" )
+	{
+		auto mass_12 = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, hydra::Vector4R* p){
+
+			return (p[0] + p[1]).mass();
+		});
+
+		auto from_table   = phsp.AverageOn(table, mass_12);
+		auto from_mothers = phsp.AverageOn(mothers.begin(), mothers.end(), mass_12);
+
+		REQUIRE( from_table.first  == Approx( from_mothers.first ) );
+		REQUIRE( from_table.second == Approx( from_mothers.second ) );
+	}
+
+}
@@ -0,0 +1,115 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * multiblock.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+
+#include <hydra/device/System.h>
+#include <hydra/multiblock.h>
+#include <hydra/Placeholders.h>
+
+TEST_CASE( "multiblock","hydra::multiblock" ) {
+
+	using namespace hydra::placeholders;
+
+	typedef hydra::multiblock<hydra::tuple<double, int>, 4, hydra::device::sys_t> block_t;
+
+	block_t data(10);
+
+	for(size_t i=0; i<10; i++)
+		data[i] = hydra::make_tuple(double(i), int(i));
+
+	SECTION( "blocks" )
+	{
+		REQUIRE( data.size() == 10 );
+		REQUIRE( data.blocks().size() == 3 );
+		REQUIRE( data.capacity() == 12 );
+
+		data.push_back(hydra::make_tuple(10.0, 10));
+		data.push_back(hydra::make_tuple(11.0, 11));
+		data.push_back(hydra::make_tuple(12.0, 12));
+
+		REQUIRE( data.size() == 13 );
+		REQUIRE( data.blocks().size() == 4 );
+		REQUIRE( data[12] == hydra::make_tuple(12.0, 12) );
+
+		data.pop_back();
+		data.pop_back();
+
+		REQUIRE( data.size() == 11 );
+		REQUIRE( data.blocks().size() == 3 );
+
+		//rows of the last block beyond the size are cleared on growth
+		data.resize(12);
+
+		REQUIRE( data[11] == hydra::make_tuple(0.0, 0) );
+
+		//column iterators walk across the blocks
+		for(size_t i=0; i<11; i++)
+			REQUIRE( data.begin(_0)[i] == double(i) );
+	}
+
+	SECTION( "insert and erase across blocks" )
+	{
+		data.insert(data.begin() + 3, hydra::make_tuple(-1.0, -1)); // 0 1 2 -1 3 4 5 6 7 8 9
+		data.erase(data.begin() + 5, data.begin() + 8);              // 0 1 2 -1 3 7 8 9
+		data.insert(data.begin() + 1, 2, hydra::make_tuple(-2.0, -2));
+
+		const int expected[10]{ 0, -2, -2, 1, 2, -1, 3, 7, 8, 9 };
+
+		REQUIRE( data.size() == 10 );
+		REQUIRE( data.blocks().size() == 3 );
+
+		for(size_t i=0; i<10; i++)
+		{
+			REQUIRE( data.begin(_0)[i] == double(expected[i]) );
+			REQUIRE( data.begin(_1)[i] == expected[i] );
+		}
+
+		block_t other(5, hydra::make_tuple(50.0, 50));
+
+		data.insert(data.begin() + 9, other.begin(), other.end());
+
+		REQUIRE( data.size() == 15 );
+		REQUIRE( data.blocks().size() == 4 );
+		REQUIRE( data[8]  == hydra::make_tuple(8.0, 8) );
+		REQUIRE( data[9]  == hydra::make_tuple(50.0, 50) );
+		REQUIRE( data[13] == hydra::make_tuple(50.0, 50) );
+		REQUIRE( data[14] == hydra::make_tuple(9.0, 9) );
+
+		data.erase(data.begin(), data.begin() + 12);
+
+		REQUIRE( data.size() == 3 );
+		REQUIRE( data.blocks().size() == 1 );
+		REQUIRE( data[0] == hydra::make_tuple(50.0, 50) );
+		REQUIRE( data[2] == hydra::make_tuple(9.0, 9) );
+	}
+
+}
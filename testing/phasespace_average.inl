@@ -0,0 +1,118 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * phasespace_average.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+#include <catch/catch.hpp>
+#include <cmath>
+
+#include <hydra/device/System.h>
+#include <hydra/Vector4R.h>
+#include <hydra/PhaseSpace.h>
+#include <hydra/PhaseSpaceIntegrator.h>
+#include <hydra/Function.h>
+#include <hydra/FunctionWrapper.h>
+
+TEST_CASE( "PhaseSpace::AverageOn","hydra::PhaseSpace" ) {
+
+	// two-body decay at rest: the cosine of the polar angle is uniform,
+	// so <cos^2> = 1/3 and its variance is 1/5 - 1/9 = 4/45
+	const double masses[2]{ 0.13957061, 0.13957061 };
+
+	const size_t nsamples = 100000;
+
+	hydra::Vector4R mother(0.497611, 0.0, 0.0, 0.0);
+
+	hydra::PhaseSpace<2> phsp(masses);
+
+	auto cos2 = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, hydra::Vector4R* p){
+
+		double cos_theta = p[0].get(3)/p[0].d3mag();
+
+		return cos_theta*cos_theta;
+	});
+
+	const double mean  = 1.0/3.0;
+	const double error = ::sqrt(4.0/45.0/nsamples);
+
+	SECTION( "plain: standard error of the mean" )
+	{
+		auto result = phsp.AverageOn(hydra::device::sys, mother, cos2, nsamples);
+
+		REQUIRE( result.second == Approx(error).epsilon(0.05) );
+	}
+
+	SECTION( "PlainSampling: same error definition as the plain overload" )
+	{
+		auto result = phsp.AverageOn(hydra::device::sys, mother, cos2, nsamples, hydra::PlainSampling);
+
+		REQUIRE( result.second == Approx(error).epsilon(0.05) );
+		REQUIRE( ::fabs(result.first - mean) < 5*result.second );
+	}
+
+	SECTION( "variance reduced sampling" )
+	{
+		hydra::PhaseSpaceSampling samplings[3]{ hydra::StratifiedSampling,
+			hydra::AntitheticSampling, hydra::QuasiRandomSampling };
+
+		for(auto sampling : samplings){
+
+			auto result = phsp.AverageOn(hydra::device::sys, mother, cos2, nsamples, sampling);
+
+			REQUIRE( result.second > 0.0 );
+			REQUIRE( ::fabs(result.first - mean) < 5*result.second );
+		}
+
+		auto stratified = phsp.AverageOn(hydra::device::sys, mother, cos2, nsamples, hydra::StratifiedSampling);
+		auto quasi      = phsp.AverageOn(hydra::device::sys, mother, cos2, nsamples, hydra::QuasiRandomSampling);
+
+		REQUIRE( stratified.second < 1.05*error );
+		REQUIRE( quasi.second      < 0.1*error );
+	}
+
+	SECTION( "PhaseSpaceIntegrator adaptive mode" )
+	{
+		hydra::PhaseSpaceIntegrator<2, hydra::device::sys_t> integrator(mother.mass(), masses, 10000);
+
+		integrator.SetTolerance(1.0e-3);
+
+		auto result = integrator.Integrate(cos2);
+
+		REQUIRE( result.second <= 1.0e-3*result.first );
+		REQUIRE( ::fabs(result.first - mean) < 5*result.second );
+
+		//unreachable tolerance, stopped by the number of batches
+		integrator.SetTolerance(1.0e-12);
+		integrator.SetMaxBatches(3);
+
+		integrator.Integrate(cos2);
+
+		REQUIRE( integrator.GetNSamplesUsed() == 3*10000 );
+	}
+
+}
@@ -0,0 +1,191 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * plain.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+#include <cmath>
+#include <vector>
+
+#include <hydra/device/System.h>
+#include <hydra/Plain.h>
+#include <hydra/Function.h>
+#include <hydra/FunctionWrapper.h>
+#include <hydra/Parameter.h>
+#include <hydra/functions/Gaussian.h>
+#include <hydra/Tuple.h>
+
+TEST_CASE( "Plain","hydra::Plain" ) {
+
+	constexpr size_t N = 3;
+
+	double min[N]{ -1.0, -1.0, -1.0 };
+	double max[N]{  1.0,  1.0,  1.0 };
+
+	const size_t calls = 200000;
+
+	SECTION( "multiple integrands in one pass" )
+	{
+		// indicator of the unit ball, integral 4*pi/3
+		auto ball = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+			double r2 = 0.0;
+
+			for(size_t i=0; i<N; i++) r2 += x[i]*x[i];
+
+			return r2 < 1.0 ? 1.0 : 0.0;
+		});
+
+		auto product = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+			return x[0]*x[0]*x[1]*x[1]*x[2]*x[2];
+		});
+
+		hydra::Plain<N, hydra::device::sys_t> plain(min, max, calls, 4357);
+
+		auto results = plain.Integrate( hydra::make_tuple(ball, product) );
+
+		REQUIRE( results.size() == 2 );
+		REQUIRE( plain.GetResult()   == results[0].first );
+		REQUIRE( plain.GetAbsError() == results[0].second );
+
+		//same seed, same sample points
+		hydra::Plain<N, hydra::device::sys_t> single(min, max, calls, 4357);
+
+		auto first  = single.Integrate(ball);
+		auto second = single.Integrate(product);
+
+		REQUIRE( results[0].first  == Approx(first.first).epsilon(1.0e-10) );
+		REQUIRE( results[0].second == Approx(first.second).epsilon(1.0e-6) );
+		REQUIRE( results[1].first  == Approx(second.first).epsilon(1.0e-10) );
+		REQUIRE( results[1].second == Approx(second.second).epsilon(1.0e-6) );
+
+		REQUIRE( ::fabs(results[1].first - 8.0/27.0) < 5.0*results[1].second );
+	}
+
+
+	SECTION( "parameter gradient" )
+	{
+		double lower[1]{ -1.0 };
+		double upper[1]{  3.0 };
+
+		const double mean = 0.5, sigma = 0.7;
+
+		hydra::Parameter mean_p  = hydra::Parameter::Create().Name("mean").Value(mean);
+		hydra::Parameter sigma_p = hydra::Parameter::Create().Name("sigma").Value(sigma);
+
+		auto integrate = [&](double mean, double sigma){
+
+			hydra::Parameter mean_p  = hydra::Parameter::Create().Name("mean").Value(mean);
+			hydra::Parameter sigma_p = hydra::Parameter::Create().Name("sigma").Value(sigma);
+
+			hydra::Plain<1, hydra::device::sys_t> plain(lower, upper, calls, 4357);
+
+			return plain.Integrate( hydra::Gaussian<>(mean_p, sigma_p) );
+		};
+
+		hydra::Plain<1, hydra::device::sys_t> plain(lower, upper, calls, 4357);
+
+		std::vector<std::pair<double, double>> gradient;
+
+		auto result = plain.Integrate( hydra::Gaussian<>(mean_p, sigma_p), gradient );
+
+		REQUIRE( gradient.size() == 2 );
+
+		//the value is integrated as by Integrate(functor)
+		auto value = integrate(mean, sigma);
+
+		REQUIRE( result.first  == Approx(value.first).epsilon(1.0e-10) );
+		REQUIRE( result.second == Approx(value.second).epsilon(1.0e-6) );
+
+		// unnormalized Gaussian over [a, b]: dI/dmean = f(a) - f(b),
+		// dI/dsigma = (I - (b - mean) f(b) + (a - mean) f(a))/sigma
+		auto f = [=](double x){ return ::exp(-0.5*(x - mean)*(x - mean)/(sigma*sigma)); };
+
+		const double a = lower[0], b = upper[0];
+		const double norm = sigma*::sqrt(0.5*PI)*( ::erf((b - mean)/(sigma*::sqrt(2.0)))
+				- ::erf((a - mean)/(sigma*::sqrt(2.0))) );
+
+		const double dmean  = f(a) - f(b);
+		const double dsigma = (norm - (b - mean)*f(b) + (a - mean)*f(a))/sigma;
+
+		REQUIRE( gradient[0].second > 0.0 );
+		REQUIRE( gradient[1].second > 0.0 );
+		REQUIRE( ::fabs(gradient[0].first - dmean)  < 5.0*gradient[0].second );
+		REQUIRE( ::fabs(gradient[1].first - dsigma) < 5.0*gradient[1].second );
+
+		//central finite differences of Integrate(functor)
+		const double h = 1.0e-3;
+
+		auto mean_up     = integrate(mean + h, sigma);
+		auto mean_down   = integrate(mean - h, sigma);
+		auto sigma_up    = integrate(mean, sigma + h);
+		auto sigma_down  = integrate(mean, sigma - h);
+
+		const double fd_mean  = (mean_up.first  - mean_down.first )/(2.0*h);
+		const double fd_sigma = (sigma_up.first - sigma_down.first)/(2.0*h);
+
+		//same sample points, so only the truncation of the differences remains
+		REQUIRE( gradient[0].first == Approx(fd_mean).epsilon(1.0e-5) );
+		REQUIRE( gradient[1].first == Approx(fd_sigma).epsilon(1.0e-5) );
+
+		//the derivatives integrated as separate functors over the same calls have the same errors
+		auto gaussian = hydra::wrap_lambda( [=] __hydra_dual__ (unsigned int, double* x){
+
+			double d = x[0] - mean;
+
+			return ::exp(-0.5*d*d/(sigma*sigma));
+		});
+
+		auto gaussian_dmean = hydra::wrap_lambda( [=] __hydra_dual__ (unsigned int, double* x){
+
+			double d = x[0] - mean;
+
+			return ::exp(-0.5*d*d/(sigma*sigma))*d/(sigma*sigma);
+		});
+
+		auto gaussian_dsigma = hydra::wrap_lambda( [=] __hydra_dual__ (unsigned int, double* x){
+
+			double d = x[0] - mean;
+
+			return ::exp(-0.5*d*d/(sigma*sigma))*d*d/(sigma*sigma*sigma);
+		});
+
+		hydra::Plain<1, hydra::device::sys_t> other(lower, upper, calls, 4357);
+
+		auto derivatives = other.Integrate( hydra::make_tuple(gaussian, gaussian_dmean, gaussian_dsigma) );
+
+		for(size_t k=0; k<2; k++)
+		{
+			REQUIRE( gradient[k].first  == Approx(derivatives[k+1].first).epsilon(1.0e-10) );
+			REQUIRE( gradient[k].second == Approx(derivatives[k+1].second).epsilon(1.0e-6) );
+		}
+	}
+
+}
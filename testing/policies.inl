@@ -0,0 +1,213 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * policies.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+#include <algorithm>
+#include <vector>
+
+#include <hydra/detail/Config.h>
+#include <hydra/detail/external/thrust/for_each.h>
+#include <hydra/detail/external/thrust/sort.h>
+#include <hydra/detail/external/thrust/reduce.h>
+#include <hydra/detail/external/thrust/functional.h>
+#include <hydra/detail/external/thrust/iterator/counting_iterator.h>
+#include <hydra/detail/external/thrust/iterator/constant_iterator.h>
+
+#ifdef _OPENMP
+
+#include <omp.h>
+#include <hydra/omp/System.h>
+
+TEST_CASE( "OMP policy","hydra::omp::sys_t" ) {
+
+	const int threads = 2;
+	const size_t n = 100000;
+
+	hydra::omp::sys_t policy(threads, 16);
+
+	//threads of the parallel regions, indexed by the thread number
+	std::vector<int> observed(std::max(omp_get_max_threads(), threads) + 1, 0);
+	int* observed_ptr = observed.data();
+
+	auto record = [observed_ptr](){ observed_ptr[omp_get_thread_num()] = omp_get_num_threads(); };
+
+	auto check_threads = [&observed, threads](){
+
+		for(auto count: observed) REQUIRE( count <= threads );
+
+		std::fill(observed.begin(), observed.end(), 0);
+	};
+
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<int> first(0);
+
+	SECTION( "for_each" )
+	{
+		std::vector<int> values(n, 0);
+		int* values_ptr = values.data();
+
+		HYDRA_EXTERNAL_NS::thrust::for_each(policy, first, first + n,
+				[values_ptr, record](int i){ record(); values_ptr[i] = 2*i; });
+
+		for(size_t i=0; i<n; i++) REQUIRE( values[i] == 2*int(i) );
+
+		check_threads();
+	}
+
+	SECTION( "sort" )
+	{
+		hydra::omp::vector<int> values(n);
+
+		for(size_t i=0; i<n; i++) values[i] = int((i*7919)%n);
+
+		HYDRA_EXTERNAL_NS::thrust::sort(policy, values.begin(), values.end(),
+				[record](int a, int b){ record(); return a < b; });
+
+		for(size_t i=0; i<n; i++) REQUIRE( values[i] == int(i) );
+
+		check_threads();
+	}
+
+	SECTION( "reduce" )
+	{
+		long sum = HYDRA_EXTERNAL_NS::thrust::reduce(policy, first, first + n, 0L,
+				[record](long a, long b){ record(); return a + b; });
+
+		REQUIRE( sum == long(n)*long(n - 1)/2 );
+
+		check_threads();
+	}
+
+	SECTION( "reduce_by_key" )
+	{
+		//ten values per key
+		hydra::omp::vector<int> keys(n);
+
+		for(size_t i=0; i<n; i++) keys[i] = int(i/10);
+
+		hydra::omp::vector<int> unique_keys(n/10);
+		hydra::omp::vector<int> counts(n/10);
+
+		auto end = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(policy, keys.begin(), keys.end(),
+				HYDRA_EXTERNAL_NS::thrust::make_constant_iterator(1), unique_keys.begin(), counts.begin());
+
+		REQUIRE( size_t(end.first - unique_keys.begin()) == n/10 );
+
+		for(size_t i=0; i<n/10; i++)
+		{
+			REQUIRE( unique_keys[i] == int(i) );
+			REQUIRE( counts[i] == 10 );
+		}
+	}
+
+}
+
+#endif //_OPENMP
+
+#if (HYDRA_THRUST_DEVICE_SYSTEM == HYDRA_THRUST_DEVICE_SYSTEM_TBB)
+
+#include <tbb/task_arena.h>
+#include <hydra/tbb/System.h>
+
+TEST_CASE( "TBB policy","hydra::tbb::sys_t" ) {
+
+	const int threads = 2;
+	const size_t n = 100000;
+
+	::tbb::task_arena arena(threads);
+
+	hydra::tbb::sys_t policy(arena, 64);
+
+	//the calls run inside the arena of the policy
+	auto in_arena = [threads](){ return ::tbb::this_task_arena::max_concurrency() <= threads; };
+
+	HYDRA_EXTERNAL_NS::thrust::counting_iterator<int> first(0);
+
+	SECTION( "for_each" )
+	{
+		std::vector<int> values(n, 0);
+		std::vector<char> inside(n, 0);
+		int*  values_ptr = values.data();
+		char* inside_ptr = inside.data();
+
+		HYDRA_EXTERNAL_NS::thrust::for_each(policy, first, first + n,
+				[values_ptr, inside_ptr, in_arena](int i){ values_ptr[i] = 2*i; inside_ptr[i] = in_arena(); });
+
+		for(size_t i=0; i<n; i++)
+		{
+			REQUIRE( values[i] == 2*int(i) );
+			REQUIRE( inside[i] == 1 );
+		}
+	}
+
+	SECTION( "sort" )
+	{
+		hydra::tbb::vector<int> values(n);
+
+		for(size_t i=0; i<n; i++) values[i] = int((i*7919)%n);
+
+		HYDRA_EXTERNAL_NS::thrust::sort(policy, values.begin(), values.end());
+
+		for(size_t i=0; i<n; i++) REQUIRE( values[i] == int(i) );
+	}
+
+	SECTION( "reduce" )
+	{
+		long sum = HYDRA_EXTERNAL_NS::thrust::reduce(policy, first, first + n, 0L,
+				HYDRA_EXTERNAL_NS::thrust::plus<long>());
+
+		REQUIRE( sum == long(n)*long(n - 1)/2 );
+	}
+
+	SECTION( "reduce_by_key" )
+	{
+		//ten values per key
+		hydra::tbb::vector<int> keys(n);
+
+		for(size_t i=0; i<n; i++) keys[i] = int(i/10);
+
+		hydra::tbb::vector<int> unique_keys(n/10);
+		hydra::tbb::vector<int> counts(n/10);
+
+		auto end = HYDRA_EXTERNAL_NS::thrust::reduce_by_key(policy, keys.begin(), keys.end(),
+				HYDRA_EXTERNAL_NS::thrust::make_constant_iterator(1), unique_keys.begin(), counts.begin());
+
+		REQUIRE( size_t(end.first - unique_keys.begin()) == n/10 );
+
+		for(size_t i=0; i<n/10; i++)
+		{
+			REQUIRE( unique_keys[i] == int(i) );
+			REQUIRE( counts[i] == 10 );
+		}
+	}
+
+}
+
+#endif //HYDRA_THRUST_DEVICE_SYSTEM_TBB
@@ -0,0 +1,102 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * quasimc.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+#include <cmath>
+
+#include <hydra/device/System.h>
+#include <hydra/QuasiMC.h>
+#include <hydra/Plain.h>
+#include <hydra/Function.h>
+#include <hydra/FunctionWrapper.h>
+
+TEST_CASE( "QuasiMC","hydra::QuasiMC" ) {
+
+	constexpr size_t N = 4;
+
+	double min[N]{ 0.0, 0.0, 0.0, 0.0 };
+	double max[N]{ 1.0, 1.0, 1.0, 1.0 };
+
+	// product of 3x^2 in the unit hypercube, integral 1
+	auto product = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+		double r = 1.0;
+
+		for(size_t i=0; i<N; i++) r *= 3.0*x[i]*x[i];
+
+		return r;
+	});
+
+	const size_t calls = 1<<18;
+
+	SECTION( "known integral" )
+	{
+		hydra::QuasiMC<N, hydra::device::sys_t> qmc(min, max, calls);
+
+		auto result = qmc.Integrate(product);
+
+		REQUIRE( result.second > 0.0 );
+		REQUIRE( ::fabs(result.first - 1.0) < 5.0*result.second );
+		REQUIRE( result.first  == qmc.GetResult() );
+		REQUIRE( result.second == qmc.GetAbsError() );
+	}
+
+	SECTION( "error below plain Monte Carlo" )
+	{
+		hydra::QuasiMC<N, hydra::device::sys_t> qmc(min, max, calls);
+		hydra::Plain<N, hydra::device::sys_t>   plain(min, max, calls);
+
+		auto quasi  = qmc.Integrate(product);
+		auto random = plain.Integrate(product);
+
+		REQUIRE( quasi.second < 0.1*random.second );
+	}
+
+	SECTION( "replicas and seeds" )
+	{
+		hydra::QuasiMC<N, hydra::device::sys_t> qmc(min, max, calls, 1234, 8);
+
+		auto first  = qmc.Integrate(product);
+		auto second = qmc.Integrate(product);
+
+		//same seed, same points
+		REQUIRE( first.first  == second.first );
+		REQUIRE( first.second == second.second );
+
+		qmc.SetSeed(4321);
+
+		auto other = qmc.Integrate(product);
+
+		REQUIRE( other.first != first.first );
+		REQUIRE( ::fabs(other.first - 1.0) < 5.0*other.second );
+	}
+
+}
@@ -0,0 +1,172 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * rebind.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+
+#include <hydra/cpp/System.h>
+#include <hydra/host/System.h>
+#include <hydra/device/System.h>
+#include <hydra/multivector.h>
+#include <hydra/multiarray.h>
+#include <hydra/Decays.h>
+#include <hydra/Vector4R.h>
+#include <hydra/Placeholders.h>
+#include <hydra/detail/Rebind.h>
+#include <hydra/detail/external/thrust/sequence.h>
+#include <hydra/detail/external/thrust/fill.h>
+
+TEST_CASE( "rebind","hydra::rebind" ) {
+
+	using namespace hydra::placeholders;
+
+	typedef hydra::multivector<hydra::tuple<double,int>, hydra::cpp::sys_t>    cpp_table_t;
+	typedef hydra::multivector<hydra::tuple<double,int>, hydra::device::sys_t> device_table_t;
+
+	const size_t n = 1000;
+
+	cpp_table_t data(n);
+
+	for(size_t i=0; i<n; i++) data[i] = hydra::make_tuple(0.5*i, int(i));
+
+	SECTION( "memory resources" )
+	{
+		//CPP and the device backend on host systems allocate with std::malloc
+		REQUIRE( (hydra::detail::is_rebindable<hydra::cpp::sys_t, hydra::device::sys_t>::value) == true );
+		REQUIRE( (hydra::detail::is_rebindable<hydra::device::sys_t, hydra::cpp::sys_t>::value) == true );
+
+		//the host backend allocates with std::allocator
+		REQUIRE( (hydra::detail::is_rebindable<hydra::cpp::sys_t, hydra::host::sys_t>::value) == false );
+		REQUIRE( (hydra::detail::is_rebindable<hydra::host::sys_t, hydra::cpp::sys_t>::value) == false );
+
+		REQUIRE( hydra::detail::is_host_backend<hydra::cpp::sys_t>::value == true );
+		REQUIRE( hydra::detail::is_host_backend<hydra::host::sys_t>::value == true );
+	}
+
+	SECTION( "adopt_storage" )
+	{
+		hydra::cpp::vector<double>    from(n, 1.0);
+		hydra::device::vector<double> to(10, 2.0);
+
+		const double* storage = HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(from.data());
+
+		hydra::detail::adopt_storage(to, from);
+
+		REQUIRE( from.size() == 0 );
+		REQUIRE( to.size() == n );
+		REQUIRE( HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(to.data()) == storage );
+		REQUIRE( to[0] == 1.0 );
+		REQUIRE( to[n-1] == 1.0 );
+	}
+
+	SECTION( "multivector: rebind without copies" )
+	{
+		const double* x = hydra::get<0>(data.spans()).data();
+		const int*    k = hydra::get<1>(data.spans()).data();
+
+		device_table_t rebound = hydra::rebind<hydra::device::sys_t>(std::move(data));
+
+		REQUIRE( data.size() == 0 );
+		REQUIRE( rebound.size() == n );
+		REQUIRE( hydra::get<0>(rebound.spans()).data() == x );
+		REQUIRE( hydra::get<1>(rebound.spans()).data() == k );
+
+		for(size_t i=0; i<n; i++){
+
+			REQUIRE( hydra::get<0>(rebound[i]) == 0.5*i );
+			REQUIRE( hydra::get<1>(rebound[i]) == int(i) );
+		}
+
+		//and back, with the cross-backend move constructor
+		cpp_table_t back(std::move(rebound));
+
+		REQUIRE( rebound.size() == 0 );
+		REQUIRE( hydra::get<0>(back.spans()).data() == x );
+	}
+
+	SECTION( "multivector: copy between backends not sharing the memory resource" )
+	{
+		hydra::multivector<hydra::tuple<double,int>, hydra::host::sys_t> copy(std::move(data));
+
+		REQUIRE( copy.size() == n );
+		REQUIRE( hydra::get<0>(copy[n-1]) == 0.5*(n-1) );
+	}
+
+	SECTION( "multivector: rebind_view" )
+	{
+		auto view = hydra::rebind_view<hydra::device::sys_t>(data);
+
+		REQUIRE( size_t(view.size()) == n );
+
+		for(size_t i=0; i<n; i++)
+			REQUIRE( hydra::get<0>(view.begin()[i]) == 0.5*i );
+
+		//writes through the view reach the container
+		view.begin()[0] = hydra::make_tuple(-1.0, -1);
+
+		REQUIRE( hydra::get<0>(data[0]) == -1.0 );
+		REQUIRE( hydra::get<1>(data[0]) == -1 );
+		REQUIRE( data.size() == n );
+	}
+
+	SECTION( "multiarray: rebind" )
+	{
+		hydra::multiarray<double, 3, hydra::cpp::sys_t> array(n, hydra::make_tuple(1.0, 2.0, 3.0));
+
+		auto rebound = hydra::rebind<hydra::device::sys_t>(std::move(array));
+
+		REQUIRE( array.size() == 0 );
+		REQUIRE( rebound.size() == n );
+		REQUIRE( hydra::get<2>(rebound[n-1]) == 3.0 );
+	}
+
+	SECTION( "Decays: rebind" )
+	{
+		hydra::Decays<2, hydra::cpp::sys_t> decays(n);
+
+		HYDRA_EXTERNAL_NS::thrust::sequence(decays.GetWeights().begin(), decays.GetWeights().end());
+		HYDRA_EXTERNAL_NS::thrust::fill(decays.GetDaughters(1).begin(), decays.GetDaughters(1).end(),
+				hydra::make_tuple(1.0, 0.0, 0.0, -0.5));
+
+		const double* weights = HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(&(*decays.GetWeights().begin()));
+
+		auto rebound = hydra::rebind<hydra::device::sys_t>(std::move(decays));
+
+		REQUIRE( decays.size() == 0 );
+		REQUIRE( rebound.size() == n );
+		REQUIRE( HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(&(*rebound.GetWeights().begin())) == weights );
+
+		hydra::Vector4R p = hydra::get<2>(rebound[n-1]);
+
+		REQUIRE( hydra::get<0>(rebound[n-1]) == double(n-1) );
+		REQUIRE( p.get(3) == -0.5 );
+	}
+
+}
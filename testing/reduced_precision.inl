@@ -0,0 +1,176 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * reduced_precision.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+
+#include <hydra/device/System.h>
+#include <hydra/multivector.h>
+#include <hydra/ReducedPrecision.h>
+#include <hydra/Random.h>
+#include <hydra/Pdf.h>
+#include <hydra/LogLikelihoodFCN.h>
+#include <hydra/functions/Gaussian.h>
+#include <hydra/Placeholders.h>
+#include <hydra/detail/external/thrust/transform.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE( "ReducedPrecision","hydra::FixedPoint" ) {
+
+	using namespace hydra::placeholders;
+
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+
+	SECTION( "FixedPoint<uint16_t>: round trip and clamping" )
+	{
+		auto codec = hydra::make_fixed_point<uint16_t>(-5.0, 5.0);
+
+		REQUIRE( codec.GetScale() == Approx(10.0/65535.0) );
+
+		REQUIRE( codec.Encode(-5.0) == 0 );
+		REQUIRE( codec.Encode( 5.0) == 65535 );
+		REQUIRE( codec.Decode(0)     == Approx(-5.0) );
+		REQUIRE( codec.Decode(65535) == Approx( 5.0) );
+
+		for(int i=0; i<=1000; i++){
+
+			double x = -5.0 + 0.01*i;
+
+			REQUIRE( std::fabs(codec.Decode(codec.Encode(x)) - x) <= 0.5*codec.GetScale()*(1.0 + 1.0e-9) );
+		}
+
+		//out of range values are stored as the closest limit, NaN as the lower one
+		REQUIRE( codec.Encode(-7.0) == 0 );
+		REQUIRE( codec.Encode( 1.0e10) == 65535 );
+		REQUIRE( codec.Encode( nan) == 0 );
+	}
+
+	SECTION( "FixedPoint<int16_t>: round trip and clamping" )
+	{
+		auto codec = hydra::make_fixed_point<int16_t>(-1.0, 1.0);
+
+		REQUIRE( codec.Encode(-1.0) == -32768 );
+		REQUIRE( codec.Encode( 1.0) ==  32767 );
+		REQUIRE( codec.Decode(-32768) == Approx(-1.0) );
+		REQUIRE( codec.Decode( 32767) == Approx( 1.0) );
+
+		for(int i=0; i<=1000; i++){
+
+			double x = -1.0 + 0.002*i;
+
+			REQUIRE( std::fabs(codec.Decode(codec.Encode(x)) - x) <= 0.5*codec.GetScale()*(1.0 + 1.0e-9) );
+		}
+
+		REQUIRE( codec.Encode(-3.0) == -32768 );
+		REQUIRE( codec.Encode( 3.0) ==  32767 );
+		REQUIRE( codec.Encode( nan) == -32768 );
+	}
+
+	SECTION( "invalid codecs" )
+	{
+		REQUIRE_THROWS_AS( (hydra::FixedPoint<uint16_t>(0.0, 1.0)), std::invalid_argument );
+		REQUIRE_THROWS_AS( (hydra::make_fixed_point<uint16_t>(1.0, 1.0)), std::invalid_argument );
+	}
+
+	SECTION( "ReducedPrecision<float>: round trip" )
+	{
+		hydra::ReducedPrecision<float> codec;
+
+		REQUIRE( codec.Decode(codec.Encode(0.1)) == double(float(0.1)) );
+		REQUIRE( codec(1.5f) == 1.5 );
+	}
+
+	SECTION( "log-likelihood over decoded columns" )
+	{
+		typedef hydra::multivector<hydra::tuple<double, double>, hydra::device::sys_t>     table_t;
+		typedef hydra::multivector<hydra::tuple<uint16_t, float>, hydra::device::sys_t>  stored_t;
+
+		const size_t n = 100000;
+		const double min = 0.0, max = 10.0;
+
+		table_t data(n);
+
+		hydra::Random<> generator(4321);
+		generator.Gauss(5.0, 1.0, data.begin(_0), data.end(_0));
+		generator.Gauss(5.0, 1.0, data.begin(_1), data.end(_1));
+
+		auto fixed_point = hydra::make_fixed_point<uint16_t>(min, max);
+		auto encoder = hydra::make_encoder(fixed_point, hydra::ReducedPrecision<float>());
+		auto decoder = hydra::make_decoder(fixed_point, hydra::ReducedPrecision<float>());
+
+		stored_t stored(n);
+
+		HYDRA_EXTERNAL_NS::thrust::transform(data.begin(), data.end(), stored.begin(), encoder);
+
+		hydra::Parameter mean  = hydra::Parameter::Create().Name("Mean").Value(5.0).Error(0.0001).Limits(0.0, 10.0);
+		hydra::Parameter sigma = hydra::Parameter::Create().Name("Sigma").Value(1.0).Error(0.0001).Limits(0.01, 1.5);
+
+		//the normalization does not depend on the column of the Gaussian
+		hydra::GaussianAnalyticalIntegral integral(min, max);
+
+		auto gaussian_0 = hydra::make_pdf(hydra::Gaussian<0>(mean, sigma), integral);
+		auto gaussian_1 = hydra::make_pdf(hydra::Gaussian<1>(mean, sigma), integral);
+
+		auto fcn_double_0  = hydra::make_loglikehood_fcn(gaussian_0, data.begin(), data.end());
+		auto fcn_decoded_0 = hydra::make_loglikehood_fcn(gaussian_0, stored.begin(decoder), stored.end(decoder));
+		auto fcn_double_1  = hydra::make_loglikehood_fcn(gaussian_1, data.begin(), data.end());
+		auto fcn_decoded_1 = hydra::make_loglikehood_fcn(gaussian_1, stored.begin(decoder), stored.end(decoder));
+
+		for(int k=0; k<3; k++){
+
+			std::vector<double> parameters{ 4.9 + 0.1*k, 0.9 + 0.05*k };
+
+			//bound of the change of the sum of -log(pdf): |d log(pdf)/dx| times the quantization error
+			double bound_0 = 0, bound_1 = 0;
+
+			for(size_t i=0; i<n; i++){
+
+				double slope_0 = std::fabs(hydra::get<0>(data[i]) - parameters[0])/(parameters[1]*parameters[1]);
+				double slope_1 = std::fabs(hydra::get<1>(data[i]) - parameters[0])/(parameters[1]*parameters[1]);
+
+				bound_0 += slope_0*0.5*fixed_point.GetScale();
+				bound_1 += slope_1*std::fabs(hydra::get<1>(data[i]))*std::numeric_limits<float>::epsilon();
+			}
+
+			double expected_0 = fcn_double_0(parameters);
+			double expected_1 = fcn_double_1(parameters);
+
+			REQUIRE( std::fabs(fcn_decoded_0(parameters) - expected_0) <= bound_0 );
+			REQUIRE( std::fabs(fcn_decoded_1(parameters) - expected_1) <= bound_1 );
+			REQUIRE( fcn_decoded_0(parameters) != expected_0 );
+		}
+	}
+
+}
@@ -0,0 +1,112 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * spans.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+
+#include <hydra/device/System.h>
+#include <hydra/multivector.h>
+#include <hydra/multivector_view.h>
+#include <hydra/ColumnSpan.h>
+#include <hydra/detail/AlignedAllocator.h>
+#include <hydra/Tuple.h>
+#include <hydra/detail/external/thrust/sequence.h>
+
+#include <cstdint>
+
+TEST_CASE( "spans","hydra::ColumnSpan" ) {
+
+	using namespace hydra::placeholders;
+
+	typedef hydra::multivector<hydra::tuple<double, float>, hydra::device::sys_t> table_t;
+
+	table_t data(37);
+
+	HYDRA_EXTERNAL_NS::thrust::sequence(data.begin(_0), data.end(_0));
+	HYDRA_EXTERNAL_NS::thrust::sequence(data.begin(_1), data.end(_1));
+
+	SECTION( "multivector" )
+	{
+		auto spans = data.spans();
+
+		auto x = hydra::get<0>(spans);
+		auto y = hydra::get<1>(spans);
+
+		REQUIRE( x.data() == HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(&(*data.begin(_0))) );
+		REQUIRE( y.data() == HYDRA_EXTERNAL_NS::thrust::raw_pointer_cast(&(*data.begin(_1))) );
+		REQUIRE( x.size() == 37 );
+		REQUIRE( y.size() == 37 );
+		REQUIRE( x.padded_size() >= x.size() );
+		REQUIRE( y.padded_size() >= y.size() );
+
+#ifdef HYDRA_ALIGNED_ALLOCATION
+		REQUIRE( reinterpret_cast<std::uintptr_t>(x.data()) % HYDRA_ALIGNMENT == 0 );
+		REQUIRE( reinterpret_cast<std::uintptr_t>(y.data()) % HYDRA_ALIGNMENT == 0 );
+		REQUIRE( (x.padded_size()*sizeof(double)) % HYDRA_ALIGNMENT == 0 );
+		REQUIRE( (y.padded_size()*sizeof(float))  % HYDRA_ALIGNMENT == 0 );
+		REQUIRE( x.padded_size() - x.size() < HYDRA_ALIGNMENT/sizeof(double) );
+#else
+		REQUIRE( x.padded_size() == x.size() );
+		REQUIRE( y.padded_size() == y.size() );
+#endif
+
+		for(size_t i=0; i<37; i++)
+		{
+			REQUIRE( x[i] == double(i) );
+			REQUIRE( y[i] == float(i) );
+		}
+
+		//writes through the spans are seen by the container
+		x[5] = -5.0;
+
+		REQUIRE( data.begin(_0)[5] == -5.0 );
+
+		//const spans
+		table_t const& cdata = data;
+
+		REQUIRE( hydra::get<1>(cdata.spans()).data() == y.data() );
+		REQUIRE( hydra::get<1>(cdata.spans()).padded_size() == y.padded_size() );
+	}
+
+	SECTION( "multivector_view" )
+	{
+		double* px = hydra::get<0>(data.spans()).data();
+		float*  py = hydra::get<1>(data.spans()).data();
+
+		auto view  = hydra::make_multivector_view(hydra::device::sys, 20, px, py);
+		auto spans = view.spans();
+
+		REQUIRE( hydra::get<0>(spans).data() == px );
+		REQUIRE( hydra::get<1>(spans).data() == py );
+		REQUIRE( hydra::get<0>(spans).size() == 20 );
+		REQUIRE( hydra::get<0>(spans).padded_size() == 20 );
+	}
+
+}
@@ -0,0 +1,114 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * sparsegrid.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+
+#include <catch/catch.hpp>
+#include <array>
+#include <cmath>
+
+#include <hydra/device/System.h>
+#include <hydra/SparseGridQuadrature.h>
+#include <hydra/GenzMalikQuadrature.h>
+#include <hydra/Function.h>
+#include <hydra/FunctionWrapper.h>
+
+TEST_CASE( "SparseGridQuadrature","hydra::SparseGridQuadrature" ) {
+
+	constexpr size_t N = 6;
+
+	std::array<double,N> min{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	std::array<double,N> max{ 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+	// product of cosines, integral sin(1)^6
+	auto cosines = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+		double r = 1.0;
+
+		for(size_t i=0; i<N; i++) r *= ::cos(x[i]);
+
+		return r;
+	});
+
+	const double integral = ::pow(::sin(1.0), 6.0);
+
+	SECTION( "known integral" )
+	{
+		hydra::SparseGridQuadrature<N, hydra::device::sys_t> quadrature(min, max, 1.0e-9);
+
+		auto result = quadrature.Integrate(cosines);
+
+		REQUIRE( result.first == Approx(integral).epsilon(1.0e-8) );
+		REQUIRE( result.first  == quadrature.GetResult() );
+		REQUIRE( result.second == quadrature.GetAbsError() );
+		REQUIRE( quadrature.GetNCalls() > 0 );
+		REQUIRE( quadrature.GetNCalls() < 100000 );
+	}
+
+	SECTION( "dimension adaptivity" )
+	{
+		// depends only on the first dimension
+		auto flat = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+			return ::exp(x[0]);
+		});
+
+		hydra::SparseGridQuadrature<N, hydra::device::sys_t> quadrature(min, max, 1.0e-10);
+
+		auto result = quadrature.Integrate(flat);
+
+		REQUIRE( result.first == Approx(::exp(1.0) - 1.0).epsilon(1.0e-9) );
+
+		hydra::SparseGridQuadrature<N, hydra::device::sys_t> isotropic(min, max, 1.0e-10);
+
+		isotropic.Integrate(cosines);
+
+		REQUIRE( quadrature.GetNCalls() < isotropic.GetNCalls() );
+	}
+
+	SECTION( "fewer calls than Genz-Malik" )
+	{
+		hydra::SparseGridQuadrature<N, hydra::device::sys_t> quadrature(min, max, 1.0e-7);
+		hydra::GenzMalikQuadrature<N, hydra::device::sys_t>  genz_malik(min, max, 1);
+
+		genz_malik.SetMaxRelativeError(1.0e-7);
+
+		auto sparse   = quadrature.Integrate(cosines);
+		auto adaptive = genz_malik.Integrate(cosines);
+
+		REQUIRE( sparse.first   == Approx(integral).epsilon(1.0e-6) );
+		REQUIRE( adaptive.first == Approx(integral).epsilon(1.0e-6) );
+
+		//each Genz-Malik box takes 2^N + 2N^2 + 2N + 1 calls
+		size_t genz_malik_calls = genz_malik.GetBoxList().size()*((1<<N) + 2*N*N + 2*N + 1);
+
+		REQUIRE( quadrature.GetNCalls() < genz_malik_calls );
+	}
+
+}
@@ -0,0 +1,322 @@
+/*----------------------------------------------------------------------------
+ *
+ *   Copyright (C) 2016 - 2018 Antonio Augusto Alves Junior
+ *
+ *   This file is part of Hydra Data Analysis Framework.
+ *
+ *   Hydra is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   Hydra is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with Hydra.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *---------------------------------------------------------------------------*/
+
+/*
+ * vegas.inl
+ *
+ *  Created on: 18/10/2018
+ *      Author: Antonio Augusto Alves Junior
+ */
+
+#pragma once
+
+#include <catch/catch.hpp>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include <hydra/device/System.h>
+#include <hydra/VegasState.h>
+#include <hydra/Vegas.h>
+#include <hydra/Function.h>
+#include <hydra/FunctionWrapper.h>
+#include <hydra/Parameter.h>
+#include <hydra/functions/Gaussian.h>
+#include <hydra/Tuple.h>
+
+TEST_CASE( "Vegas","hydra::Vegas" ) {
+
+	constexpr size_t N = 3;
+
+	double min[N]{ -5.0, -5.0, -5.0 };
+	double max[N]{  5.0,  5.0,  5.0 };
+
+	// normalized 3D Gaussian, truncated at 5 sigma
+	auto gaussian = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+		double r2 = 0.0;
+
+		for(size_t i=0; i<N; i++) r2 += x[i]*x[i];
+
+		return ::exp(-0.5*r2)/::pow(2.0*PI, 1.5);
+	});
+
+	const double integral = ::pow(::erf(5.0/::sqrt(2.0)), 3.0);
+
+	auto configure = [](hydra::VegasState<N, hydra::device::sys_t>& state, int mode){
+
+		state.SetVerbose(-2);
+		state.SetMode(mode);
+		state.SetIterations(10);
+		state.SetMaxError(1.0e-3);
+		state.SetCalls(100000);
+		state.SetTrainingCalls(10000);
+		state.SetTrainingIterations(2);
+	};
+
+	SECTION( "importance sampling" )
+	{
+		hydra::VegasState<N, hydra::device::sys_t> state(min, max);
+		configure(state, hydra::MODE_IMPORTANCE);
+
+		hydra::Vegas<N, hydra::device::sys_t> vegas(state);
+
+		auto result = vegas.Integrate(gaussian);
+
+		REQUIRE( result.second > 0.0 );
+		REQUIRE( ::fabs(result.first - integral) < 5.0*result.second );
+	}
+
+	SECTION( "importance sampling only, scrambled seeds" )
+	{
+		hydra::VegasState<N, hydra::device::sys_t> state(min, max);
+		configure(state, hydra::MODE_IMPORTANCE_ONLY);
+		state.SetScrambledSeeds(true);
+
+		hydra::Vegas<N, hydra::device::sys_t> vegas(state);
+
+		auto result = vegas.Integrate(gaussian);
+
+		REQUIRE( result.second > 0.0 );
+		REQUIRE( ::fabs(result.first - integral) < 5.0*result.second );
+	}
+
+	SECTION( "adaptive stratified sampling" )
+	{
+		hydra::VegasState<N, hydra::device::sys_t> state(min, max);
+		configure(state, hydra::MODE_ADAPTIVE_STRATIFIED);
+
+		hydra::Vegas<N, hydra::device::sys_t> vegas(state);
+
+		auto result = vegas.Integrate(gaussian);
+
+		REQUIRE( result.second > 0.0 );
+		REQUIRE( ::fabs(result.first - integral) < 5.0*result.second );
+	}
+
+	SECTION( "multiple integrands in one pass" )
+	{
+		// second moment of the first coordinate
+		auto moment = hydra::wrap_lambda( [] __hydra_dual__ (unsigned int, double* x){
+
+			double r2 = 0.0;
+
+			for(size_t i=0; i<N; i++) r2 += x[i]*x[i];
+
+			return x[0]*x[0]*::exp(-0.5*r2)/::pow(2.0*PI, 1.5);
+		});
+
+		hydra::VegasState<N, hydra::device::sys_t> state(min, max);
+		configure(state, hydra::MODE_IMPORTANCE);
+
+		hydra::Vegas<N, hydra::device::sys_t> vegas(state);
+
+		auto results = vegas.Integrate( hydra::make_tuple(gaussian, moment, gaussian) );
+
+		REQUIRE( results.size() == 3 );
+
+		//the grid is trained on the first functor, as by the single functor integration
+		hydra::VegasState<N, hydra::device::sys_t> single_state(min, max);
+		configure(single_state, hydra::MODE_IMPORTANCE);
+
+		hydra::Vegas<N, hydra::device::sys_t> single(single_state);
+
+		auto first = single.Integrate(gaussian);
+
+		REQUIRE( results[0].first  == first.first );
+		REQUIRE( results[0].second == first.second );
+
+		//the same functor in another slot sees the same calls
+		REQUIRE( results[2].first  == Approx(results[0].first).epsilon(1.0e-3) );
+		REQUIRE( results[2].second == Approx(results[0].second).epsilon(1.0e-1) );
+
+		hydra::VegasState<N, hydra::device::sys_t> moment_state(min, max);
+		configure(moment_state, hydra::MODE_IMPORTANCE);
+
+		hydra::Vegas<N, hydra::device::sys_t> other(moment_state);
+
+		auto second = other.Integrate(moment);
+
+		REQUIRE( results[1].second > 0.0 );
+		REQUIRE( ::fabs(results[1].first - second.first) <
+				5.0*::sqrt(results[1].second*results[1].second + second.second*second.second) );
+	}
+
+	SECTION( "parameter gradient" )
+	{
+		double lower[1]{ -1.0 };
+		double upper[1]{  3.0 };
+
+		auto configure_1d = [](hydra::VegasState<1, hydra::device::sys_t>& state){
+
+			state.SetVerbose(-2);
+			state.SetMode(hydra::MODE_IMPORTANCE);
+			state.SetIterations(10);
+			state.SetMaxError(1.0e-3);
+			state.SetCalls(100000);
+			state.SetTrainingCalls(10000);
+			state.SetTrainingIterations(2);
+		};
+
+		const double mean = 0.5, sigma = 0.7;
+
+		hydra::Parameter mean_p  = hydra::Parameter::Create().Name("mean").Value(mean);
+		hydra::Parameter sigma_p = hydra::Parameter::Create().Name("sigma").Value(sigma);
+
+		auto integrate = [&](double mean, double sigma){
+
+			hydra::Parameter mean_p  = hydra::Parameter::Create().Name("mean").Value(mean);
+			hydra::Parameter sigma_p = hydra::Parameter::Create().Name("sigma").Value(sigma);
+
+			hydra::VegasState<1, hydra::device::sys_t> state(lower, upper);
+			configure_1d(state);
+
+			hydra::Vegas<1, hydra::device::sys_t> vegas(state);
+
+			return vegas.Integrate( hydra::Gaussian<>(mean_p, sigma_p) );
+		};
+
+		hydra::VegasState<1, hydra::device::sys_t> state(lower, upper);
+		configure_1d(state);
+
+		hydra::Vegas<1, hydra::device::sys_t> vegas(state);
+
+		std::vector<std::pair<double, double>> gradient;
+
+		auto result = vegas.Integrate( hydra::Gaussian<>(mean_p, sigma_p), gradient );
+
+		REQUIRE( gradient.size() == 2 );
+
+		//the value is integrated as by Integrate(functor)
+		auto value = integrate(mean, sigma);
+
+		REQUIRE( result.first  == Approx(value.first).epsilon(1.0e-10) );
+		REQUIRE( result.second == Approx(value.second).epsilon(1.0e-6) );
+
+		// unnormalized Gaussian over [a, b]: dI/dmean = f(a) - f(b),
+		// dI/dsigma = (I - (b - mean) f(b) + (a - mean) f(a))/sigma
+		auto f = [=](double x){ return ::exp(-0.5*(x - mean)*(x - mean)/(sigma*sigma)); };
+
+		const double a = lower[0], b = upper[0];
+		const double norm = sigma*::sqrt(0.5*PI)*( ::erf((b - mean)/(sigma*::sqrt(2.0)))
+				- ::erf((a - mean)/(sigma*::sqrt(2.0))) );
+
+		const double dmean  = f(a) - f(b);
+		const double dsigma = (norm - (b - mean)*f(b) + (a - mean)*f(a))/sigma;
+
+		REQUIRE( gradient[0].second > 0.0 );
+		REQUIRE( gradient[1].second > 0.0 );
+		REQUIRE( ::fabs(gradient[0].first - dmean)  < 5.0*gradient[0].second );
+		REQUIRE( ::fabs(gradient[1].first - dsigma) < 5.0*gradient[1].second );
+
+		//central finite differences of Integrate(functor)
+		const double h = 1.0e-3;
+
+		auto mean_up     = integrate(mean + h, sigma);
+		auto mean_down   = integrate(mean - h, sigma);
+		auto sigma_up    = integrate(mean, sigma + h);
+		auto sigma_down  = integrate(mean, sigma - h);
+
+		const double fd_mean  = (mean_up.first  - mean_down.first )/(2.0*h);
+		const double fd_sigma = (sigma_up.first - sigma_down.first)/(2.0*h);
+
+		REQUIRE( ::fabs(gradient[0].first - fd_mean)  < 5.0*gradient[0].second );
+		REQUIRE( ::fabs(gradient[1].first - fd_sigma) < 5.0*gradient[1].second );
+
+		//the derivatives integrated as separate functors over the same calls have the same errors
+		auto gaussian = hydra::wrap_lambda( [=] __hydra_dual__ (unsigned int, double* x){
+
+			double d = x[0] - mean;
+
+			return ::exp(-0.5*d*d/(sigma*sigma));
+		});
+
+		auto gaussian_dmean = hydra::wrap_lambda( [=] __hydra_dual__ (unsigned int, double* x){
+
+			double d = x[0] - mean;
+
+			return ::exp(-0.5*d*d/(sigma*sigma))*d/(sigma*sigma);
+		});
+
+		auto gaussian_dsigma = hydra::wrap_lambda( [=] __hydra_dual__ (unsigned int, double* x){
+
+			double d = x[0] - mean;
+
+			return ::exp(-0.5*d*d/(sigma*sigma))*d*d/(sigma*sigma*sigma);
+		});
+
+		hydra::VegasState<1, hydra::device::sys_t> tuple_state(lower, upper);
+		configure_1d(tuple_state);
+
+		hydra::Vegas<1, hydra::device::sys_t> other(tuple_state);
+
+		auto derivatives = other.Integrate( hydra::make_tuple(gaussian, gaussian_dmean, gaussian_dsigma) );
+
+		for(size_t k=0; k<2; k++)
+		{
+			REQUIRE( gradient[k].first  == Approx(derivatives[k+1].first).epsilon(1.0e-10) );
+			REQUIRE( gradient[k].second == Approx(derivatives[k+1].second).epsilon(1.0e-6) );
+		}
+	}
+
+	SECTION( "SaveState/LoadState round trip" )
+	{
+		const char* filename = "hydra_test_vegas_state.bin";
+
+		hydra::VegasState<N, hydra::device::sys_t> state(min, max);
+		configure(state, hydra::MODE_ADAPTIVE_STRATIFIED);
+
+		hydra::Vegas<N, hydra::device::sys_t> vegas(state);
+
+		vegas.Integrate(gaussian);
+
+		REQUIRE( vegas.GetState().SaveState(filename) == true );
+
+		hydra::VegasState<N, hydra::device::sys_t> loaded(min, max);
+
+		REQUIRE( loaded.LoadState(filename) == true );
+
+		REQUIRE( loaded.GetNBins() == vegas.GetState().GetNBins() );
+		REQUIRE( loaded.GetMode()  == vegas.GetState().GetMode() );
+		REQUIRE( loaded.GetResult() == vegas.GetState().GetResult() );
+
+		for(size_t i=0; i<vegas.GetState().GetXi().size(); i++)
+			REQUIRE( loaded.GetXi()[i] == vegas.GetState().GetXi()[i] );
+
+		//the warm integration skips the training and uses the loaded grid
+		hydra::Vegas<N, hydra::device::sys_t> warm(loaded);
+
+		auto result = warm.WarmIntegrate(gaussian);
+
+		REQUIRE( ::fabs(result.first - integral) < 5.0*result.second );
+
+		//states with a different number of dimensions are rejected
+		double min2[2]{ -1.0, -1.0 };
+		double max2[2]{  1.0,  1.0 };
+
+		hydra::VegasState<2, hydra::device::sys_t> other(min2, max2);
+
+		REQUIRE( other.LoadState(filename) == false );
+
+		std::remove(filename);
+	}
+
+}